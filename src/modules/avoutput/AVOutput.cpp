@@ -6,6 +6,7 @@
  */
 
 #include "AVOutput.h"
+#include "nal_units.h"
 #include "yuri/core/Module.h"
 #include "yuri/libav/libav.h"
 #include "yuri/core/frame/RawVideoFrame.h"
@@ -29,11 +30,35 @@ core::Parameters AVOutput::configure() {
     p["video_codec"]["Specify codec for video output."] = std::string("");
     p["audio_codec"]["Specify codec for audio output."] = std::string("");
 	p["audio"]["Allow audio in stream."] = true;
+    p["format"]["Output container: auto (guessed from url, flv for RTMP), flv, mp4, fmp4 (fragmented mp4), mkv, mpegts, nut "
+                "or any other libavformat muxer name."] = std::string("auto");
+    p["queue_size"]["Maximal number of frames waiting for each encoder (and twice as many packets waiting for the muxer)."] = 16;
 	return p;
 }
 
 namespace {
 
+const auto queue_timeout = 100_ms;
+
+struct container_t {
+    std::string name;
+    std::string movflags;
+};
+
+container_t get_container(const std::string& format, const std::string& url) {
+    if (format == "fmp4")
+        return {"mp4", "frag_keyframe+empty_moov+default_base_moof"};
+    if (format == "mkv")
+        return {"matroska", ""};
+    if (format == "ts")
+        return {"mpegts", ""};
+    if (!format.empty() && format != "auto")
+        return {format, ""};
+    if (url.compare(0, 4, "rtmp") != 0 && av_guess_format(nullptr, url.c_str(), nullptr))
+        return {"", ""};
+    return {"flv", ""};
+}
+
 void add_stream(StreamDescription *output_stream, AVFormatContext *fmt_ctx, const AVCodec **codec, enum AVCodecID codec_id) {
     #if defined(__arm__) || defined(__aarch64__)
     // Should be Raspberry specific, not all arm, uses HW encoders for video
@@ -49,9 +74,6 @@ void add_stream(StreamDescription *output_stream, AVFormatContext *fmt_ctx, cons
     #endif
     if (!(*codec))
         throw(std::runtime_error("Could not find encoder for codec."));
-    output_stream->tmp_pkt = av_packet_alloc();
-    if (!output_stream->tmp_pkt)
-        throw(std::runtime_error("Could not allocate AVPacket."));
     output_stream->stream = avformat_new_stream(fmt_ctx, nullptr);
     if (!output_stream->stream)
         throw(std::runtime_error("Could not allocate stream."));
@@ -108,6 +130,25 @@ void add_stream(StreamDescription *output_stream, AVFormatContext *fmt_ctx, cons
         codec_ctx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 }
 
+void add_copy_stream(StreamDescription *output_stream, AVFormatContext *fmt_ctx, enum AVCodecID codec_id, const std::vector<uint8_t>& extradata) {
+    output_stream->stream = avformat_new_stream(fmt_ctx, nullptr);
+    if (!output_stream->stream)
+        throw(std::runtime_error("Could not allocate stream."));
+    output_stream->stream->id = fmt_ctx->nb_streams-1;
+    AVCodecParameters *par = output_stream->stream->codecpar;
+    par->codec_type = AVMEDIA_TYPE_VIDEO;
+    par->codec_id   = codec_id;
+    par->width      = output_stream->width;
+    par->height     = output_stream->height;
+    par->extradata  = static_cast<uint8_t*>(av_mallocz(extradata.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+    if (!par->extradata)
+        throw(std::runtime_error("Could not allocate extradata."));
+    std::copy(extradata.begin(), extradata.end(), par->extradata);
+    par->extradata_size = extradata.size();
+    // Only a hint, muxers may choose their own time base
+    output_stream->stream->time_base = av_make_q(1, 90000);
+}
+
 AVFrame *alloc_video_frame(enum AVPixelFormat pix_fmt, int width, int height) {
     AVFrame *frame;
     int ret;
@@ -141,30 +182,24 @@ AVFrame *alloc_audio_frame(enum AVSampleFormat sample_fmt, uint64_t channel_layo
     return frame;
 }
 
-bool write_frame(AVFormatContext *fmt_ctx, AVCodecContext *codec_ctx, AVStream *st, AVFrame *frame, AVPacket *pkt) {
-    auto ret = avcodec_send_frame(codec_ctx, frame);
-    if (ret < 0)
-        throw(std::runtime_error("Error sending a frame to the encoder."));
-    while (ret >= 0) {
-        ret = avcodec_receive_packet(codec_ctx, pkt);
-        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
-            break;
-        else if (ret < 0)
-            throw(std::runtime_error("Error encoding a frame."));
-
-        av_packet_rescale_ts(pkt, codec_ctx->time_base, st->time_base);
-        pkt->stream_index = st->index;
-
-        ret = av_interleaved_write_frame(fmt_ctx, pkt);
-
-        if (ret < 0)
-            throw(std::runtime_error("Error while writing output packet."));
+AVFrame *convert_video_frame(StreamDescription *output_stream, const core::RawVideoFrame& yuri_video_frame) {
+    AVFrame *av_pic = output_stream->tmp_frame;
+    auto no_planes = yuri_video_frame.get_planes_count();
+    auto line_size = yuri_video_frame[0].get_line_size();
+    for (yuri::size_t i = 0; i < AV_NUM_DATA_POINTERS; i++) {
+        if (no_planes>1 && i < no_planes) line_size = yuri_video_frame[i].get_line_size();
+        if (i >= no_planes) {
+            av_pic->data[i]=nullptr;
+            av_pic->linesize[i]=0;
+        } else {
+            av_pic->data[i]=const_cast<uint8_t*>(yuri_video_frame[i].data());
+            if (yuri_video_frame.get_height()) {
+                av_pic->linesize[i]=line_size;
+            } else {
+                av_pic->linesize[i]=0;
+            }
+        }
     }
-    return ret == AVERROR_EOF ? false : true;
-}
-
-bool write_video_frame(AVFormatContext *fmt_ctx, StreamDescription *output_stream) {
-    AVCodecContext *codec_ctx = output_stream->enc;
 
     if (!output_stream->sws_ctx) {
         output_stream->sws_ctx = sws_getContext(output_stream->enc->width, output_stream->enc->height,
@@ -179,31 +214,34 @@ bool write_video_frame(AVFormatContext *fmt_ctx, StreamDescription *output_strea
     av_frame_make_writable(output_stream->frame);
     sws_scale(output_stream->sws_ctx, output_stream->tmp_frame->data, output_stream->tmp_frame->linesize, 0, output_stream->tmp_frame->height, output_stream->frame->data, output_stream->frame->linesize);
 
-    output_stream->frame->pts = output_stream->next_pts++; 
-    return write_frame(fmt_ctx, codec_ctx, output_stream->stream, output_stream->frame, output_stream->tmp_pkt);
+    output_stream->frame->pts = output_stream->next_pts++;
+    return output_stream->frame;
 }
 
-bool write_audio_frame(AVFormatContext *fmt_ctx, StreamDescription *output_stream) {
-    AVCodecContext *codec_ctx;
-    int dst_nb_samples;
-    codec_ctx = output_stream->enc;
-    if (output_stream->tmp_frame) {
-        dst_nb_samples = av_rescale_rnd(swr_get_delay(output_stream->swr_ctx, codec_ctx->sample_rate)
-                         + output_stream->tmp_frame->nb_samples, codec_ctx->sample_rate, codec_ctx->sample_rate, AV_ROUND_UP);
-        auto ret = av_frame_make_writable(output_stream->frame);
-        if (ret < 0)
-            throw(std::runtime_error("Could not make frame writable."));
+AVFrame *convert_audio_frame(StreamDescription *output_stream, const core::RawAudioFrame& yuri_audio_frame, log::Log& log) {
+    AVCodecContext *codec_ctx = output_stream->enc;
+    AVFrame *frame = output_stream->tmp_frame;
+    auto dst_data = frame->data[0];
+    auto src_data = yuri_audio_frame.data();
+    auto max_samples = std::min(frame->nb_samples, static_cast<int>(yuri_audio_frame.get_sample_count()));
+    if (frame->nb_samples != static_cast<int>(yuri_audio_frame.get_sample_count()))
+        log[log::warning] << "Codec samples are not the same as source samples (" << frame->nb_samples << " != " << yuri_audio_frame.get_sample_count() << ")!";
+    std::copy(src_data,src_data+max_samples*(yuri_audio_frame.get_sample_size()/8),dst_data);
+
+    auto dst_nb_samples = av_rescale_rnd(swr_get_delay(output_stream->swr_ctx, codec_ctx->sample_rate)
+                     + frame->nb_samples, codec_ctx->sample_rate, codec_ctx->sample_rate, AV_ROUND_UP);
+    auto ret = av_frame_make_writable(output_stream->frame);
+    if (ret < 0)
+        throw(std::runtime_error("Could not make frame writable."));
 
-        ret = swr_convert(output_stream->swr_ctx,
-                          output_stream->frame->data, dst_nb_samples,
-                          (const uint8_t **)output_stream->tmp_frame->data, output_stream->tmp_frame->nb_samples);
-        if (ret < 0)
-            throw(std::runtime_error("Error while converting audio frame."));
-        output_stream->tmp_frame = output_stream->frame;
-        output_stream->tmp_frame->pts = av_rescale_q(output_stream->next_pts, av_make_q(1, codec_ctx->sample_rate), codec_ctx->time_base);
-        output_stream->next_pts += dst_nb_samples;
-    }
-    return write_frame(fmt_ctx, codec_ctx, output_stream->stream, output_stream->tmp_frame, output_stream->tmp_pkt);
+    ret = swr_convert(output_stream->swr_ctx,
+                      output_stream->frame->data, dst_nb_samples,
+                      (const uint8_t **)frame->data, frame->nb_samples);
+    if (ret < 0)
+        throw(std::runtime_error("Error while converting audio frame."));
+    output_stream->frame->pts = av_rescale_q(output_stream->next_pts, av_make_q(1, codec_ctx->sample_rate), codec_ctx->time_base);
+    output_stream->next_pts += dst_nb_samples;
+    return output_stream->frame;
 }
 
 void open_video(const AVCodec *codec, StreamDescription *output_stream, AVDictionary *opt_arg) {
@@ -269,13 +307,13 @@ void open_audio(const AVCodec *codec, StreamDescription *output_stream, AVDictio
         throw(std::runtime_error("Failed to initialize the resampling context."));
 }
 
-void start_stream(AVFormatContext *fmt_ctx, AVDictionary *opt_arg, std::string address) {
+void start_stream(AVFormatContext *fmt_ctx, AVDictionary **opt_arg, std::string address) {
 	if (!(fmt_ctx->oformat->flags & AVFMT_NOFILE)) {
 		auto ret = avio_open2(&fmt_ctx->pb, address.c_str(), AVIO_FLAG_WRITE, nullptr, nullptr);
 		if (ret < 0)
             throw(std::runtime_error("Could not connect to the destination."));
 	}
-	auto ret = avformat_write_header(fmt_ctx, &opt_arg);
+	auto ret = avformat_write_header(fmt_ctx, opt_arg);
     if (ret < 0)
         throw(std::runtime_error("Could not write stream header."));
 }
@@ -286,7 +324,6 @@ static void close_stream(StreamDescription *output_stream) {
         av_frame_free(&output_stream->tmp_frame);
     }
     if (output_stream->frame)     av_frame_free(&output_stream->frame);
-    if (output_stream->tmp_pkt)   av_packet_free(&output_stream->tmp_pkt);
     if (output_stream->sws_ctx)   sws_freeContext(output_stream->sws_ctx);
     if (output_stream->swr_ctx)   swr_free(&output_stream->swr_ctx);
 }
@@ -297,15 +334,20 @@ AVOutput::AVOutput(const log::Log& _log, core::pwThreadBase parent, const core::
     : base_type(_log, parent, 1, 1, "av_output"),
 	av_initialized_(false),
 	url_(""),
+	format_("auto"),
 	fps_(30),
     audio_bitrate_(128000),
 	video_bitrate_(3584000),
 	audio_(true),
+	queue_size_(16),
+	fmt_ctx_(nullptr),
     yuri_audio_frame_(nullptr),
-    yuri_video_frame_(nullptr) {
+    yuri_video_frame_(nullptr),
+    copy_video_(false),
+    last_video_dts_(AV_NOPTS_VALUE),
+    failed_(false) {
     IOTHREAD_INIT(parameters)
 	if (audio_) resize(2,0);
-    set_latency(10_us);
 }
 
 AVOutput::~AVOutput() noexcept {
@@ -318,12 +360,20 @@ void AVOutput::initialize() {
     const AVCodec *audio_codec, *video_codec;
     AVDictionary *opt = nullptr;
 
-    memset(&fmt_ctx_, 0, sizeof(fmt_ctx_));
-	auto ret = avformat_alloc_output_context2(&fmt_ctx_, nullptr, "flv", nullptr);
-	if (ret < 0)
+    fmt_ctx_ = nullptr;
+    const auto container = get_container(format_, url_);
+    if (!container.movflags.empty())
+        av_dict_set(&opt, "movflags", container.movflags.c_str(), 0);
+    auto ret = avformat_alloc_output_context2(&fmt_ctx_, nullptr, container.name.empty() ? nullptr : container.name.c_str(), url_.c_str());
+    if (ret < 0 || !fmt_ctx_)
         throw(std::runtime_error("Could not allocate output format context."));
 
-    if (yuri_video_frame_) {
+    copy_video_ = static_cast<bool>(yuri_compressed_frame_);
+    if (copy_video_) {
+        video_st_.width = yuri_compressed_frame_->get_width();
+        video_st_.height = yuri_compressed_frame_->get_height();
+        add_copy_stream(&video_st_, fmt_ctx_, libav::avcodec_from_yuri_format(yuri_compressed_frame_->get_format()), extradata_);
+    } else if (yuri_video_frame_) {
         video_st_.width = yuri_video_frame_->get_width();
         video_st_.height = yuri_video_frame_->get_height();
         video_st_.fps = fps_;
@@ -345,16 +395,40 @@ void AVOutput::initialize() {
         #endif
     }
 
-	if (yuri_video_frame_) open_video(video_codec, &video_st_, opt);
-	if (yuri_audio_frame_) open_audio(audio_codec, &audio_st_, opt);
+	if (yuri_video_frame_ && !copy_video_) open_video(video_codec, &video_st_, nullptr);
+	if (yuri_audio_frame_) open_audio(audio_codec, &audio_st_, nullptr);
 
-    start_stream(fmt_ctx_, opt, url_);
+    start_stream(fmt_ctx_, &opt, url_);
+    av_dict_free(&opt);
+    log[log::info] << "Writing " << fmt_ctx_->oformat->name << " to " << url_ << (copy_video_ ? ", video is remuxed without encoding (B-frames are not supported)" : "");
+
+    failed_ = false;
+    first_video_timestamp_ = copy_video_ ? yuri_compressed_frame_->get_timestamp() : timestamp_t{};
+    last_video_dts_ = AV_NOPTS_VALUE;
+    video_queue_.reset(queue_size_);
+    audio_queue_.reset(queue_size_);
+    mux_queue_.reset(2 * queue_size_);
+    if (yuri_video_frame_ && !copy_video_)
+        video_thread_ = std::thread([this]{ encode_video(); });
+    if (yuri_audio_frame_)
+        audio_thread_ = std::thread([this]{ encode_audio(); });
+    mux_thread_ = std::thread([this]{ mux(); });
 
     av_initialized_ = true;
 }
 
 void AVOutput::deinitialize() {
     if (av_initialized_) {
+        // Encoders finish queued frames and flush, then the muxer writes everything they produced
+        video_queue_.close();
+        audio_queue_.close();
+        if (video_thread_.joinable())
+            video_thread_.join();
+        if (audio_thread_.joinable())
+            audio_thread_.join();
+        mux_queue_.close();
+        if (mux_thread_.joinable())
+            mux_thread_.join();
         av_write_trailer(fmt_ctx_);
         close_stream(&video_st_);
         close_stream(&audio_st_);
@@ -362,89 +436,226 @@ void AVOutput::deinitialize() {
             avio_closep(&fmt_ctx_->pb);
         if (fmt_ctx_)
             avformat_free_context(fmt_ctx_);
+        fmt_ctx_ = nullptr;
     }
     av_initialized_ = false;
 }
 
+void AVOutput::fail(const std::string& reason) {
+    log[log::error] << reason;
+    failed_ = true;
+    video_queue_.close();
+    audio_queue_.close();
+    mux_queue_.close();
+}
+
+template<class T>
+bool AVOutput::enqueue(bounded_queue<T>& queue, T& value, bool stoppable) {
+    // Only the thread running step() may check whether it should stop
+    while (!failed_ && (!stoppable || still_running())) {
+        switch (queue.push(value, queue_timeout)) {
+        case bounded_queue<T>::status_t::ok:
+            return true;
+        case bounded_queue<T>::status_t::closed:
+            return false;
+        case bounded_queue<T>::status_t::timeout:
+            break;
+        }
+    }
+    return false;
+}
+
+bool AVOutput::encode(StreamDescription& output_stream, AVFrame* frame) {
+    auto ret = avcodec_send_frame(output_stream.enc, frame);
+    if (ret < 0)
+        throw(std::runtime_error("Error sending a frame to the encoder."));
+    while (true) {
+        packet_t packet(av_packet_alloc());
+        if (!packet)
+            throw(std::runtime_error("Could not allocate AVPacket."));
+        ret = avcodec_receive_packet(output_stream.enc, packet.get());
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+            return true;
+        else if (ret < 0)
+            throw(std::runtime_error("Error encoding a frame."));
+
+        av_packet_rescale_ts(packet.get(), output_stream.enc->time_base, output_stream.stream->time_base);
+        packet->stream_index = output_stream.stream->index;
+        if (!enqueue(mux_queue_, packet, false))
+            return false;
+    }
+}
+
+void AVOutput::encode_video() {
+    try {
+        core::pRawVideoFrame frame;
+        while (video_queue_.pop(frame)) {
+            if (!encode(video_st_, convert_video_frame(&video_st_, *frame)))
+                return;
+            frame.reset();
+        }
+        encode(video_st_, nullptr);
+    } catch(const std::exception& e) {
+        fail(std::string("Not able to encode video frame: ") + e.what());
+    }
+}
+
+void AVOutput::encode_audio() {
+    try {
+        core::pRawAudioFrame frame;
+        while (audio_queue_.pop(frame)) {
+            if (!encode(audio_st_, convert_audio_frame(&audio_st_, *frame, log)))
+                return;
+            frame.reset();
+        }
+        encode(audio_st_, nullptr);
+    } catch(const std::exception& e) {
+        fail(std::string("Not able to encode audio frame: ") + e.what());
+    }
+}
+
+void AVOutput::mux() {
+    try {
+        packet_t packet;
+        while (mux_queue_.pop(packet)) {
+            // Interleaves packets of all streams by their timestamps, taking the reference from the packet
+            if (av_interleaved_write_frame(fmt_ctx_, packet.get()) < 0)
+                throw(std::runtime_error("Error while writing output packet."));
+        }
+    } catch(const std::exception& e) {
+        fail(std::string("Not able to send packet: ") + e.what());
+    }
+}
+
+bool AVOutput::remux_video_frame(const core::pCompressedVideoFrame& frame) {
+    auto format = frame->get_format();
+    const uint8_t* data = frame->get_data().data();
+    size_t size = frame->size();
+    std::vector<uint8_t> converted;
+    if (format == core::compressed_frame::avc1) {
+        if (!avc1_to_annexb(data, size, converted)) {
+            log[log::warning] << "Invalid AVC1 frame, ignoring it";
+            return false;
+        }
+        format = core::compressed_frame::h264;
+        data = converted.data();
+        size = converted.size();
+    }
+    const auto nals = summarize_nals(format, data, size);
+    if (!nals.picture) {
+        // Parameter sets sent separately (e.g. by rawavfile)
+        pending_parameter_sets_.insert(pending_parameter_sets_.end(), nals.parameter_sets.begin(), nals.parameter_sets.end());
+        return false;
+    }
+    if (!av_initialized_) {
+        // Muxers need parameter sets in the header, so the output has to start with a keyframe
+        const auto& parameter_sets = nals.parameter_sets.empty() ? pending_parameter_sets_ : nals.parameter_sets;
+        if (!nals.keyframe || parameter_sets.empty())
+            return false;
+        extradata_ = parameter_sets;
+        yuri_compressed_frame_ = frame;
+        return true;
+    }
+
+    packet_t packet(av_packet_alloc());
+    if (!packet)
+        return false;
+    // Copied, as decoders and parsers need zeroed padding after the data, which frames don't have
+    if (av_new_packet(packet.get(), pending_parameter_sets_.size() + size) < 0)
+        return false;
+    auto end = std::copy(pending_parameter_sets_.begin(), pending_parameter_sets_.end(), packet->data);
+    std::copy(data, data + size, end);
+    pending_parameter_sets_.clear();
+    auto pts = av_rescale_q((frame->get_timestamp() - first_video_timestamp_).value, av_make_q(1, 1000000), video_st_.stream->time_base);
+    // Muxers require strictly increasing timestamps
+    if (last_video_dts_ != AV_NOPTS_VALUE && pts <= last_video_dts_)
+        pts = last_video_dts_ + 1;
+    last_video_dts_ = pts;
+    // Frame timestamps don't carry decoding order, so reordered (B-frame) streams are not supported
+    packet->pts = pts;
+    packet->dts = pts;
+    if (nals.keyframe)
+        packet->flags |= AV_PKT_FLAG_KEY;
+    packet->stream_index = video_st_.stream->index;
+    return enqueue(mux_queue_, packet, true);
+}
+
 bool AVOutput::step() {
-    auto yuri_video_frame = std::dynamic_pointer_cast<core::RawVideoFrame>(pop_frame(0));
+    if (av_initialized_ && failed_) {
+        // The error was already reported, next frames will initialize the output again
+        yuri_video_frame_ = nullptr;
+        yuri_audio_frame_ = nullptr;
+        yuri_compressed_frame_ = nullptr;
+        deinitialize();
+    }
+
+    auto video_frame = std::dynamic_pointer_cast<core::VideoFrame>(pop_frame(0));
+    auto yuri_video_frame = std::dynamic_pointer_cast<core::RawVideoFrame>(video_frame);
+    auto yuri_compressed_frame = std::dynamic_pointer_cast<core::CompressedVideoFrame>(video_frame);
     auto yuri_audio_frame = std::dynamic_pointer_cast<core::RawAudioFrame>(pop_frame(1));
 
-    if (av_initialized_ && yuri_video_frame &&
-        (  last_video_format != yuri_video_frame->get_format()
-        || last_video_width  != yuri_video_frame->get_width()
-        || last_video_height != yuri_video_frame->get_height())) {
+    if (yuri_compressed_frame &&
+        yuri_compressed_frame->get_format() != core::compressed_frame::h264 &&
+        yuri_compressed_frame->get_format() != core::compressed_frame::avc1 &&
+        yuri_compressed_frame->get_format() != core::compressed_frame::h265) {
+        log[log::warning] << "Only H.264 and H.265 compressed frames can be remuxed, ignoring frame";
+        yuri_compressed_frame = nullptr;
+        video_frame = nullptr;
+    }
+
+    if (av_initialized_ && video_frame &&
+        (  last_video_format != video_frame->get_format()
+        || last_video_width  != video_frame->get_width()
+        || last_video_height != video_frame->get_height())) {
         // Different frame arrived, new initialization
         log[log::warning] << "Different frame arrived, we have to repeat the initialization.";
         yuri_video_frame_ = nullptr;
         yuri_audio_frame_ = nullptr;
+        yuri_compressed_frame_ = nullptr;
         deinitialize();
     }
 
-    yuri_video_frame ? yuri_video_frame_ = yuri_video_frame : yuri_video_frame = yuri_video_frame_;
-    yuri_audio_frame ? yuri_audio_frame_ = yuri_audio_frame : yuri_audio_frame = yuri_audio_frame_;
-
 	if (!av_initialized_) {
+        // Keeps the latest frames until there's a frame for every stream
+        if (yuri_video_frame) {
+            yuri_video_frame_ = yuri_video_frame;
+            yuri_compressed_frame_ = nullptr;
+        }
+        if (yuri_compressed_frame && remux_video_frame(yuri_compressed_frame))
+            yuri_video_frame_ = nullptr;
+        if (yuri_audio_frame)
+            yuri_audio_frame_ = yuri_audio_frame;
+        const bool have_video = yuri_video_frame_ || yuri_compressed_frame_;
         try {
-            if (audio_ && yuri_audio_frame_ && yuri_video_frame_) {
-                initialize();
-            } else if (!audio_ && yuri_video_frame_) {
+            if (have_video && (!audio_ || yuri_audio_frame_)) {
                 initialize();
             }
         } catch(const std::exception& e) {
             log[log::error] << "Initialization error: " << e.what();
         }
+        if (!av_initialized_)
+            return true;
+        // Frames used for the initialization are the first ones written
+        yuri_video_frame = copy_video_ ? nullptr : yuri_video_frame_;
+        yuri_compressed_frame = copy_video_ ? yuri_compressed_frame_ : nullptr;
+        yuri_audio_frame = yuri_audio_frame_;
+        video_frame = copy_video_ ? core::pVideoFrame(yuri_compressed_frame) : core::pVideoFrame(yuri_video_frame);
+        yuri_video_frame_ = nullptr;
+        yuri_audio_frame_ = nullptr;
+        yuri_compressed_frame_ = nullptr;
 	}
 
-	if (av_initialized_ && yuri_video_frame &&
-        (!audio_ || av_compare_ts(video_st_.next_pts, video_st_.enc->time_base, audio_st_.next_pts, audio_st_.enc->time_base) <= 0)) {
-        AVFrame *av_pic = video_st_.tmp_frame;
-		auto no_planes = yuri_video_frame->get_planes_count();
-		auto line_size = PLANE_DATA(yuri_video_frame,0).get_line_size();
-		for (yuri::size_t i = 0; i < AV_NUM_DATA_POINTERS; i++) {
-			if (no_planes>1) line_size = PLANE_DATA(yuri_video_frame,i).get_line_size();
-			if (i >= no_planes) {
-				av_pic->data[i]=nullptr;
-				av_pic->linesize[i]=0;
-			} else {
-				av_pic->data[i]=reinterpret_cast<uint8_t*>(PLANE_RAW_DATA(yuri_video_frame,i));
-				if (yuri_video_frame->get_height()) {
-					av_pic->linesize[i]=line_size;
-				} else {
-					av_pic->linesize[i]=0;
-				}
-			}
-		}
-        try {
-            if (!write_video_frame(fmt_ctx_, &video_st_))
-                log[log::warning] << "Temporary error in sending video frame.";
-            last_video_format = yuri_video_frame_->get_format();
-            last_video_width  = yuri_video_frame_->get_width();
-            last_video_height = yuri_video_frame_->get_height();
-            yuri_video_frame_ = nullptr;
-        } catch(const std::exception& e) {
-            log[log::error] << "Not able to send video frame: " << e.what();
-            deinitialize();
-        }
-    }
-    if (av_initialized_ && yuri_audio_frame &&
-        av_compare_ts(audio_st_.next_pts, audio_st_.enc->time_base, video_st_.next_pts, video_st_.enc->time_base) <= 0) {
-        AVFrame *frame = audio_st_.tmp_frame;
-        uint8_t* dst_data = reinterpret_cast<uint8_t*>(frame->data[0]);
-        uint8_t* src_data = reinterpret_cast<uint8_t*>(yuri_audio_frame->data());
-        auto max_samples = std::min(frame->nb_samples, static_cast<int>(yuri_audio_frame->get_sample_count()));
-        if (frame->nb_samples != static_cast<int>(yuri_audio_frame->get_sample_count()))
-            log[log::warning] << "Codec samples are not the same as source samples (" << frame->nb_samples << " != " << yuri_audio_frame->get_sample_count() << ")!";
-        std::copy(src_data,src_data+max_samples*(yuri_audio_frame->get_sample_size()/8),dst_data);
-        try {
-            if (!write_audio_frame(fmt_ctx_, &audio_st_))
-                log[log::warning] << "Temporary error in sending audio frame.";
-            yuri_audio_frame_ = nullptr;
-        } catch(const std::exception& e) {
-            log[log::error] << "Not able to send audio frame: " << e.what();
-            deinitialize();
-        }
+    if (video_frame) {
+        last_video_format = video_frame->get_format();
+        last_video_width  = video_frame->get_width();
+        last_video_height = video_frame->get_height();
     }
+    if (yuri_video_frame)
+        enqueue(video_queue_, yuri_video_frame, true);
+    if (yuri_compressed_frame)
+        remux_video_frame(yuri_compressed_frame);
+    if (yuri_audio_frame && audio_st_.enc)
+        enqueue(audio_queue_, yuri_audio_frame, true);
 
     return true;
 }
@@ -456,6 +667,8 @@ bool AVOutput::set_param(const core::Parameter &parameter) {
 		(audio_bitrate_, "audio_bitrate")
         (video_bitrate_, "video_bitrate")
 		(audio_,         "audio")
+		(format_,        "format")
+		(queue_size_,    "queue_size")
         )
         return true;
     return IOThread::set_param(parameter);
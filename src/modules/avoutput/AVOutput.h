@@ -8,10 +8,16 @@
 #ifndef RTMP_H_
 #define RTMP_H_
 
+#include "bounded_queue.h"
 #include "yuri/core/thread/IOThread.h"
 #include "yuri/core/frame/RawVideoFrame.h"
 #include "yuri/core/frame/RawAudioFrame.h"
+#include "yuri/core/frame/CompressedVideoFrame.h"
 #include "yuri/core/utils/managed_resource.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -26,12 +32,18 @@ extern "C" {
 namespace yuri {
 namespace avoutput {
 
+struct AVPacketDeleter {
+    void operator()(AVPacket* p) {
+        av_packet_free(&p);
+    }
+};
+using packet_t = std::unique_ptr<AVPacket, AVPacketDeleter>;
+
 struct StreamDescription {
     AVStream       *stream;
     AVCodecContext *enc;
     AVFrame        *frame;
     AVFrame        *tmp_frame;
-    AVPacket       *tmp_pkt;
     int64_t        next_pts;
     struct SwsContext *sws_ctx;
     struct SwrContext *swr_ctx;
@@ -61,13 +73,34 @@ private:
 	void initialize();
 	void deinitialize();
 
+    // Worker threads, running between initialize() and deinitialize()
+    void encode_video();
+    void encode_audio();
+    void mux();
+    //! Sends @em frame (or nullptr to flush) to the encoder and queues resulting packets for muxing
+    bool encode(StreamDescription& output_stream, AVFrame* frame);
+    void fail(const std::string& reason);
+    //! Waits for space in @em queue, giving up when the thread is stopped (or the queue closed)
+    template<class T>
+    bool enqueue(bounded_queue<T>& queue, T& value, bool stoppable);
+
+    /*!
+     * Queues compressed frame for muxing (or keeps it for initialization of the output).
+     * Frames are expected in presentation order without B-frames, as the timestamps are
+     * taken from arrival of the frames and used both as pts and dts.
+     * @return false if the frame can't be used yet
+     */
+    bool remux_video_frame(const core::pCompressedVideoFrame& frame);
+
     bool                av_initialized_;
 
 	std::string         url_;
+	std::string         format_;
 	double              fps_;
 	int                 audio_bitrate_;
     int                 video_bitrate_;
     bool                audio_;
+    size_t              queue_size_;
 
     AVFormatContext*    fmt_ctx_;
     StreamDescription   video_st_;
@@ -75,6 +108,23 @@ private:
 
     std::shared_ptr<yuri::core::RawAudioFrame>  yuri_audio_frame_;
     std::shared_ptr<yuri::core::RawVideoFrame>  yuri_video_frame_;
+    // Compressed video is muxed as it is, without encoding
+    core::pCompressedVideoFrame                 yuri_compressed_frame_;
+    bool                                        copy_video_;
+    //! SPS/PPS (and VPS) for the muxer, from the first keyframe
+    std::vector<uint8_t>                        extradata_;
+    //! Parameter sets received in separate frames, prepended to the next picture
+    std::vector<uint8_t>                        pending_parameter_sets_;
+    timestamp_t                                 first_video_timestamp_;
+    int64_t                                     last_video_dts_;
+
+    bounded_queue<core::pRawVideoFrame>         video_queue_;
+    bounded_queue<core::pRawAudioFrame>         audio_queue_;
+    bounded_queue<packet_t>                     mux_queue_;
+    std::thread                                 video_thread_;
+    std::thread                                 audio_thread_;
+    std::thread                                 mux_thread_;
+    std::atomic<bool>                           failed_;
 
     size_t   last_video_width;
     size_t   last_video_height;
@@ -0,0 +1,94 @@
+/*!
+ * @file 		bounded_queue.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Blocking queue with limited capacity, connecting encoder and muxer threads.
+ */
+
+#ifndef MODULES_AVOUTPUT_BOUNDED_QUEUE_H_
+#define MODULES_AVOUTPUT_BOUNDED_QUEUE_H_
+
+#include "yuri/core/utils/time_types.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace yuri {
+namespace avoutput {
+
+template<class T>
+class bounded_queue {
+public:
+	enum class status_t {
+		ok,
+		timeout,
+		closed
+	};
+
+	explicit bounded_queue(size_t capacity = 1):capacity_(capacity),closed_(false) {}
+
+	/*!
+	 * Appends @em value, waiting up to @em timeout for free space.
+	 * The value is moved from only when status_t::ok is returned.
+	 */
+	status_t push(T& value, duration_t timeout)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (!cond_.wait_for(lock, std::chrono::microseconds(timeout.value),
+				[this]{ return closed_ || queue_.size() < capacity_; })) {
+			return status_t::timeout;
+		}
+		if (closed_) return status_t::closed;
+		queue_.push_back(std::move(value));
+		cond_.notify_all();
+		return status_t::ok;
+	}
+
+	/*!
+	 * Takes the oldest value, waiting until there's one.
+	 * @return false if the queue was closed and all values were taken
+	 */
+	bool pop(T& value)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		cond_.wait(lock, [this]{ return closed_ || !queue_.empty(); });
+		if (queue_.empty()) return false;
+		value = std::move(queue_.front());
+		queue_.pop_front();
+		cond_.notify_all();
+		return true;
+	}
+
+	//! Refuses further values. Values already queued can still be taken.
+	void close()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		closed_ = true;
+		cond_.notify_all();
+	}
+
+	//! Drops all values and opens the queue again
+	void reset(size_t capacity)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		queue_.clear();
+		capacity_ = capacity > 0 ? capacity : 1;
+		closed_ = false;
+	}
+
+private:
+	std::deque<T> queue_;
+	size_t capacity_;
+	bool closed_;
+	std::mutex mutex_;
+	std::condition_variable cond_;
+};
+
+}
+}
+
+#endif /* MODULES_AVOUTPUT_BOUNDED_QUEUE_H_ */
@@ -0,0 +1,86 @@
+/*!
+ * @file 		nal_units.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "nal_units.h"
+#include "yuri/core/frame/compressed_frame_types.h"
+
+namespace yuri {
+namespace avoutput {
+
+namespace {
+const uint8_t start_code[] = {0, 0, 0, 1};
+
+//! Returns position of next 3 byte start code, or @em end
+const uint8_t* find_start_code(const uint8_t* p, const uint8_t* end)
+{
+	for (; end - p >= 3; ++p) {
+		if (p[0] == 0 && p[1] == 0 && p[2] == 1) return p;
+	}
+	return end;
+}
+
+}
+
+void for_each_nal(const uint8_t* data, size_t size, const std::function<void(const uint8_t*, size_t)>& func)
+{
+	const auto end = data + size;
+	auto nal = find_start_code(data, end);
+	while (nal != end) {
+		nal += 3;
+		auto next = find_start_code(nal, end);
+		auto nal_end = next;
+		// Zero bytes before the next start code belong to it (4 byte start code or trailing zeros)
+		while (nal_end > nal && nal_end[-1] == 0) --nal_end;
+		if (nal_end > nal) func(nal, nal_end - nal);
+		nal = next;
+	}
+}
+
+bool avc1_to_annexb(const uint8_t* data, size_t size, std::vector<uint8_t>& out)
+{
+	out.assign(data, data + size);
+	size_t pos = 0;
+	while (size - pos >= 4) {
+		const size_t len = (static_cast<size_t>(data[pos]) << 24) | (data[pos + 1] << 16) | (data[pos + 2] << 8) | data[pos + 3];
+		if (len > size - pos - 4) return false;
+		std::copy(std::begin(start_code), std::end(start_code), out.begin() + pos);
+		pos += 4 + len;
+	}
+	return pos == size;
+}
+
+nal_summary_t summarize_nals(format_t format, const uint8_t* data, size_t size)
+{
+	nal_summary_t summary;
+	const bool hevc = format == core::compressed_frame::h265;
+	for_each_nal(data, size, [&](const uint8_t* nal, size_t nal_size) {
+		bool parameter_set = false;
+		if (hevc) {
+			const auto type = (nal[0] >> 1) & 0x3f;
+			// 0-31 are VCL units, 16-23 IRAP pictures, 32-34 VPS, SPS and PPS
+			if (type < 32) summary.picture = true;
+			if (type >= 16 && type <= 23) summary.keyframe = true;
+			parameter_set = type >= 32 && type <= 34;
+		} else {
+			const auto type = nal[0] & 0x1f;
+			// 1-5 are slices, 5 IDR slice, 7 SPS and 8 PPS
+			if (type >= 1 && type <= 5) summary.picture = true;
+			if (type == 5) summary.keyframe = true;
+			parameter_set = type == 7 || type == 8;
+		}
+		if (parameter_set) {
+			summary.parameter_sets.insert(summary.parameter_sets.end(), std::begin(start_code), std::end(start_code));
+			summary.parameter_sets.insert(summary.parameter_sets.end(), nal, nal + nal_size);
+		}
+	});
+	return summary;
+}
+
+}
+}
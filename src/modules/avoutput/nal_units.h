@@ -0,0 +1,49 @@
+/*!
+ * @file 		nal_units.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Helpers for inspecting H.264 and H.265 bit streams being remuxed.
+ */
+
+#ifndef MODULES_AVOUTPUT_NAL_UNITS_H_
+#define MODULES_AVOUTPUT_NAL_UNITS_H_
+
+#include "yuri/core/utils/new_types.h"
+#include <functional>
+#include <vector>
+
+namespace yuri {
+namespace avoutput {
+
+/*!
+ * Calls @em func for every NAL unit (without start code) in annex B bit stream.
+ */
+void for_each_nal(const uint8_t* data, size_t size, const std::function<void(const uint8_t*, size_t)>& func);
+
+/*!
+ * Converts AVC1 bit stream (4 byte length prefixes) to annex B by replacing the prefixes with start codes.
+ * @return false if the lengths don't match the size of the data
+ */
+bool avc1_to_annexb(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+struct nal_summary_t {
+	//! Stream contains a picture (not only parameter sets or SEI)
+	bool picture = false;
+	//! Stream contains IDR (H.264) or IRAP (H.265) picture
+	bool keyframe = false;
+	//! Parameter sets (SPS, PPS and VPS for H.265) in annex B, usable as extradata
+	std::vector<uint8_t> parameter_sets;
+};
+
+/*!
+ * Scans annex B bit stream of format @em format (core::compressed_frame::h264 or h265).
+ */
+nal_summary_t summarize_nals(format_t format, const uint8_t* data, size_t size);
+
+}
+}
+
+#endif /* MODULES_AVOUTPUT_NAL_UNITS_H_ */
@@ -0,0 +1,416 @@
+/*!
+ * @file 		BayerDemosaic.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "BayerDemosaic.h"
+#include "yuri/core/Module.h"
+#include "yuri/core/frame/raw_frame_types.h"
+#include "yuri/core/utils/irange.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <map>
+
+namespace yuri {
+namespace bayer {
+
+
+IOTHREAD_GENERATOR(BayerDemosaic)
+
+core::Parameters BayerDemosaic::configure()
+{
+	core::Parameters p = base_type::configure();
+	p.set_description("Interpolates full colour image from Bayer pattern. "
+			"Supports 8, 10, 12 and 16 bit patterns and RGB or YUV output.");
+	p["format"]["Output format"]="RGB24";
+	p["algorithm"]["Interpolation algorithm (bilinear, malvar)"]="malvar";
+	p["matrix"]["YUV matrix used for YUV output (bt601, bt709, bt2020)"]="bt709";
+	p["limited_range"]["Produce limited range YUV"]=true;
+	p["threads"]["Number of threads to process each frame"]=1;
+	return p;
+}
+
+namespace {
+
+using namespace core::raw_format;
+
+//! Layout of the pattern
+struct pattern_t {
+	//! First line contains red samples (the second one blue)
+	bool	red_first;
+	//! First line starts with green sample
+	bool	green_first;
+	int		bits;
+};
+
+const std::map<format_t, pattern_t> patterns = {
+		{bayer_rggb,	{true, false, 8}},
+		{bayer_bggr,	{false, false, 8}},
+		{bayer_grbg,	{true, true, 8}},
+		{bayer_gbrg,	{false, true, 8}},
+		{bayer_rggb10,	{true, false, 10}},
+		{bayer_bggr10,	{false, false, 10}},
+		{bayer_grbg10,	{true, true, 10}},
+		{bayer_gbrg10,	{false, true, 10}},
+		{bayer_rggb12,	{true, false, 12}},
+		{bayer_bggr12,	{false, false, 12}},
+		{bayer_grbg12,	{true, true, 12}},
+		{bayer_gbrg12,	{false, true, 12}},
+		{bayer_rggb16,	{true, false, 16}},
+		{bayer_bggr16,	{false, false, 16}},
+		{bayer_grbg16,	{true, true, 16}},
+		{bayer_gbrg16,	{false, true, 16}},
+};
+
+const std::map<std::string, algorithm_t> algorithm_strings = {
+		{"bilinear", algorithm_t::bilinear},
+		{"malvar", algorithm_t::malvar},
+};
+
+//! Kr and Kb coefficients of YUV matrices
+const std::map<std::string, std::pair<double, double>> matrices = {
+		{"bt601", {0.299, 0.114}},
+		{"bt709", {0.2126, 0.0722}},
+		{"bt2020", {0.2627, 0.0593}},
+};
+
+yuv_coefs_t make_yuv_coefs(double kr, double kb, bool limited_range)
+{
+	const double kg = 1.0 - kr - kb;
+	const double sy = limited_range ? 219.0 / 255.0 : 1.0;
+	const double sc = limited_range ? 224.0 / 255.0 : 1.0;
+	const double one = 1 << 14;
+	const auto fix = [one](double v) { return static_cast<int>(std::lround(v * one)); };
+	const double cu = sc * 0.5 / (1.0 - kb);
+	const double cv = sc * 0.5 / (1.0 - kr);
+	return {{fix(sy * kr), fix(sy * kg), fix(sy * kb)},
+			{fix(-cu * kr), fix(-cu * kg), fix(cu * (1.0 - kb))},
+			{fix(cv * (1.0 - kr)), fix(-cv * kg), fix(-cv * kb)},
+			limited_range ? 16 : 0};
+}
+
+//! Parameters for storing the interpolated components
+struct store_params_t {
+	//! Shift to reduce the samples to 8 bits
+	int				shift;
+	int				bits;
+	yuv_coefs_t		yuv;
+};
+
+template<typename T>
+using store_t = void (*)(const T* r, const T* g, const T* b, uint8_t* dst, size_t width, const store_params_t& p);
+
+template<typename T, size_t step, size_t ri, size_t gi, size_t bi, int ai>
+void store_rgb8(const T* r, const T* g, const T* b, uint8_t* dst, size_t width, const store_params_t& p)
+{
+	const int shift = p.shift;
+	for (size_t i = 0; i < width; ++i) {
+		dst[ri] = static_cast<uint8_t>(r[i] >> shift);
+		dst[gi] = static_cast<uint8_t>(g[i] >> shift);
+		dst[bi] = static_cast<uint8_t>(b[i] >> shift);
+		if (ai >= 0) dst[ai] = 255;
+		dst += step;
+	}
+}
+
+//! Expands the samples to full 16 bit range
+template<typename T, size_t step, size_t ri, size_t gi, size_t bi, int ai>
+void store_rgb16(const T* r, const T* g, const T* b, uint8_t* dst8, size_t width, const store_params_t& p)
+{
+	uint16_t* dst = reinterpret_cast<uint16_t*>(dst8);
+	const int up = 16 - p.bits;
+	const int down = p.bits - up;
+	const auto expand = [up, down](int v) { return static_cast<uint16_t>((v << up) | (v >> down)); };
+	for (size_t i = 0; i < width; ++i) {
+		dst[ri] = expand(r[i]);
+		dst[gi] = expand(g[i]);
+		dst[bi] = expand(b[i]);
+		if (ai >= 0) dst[ai] = 0xFFFF;
+		dst += step;
+	}
+}
+
+inline uint8_t clip8(int v)
+{
+	return static_cast<uint8_t>(std::min(std::max(v, 0), 255));
+}
+
+template<typename T>
+void store_yuv444(const T* r, const T* g, const T* b, uint8_t* dst, size_t width, const store_params_t& p)
+{
+	const auto& c = p.yuv;
+	const int shift = p.shift;
+	const int y_offset = (c.y_offset << 14) + (1 << 13);
+	const int uv_offset = (128 << 14) + (1 << 13);
+	for (size_t i = 0; i < width; ++i) {
+		const int rv = r[i] >> shift;
+		const int gv = g[i] >> shift;
+		const int bv = b[i] >> shift;
+		*dst++ = clip8((c.y[0] * rv + c.y[1] * gv + c.y[2] * bv + y_offset) >> 14);
+		*dst++ = clip8((c.u[0] * rv + c.u[1] * gv + c.u[2] * bv + uv_offset) >> 14);
+		*dst++ = clip8((c.v[0] * rv + c.v[1] * gv + c.v[2] * bv + uv_offset) >> 14);
+	}
+}
+
+//! Chroma is computed from average of both pixels
+template<typename T, size_t yi0, size_t ui, size_t yi1, size_t vi>
+void store_yuv422(const T* r, const T* g, const T* b, uint8_t* dst, size_t width, const store_params_t& p)
+{
+	const auto& c = p.yuv;
+	const int shift = p.shift;
+	const int y_offset = (c.y_offset << 14) + (1 << 13);
+	const int uv_offset = (128 << 15) + (1 << 14);
+	for (size_t i = 0; i + 1 < width; i += 2) {
+		const int r0 = r[i] >> shift, r1 = r[i + 1] >> shift;
+		const int g0 = g[i] >> shift, g1 = g[i + 1] >> shift;
+		const int b0 = b[i] >> shift, b1 = b[i + 1] >> shift;
+		dst[yi0] = clip8((c.y[0] * r0 + c.y[1] * g0 + c.y[2] * b0 + y_offset) >> 14);
+		dst[yi1] = clip8((c.y[0] * r1 + c.y[1] * g1 + c.y[2] * b1 + y_offset) >> 14);
+		dst[ui] = clip8((c.u[0] * (r0 + r1) + c.u[1] * (g0 + g1) + c.u[2] * (b0 + b1) + uv_offset) >> 15);
+		dst[vi] = clip8((c.v[0] * (r0 + r1) + c.v[1] * (g0 + g1) + c.v[2] * (b0 + b1) + uv_offset) >> 15);
+		dst += 4;
+	}
+	if (width % 2) {
+		// The last pixel of an odd line has room only for its luma and U
+		const int rv = r[width - 1] >> shift;
+		const int gv = g[width - 1] >> shift;
+		const int bv = b[width - 1] >> shift;
+		dst[yi0] = clip8((c.y[0] * rv + c.y[1] * gv + c.y[2] * bv + y_offset) >> 14);
+		dst[ui] = clip8((c.u[0] * 2 * rv + c.u[1] * 2 * gv + c.u[2] * 2 * bv + uv_offset) >> 15);
+	}
+}
+
+template<typename T>
+store_t<T> get_store(format_t format)
+{
+	switch (format) {
+		case rgb24: return &store_rgb8<T, 3, 0, 1, 2, -1>;
+		case bgr24: return &store_rgb8<T, 3, 2, 1, 0, -1>;
+		case rgba32: return &store_rgb8<T, 4, 0, 1, 2, 3>;
+		case bgra32: return &store_rgb8<T, 4, 2, 1, 0, 3>;
+		case yuv444: return &store_yuv444<T>;
+		case yuyv422: return &store_yuv422<T, 0, 1, 2, 3>;
+		case uyvy422: return &store_yuv422<T, 1, 0, 3, 2>;
+		case rgb48: return &store_rgb16<T, 3, 0, 1, 2, -1>;
+		case bgr48: return &store_rgb16<T, 3, 2, 1, 0, -1>;
+		case rgba64: return &store_rgb16<T, 4, 0, 1, 2, 3>;
+		default: return nullptr;
+	}
+}
+
+template<typename T>
+using kernel_t = std::function<void(const bayer_lines_t<T>&, T*, T*, T*, size_t, bool)>;
+
+template<typename T>
+struct job_t {
+	const core::Plane&		in;
+	core::Plane&			out;
+	resolution_t			res;
+	pattern_t				pattern;
+	kernel_t<T>				kernel;
+	store_t<T>				store;
+	store_params_t			params;
+};
+
+/*
+ * Lines outside of the image are mirrored around the edge samples,
+ * which keeps the colour of every position.
+ */
+inline dimension_t mirror(ptrdiff_t pos, dimension_t size)
+{
+	if (pos < 0) return static_cast<dimension_t>(-pos);
+	if (pos >= static_cast<ptrdiff_t>(size)) return static_cast<dimension_t>(2 * (size - 1) - pos);
+	return static_cast<dimension_t>(pos);
+}
+
+template<typename T>
+void process_lines(const job_t<T>& job, dimension_t first, dimension_t last)
+{
+	const dimension_t width = job.res.width;
+	const dimension_t height = job.res.height;
+	const size_t in_line = job.in.get_line_size();
+	const size_t out_line = job.out.get_line_size();
+	const size_t padded = width + 4;
+
+	// Copies of the input lines with two mirrored samples on each side
+	std::vector<T> cache(padded * 5);
+	std::array<ptrdiff_t, 5> cached;
+	cached.fill(-1);
+	const auto fill = [&](size_t slot, dimension_t line) {
+		const T* src = reinterpret_cast<const T*>(job.in.data() + line * in_line);
+		T* dst = &cache[slot * padded] + 2;
+		std::copy(src, src + width, dst);
+		dst[-1] = src[1];
+		dst[-2] = src[2];
+		dst[width] = src[width - 2];
+		dst[width + 1] = src[width - 3];
+		cached[slot] = line;
+	};
+
+	std::vector<T> components(width * 3);
+	T* r = &components[0];
+	T* g = r + width;
+	T* b = g + width;
+
+	for (dimension_t y = first; y < last; ++y) {
+		std::array<dimension_t, 5> needed;
+		for (auto i: irange(5)) {
+			needed[i] = mirror(static_cast<ptrdiff_t>(y) + i - 2, height);
+		}
+		bayer_lines_t<T> lines;
+		for (auto i: irange(5)) {
+			auto it = std::find(cached.begin(), cached.end(), needed[i]);
+			if (it == cached.end()) {
+				it = std::find_if(cached.begin(), cached.end(), [&needed](ptrdiff_t line) {
+					return std::find(needed.begin(), needed.end(), line) == needed.end();
+				});
+				fill(it - cached.begin(), needed[i]);
+			}
+			lines.line[i] = &cache[(it - cached.begin()) * padded] + 2;
+		}
+		const bool even = (y & 1) == 0;
+		const bool red_line = even == job.pattern.red_first;
+		const bool green_first = even == job.pattern.green_first;
+		if (red_line) {
+			job.kernel(lines, r, g, b, width, green_first);
+		} else {
+			job.kernel(lines, b, g, r, width, green_first);
+		}
+		job.store(r, g, b, job.out.data() + y * out_line, width, job.params);
+	}
+}
+
+template<typename T>
+void run_job(const job_t<T>& job, size_t threads)
+{
+	const dimension_t height = job.res.height;
+	if (threads < 2 || height < threads) {
+		process_lines(job, 0, height);
+		return;
+	}
+	const dimension_t task_lines = height / threads;
+	std::vector<std::future<void>> results(threads);
+	dimension_t start = 0;
+	for (auto i: irange(threads)) {
+		const dimension_t end = (i == threads - 1) ? height : start + task_lines;
+		results[i] = std::async(std::launch::async, &process_lines<T>, std::cref(job), start, end);
+		start = end;
+	}
+	for (auto& r: results) r.get();
+}
+
+}
+
+
+BayerDemosaic::BayerDemosaic(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
+base_type(log_,parent,std::string("bayer_demosaic")),
+format_(rgb24),algorithm_(algorithm_t::malvar),matrix_("bt709"),limited_range_(true),threads_(1),
+kernels_(select_demosaic_kernels())
+{
+	IOTHREAD_INIT(parameters)
+	if (!threads_) threads_ = 1;
+	auto it = matrices.find(matrix_);
+	if (it == matrices.end()) {
+		log[log::warning] << "Unknown matrix " << matrix_ << ", using bt709";
+		it = matrices.find("bt709");
+	}
+	yuv_coefs_ = make_yuv_coefs(it->second.first, it->second.second, limited_range_);
+	log[log::debug] << "Using " << kernels_.name << " implementation";
+}
+
+BayerDemosaic::~BayerDemosaic() noexcept
+{
+}
+
+core::pRawVideoFrame BayerDemosaic::demosaic(const core::pRawVideoFrame& frame, format_t target_format)
+{
+	const auto it = patterns.find(frame->get_format());
+	if (it == patterns.end()) {
+		log[log::warning] << "Unsupported input format " << get_format_name(frame->get_format());
+		return {};
+	}
+	const auto& pattern = it->second;
+	const auto res = frame->get_resolution();
+	if (res.width < 3 || res.height < 3) {
+		log[log::warning] << "Frame too small";
+		return {};
+	}
+	const auto& in = (*frame)[0];
+	if (in.get_line_size() * res.height > in.size()) {
+		log[log::warning] << "Frame too small for its resolution, ignoring";
+		return {};
+	}
+
+	const bool deep = pattern.bits > 8;
+	if (!get_store<uint8_t>(target_format)) {
+		log[log::warning] << "Unsupported output format " << get_format_name(target_format);
+		return {};
+	}
+	auto outframe = core::RawVideoFrame::create_empty(target_format, res, true);
+	outframe->copy_video_params(*frame);
+	outframe->set_format(target_format);
+	const store_params_t params {std::max(pattern.bits - 8, 0), pattern.bits, yuv_coefs_};
+
+	if (!deep) {
+		const kernel_t<uint8_t> kernel = algorithm_ == algorithm_t::bilinear ? kernels_.bilinear8 : kernels_.malvar8;
+		run_job(job_t<uint8_t>{in, (*outframe)[0], res, pattern, kernel, get_store<uint8_t>(target_format), params}, threads_);
+	} else {
+		kernel_t<uint16_t> kernel = kernels_.bilinear16;
+		if (algorithm_ == algorithm_t::malvar) {
+			// SIMD versions of malvar16 handle only up to 10 bits
+			const auto malvar = pattern.bits > 10 ? get_scalar_demosaic_kernels().malvar16 : kernels_.malvar16;
+			const int max_value = (1 << pattern.bits) - 1;
+			kernel = [malvar, max_value](const bayer_lines_t<uint16_t>& l, uint16_t* x, uint16_t* g, uint16_t* y, size_t count, bool green_first) {
+				malvar(l, x, g, y, count, green_first, max_value);
+			};
+		}
+		run_job(job_t<uint16_t>{in, (*outframe)[0], res, pattern, kernel, get_store<uint16_t>(target_format), params}, threads_);
+	}
+	return outframe;
+}
+
+core::pFrame BayerDemosaic::do_special_single_step(core::pRawVideoFrame frame)
+{
+	return demosaic(frame, format_);
+}
+
+core::pFrame BayerDemosaic::do_convert_frame(core::pFrame input_frame, format_t target_format)
+{
+	core::pRawVideoFrame frame = std::dynamic_pointer_cast<core::RawVideoFrame>(input_frame);
+	if (!frame) {
+		log[log::warning] << "Got bad frame type!!";
+		return {};
+	}
+	return demosaic(frame, target_format);
+}
+
+bool BayerDemosaic::set_param(const core::Parameter& param)
+{
+	if (assign_parameters(param)
+			.parsed<std::string>
+				(format_, "format", core::raw_format::parse_format)
+			.parsed<std::string>
+				(algorithm_, "algorithm", [this](const std::string& s){
+					auto it = algorithm_strings.find(s);
+					if (it == algorithm_strings.end()) {
+						log[log::warning] << "Unknown algorithm " << s << ", using malvar";
+						return algorithm_t::malvar;
+					}
+					return it->second;
+				})
+			(matrix_, "matrix")
+			(limited_range_, "limited_range")
+			(threads_, "threads"))
+		return true;
+	return base_type::set_param(param);
+}
+
+} /* namespace bayer */
+} /* namespace yuri */
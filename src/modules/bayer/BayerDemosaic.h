@@ -0,0 +1,61 @@
+/*!
+ * @file 		BayerDemosaic.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef BAYERDEMOSAIC_H_
+#define BAYERDEMOSAIC_H_
+
+#include "yuri/core/thread/SpecializedIOFilter.h"
+#include "yuri/core/thread/ConverterThread.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "demosaic.h"
+
+namespace yuri {
+namespace bayer {
+
+enum class algorithm_t {
+	bilinear,
+	malvar
+};
+
+//! Fixed point (14 bit) coefficients of RGB to YUV conversion
+struct yuv_coefs_t {
+	int y[3];
+	int u[3];
+	int v[3];
+	int y_offset;
+};
+
+class BayerDemosaic: public core::SpecializedIOFilter<core::RawVideoFrame>, public core::ConverterThread
+{
+	using base_type = core::SpecializedIOFilter<core::RawVideoFrame>;
+public:
+	IOTHREAD_GENERATOR_DECLARATION
+	static core::Parameters configure();
+	BayerDemosaic(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters);
+	virtual ~BayerDemosaic() noexcept;
+private:
+	virtual core::pFrame do_special_single_step(core::pRawVideoFrame frame) override;
+	virtual core::pFrame do_convert_frame(core::pFrame input_frame, format_t target_format) override;
+	virtual bool set_param(const core::Parameter& param) override;
+
+	core::pRawVideoFrame demosaic(const core::pRawVideoFrame& frame, format_t target_format);
+
+	format_t				format_;
+	algorithm_t				algorithm_;
+	std::string				matrix_;
+	bool					limited_range_;
+	size_t					threads_;
+
+	demosaic_kernels_t		kernels_;
+	yuv_coefs_t				yuv_coefs_;
+};
+
+} /* namespace bayer */
+} /* namespace yuri */
+#endif /* BAYERDEMOSAIC_H_ */
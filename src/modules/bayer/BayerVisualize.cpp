@@ -16,10 +16,6 @@ namespace bayer {
 
 IOTHREAD_GENERATOR(BayerVisualize)
 
-MODULE_REGISTRATION_BEGIN("bayer")
-		REGISTER_IOTHREAD("bayer_visualize",BayerVisualize)
-MODULE_REGISTRATION_END()
-
 core::Parameters BayerVisualize::configure()
 {
 	core::Parameters p = base_type::configure();
@@ -0,0 +1,432 @@
+/*!
+ * @file 		demosaic.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "demosaic.h"
+#include "yuri/core/utils/cpu_features.h"
+#include <algorithm>
+#ifdef YURI_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef YURI_HAVE_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+namespace yuri {
+namespace bayer {
+
+namespace {
+
+inline int avg(int a, int b)
+{
+	return (a + b + 1) >> 1;
+}
+
+template<typename T>
+bayer_lines_t<T> advance(const bayer_lines_t<T>& l, size_t offset)
+{
+	return {{l.line[0] + offset, l.line[1] + offset, l.line[2] + offset, l.line[3] + offset, l.line[4] + offset}};
+}
+
+/*
+ * Green sample is known in green positions, the other colours
+ * are averaged from their nearest neighbours.
+ * X is the colour sharing line with the interpolated sample, Y the other one.
+ */
+template<typename T>
+void bilinear_scalar(const bayer_lines_t<T>& l, T* x, T* g, T* y, size_t count, bool green_first)
+{
+	const T* up = l.line[1];
+	const T* mid = l.line[2];
+	const T* down = l.line[3];
+	const size_t green = green_first ? 0 : 1;
+	for (size_t i = 0; i < count; ++i) {
+		const int c = mid[i];
+		const int vert = avg(up[i], down[i]);
+		const int horiz = avg(mid[i - 1], mid[i + 1]);
+		if ((i & 1) == green) {
+			x[i] = static_cast<T>(horiz);
+			g[i] = static_cast<T>(c);
+			y[i] = static_cast<T>(vert);
+		} else {
+			x[i] = static_cast<T>(c);
+			g[i] = static_cast<T>(avg(vert, horiz));
+			y[i] = static_cast<T>(avg(avg(up[i - 1], up[i + 1]), avg(down[i - 1], down[i + 1])));
+		}
+	}
+}
+
+/*
+ * Malvar, He, Cutler: High-quality linear interpolation for demosaicing
+ * of Bayer-patterned color images. Weights are multiplied by 16.
+ */
+template<typename T>
+void malvar_scalar(const bayer_lines_t<T>& l, T* x, T* g, T* y, size_t count, bool green_first, int max_value)
+{
+	const size_t green = green_first ? 0 : 1;
+	const auto clip = [max_value](int v) { return static_cast<T>(std::min(std::max((v + 8) >> 4, 0), max_value)); };
+	for (size_t i = 0; i < count; ++i) {
+		const int c = l.line[2][i];
+		const int vert2 = l.line[0][i] + l.line[4][i];
+		const int horiz2 = l.line[2][i - 2] + l.line[2][i + 2];
+		const int vert = l.line[1][i] + l.line[3][i];
+		const int horiz = l.line[2][i - 1] + l.line[2][i + 1];
+		const int diag = l.line[1][i - 1] + l.line[1][i + 1] + l.line[3][i - 1] + l.line[3][i + 1];
+		if ((i & 1) == green) {
+			x[i] = clip(10 * c + 8 * horiz - 2 * (horiz2 + diag) + vert2);
+			g[i] = static_cast<T>(c);
+			y[i] = clip(10 * c + 8 * vert - 2 * (vert2 + diag) + horiz2);
+		} else {
+			x[i] = static_cast<T>(c);
+			g[i] = clip(8 * c + 4 * (vert + horiz) - 2 * (vert2 + horiz2));
+			y[i] = clip(12 * c + 4 * diag - 3 * (vert2 + horiz2));
+		}
+	}
+}
+
+void malvar8_scalar(const bayer_lines_t<uint8_t>& l, uint8_t* x, uint8_t* g, uint8_t* y, size_t count, bool green_first)
+{
+	malvar_scalar(l, x, g, y, count, green_first, 255);
+}
+
+#ifdef YURI_HAVE_SSE2
+inline __m128i load_sse2(const uint8_t* p)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+inline __m128i load_sse2(const uint16_t* p)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+inline void store_sse2(uint8_t* p, __m128i v)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+inline void store_sse2(uint16_t* p, __m128i v)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+inline __m128i load8_sse2(const uint8_t* p)
+{
+	return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128());
+}
+inline __m128i load8_sse2(const uint16_t* p)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+inline void store8_sse2(uint8_t* p, __m128i v)
+{
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(v, v));
+}
+inline void store8_sse2(uint16_t* p, __m128i v)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+//! Returns @em a where @em mask is set, @em b elsewhere
+inline __m128i select_sse2(__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+inline __m128i avg_sse2(__m128i a, __m128i b, uint8_t)
+{
+	return _mm_avg_epu8(a, b);
+}
+inline __m128i avg_sse2(__m128i a, __m128i b, uint16_t)
+{
+	return _mm_avg_epu16(a, b);
+}
+//! Mask selecting green positions
+inline __m128i green_mask_sse2(bool green_first, uint8_t)
+{
+	return _mm_set1_epi16(green_first ? 0x00FF : static_cast<int16_t>(0xFF00));
+}
+inline __m128i green_mask_sse2(bool green_first, uint16_t)
+{
+	return _mm_set1_epi32(green_first ? 0x0000FFFF : static_cast<int32_t>(0xFFFF0000));
+}
+
+template<typename T>
+void bilinear_sse2(const bayer_lines_t<T>& l, T* x, T* g, T* y, size_t count, bool green_first)
+{
+	constexpr size_t step = 16 / sizeof(T);
+	const __m128i mask = green_mask_sse2(green_first, T{});
+	const T* up = l.line[1];
+	const T* mid = l.line[2];
+	const T* down = l.line[3];
+	size_t i = 0;
+	for (; i + step <= count; i += step) {
+		const __m128i c = load_sse2(mid + i);
+		const __m128i vert = avg_sse2(load_sse2(up + i), load_sse2(down + i), T{});
+		const __m128i horiz = avg_sse2(load_sse2(mid + i - 1), load_sse2(mid + i + 1), T{});
+		const __m128i diag = avg_sse2(avg_sse2(load_sse2(up + i - 1), load_sse2(up + i + 1), T{}),
+				avg_sse2(load_sse2(down + i - 1), load_sse2(down + i + 1), T{}), T{});
+		store_sse2(x + i, select_sse2(mask, horiz, c));
+		store_sse2(g + i, select_sse2(mask, c, avg_sse2(vert, horiz, T{})));
+		store_sse2(y + i, select_sse2(mask, vert, diag));
+	}
+	bilinear_scalar(advance(l, i), x + i, g + i, y + i, count - i, green_first);
+}
+
+void bilinear8_sse2(const bayer_lines_t<uint8_t>& l, uint8_t* x, uint8_t* g, uint8_t* y, size_t count, bool green_first)
+{
+	bilinear_sse2(l, x, g, y, count, green_first);
+}
+
+void bilinear16_sse2(const bayer_lines_t<uint16_t>& l, uint16_t* x, uint16_t* g, uint16_t* y, size_t count, bool green_first)
+{
+	bilinear_sse2(l, x, g, y, count, green_first);
+}
+
+inline __m128i clip_sse2(__m128i v, __m128i max_value)
+{
+	const __m128i r = _mm_srai_epi16(_mm_add_epi16(v, _mm_set1_epi16(8)), 4);
+	return _mm_min_epi16(_mm_max_epi16(r, _mm_setzero_si128()), max_value);
+}
+
+/*
+ * Processes 8 samples at a time in 16 bit lanes. Intermediate sums may wrap around,
+ * but the final values fit into 16 bits for inputs up to 10 bits.
+ */
+template<typename T>
+void malvar_sse2(const bayer_lines_t<T>& l, T* x, T* g, T* y, size_t count, bool green_first, int max_value)
+{
+	const __m128i mask = _mm_set1_epi32(green_first ? 0x0000FFFF : static_cast<int32_t>(0xFFFF0000));
+	const __m128i maxv = _mm_set1_epi16(static_cast<int16_t>(max_value));
+	const __m128i k10 = _mm_set1_epi16(10);
+	const __m128i k12 = _mm_set1_epi16(12);
+	const __m128i k3 = _mm_set1_epi16(3);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const T* l0 = l.line[0] + i;
+		const T* l1 = l.line[1] + i;
+		const T* l2 = l.line[2] + i;
+		const T* l3 = l.line[3] + i;
+		const T* l4 = l.line[4] + i;
+		const __m128i c = load8_sse2(l2);
+		const __m128i vert2 = _mm_add_epi16(load8_sse2(l0), load8_sse2(l4));
+		const __m128i horiz2 = _mm_add_epi16(load8_sse2(l2 - 2), load8_sse2(l2 + 2));
+		const __m128i vert = _mm_add_epi16(load8_sse2(l1), load8_sse2(l3));
+		const __m128i horiz = _mm_add_epi16(load8_sse2(l2 - 1), load8_sse2(l2 + 1));
+		const __m128i diag = _mm_add_epi16(_mm_add_epi16(load8_sse2(l1 - 1), load8_sse2(l1 + 1)),
+				_mm_add_epi16(load8_sse2(l3 - 1), load8_sse2(l3 + 1)));
+		const __m128i c10 = _mm_mullo_epi16(c, k10);
+		const __m128i both2 = _mm_add_epi16(vert2, horiz2);
+
+		const __m128i gx = _mm_add_epi16(_mm_sub_epi16(_mm_add_epi16(c10, _mm_slli_epi16(horiz, 3)),
+				_mm_slli_epi16(_mm_add_epi16(horiz2, diag), 1)), vert2);
+		const __m128i gy = _mm_add_epi16(_mm_sub_epi16(_mm_add_epi16(c10, _mm_slli_epi16(vert, 3)),
+				_mm_slli_epi16(_mm_add_epi16(vert2, diag), 1)), horiz2);
+		const __m128i ng = _mm_sub_epi16(_mm_add_epi16(_mm_slli_epi16(c, 3), _mm_slli_epi16(_mm_add_epi16(vert, horiz), 2)),
+				_mm_slli_epi16(both2, 1));
+		const __m128i ny = _mm_sub_epi16(_mm_add_epi16(_mm_mullo_epi16(c, k12), _mm_slli_epi16(diag, 2)),
+				_mm_mullo_epi16(both2, k3));
+
+		store8_sse2(x + i, select_sse2(mask, clip_sse2(gx, maxv), c));
+		store8_sse2(g + i, select_sse2(mask, c, clip_sse2(ng, maxv)));
+		store8_sse2(y + i, select_sse2(mask, clip_sse2(gy, maxv), clip_sse2(ny, maxv)));
+	}
+	malvar_scalar(advance(l, i), x + i, g + i, y + i, count - i, green_first, max_value);
+}
+
+void malvar8_sse2(const bayer_lines_t<uint8_t>& l, uint8_t* x, uint8_t* g, uint8_t* y, size_t count, bool green_first)
+{
+	malvar_sse2(l, x, g, y, count, green_first, 255);
+}
+
+void malvar16_sse2(const bayer_lines_t<uint16_t>& l, uint16_t* x, uint16_t* g, uint16_t* y, size_t count, bool green_first, int max_value)
+{
+	malvar_sse2(l, x, g, y, count, green_first, max_value);
+}
+#endif
+
+#ifdef YURI_HAVE_AVX2_TARGET
+YURI_TARGET_AVX2
+inline __m256i load_avx2(const uint8_t* p)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+YURI_TARGET_AVX2
+inline __m256i load_avx2(const uint16_t* p)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+YURI_TARGET_AVX2
+inline void store_avx2(uint8_t* p, __m256i v)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+YURI_TARGET_AVX2
+inline void store_avx2(uint16_t* p, __m256i v)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+YURI_TARGET_AVX2
+inline __m256i load16_avx2(const uint8_t* p)
+{
+	return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+YURI_TARGET_AVX2
+inline __m256i load16_avx2(const uint16_t* p)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+YURI_TARGET_AVX2
+inline void store16_avx2(uint8_t* p, __m256i v)
+{
+	const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0xD8);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(packed));
+}
+YURI_TARGET_AVX2
+inline void store16_avx2(uint16_t* p, __m256i v)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+YURI_TARGET_AVX2
+inline __m256i avg_avx2(__m256i a, __m256i b, uint8_t)
+{
+	return _mm256_avg_epu8(a, b);
+}
+YURI_TARGET_AVX2
+inline __m256i avg_avx2(__m256i a, __m256i b, uint16_t)
+{
+	return _mm256_avg_epu16(a, b);
+}
+YURI_TARGET_AVX2
+inline __m256i green_mask_avx2(bool green_first, uint8_t)
+{
+	return _mm256_set1_epi16(green_first ? 0x00FF : static_cast<int16_t>(0xFF00));
+}
+YURI_TARGET_AVX2
+inline __m256i green_mask_avx2(bool green_first, uint16_t)
+{
+	return _mm256_set1_epi32(green_first ? 0x0000FFFF : static_cast<int32_t>(0xFFFF0000));
+}
+
+template<typename T>
+YURI_TARGET_AVX2
+void bilinear_avx2(const bayer_lines_t<T>& l, T* x, T* g, T* y, size_t count, bool green_first)
+{
+	constexpr size_t step = 32 / sizeof(T);
+	const __m256i mask = green_mask_avx2(green_first, T{});
+	const T* up = l.line[1];
+	const T* mid = l.line[2];
+	const T* down = l.line[3];
+	size_t i = 0;
+	for (; i + step <= count; i += step) {
+		const __m256i c = load_avx2(mid + i);
+		const __m256i vert = avg_avx2(load_avx2(up + i), load_avx2(down + i), T{});
+		const __m256i horiz = avg_avx2(load_avx2(mid + i - 1), load_avx2(mid + i + 1), T{});
+		const __m256i diag = avg_avx2(avg_avx2(load_avx2(up + i - 1), load_avx2(up + i + 1), T{}),
+				avg_avx2(load_avx2(down + i - 1), load_avx2(down + i + 1), T{}), T{});
+		store_avx2(x + i, _mm256_blendv_epi8(c, horiz, mask));
+		store_avx2(g + i, _mm256_blendv_epi8(avg_avx2(vert, horiz, T{}), c, mask));
+		store_avx2(y + i, _mm256_blendv_epi8(diag, vert, mask));
+	}
+	bilinear_scalar(advance(l, i), x + i, g + i, y + i, count - i, green_first);
+}
+
+YURI_TARGET_AVX2
+void bilinear8_avx2(const bayer_lines_t<uint8_t>& l, uint8_t* x, uint8_t* g, uint8_t* y, size_t count, bool green_first)
+{
+	bilinear_avx2(l, x, g, y, count, green_first);
+}
+
+YURI_TARGET_AVX2
+void bilinear16_avx2(const bayer_lines_t<uint16_t>& l, uint16_t* x, uint16_t* g, uint16_t* y, size_t count, bool green_first)
+{
+	bilinear_avx2(l, x, g, y, count, green_first);
+}
+
+YURI_TARGET_AVX2
+inline __m256i clip_avx2(__m256i v, __m256i max_value)
+{
+	const __m256i r = _mm256_srai_epi16(_mm256_add_epi16(v, _mm256_set1_epi16(8)), 4);
+	return _mm256_min_epi16(_mm256_max_epi16(r, _mm256_setzero_si256()), max_value);
+}
+
+template<typename T>
+YURI_TARGET_AVX2
+void malvar_avx2(const bayer_lines_t<T>& l, T* x, T* g, T* y, size_t count, bool green_first, int max_value)
+{
+	const __m256i mask = _mm256_set1_epi32(green_first ? 0x0000FFFF : static_cast<int32_t>(0xFFFF0000));
+	const __m256i maxv = _mm256_set1_epi16(static_cast<int16_t>(max_value));
+	const __m256i k10 = _mm256_set1_epi16(10);
+	const __m256i k12 = _mm256_set1_epi16(12);
+	const __m256i k3 = _mm256_set1_epi16(3);
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const T* l0 = l.line[0] + i;
+		const T* l1 = l.line[1] + i;
+		const T* l2 = l.line[2] + i;
+		const T* l3 = l.line[3] + i;
+		const T* l4 = l.line[4] + i;
+		const __m256i c = load16_avx2(l2);
+		const __m256i vert2 = _mm256_add_epi16(load16_avx2(l0), load16_avx2(l4));
+		const __m256i horiz2 = _mm256_add_epi16(load16_avx2(l2 - 2), load16_avx2(l2 + 2));
+		const __m256i vert = _mm256_add_epi16(load16_avx2(l1), load16_avx2(l3));
+		const __m256i horiz = _mm256_add_epi16(load16_avx2(l2 - 1), load16_avx2(l2 + 1));
+		const __m256i diag = _mm256_add_epi16(_mm256_add_epi16(load16_avx2(l1 - 1), load16_avx2(l1 + 1)),
+				_mm256_add_epi16(load16_avx2(l3 - 1), load16_avx2(l3 + 1)));
+		const __m256i c10 = _mm256_mullo_epi16(c, k10);
+		const __m256i both2 = _mm256_add_epi16(vert2, horiz2);
+
+		const __m256i gx = _mm256_add_epi16(_mm256_sub_epi16(_mm256_add_epi16(c10, _mm256_slli_epi16(horiz, 3)),
+				_mm256_slli_epi16(_mm256_add_epi16(horiz2, diag), 1)), vert2);
+		const __m256i gy = _mm256_add_epi16(_mm256_sub_epi16(_mm256_add_epi16(c10, _mm256_slli_epi16(vert, 3)),
+				_mm256_slli_epi16(_mm256_add_epi16(vert2, diag), 1)), horiz2);
+		const __m256i ng = _mm256_sub_epi16(_mm256_add_epi16(_mm256_slli_epi16(c, 3), _mm256_slli_epi16(_mm256_add_epi16(vert, horiz), 2)),
+				_mm256_slli_epi16(both2, 1));
+		const __m256i ny = _mm256_sub_epi16(_mm256_add_epi16(_mm256_mullo_epi16(c, k12), _mm256_slli_epi16(diag, 2)),
+				_mm256_mullo_epi16(both2, k3));
+
+		store16_avx2(x + i, _mm256_blendv_epi8(c, clip_avx2(gx, maxv), mask));
+		store16_avx2(g + i, _mm256_blendv_epi8(clip_avx2(ng, maxv), c, mask));
+		store16_avx2(y + i, _mm256_blendv_epi8(clip_avx2(ny, maxv), clip_avx2(gy, maxv), mask));
+	}
+	malvar_scalar(advance(l, i), x + i, g + i, y + i, count - i, green_first, max_value);
+}
+
+YURI_TARGET_AVX2
+void malvar8_avx2(const bayer_lines_t<uint8_t>& l, uint8_t* x, uint8_t* g, uint8_t* y, size_t count, bool green_first)
+{
+	malvar_avx2(l, x, g, y, count, green_first, 255);
+}
+
+YURI_TARGET_AVX2
+void malvar16_avx2(const bayer_lines_t<uint16_t>& l, uint16_t* x, uint16_t* g, uint16_t* y, size_t count, bool green_first, int max_value)
+{
+	malvar_avx2(l, x, g, y, count, green_first, max_value);
+}
+#endif
+
+}
+
+demosaic_kernels_t get_scalar_demosaic_kernels()
+{
+	return {&bilinear_scalar<uint8_t>, &bilinear_scalar<uint16_t>,
+			&malvar8_scalar, &malvar_scalar<uint16_t>,
+			"scalar"};
+}
+
+demosaic_kernels_t select_demosaic_kernels()
+{
+#ifdef YURI_HAVE_AVX2_TARGET
+	if (core::utils::cpu_has_avx2()) {
+		return {&bilinear8_avx2, &bilinear16_avx2, &malvar8_avx2, &malvar16_avx2, "AVX2"};
+	}
+#endif
+#ifdef YURI_HAVE_SSE2
+	if (core::utils::cpu_has_sse2()) {
+		return {&bilinear8_sse2, &bilinear16_sse2, &malvar8_sse2, &malvar16_sse2, "SSE2"};
+	}
+#endif
+	return get_scalar_demosaic_kernels();
+}
+
+}
+}
@@ -0,0 +1,61 @@
+/*!
+ * @file 		demosaic.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Line kernels for Bayer demosaicing.
+ *
+ * Every kernel interpolates one line of the mosaic into three separate
+ * component lines. The line contains samples of one colour (X) interleaved
+ * with green samples, the other colour (Y) is on neighbouring lines.
+ * Scalar, SSE2 and AVX2 implementations produce identical results.
+ */
+
+#ifndef DEMOSAIC_H_
+#define DEMOSAIC_H_
+
+#include "yuri/core/utils/new_types.h"
+
+namespace yuri {
+namespace bayer {
+
+/*!
+ * Five consecutive lines of the mosaic, the interpolated one being in the middle.
+ * Every line has to be readable two samples before its beginning and
+ * two samples after its end.
+ */
+template<typename T>
+struct bayer_lines_t {
+	const T* line[5];
+};
+
+template<typename T>
+using demosaic_line_t = void (*)(const bayer_lines_t<T>& lines, T* x, T* g, T* y, size_t count, bool green_first);
+
+template<typename T>
+using demosaic_line_max_t = void (*)(const bayer_lines_t<T>& lines, T* x, T* g, T* y, size_t count, bool green_first, int max_value);
+
+struct demosaic_kernels_t {
+	//! Bilinear interpolation
+	demosaic_line_t<uint8_t> bilinear8;
+	demosaic_line_t<uint16_t> bilinear16;
+	//! Gradient corrected interpolation by Malvar, He and Cutler
+	demosaic_line_t<uint8_t> malvar8;
+	//! Expects at most 10 significant bits, use scalar version for more.
+	demosaic_line_max_t<uint16_t> malvar16;
+	const char* name;
+};
+
+/*!
+ * Returns the fastest kernels supported by current CPU.
+ */
+demosaic_kernels_t select_demosaic_kernels();
+
+demosaic_kernels_t get_scalar_demosaic_kernels();
+
+}
+}
+
+#endif /* DEMOSAIC_H_ */
@@ -0,0 +1,189 @@
+/*!
+ * @file 		register.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "BayerVisualize.h"
+#include "BayerDemosaic.h"
+#include "yuri/core/thread/IOThreadGenerator.h"
+#include "yuri/core/frame/raw_frame_types.h"
+#include "yuri/core/thread/ConverterRegister.h"
+
+namespace yuri {
+namespace bayer {
+using namespace yuri::core;
+MODULE_REGISTRATION_BEGIN("bayer")
+		REGISTER_IOTHREAD("bayer_visualize",BayerVisualize)
+		REGISTER_IOTHREAD("bayer_demosaic",BayerDemosaic)
+
+		REGISTER_CONVERTER(raw_format::bayer_rggb, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb, raw_format::uyvy422, "bayer_demosaic", 25)
+
+		REGISTER_CONVERTER(raw_format::bayer_bggr, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr, raw_format::uyvy422, "bayer_demosaic", 25)
+
+		REGISTER_CONVERTER(raw_format::bayer_grbg, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg, raw_format::uyvy422, "bayer_demosaic", 25)
+
+		REGISTER_CONVERTER(raw_format::bayer_gbrg, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg, raw_format::uyvy422, "bayer_demosaic", 25)
+
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb10, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr10, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg10, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg10, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb12, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr12, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg12, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg12, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_rggb16, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_bggr16, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_grbg16, raw_format::rgba64, "bayer_demosaic", 20)
+
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::rgb24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::bgr24, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::rgba32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::bgra32, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::yuv444, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::yuyv422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::uyvy422, "bayer_demosaic", 25)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::rgb48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::bgr48, "bayer_demosaic", 20)
+		REGISTER_CONVERTER(raw_format::bayer_gbrg16, raw_format::rgba64, "bayer_demosaic", 20)
+MODULE_REGISTRATION_END()
+
+}
+}
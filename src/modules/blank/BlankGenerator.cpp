@@ -44,7 +44,6 @@ BasicEventConsumer(log),
 fps_(25),resolution_{640,480},format_(core::raw_format::yuyv422),
 color_(core::color_t::create_rgb(0,0,0))
 {
-	set_latency(10_ms);
 	IOTHREAD_INIT(parameters)
 
 }
@@ -323,12 +322,11 @@ core::pRawVideoFrame BlankGenerator::generate_frame(format_t format, resolution_
 
 void BlankGenerator::run()
 {
-	next_time_ = timestamp_t{};
+	timer_.set_fps(fps_);
+	timer_.reset();
 	while(still_running()) {
 		process_events();
-		const auto curtime = timestamp_t{};
-		if (next_time_ > curtime) {
-			sleep(std::min(get_latency(), next_time_ - curtime));
+		if (!wait_until(timer_.next_deadline())) {
 			continue;
 		}
 
@@ -342,7 +340,7 @@ void BlankGenerator::run()
 		if (frame_cache_) {
 			push_frame(0, frame_cache_);
 		}
-		next_time_ = next_time_ + (1_s / fps_);
+		timer_.advance();
 	}
 }
 
@@ -371,6 +369,7 @@ bool BlankGenerator::do_process_event(const std::string& event_name, const event
 	}
 	if (assign_events(event_name, event)
 			(fps_, 			"fps")) {
+		timer_.set_fps(fps_);
 		return true;
 	}
 	return false;
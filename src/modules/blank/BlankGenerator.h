@@ -15,6 +15,7 @@
 #include "yuri/core/frame/RawVideoFrame.h"
 #include "yuri/event/BasicEventConsumer.h"
 #include "yuri/core/utils/color.h"
+#include "yuri/core/utils/Timer.h"
 namespace yuri {
 
 namespace blank {
@@ -30,7 +31,7 @@ private:
 	bool set_param(const core::Parameter &p) override;
 	core::pRawVideoFrame generate_frame(format_t format, resolution_t resolution, core::color_t color);
 	virtual bool do_process_event(const std::string& event_name, const event::pBasicEvent& event) override;
-	timestamp_t next_time_;
+	FPSTimer timer_;
 	float fps_;
 	resolution_t resolution_;
 	yuri::format_t format_;
@@ -0,0 +1,139 @@
+/*!
+ * @file 		ChangeGate.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "ChangeGate.h"
+#include "yuri/core/Module.h"
+#include "yuri/core/frame/CompressedVideoFrame.h"
+#include <algorithm>
+
+namespace yuri {
+namespace change_gate {
+
+
+IOTHREAD_GENERATOR(ChangeGate)
+
+MODULE_REGISTRATION_BEGIN("change_gate")
+		REGISTER_IOTHREAD("change_gate",ChangeGate)
+MODULE_REGISTRATION_END()
+
+core::Parameters ChangeGate::configure()
+{
+	core::Parameters p = core::IOFilter::configure();
+	p.set_description("Forwards only frames that differ from the previous forwarded frame. "
+			"Sends event 'change' with number of changed tiles for every forwarded changed frame.");
+	p["keep_alive"]["Forward a frame at least once per this interval (in seconds), even if it didn't change. Set to 0 to disable."]=1.0;
+	p["line_step"]["Hash only every n-th line of the image. Changes in skipped lines won't be detected."]=1;
+	p["tiles_x"]["Number of tiles in horizontal direction"]=1;
+	p["tiles_y"]["Number of tiles in vertical direction"]=1;
+	return p;
+}
+
+
+ChangeGate::ChangeGate(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
+core::IOFilter(log_,parent,std::string("change_gate")),
+event::BasicEventProducer(log),
+keep_alive_(1_s),line_step_(1),tiles_x_(1),tiles_y_(1),
+hash_update_(select_hash_update()),last_format_(0),last_resolution_{0, 0},dropped_(0)
+{
+	IOTHREAD_INIT(parameters)
+	if (!line_step_) line_step_ = 1;
+	if (!tiles_x_) tiles_x_ = 1;
+	if (!tiles_y_) tiles_y_ = 1;
+}
+
+ChangeGate::~ChangeGate() noexcept
+{
+}
+
+void ChangeGate::hash_raw_frame(const core::pRawVideoFrame& frame)
+{
+	states_.resize(tiles_x_ * tiles_y_);
+	for (auto& s: states_) hash_reset(s);
+
+	for (const auto& plane: *frame) {
+		const size_t line_size = plane.get_line_size();
+		if (!line_size) continue;
+		const size_t lines = plane.size() / line_size;
+		const uint8_t* data = plane.data();
+		for (size_t line = 0; line < lines; line += line_step_) {
+			const uint8_t* line_start = data + line * line_size;
+			auto state = states_.begin() + (line * tiles_y_ / lines) * tiles_x_;
+			for (size_t tile = 0; tile < tiles_x_; ++tile) {
+				const size_t start = line_size * tile / tiles_x_;
+				const size_t end = line_size * (tile + 1) / tiles_x_;
+				hash_update_(*state++, line_start + start, end - start);
+			}
+		}
+	}
+	hashes_.resize(states_.size());
+	std::transform(states_.begin(), states_.end(), hashes_.begin(), hash_finish);
+}
+
+void ChangeGate::hash_data(const uint8_t* data, size_t size)
+{
+	states_.resize(1);
+	hash_reset(states_[0]);
+	hash_update_(states_[0], data, size);
+	hashes_.assign(1, hash_finish(states_[0]));
+}
+
+core::pFrame ChangeGate::do_simple_single_step(core::pFrame frame)
+{
+	resolution_t resolution {0, 0};
+	if (auto raw = std::dynamic_pointer_cast<core::RawVideoFrame>(frame)) {
+		hash_raw_frame(raw);
+		resolution = raw->get_resolution();
+	} else if (auto compressed = std::dynamic_pointer_cast<core::CompressedVideoFrame>(frame)) {
+		hash_data(compressed->data(), compressed->size());
+		resolution = compressed->get_resolution();
+	} else {
+		// Not a video frame, nothing to compare
+		return frame;
+	}
+
+	size_t changed = hashes_.size();
+	if (frame->get_format() == last_format_ && resolution == last_resolution_ &&
+			hashes_.size() == last_hashes_.size()) {
+		changed = 0;
+		for (size_t i = 0; i < hashes_.size(); ++i) {
+			if (hashes_[i] != last_hashes_[i]) ++changed;
+		}
+	}
+
+	timestamp_t now;
+	if (changed) {
+		emit_event("change", changed);
+	} else if (!keep_alive_.value || (now - last_sent_) < keep_alive_) {
+		++dropped_;
+		return {};
+	}
+	if (dropped_) {
+		log[log::verbose_debug] << "Dropped " << dropped_ << " unchanged frames";
+		dropped_ = 0;
+	}
+	std::swap(hashes_, last_hashes_);
+	last_format_ = frame->get_format();
+	last_resolution_ = resolution;
+	last_sent_ = now;
+	return frame;
+}
+
+bool ChangeGate::set_param(const core::Parameter& param)
+{
+	if (assign_parameters(param)
+			(keep_alive_, "keep_alive", [](const core::Parameter& p){ return 1_s * p.get<double>(); })
+			(line_step_, "line_step")
+			(tiles_x_, "tiles_x")
+			(tiles_y_, "tiles_y"))
+		return true;
+	return core::IOFilter::set_param(param);
+}
+
+} /* namespace change_gate */
+} /* namespace yuri */
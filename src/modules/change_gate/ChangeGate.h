@@ -0,0 +1,53 @@
+/*!
+ * @file 		ChangeGate.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef CHANGEGATE_H_
+#define CHANGEGATE_H_
+
+#include "yuri/core/thread/IOFilter.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/event/BasicEventProducer.h"
+#include "frame_hash.h"
+
+namespace yuri {
+namespace change_gate {
+
+class ChangeGate: public core::IOFilter, public event::BasicEventProducer
+{
+public:
+	IOTHREAD_GENERATOR_DECLARATION
+	static core::Parameters configure();
+	ChangeGate(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters);
+	virtual ~ChangeGate() noexcept;
+private:
+	virtual core::pFrame do_simple_single_step(core::pFrame frame) override;
+	virtual bool set_param(const core::Parameter& param) override;
+
+	void hash_raw_frame(const core::pRawVideoFrame& frame);
+	void hash_data(const uint8_t* data, size_t size);
+
+	duration_t				keep_alive_;
+	dimension_t				line_step_;
+	dimension_t				tiles_x_;
+	dimension_t				tiles_y_;
+
+	hash_update_t			hash_update_;
+	std::vector<hash_state_t>
+							states_;
+	std::vector<uint64_t>	hashes_;
+	std::vector<uint64_t>	last_hashes_;
+	format_t				last_format_;
+	resolution_t			last_resolution_;
+	timestamp_t				last_sent_;
+	size_t					dropped_;
+};
+
+} /* namespace change_gate */
+} /* namespace yuri */
+#endif /* CHANGEGATE_H_ */
@@ -0,0 +1,149 @@
+/*!
+ * @file 		frame_hash.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "frame_hash.h"
+#include "yuri/core/utils/cpu_features.h"
+#include <cstring>
+#ifdef YURI_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef YURI_HAVE_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+namespace yuri {
+namespace change_gate {
+
+namespace {
+const uint64_t key0 = 0x9E3779B185EBCA87ULL;
+const uint64_t key1 = 0xC2B2AE3D27D4EB4FULL;
+
+inline uint64_t mix(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+inline void hash_block(uint64_t acc[2], const uint8_t* data, uint64_t block)
+{
+	uint64_t d[2];
+	std::memcpy(d, data, sizeof(d));
+	const uint64_t dk0 = d[0] ^ (key0 + block);
+	const uint64_t dk1 = d[1] ^ (key1 + block);
+	acc[0] += (dk0 & 0xFFFFFFFFULL) * (dk0 >> 32) + d[1];
+	acc[1] += (dk1 & 0xFFFFFFFFULL) * (dk1 >> 32) + d[0];
+}
+
+//! Processes the last incomplete block, padded with zeroes
+void hash_tail(hash_state_t& state, const uint8_t* data, size_t size)
+{
+	if (!size) return;
+	uint8_t tmp[16] = {};
+	std::memcpy(tmp, data, size);
+	hash_block(state.acc, tmp, state.block++);
+}
+
+#ifdef YURI_HAVE_SSE2
+void hash_update_sse2(hash_state_t& state, const uint8_t* data, size_t size)
+{
+	const size_t blocks = size / 16;
+	__m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.acc));
+	__m128i key = _mm_add_epi64(_mm_set_epi64x(key1, key0), _mm_set1_epi64x(state.block));
+	const __m128i one = _mm_set1_epi64x(1);
+	for (size_t i = 0; i < blocks; ++i) {
+		const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+		const __m128i dk = _mm_xor_si128(d, key);
+		const __m128i product = _mm_mul_epu32(dk, _mm_shuffle_epi32(dk, _MM_SHUFFLE(2, 3, 0, 1)));
+		const __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+		acc = _mm_add_epi64(acc, _mm_add_epi64(product, swapped));
+		key = _mm_add_epi64(key, one);
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state.acc), acc);
+	state.block += blocks;
+	state.length += size;
+	hash_tail(state, data + 16 * blocks, size % 16);
+}
+#endif
+
+#ifdef YURI_HAVE_AVX2_TARGET
+YURI_TARGET_AVX2
+void hash_update_avx2(hash_state_t& state, const uint8_t* data, size_t size)
+{
+	const size_t pairs = size / 32;
+	// Even blocks are accumulated in the lower half, odd ones in the upper half
+	__m256i acc = _mm256_setzero_si256();
+	__m256i key = _mm256_add_epi64(_mm256_set_epi64x(key1, key0, key1, key0),
+			_mm256_set_epi64x(state.block + 1, state.block + 1, state.block, state.block));
+	const __m256i two = _mm256_set1_epi64x(2);
+	for (size_t i = 0; i < pairs; ++i) {
+		const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32 * i));
+		const __m256i dk = _mm256_xor_si256(d, key);
+		const __m256i product = _mm256_mul_epu32(dk, _mm256_shuffle_epi32(dk, _MM_SHUFFLE(2, 3, 0, 1)));
+		const __m256i swapped = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+		acc = _mm256_add_epi64(acc, _mm256_add_epi64(product, swapped));
+		key = _mm256_add_epi64(key, two);
+	}
+	const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+	const __m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.acc));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state.acc), _mm_add_epi64(old, sum));
+	state.block += 2 * pairs;
+	// Remaining (at most 31) bytes are processed by SSE2 version
+	hash_update_sse2(state, data + 32 * pairs, size % 32);
+	state.length += size - size % 32;
+}
+#endif
+
+}
+
+void hash_reset(hash_state_t& state)
+{
+	state.acc[0] = 0;
+	state.acc[1] = 0;
+	state.block = 0;
+	state.length = 0;
+}
+
+uint64_t hash_finish(const hash_state_t& state)
+{
+	return mix(state.acc[0] ^ state.length) ^ mix(state.acc[1] + key0);
+}
+
+void hash_update_scalar(hash_state_t& state, const uint8_t* data, size_t size)
+{
+	const size_t blocks = size / 16;
+	for (size_t i = 0; i < blocks; ++i) {
+		hash_block(state.acc, data + 16 * i, state.block++);
+	}
+	state.length += size;
+	hash_tail(state, data + 16 * blocks, size % 16);
+}
+
+std::vector<hash_kernel_t> get_supported_hash_updates()
+{
+	std::vector<hash_kernel_t> kernels {{&hash_update_scalar, "scalar"}};
+#ifdef YURI_HAVE_SSE2
+	if (core::utils::cpu_has_sse2()) kernels.push_back({&hash_update_sse2, "sse2"});
+#endif
+#ifdef YURI_HAVE_AVX2_TARGET
+	if (core::utils::cpu_has_avx2()) kernels.push_back({&hash_update_avx2, "avx2"});
+#endif
+	return kernels;
+}
+
+hash_update_t select_hash_update()
+{
+	return get_supported_hash_updates().back().update;
+}
+
+}
+}
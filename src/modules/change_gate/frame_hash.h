@@ -0,0 +1,55 @@
+/*!
+ * @file 		frame_hash.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Fast non-cryptographic hash used to detect changes in frame data.
+ *
+ * Data are processed in 16 byte blocks, each block is mixed with a key
+ * depending on its position, so moved or swapped blocks change the hash.
+ * Scalar, SSE2 and AVX2 implementations produce identical results.
+ */
+
+#ifndef FRAME_HASH_H_
+#define FRAME_HASH_H_
+
+#include "yuri/core/utils/new_types.h"
+#include <vector>
+
+namespace yuri {
+namespace change_gate {
+
+struct hash_state_t {
+	uint64_t acc[2];
+	uint64_t block;
+	uint64_t length;
+};
+
+using hash_update_t = void (*)(hash_state_t&, const uint8_t*, size_t);
+
+void hash_reset(hash_state_t& state);
+uint64_t hash_finish(const hash_state_t& state);
+
+struct hash_kernel_t {
+	hash_update_t update;
+	const char* name;
+};
+
+/*!
+ * Returns all implementations of hash update supported by current CPU, from the slowest (scalar) one.
+ */
+std::vector<hash_kernel_t> get_supported_hash_updates();
+
+/*!
+ * Returns the fastest implementation of hash update supported by current CPU.
+ */
+hash_update_t select_hash_update();
+
+void hash_update_scalar(hash_state_t& state, const uint8_t* data, size_t size);
+
+}
+}
+
+#endif /* FRAME_HASH_H_ */
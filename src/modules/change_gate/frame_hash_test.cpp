@@ -0,0 +1,121 @@
+/*!
+ * @file 		frame_hash_test.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "tests/catch.hpp"
+#include "frame_hash.h"
+#include <random>
+#include <vector>
+
+namespace yuri {
+namespace change_gate {
+
+namespace {
+
+std::vector<uint8_t> random_plane(std::mt19937& gen, size_t size)
+{
+	std::uniform_int_distribution<unsigned> dist(0, 255);
+	std::vector<uint8_t> data(size);
+	for (auto& d: data) d = static_cast<uint8_t>(dist(gen));
+	return data;
+}
+
+/*!
+ * Hashes a plane split to tiles, feeding each tile line by line, as ChangeGate does.
+ */
+std::vector<uint64_t> hash_tiles(hash_update_t update, const std::vector<uint8_t>& plane,
+		size_t line_size, size_t tiles_x, size_t tiles_y)
+{
+	const size_t lines = plane.size() / line_size;
+	std::vector<hash_state_t> states(tiles_x * tiles_y);
+	for (auto& s: states) hash_reset(s);
+	for (size_t line = 0; line < lines; ++line) {
+		auto state = states.begin() + (line * tiles_y / lines) * tiles_x;
+		for (size_t tile = 0; tile < tiles_x; ++tile) {
+			const size_t start = line_size * tile / tiles_x;
+			const size_t end = line_size * (tile + 1) / tiles_x;
+			update(*state++, plane.data() + line * line_size + start, end - start);
+		}
+	}
+	std::vector<uint64_t> hashes;
+	for (const auto& s: states) hashes.push_back(hash_finish(s));
+	return hashes;
+}
+
+}
+
+TEST_CASE("frame hash kernels", "[change_gate]")
+{
+	const auto kernels = get_supported_hash_updates();
+	REQUIRE(kernels.size() > 0);
+	REQUIRE(select_hash_update() == kernels.back().update);
+	const auto& scalar = kernels.front();
+	std::mt19937 gen(27);
+
+	// Sizes around the 16 and 32 byte vector widths, and odd frame widths
+	std::vector<size_t> line_sizes;
+	for (size_t i = 1; i < 100; ++i) line_sizes.push_back(i);
+	for (size_t i: {127, 128, 129, 1000, 1917, 1920 * 2, 1922 * 3}) line_sizes.push_back(i);
+
+	for (const auto& k: kernels) {
+		INFO("kernel: " << k.name);
+		for (auto line_size: line_sizes) {
+			INFO("line size " << line_size);
+			const auto plane = random_plane(gen, line_size * 7);
+			// Whole plane at once
+			{
+				hash_state_t s0, s1;
+				hash_reset(s0);
+				hash_reset(s1);
+				scalar.update(s0, plane.data(), plane.size());
+				k.update(s1, plane.data(), plane.size());
+				REQUIRE(hash_finish(s0) == hash_finish(s1));
+			}
+			// Tiles updated line by line
+			for (size_t tiles_x: {1, 3, 4}) {
+				for (size_t tiles_y: {1, 2}) {
+					INFO(tiles_x << "x" << tiles_y << " tiles");
+					REQUIRE(hash_tiles(k.update, plane, line_size, tiles_x, tiles_y) ==
+							hash_tiles(scalar.update, plane, line_size, tiles_x, tiles_y));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("frame hash changes", "[change_gate]")
+{
+	const auto update = select_hash_update();
+	std::mt19937 gen(28);
+	auto plane = random_plane(gen, 1000);
+	auto hash = [&](const std::vector<uint8_t>& data) {
+		hash_state_t s;
+		hash_reset(s);
+		update(s, data.data(), data.size());
+		return hash_finish(s);
+	};
+	const auto original = hash(plane);
+	REQUIRE(hash(plane) == original);
+
+	auto changed = plane;
+	changed[999] ^= 1;
+	REQUIRE(hash(changed) != original);
+
+	// Swapped blocks
+	changed = plane;
+	std::swap_ranges(changed.begin(), changed.begin() + 16, changed.begin() + 32);
+	REQUIRE(hash(changed) != original);
+
+	// Trailing zeroes change the length
+	changed = plane;
+	changed.push_back(0);
+	REQUIRE(hash(changed) != original);
+}
+
+}
+}
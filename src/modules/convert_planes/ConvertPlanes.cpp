@@ -13,6 +13,7 @@
 #include "yuri/core/frame/raw_frame_params.h"
 #include "yuri/core/thread/ConverterRegister.h"
 #include "yuri/core/utils/irange.h"
+#include "yuri/core/utils/swizzle.h"
 #include <array>
 namespace yuri {
 namespace convert_planar {
@@ -24,30 +25,22 @@ core::pRawVideoFrame split_planes(const core::pRawVideoFrame& frame, const std::
 {
 	const resolution_t res = frame->get_resolution();
 	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(out, res);
-	typedef decltype(PLANE_DATA(frame_out,0).begin()) iter_t;
-	std::array<iter_t, planes> iters_start;
-	std::array<iter_t, planes> iters;
-	std::array<size_t, planes> lsizes;
-
 	const size_t linesize = PLANE_DATA(frame, 0).get_line_size();
-	iter_t iter_in_start = PLANE_DATA(frame, 0).begin();
+	const uint8_t* iter_in_start = PLANE_DATA(frame, 0).data();
+	std::array<uint8_t*, planes> iters_start;
+	std::array<size_t, planes> lsizes;
+	std::array<uint8_t*, planes> iters;
 
 	for (auto i: irange(planes)) {
-		iters_start[offsets[i]]=PLANE_DATA(frame_out, i).begin();
+		iters_start[offsets[i]] = PLANE_DATA(frame_out, i).data();
 		lsizes[offsets[i]] = PLANE_DATA(frame_out, i).get_line_size();
 	}
 
-
 	for (auto line: irange(res.height)) {
-		auto iter_in = iter_in_start  + line * linesize;
 		for (auto i: irange(planes)) {
-			iters[i]=iters_start[i] + line * lsizes[i];
-		}
-		for (size_t col = 0; col < res.width; ++col) {
-			for (size_t i = 0; i < planes; ++i) {
-				*iters[i]++=*iter_in++;
-			}
+			iters[i] = iters_start[i] + line * lsizes[i];
 		}
+		core::utils::deinterleave_planes(iter_in_start + line * linesize, iters.data(), planes, res.width);
 	}
 	return frame_out;
 }
@@ -57,66 +50,33 @@ core::pRawVideoFrame merge_planes(const core::pRawVideoFrame& frame, const std::
 {
 	const resolution_t res = frame->get_resolution();
 	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(out, res);
-	typedef decltype(PLANE_DATA(frame_out,0).begin()) iter_t;
-	std::array<iter_t, planes> iters_start;
-	std::array<iter_t, planes> iters;
-	std::array<size_t, planes> lsizes;
 	const size_t linesize = PLANE_DATA(frame_out, 0).get_line_size();
-	auto iter_out_start = PLANE_DATA(frame_out, 0).begin();
+	uint8_t* iter_out_start = PLANE_DATA(frame_out, 0).data();
+	std::array<const uint8_t*, planes> iters_start;
+	std::array<size_t, planes> lsizes;
+	std::array<const uint8_t*, planes> iters;
 	for (auto i: irange(planes)) {
-		iters_start[i]=PLANE_DATA(frame, offsets[i]).begin();
+		iters_start[i] = PLANE_DATA(frame, offsets[i]).data();
 		lsizes[i] = PLANE_DATA(frame, offsets[i]).get_line_size();
 	}
 	for (auto line: irange(res.height)) {
-		auto iter_out = iter_out_start  + line * linesize;
 		for (auto i: irange(planes)) {
-			iters[i]=iters_start[i] + line * lsizes[i];
-		}
-		for (auto col: irange(res.width)) {
-			(void)col;
-			for (auto i: irange(planes)) {
-				*iter_out++ = *iters[i]++;
-			}
+			iters[i] = iters_start[i] + line * lsizes[i];
 		}
+		core::utils::interleave_planes(iters.data(), iter_out_start + line * linesize, planes, res.width);
 	}
 	return frame_out;
 }
-template<format_t in>
-void store_yuv422(uint8_t*& it, uint8_t*& y, uint8_t*& u, uint8_t*& v);
-
-template<>
-void store_yuv422<core::raw_format::yuyv422>(uint8_t*& it, uint8_t*& y, uint8_t*& u, uint8_t*& v)
-{
-	*y++=*it++;
-	*u++=*it++;
-	*y++=*it++;
-	*v++=*it++;
-}
-
-template<>
-void store_yuv422<core::raw_format::uyvy422>(uint8_t*& it, uint8_t*& y, uint8_t*& u, uint8_t*& v)
-{
-	*u++=*it++;
-	*y++=*it++;
-	*v++=*it++;
-	*y++=*it++;
-}
-template<>
-void store_yuv422<core::raw_format::yvyu422>(uint8_t*& it, uint8_t*& y, uint8_t*& u, uint8_t*& v)
-{
-	*y++=*it++;
-	*v++=*it++;
-	*y++=*it++;
-	*u++=*it++;
-}
 
-template<>
-void store_yuv422<core::raw_format::vyuy422>(uint8_t*& it, uint8_t*& y, uint8_t*& u, uint8_t*& v)
+core::utils::yuv422_layout_t get_yuv422_layout(format_t fmt)
 {
-	*v++=*it++;
-	*y++=*it++;
-	*u++=*it++;
-	*y++=*it++;
+	using namespace yuri::core::raw_format;
+	switch (fmt) {
+		case uyvy422: return core::utils::uyvy_layout;
+		case yvyu422: return core::utils::yvyu_layout;
+		case vyuy422: return core::utils::vyuy_layout;
+		default: return core::utils::yuyv_layout;
+	}
 }
 
 template<format_t in, format_t out>
@@ -124,20 +84,22 @@ core::pRawVideoFrame split_planes_422p(core::pRawVideoFrame frame)
 {
 	const resolution_t res = frame->get_resolution();
 	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(out, res);
-	auto iter_in = PLANE_DATA(frame, 0).begin();
-	auto iter_out0 = PLANE_DATA(frame_out, 0).begin();
-	auto iter_out1 = PLANE_DATA(frame_out, 1).begin();
-	auto iter_out2 = PLANE_DATA(frame_out, 2).begin();
-	for (size_t line = 0; line < res.height; line+=1) {
-		for (size_t col = 0; col < res.width; col+=2) {
-			store_yuv422<in>(iter_in, iter_out0, iter_out1, iter_out2);
-		}
+	const auto layout = get_yuv422_layout(in);
+	const auto& plane_in = PLANE_DATA(frame, 0);
+	auto& plane_y = PLANE_DATA(frame_out, 0);
+	auto& plane_u = PLANE_DATA(frame_out, 1);
+	auto& plane_v = PLANE_DATA(frame_out, 2);
+	for (size_t line = 0; line < res.height; ++line) {
+		core::utils::split_yuv422(plane_in.data() + line * plane_in.get_line_size(),
+				plane_y.data() + line * plane_y.get_line_size(),
+				plane_u.data() + line * plane_u.get_line_size(),
+				plane_v.data() + line * plane_v.get_line_size(),
+				res.width / 2, layout);
 	}
 	return frame_out;
 }
 
 
-
 template<format_t format>
 void store_yuv420(uint8_t*& it0, uint8_t*& it1, uint8_t*& y0, uint8_t*& y1, uint8_t*& u, uint8_t*& v);
 
@@ -384,168 +346,78 @@ core::pRawVideoFrame merge_planes_sub3_xy(core::pRawVideoFrame frame) {
 //	return frame_out;
 //}
 template<format_t in, format_t out>
-core::pRawVideoFrame merge_planes_420p_yuyv(core::pRawVideoFrame frame) {
-
+core::pRawVideoFrame merge_planes_420p(core::pRawVideoFrame frame) {
 	const resolution_t res = frame->get_resolution();
 	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(out, res);
-	typedef decltype(PLANE_DATA(frame_out,0).begin()) iter_t;
-	iter_t iter_in0 = PLANE_DATA(frame, 0).begin();
-	iter_t iter_in1 = PLANE_DATA(frame, 1).begin();
-	iter_t iter_in2 = PLANE_DATA(frame, 2).begin();
-	iter_t iter_out = PLANE_DATA(frame_out, 0).begin();
-	for (size_t line = 0; line < res.height; line+=2) {
-		for (size_t line2 = line; line2 < std::min(res.height,line+2); ++line2) {
-			iter_t it1 = iter_in1;
-			iter_t it2 = iter_in2;
-			for (size_t col = 0; col < res.width; col+=2) {
-					*iter_out++ = *iter_in0++;
-					*iter_out++ = *it1++;
-					*iter_out++ = *iter_in0++;
-					*iter_out++ = *it2++;
-			}
-		}
-		iter_in1+=res.width/2;
-		iter_in2+=res.width/2;
+	const auto layout = get_yuv422_layout(out);
+	const auto& plane_y = PLANE_DATA(frame, 0);
+	const auto& plane_u = PLANE_DATA(frame, 1);
+	const auto& plane_v = PLANE_DATA(frame, 2);
+	auto& plane_out = PLANE_DATA(frame_out, 0);
+	for (size_t line = 0; line < res.height; ++line) {
+		core::utils::merge_yuv422(plane_y.data() + line * plane_y.get_line_size(),
+				plane_u.data() + (line / 2) * plane_u.get_line_size(),
+				plane_v.data() + (line / 2) * plane_v.get_line_size(),
+				plane_out.data() + line * plane_out.get_line_size(),
+				res.width / 2, layout);
 	}
-
 	return frame_out;
 }
-template<format_t in, format_t out>
-core::pRawVideoFrame merge_planes_420p_yvyu(core::pRawVideoFrame frame) {
 
+template<format_t in, format_t out>
+core::pRawVideoFrame merge_planes_422p(core::pRawVideoFrame frame) {
 	const resolution_t res = frame->get_resolution();
 	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(out, res);
-	typedef decltype(PLANE_DATA(frame_out,0).begin()) iter_t;
-	iter_t iter_in0 = PLANE_DATA(frame, 0).begin();
-	iter_t iter_in1 = PLANE_DATA(frame, 1).begin();
-	iter_t iter_in2 = PLANE_DATA(frame, 2).begin();
-	iter_t iter_out = PLANE_DATA(frame_out, 0).begin();
-	for (size_t line = 0; line < res.height; line+=2) {
-		for (size_t line2 = line; line2 < std::min(res.height,line+2); ++line2) {
-			iter_t it1 = iter_in1;
-			iter_t it2 = iter_in2;
-			for (size_t col = 0; col < res.width; col+=2) {
-					*iter_out++ = *iter_in0++;
-					*iter_out++ = *it2++;
-					*iter_out++ = *iter_in0++;
-					*iter_out++ = *it1++;
-			}
-		}
-		iter_in1+=res.width/2;
-		iter_in2+=res.width/2;
+	const auto layout = get_yuv422_layout(out);
+	const auto& plane_y = PLANE_DATA(frame, 0);
+	const auto& plane_u = PLANE_DATA(frame, 1);
+	const auto& plane_v = PLANE_DATA(frame, 2);
+	auto& plane_out = PLANE_DATA(frame_out, 0);
+	for (size_t line = 0; line < res.height; ++line) {
+		core::utils::merge_yuv422(plane_y.data() + line * plane_y.get_line_size(),
+				plane_u.data() + line * plane_u.get_line_size(),
+				plane_v.data() + line * plane_v.get_line_size(),
+				plane_out.data() + line * plane_out.get_line_size(),
+				res.width / 2, layout);
 	}
-
 	return frame_out;
 }
-template<format_t in, format_t out>
-core::pRawVideoFrame merge_planes_420p_uyvy(core::pRawVideoFrame frame) {
 
-	const resolution_t res = frame->get_resolution();
-	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(out, res);
-	typedef decltype(PLANE_DATA(frame_out,0).begin()) iter_t;
-	iter_t iter_in0 = PLANE_DATA(frame, 0).begin();
-	iter_t iter_in1 = PLANE_DATA(frame, 1).begin();
-	iter_t iter_in2 = PLANE_DATA(frame, 2).begin();
-	iter_t iter_out = PLANE_DATA(frame_out, 0).begin();
-	for (size_t line = 0; line < res.height; line+=2) {
-		for (size_t line2 = line; line2 < std::min(res.height,line+2); ++line2) {
-			iter_t it1 = iter_in1;
-			iter_t it2 = iter_in2;
-			for (size_t col = 0; col < res.width; col+=2) {
-				*iter_out++ = *it1++;
-				*iter_out++ = *iter_in0++;
-				*iter_out++ = *it2++;
-				*iter_out++ = *iter_in0++;
-			}
-		}
-		iter_in1+=res.width/2;
-		iter_in2+=res.width/2;
+void copy_plane(const core::Plane& plane_in, core::Plane& plane_out, size_t width, size_t height)
+{
+	for (size_t line = 0; line < height; ++line) {
+		std::copy(plane_in.data() + line * plane_in.get_line_size(),
+				plane_in.data() + line * plane_in.get_line_size() + width,
+				plane_out.data() + line * plane_out.get_line_size());
 	}
-
-	return frame_out;
 }
-template<format_t in, format_t out>
-core::pRawVideoFrame merge_planes_420p_vyuy(core::pRawVideoFrame frame) {
 
+core::pRawVideoFrame split_planes_nv12(core::pRawVideoFrame frame) {
 	const resolution_t res = frame->get_resolution();
-	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(out, res);
-	typedef decltype(PLANE_DATA(frame_out,0).begin()) iter_t;
-	iter_t iter_in0 = PLANE_DATA(frame, 0).begin();
-	iter_t iter_in1 = PLANE_DATA(frame, 1).begin();
-	iter_t iter_in2 = PLANE_DATA(frame, 2).begin();
-	iter_t iter_out = PLANE_DATA(frame_out, 0).begin();
-	for (size_t line = 0; line < res.height; line+=2) {
-		for (size_t line2 = line; line2 < std::min(res.height,line+2); ++line2) {
-			iter_t it1 = iter_in1;
-			iter_t it2 = iter_in2;
-			for (size_t col = 0; col < res.width; col+=2) {
-				*iter_out++ = *it2++;
-				*iter_out++ = *iter_in0++;
-				*iter_out++ = *it1++;
-				*iter_out++ = *iter_in0++;
-			}
-		}
-		iter_in1+=res.width/2;
-		iter_in2+=res.width/2;
+	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(core::raw_format::yuv420p, res);
+	copy_plane(PLANE_DATA(frame, 0), PLANE_DATA(frame_out, 0), res.width, res.height);
+	const auto& plane_uv = PLANE_DATA(frame, 1);
+	auto& plane_u = PLANE_DATA(frame_out, 1);
+	auto& plane_v = PLANE_DATA(frame_out, 2);
+	for (size_t line = 0; line < (res.height + 1) / 2; ++line) {
+		uint8_t* planes[] = {plane_u.data() + line * plane_u.get_line_size(),
+							 plane_v.data() + line * plane_v.get_line_size()};
+		core::utils::deinterleave_planes(plane_uv.data() + line * plane_uv.get_line_size(), planes, 2, (res.width + 1) / 2);
 	}
-
 	return frame_out;
 }
 
-template<format_t fmt>
-void store_yuv422_plane(uint8_t*& iter_y, uint8_t*& iter_u, uint8_t*& iter_v, uint8_t*& iter_yuv);
-
-template<>
-void store_yuv422_plane<core::raw_format::yuyv422>(uint8_t*& iter_y, uint8_t*& iter_u, uint8_t*& iter_v, uint8_t*& iter_yuv)
-{
-	*iter_yuv++ = *iter_y++;
-	*iter_yuv++ = *iter_u++;
-	*iter_yuv++ = *iter_y++;
-	*iter_yuv++ = *iter_v++;
-}
-
-template<>
-void store_yuv422_plane<core::raw_format::yvyu422>(uint8_t*& iter_y, uint8_t*& iter_u, uint8_t*& iter_v, uint8_t*& iter_yuv)
-{
-	*iter_yuv++ = *iter_y++;
-	*iter_yuv++ = *iter_v++;
-	*iter_yuv++ = *iter_y++;
-	*iter_yuv++ = *iter_u++;
-}
-
-template<>
-void store_yuv422_plane<core::raw_format::uyvy422>(uint8_t*& iter_y, uint8_t*& iter_u, uint8_t*& iter_v, uint8_t*& iter_yuv)
-{
-	*iter_yuv++ = *iter_u++;
-	*iter_yuv++ = *iter_y++;
-	*iter_yuv++ = *iter_v++;
-	*iter_yuv++ = *iter_y++;
-}
-
-template<>
-void store_yuv422_plane<core::raw_format::vyuy422>(uint8_t*& iter_y, uint8_t*& iter_u, uint8_t*& iter_v, uint8_t*& iter_yuv)
-{
-	*iter_yuv++ = *iter_v++;
-	*iter_yuv++ = *iter_y++;
-	*iter_yuv++ = *iter_u++;
-	*iter_yuv++ = *iter_y++;
-}
-
-
-template<format_t in, format_t out>
-core::pRawVideoFrame merge_planes_422p_yuyv(core::pRawVideoFrame frame) {
-
+core::pRawVideoFrame merge_planes_nv12(core::pRawVideoFrame frame) {
 	const resolution_t res = frame->get_resolution();
-	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(out, res);
-	typedef decltype(PLANE_DATA(frame_out,0).begin()) iter_t;
-	iter_t iter_in0 = PLANE_DATA(frame, 0).begin();
-	iter_t iter_in1 = PLANE_DATA(frame, 1).begin();
-	iter_t iter_in2 = PLANE_DATA(frame, 2).begin();
-	iter_t iter_out = PLANE_DATA(frame_out, 0).begin();
-	for (size_t line = 0; line < res.height; ++line) {
-			for (size_t col = 0; col < res.width; col+=2) {
-				store_yuv422_plane<out>(iter_in0, iter_in1, iter_in2, iter_out);
-			}
+	core::pRawVideoFrame frame_out = core::RawVideoFrame::create_empty(core::raw_format::nv12, res);
+	copy_plane(PLANE_DATA(frame, 0), PLANE_DATA(frame_out, 0), res.width, res.height);
+	const auto& plane_u = PLANE_DATA(frame, 1);
+	const auto& plane_v = PLANE_DATA(frame, 2);
+	auto& plane_uv = PLANE_DATA(frame_out, 1);
+	for (size_t line = 0; line < (res.height + 1) / 2; ++line) {
+		const uint8_t* planes[] = {plane_u.data() + line * plane_u.get_line_size(),
+								   plane_v.data() + line * plane_v.get_line_size()};
+		core::utils::interleave_planes(planes, plane_uv.data() + line * plane_uv.get_line_size(), 2, (res.width + 1) / 2);
 	}
 	return frame_out;
 }
@@ -621,15 +493,19 @@ core::pFrame dispatch(core::pRawVideoFrame frame, format_t target) {
 
 	//	if (source == yuv420p && target == yuv444) frame_out =  merge_planes_sub3_xy<yuv420p, yuv444>(frame);
 //	if (source == yuv411p && target == yuyv422) frame_out =  merge_planes_411p_422<yuv420p, yuyv422>(frame);
-	if (source == yuv420p && target == yuyv422) frame_out =  merge_planes_420p_yuyv<yuv420p, yuyv422>(frame);
-	if (source == yuv420p && target == yvyu422) frame_out =  merge_planes_420p_yvyu<yuv420p, yvyu422>(frame);
-	if (source == yuv420p && target == uyvy422) frame_out =  merge_planes_420p_uyvy<yuv420p, uyvy422>(frame);
-	if (source == yuv420p && target == vyuy422) frame_out =  merge_planes_420p_vyuy<yuv420p, vyuy422>(frame);
+	if (source == yuv420p && target == yuyv422) frame_out =  merge_planes_420p<yuv420p, yuyv422>(frame);
+	if (source == yuv420p && target == yvyu422) frame_out =  merge_planes_420p<yuv420p, yvyu422>(frame);
+	if (source == yuv420p && target == uyvy422) frame_out =  merge_planes_420p<yuv420p, uyvy422>(frame);
+	if (source == yuv420p && target == vyuy422) frame_out =  merge_planes_420p<yuv420p, vyuy422>(frame);
+
+	if (source == yuv422p && target == yuyv422) frame_out =  merge_planes_422p<yuv422p, yuyv422>(frame);
+	if (source == yuv422p && target == yvyu422) frame_out =  merge_planes_422p<yuv422p, yvyu422>(frame);
+	if (source == yuv422p && target == uyvy422) frame_out =  merge_planes_422p<yuv422p, uyvy422>(frame);
+	if (source == yuv422p && target == vyuy422) frame_out =  merge_planes_422p<yuv422p, vyuy422>(frame);
 
-	if (source == yuv422p && target == yuyv422) frame_out =  merge_planes_422p_yuyv<yuv422p, yuyv422>(frame);
-	if (source == yuv422p && target == yvyu422) frame_out =  merge_planes_422p_yuyv<yuv422p, yvyu422>(frame);
-	if (source == yuv422p && target == uyvy422) frame_out =  merge_planes_422p_yuyv<yuv422p, uyvy422>(frame);
-	if (source == yuv422p && target == vyuy422) frame_out =  merge_planes_422p_yuyv<yuv422p, vyuy422>(frame);
+	// NV12
+	if (source == nv12 && target == yuv420p) frame_out =  split_planes_nv12(frame);
+	if (source == yuv420p && target == nv12) frame_out =  merge_planes_nv12(frame);
 
 	if (frame_out) {
 		frame_out->copy_video_params(*frame);
@@ -712,6 +588,9 @@ MODULE_REGISTRATION_BEGIN("convert_planar")
 		REGISTER_CONVERTER(yuri::core::raw_format::yuv422p, yuri::core::raw_format::uyvy422, "convert_planar", 10)
 		REGISTER_CONVERTER(yuri::core::raw_format::yuv422p, yuri::core::raw_format::vyuy422, "convert_planar", 10)
 
+		REGISTER_CONVERTER(yuri::core::raw_format::nv12, yuri::core::raw_format::yuv420p, "convert_planar", 5)
+		REGISTER_CONVERTER(yuri::core::raw_format::yuv420p, yuri::core::raw_format::nv12, "convert_planar", 5)
+
 MODULE_REGISTRATION_END()
 
 core::Parameters ConvertPlanes::configure()
@@ -0,0 +1,394 @@
+/*!
+ * @file 		Deinterlace.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "Deinterlace.h"
+#include "yuri/core/Module.h"
+#include "yuri/core/frame/raw_frame_types.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+
+namespace yuri {
+namespace deinterlace {
+
+
+IOTHREAD_GENERATOR(Deinterlace)
+
+MODULE_REGISTRATION_BEGIN("deinterlace")
+		REGISTER_IOTHREAD("deinterlace",Deinterlace)
+MODULE_REGISTRATION_END()
+
+core::Parameters Deinterlace::configure()
+{
+	core::Parameters p = base_type::configure();
+	p.set_description("Deinterlaces video. Mode 'bob' interpolates lines of one field, "
+			"'blend' blends both fields together and 'yadif' uses motion adaptive interpolation (delays output by one frame).");
+	p["mode"]["Deinterlacing mode (bob, blend, yadif)"]="yadif";
+	p["field_order"]["Field order (auto, top, bottom). Auto uses field order from the frames and top field first if it's not specified."]="auto";
+	p["double_rate"]["Output a frame for every field (not supported in blend mode)"]=false;
+	p["only_interlaced"]["Pass frames not marked as interlaced without change"]=false;
+	return p;
+}
+
+namespace {
+
+using namespace core::raw_format;
+
+//! Size of a single sample for supported formats
+const std::map<format_t, size_t> sample_sizes = {
+		{yuyv422, 1},
+		{yvyu422, 1},
+		{uyvy422, 1},
+		{vyuy422, 1},
+		{y8, 1},
+		{yuv444p, 1},
+		{yuv422p, 1},
+		{yuv420p, 1},
+		{yuv422p10, 2},
+		{yuv420p10, 2},
+};
+
+const std::map<std::string, deinterlace_mode_t> mode_strings = {
+		{"bob", deinterlace_mode_t::bob},
+		{"blend", deinterlace_mode_t::blend},
+		{"yadif", deinterlace_mode_t::yadif},
+};
+
+const std::map<std::string, field_order_t> field_order_strings = {
+		{"auto", field_order_t::none},
+		{"top", field_order_t::top_field_first},
+		{"bottom", field_order_t::bottom_field_first},
+};
+
+template<typename T>
+const T* get_line(const core::Plane& plane, size_t line)
+{
+	return reinterpret_cast<const T*>(plane.data() + line * plane.get_line_size());
+}
+
+template<typename T>
+T* get_line(core::Plane& plane, size_t line)
+{
+	return reinterpret_cast<T*>(plane.data() + line * plane.get_line_size());
+}
+
+//! Number of lines and samples per line that can be processed in all planes
+struct plane_size_t {
+	size_t lines;
+	size_t count;
+};
+
+template<typename T>
+plane_size_t get_plane_size(std::initializer_list<const core::Plane*> planes)
+{
+	plane_size_t size {std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max()};
+	for (const auto plane: planes) {
+		const size_t line_size = plane->get_line_size();
+		if (!line_size) return {0, 0};
+		size.lines = std::min(size.lines, plane->size() / line_size);
+		size.count = std::min(size.count, line_size / sizeof(T));
+	}
+	return size;
+}
+
+template<typename T>
+void copy_line(T* dst, const T* src, size_t count)
+{
+	std::memcpy(dst, src, count * sizeof(T));
+}
+
+inline void run_bob(const kernels_t& k, uint8_t* dst, const uint8_t* up, const uint8_t* down, size_t count)
+{
+	k.bob8(dst, up, down, count);
+}
+inline void run_bob(const kernels_t& k, uint16_t* dst, const uint16_t* up, const uint16_t* down, size_t count)
+{
+	k.bob16(dst, up, down, count);
+}
+inline void run_blend(const kernels_t& k, uint8_t* dst, const uint8_t* up, const uint8_t* mid, const uint8_t* down, size_t count)
+{
+	k.blend8(dst, up, mid, down, count);
+}
+inline void run_blend(const kernels_t& k, uint16_t* dst, const uint16_t* up, const uint16_t* mid, const uint16_t* down, size_t count)
+{
+	k.blend16(dst, up, mid, down, count);
+}
+inline void run_yadif(const kernels_t& k, uint8_t* dst, const yadif_lines_t<uint8_t>& lines, size_t count)
+{
+	k.yadif8(dst, lines, count);
+}
+inline void run_yadif(const kernels_t& k, uint16_t* dst, const yadif_lines_t<uint16_t>& lines, size_t count)
+{
+	k.yadif16(dst, lines, count);
+}
+
+/*!
+ * Keeps lines with parity @em keep and interpolates the others from lines above and below.
+ */
+template<typename T>
+void bob_plane(const kernels_t& k, const core::Plane& in, core::Plane& out, size_t keep)
+{
+	const auto size = get_plane_size<T>({&in, &out});
+	for (size_t y = 0; y < size.lines; ++y) {
+		T* dst = get_line<T>(out, y);
+		if (size.lines < 2 || (y & 1) == keep) {
+			copy_line(dst, get_line<T>(in, y), size.count);
+			continue;
+		}
+		const size_t up = y ? y - 1 : y + 1;
+		const size_t down = y + 1 < size.lines ? y + 1 : y - 1;
+		run_bob(k, dst, get_line<T>(in, up), get_line<T>(in, down), size.count);
+	}
+}
+
+template<typename T>
+void blend_plane(const kernels_t& k, const core::Plane& in, core::Plane& out)
+{
+	const auto size = get_plane_size<T>({&in, &out});
+	for (size_t y = 0; y < size.lines; ++y) {
+		const size_t up = y ? y - 1 : y;
+		const size_t down = y + 1 < size.lines ? y + 1 : y;
+		run_blend(k, get_line<T>(out, y), get_line<T>(in, up), get_line<T>(in, y), get_line<T>(in, down), size.count);
+	}
+}
+
+/*!
+ * Keeps lines with parity @em keep from @em cur and interpolates the others.
+ * @param first_field true if the kept field is the one captured first in the frame
+ */
+template<typename T>
+void yadif_plane(const kernels_t& k, const core::Plane& prev, const core::Plane& cur, const core::Plane& next,
+		core::Plane& out, size_t keep, bool first_field)
+{
+	const auto size = get_plane_size<T>({&prev, &cur, &next, &out});
+	// Missing field was captured between the previous frame and current frame for the first field
+	// and between current and next frame for the second one.
+	const auto& prev2 = first_field ? prev : cur;
+	const auto& next2 = first_field ? cur : next;
+	for (size_t y = 0; y < size.lines; ++y) {
+		T* dst = get_line<T>(out, y);
+		if (size.lines < 2 || (y & 1) == keep) {
+			copy_line(dst, get_line<T>(cur, y), size.count);
+			continue;
+		}
+		const size_t up = y ? y - 1 : y + 1;
+		const size_t down = y + 1 < size.lines ? y + 1 : y - 1;
+		const size_t up2 = y >= 2 ? y - 2 : y;
+		const size_t down2 = y + 2 < size.lines ? y + 2 : y;
+		const yadif_lines_t<T> lines = {
+				get_line<T>(cur, up), get_line<T>(cur, down),
+				get_line<T>(prev, up), get_line<T>(prev, down),
+				get_line<T>(next, up), get_line<T>(next, down),
+				get_line<T>(prev2, y), get_line<T>(next2, y),
+				get_line<T>(prev2, up2), get_line<T>(prev2, down2),
+				get_line<T>(next2, up2), get_line<T>(next2, down2)};
+		run_yadif(k, dst, lines, size.count);
+	}
+}
+
+bool same_geometry(const core::RawVideoFrame& a, const core::RawVideoFrame& b)
+{
+	return a.get_format() == b.get_format() && a.get_resolution() == b.get_resolution();
+}
+
+}
+
+
+Deinterlace::Deinterlace(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
+base_type(log_,parent,std::string("deinterlace")),
+mode_(deinterlace_mode_t::yadif),field_order_(field_order_t::none),double_rate_(false),only_interlaced_(false),
+kernels_(select_kernels()),timestamp_valid_(false)
+{
+	IOTHREAD_INIT(parameters)
+	if (mode_ == deinterlace_mode_t::blend && double_rate_) {
+		log[log::warning] << "Double rate output is not supported in blend mode";
+		double_rate_ = false;
+	}
+	log[log::debug] << "Using " << kernels_.name << " implementation";
+	set_supported_formats(sample_sizes);
+}
+
+Deinterlace::~Deinterlace() noexcept
+{
+}
+
+bool Deinterlace::top_field_first(const core::RawVideoFrame& frame) const
+{
+	const auto order = field_order_ == field_order_t::none ? frame.get_field_order() : field_order_;
+	return order != field_order_t::bottom_field_first;
+}
+
+core::pRawVideoFrame Deinterlace::bob(const core::RawVideoFrame& frame, size_t keep) const
+{
+	auto out = core::RawVideoFrame::create_empty(frame.get_format(), frame.get_resolution(), true);
+	const bool wide = sample_sizes.at(frame.get_format()) > 1;
+	for (size_t i = 0; i < std::min(frame.get_planes_count(), out->get_planes_count()); ++i) {
+		if (wide) bob_plane<uint16_t>(kernels_, frame[i], (*out)[i], keep);
+		else bob_plane<uint8_t>(kernels_, frame[i], (*out)[i], keep);
+	}
+	return out;
+}
+
+core::pRawVideoFrame Deinterlace::blend(const core::RawVideoFrame& frame) const
+{
+	auto out = core::RawVideoFrame::create_empty(frame.get_format(), frame.get_resolution(), true);
+	const bool wide = sample_sizes.at(frame.get_format()) > 1;
+	for (size_t i = 0; i < std::min(frame.get_planes_count(), out->get_planes_count()); ++i) {
+		if (wide) blend_plane<uint16_t>(kernels_, frame[i], (*out)[i]);
+		else blend_plane<uint8_t>(kernels_, frame[i], (*out)[i]);
+	}
+	return out;
+}
+
+core::pRawVideoFrame Deinterlace::yadif(const core::RawVideoFrame& prev, const core::RawVideoFrame& cur,
+			const core::RawVideoFrame& next, size_t keep, bool first_field) const
+{
+	auto out = core::RawVideoFrame::create_empty(cur.get_format(), cur.get_resolution(), true);
+	const bool wide = sample_sizes.at(cur.get_format()) > 1;
+	const size_t planes = std::min({prev.get_planes_count(), cur.get_planes_count(), next.get_planes_count(), out->get_planes_count()});
+	for (size_t i = 0; i < planes; ++i) {
+		if (wide) yadif_plane<uint16_t>(kernels_, prev[i], cur[i], next[i], (*out)[i], keep, first_field);
+		else yadif_plane<uint8_t>(kernels_, prev[i], cur[i], next[i], (*out)[i], keep, first_field);
+	}
+	return out;
+}
+
+void Deinterlace::set_output_params(core::RawVideoFrame& out, const core::RawVideoFrame& frame, bool second_field, duration_t interval) const
+{
+	out.copy_video_params(frame);
+	out.set_interlacing(interlace_t::progressive);
+	out.set_field_order(field_order_t::none);
+	if (double_rate_) {
+		// Let push_frame() number the output frames
+		out.set_index(0);
+		out.set_duration(interval / 2);
+		if (second_field) out.set_timestamp(frame.get_timestamp() + interval / 2);
+	}
+}
+
+core::pFrame Deinterlace::do_special_single_step(core::pRawVideoFrame frame)
+{
+	if (only_interlaced_ && frame->get_interlacing() != interlace_t::interlaced) {
+		flush();
+		return frame;
+	}
+	if (!sample_sizes.count(frame->get_format())) {
+		log[log::warning] << "Unsupported format " << core::raw_format::get_format_name(frame->get_format());
+		return {};
+	}
+
+	if (mode_ == deinterlace_mode_t::blend) {
+		auto out = blend(*frame);
+		set_output_params(*out, *frame, false, 0_us);
+		return out;
+	}
+
+	if (mode_ == deinterlace_mode_t::bob) {
+		duration_t interval = frame->get_duration();
+		if (interval <= 0_us && timestamp_valid_) interval = frame->get_timestamp() - last_timestamp_;
+		last_timestamp_ = frame->get_timestamp();
+		timestamp_valid_ = true;
+
+		const size_t first = top_field_first(*frame) ? 0 : 1;
+		auto out = bob(*frame, first);
+		set_output_params(*out, *frame, false, interval);
+		if (!double_rate_) return out;
+		push_frame(0, std::move(out));
+		auto out2 = bob(*frame, 1 - first);
+		set_output_params(*out2, *frame, true, interval);
+		return out2;
+	}
+
+	// yadif needs the next frame, so the output is delayed by one frame
+	if (cur_ && !same_geometry(*cur_, *frame)) {
+		flush();
+	}
+	if (!cur_) {
+		prev_ = frame;
+		cur_ = std::move(frame);
+		return {};
+	}
+	duration_t interval = cur_->get_duration();
+	if (interval <= 0_us) interval = frame->get_timestamp() - cur_->get_timestamp();
+	push_yadif(*frame, interval);
+	prev_ = std::move(cur_);
+	cur_ = std::move(frame);
+	return {};
+}
+
+void Deinterlace::push_yadif(const core::RawVideoFrame& next, duration_t interval)
+{
+	const size_t first = top_field_first(*cur_) ? 0 : 1;
+	auto out = yadif(*prev_, *cur_, next, first, true);
+	set_output_params(*out, *cur_, false, interval);
+	push_frame(0, std::move(out));
+	if (double_rate_) {
+		auto out2 = yadif(*prev_, *cur_, next, 1 - first, false);
+		set_output_params(*out2, *cur_, true, interval);
+		push_frame(0, std::move(out2));
+	}
+}
+
+void Deinterlace::flush()
+{
+	if (cur_) {
+		duration_t interval = cur_->get_duration();
+		if (interval <= 0_us) interval = cur_->get_timestamp() - prev_->get_timestamp();
+		push_yadif(*cur_, interval);
+	}
+	prev_.reset();
+	cur_.reset();
+}
+
+bool Deinterlace::step()
+{
+	const bool ret = base_type::step();
+	// The last frame has no next frame, so it's output only after the input ends
+	if (cur_ && input_ && input_->is_finished()) {
+		flush();
+	}
+	return ret;
+}
+
+void Deinterlace::do_connect_in(position_t position, core::pPipe pipe)
+{
+	input_ = pipe;
+	base_type::do_connect_in(position, std::move(pipe));
+}
+
+bool Deinterlace::set_param(const core::Parameter& param)
+{
+	if (assign_parameters(param)
+			.parsed<std::string>
+				(mode_, "mode", [this](const std::string& s){
+					auto it = mode_strings.find(s);
+					if (it == mode_strings.end()) {
+						log[log::warning] << "Unknown mode " << s << ", using yadif";
+						return deinterlace_mode_t::yadif;
+					}
+					return it->second;
+				})
+			.parsed<std::string>
+				(field_order_, "field_order", [this](const std::string& s){
+					auto it = field_order_strings.find(s);
+					if (it == field_order_strings.end()) {
+						log[log::warning] << "Unknown field order " << s << ", using auto";
+						return field_order_t::none;
+					}
+					return it->second;
+				})
+			(double_rate_, "double_rate")
+			(only_interlaced_, "only_interlaced"))
+		return true;
+	return base_type::set_param(param);
+}
+
+} /* namespace deinterlace */
+} /* namespace yuri */
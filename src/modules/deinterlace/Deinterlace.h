@@ -0,0 +1,76 @@
+/*!
+ * @file 		Deinterlace.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef DEINTERLACE_H_
+#define DEINTERLACE_H_
+
+#include "yuri/core/thread/SpecializedIOFilter.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "deinterlace_kernels.h"
+
+namespace yuri {
+namespace deinterlace {
+
+enum class deinterlace_mode_t {
+	bob,
+	blend,
+	yadif
+};
+
+class Deinterlace: public core::SpecializedIOFilter<core::RawVideoFrame>
+{
+	using base_type = core::SpecializedIOFilter<core::RawVideoFrame>;
+public:
+	IOTHREAD_GENERATOR_DECLARATION
+	static core::Parameters configure();
+	Deinterlace(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters);
+	virtual ~Deinterlace() noexcept;
+private:
+	virtual core::pFrame do_special_single_step(core::pRawVideoFrame frame) override;
+	virtual bool step() override;
+	virtual void do_connect_in(position_t position, core::pPipe pipe) override;
+	virtual bool set_param(const core::Parameter& param) override;
+
+	//! Returns true if the top field of @em frame was captured first
+	bool top_field_first(const core::RawVideoFrame& frame) const;
+	/*!
+	 * Copies parameters of the input frame. In double rate mode sets timestamp
+	 * and duration of the field, @em interval being the duration of the input frame.
+	 */
+	void set_output_params(core::RawVideoFrame& out, const core::RawVideoFrame& frame, bool second_field, duration_t interval) const;
+
+	core::pRawVideoFrame bob(const core::RawVideoFrame& frame, size_t keep) const;
+	core::pRawVideoFrame blend(const core::RawVideoFrame& frame) const;
+	core::pRawVideoFrame yadif(const core::RawVideoFrame& prev, const core::RawVideoFrame& cur,
+			const core::RawVideoFrame& next, size_t keep, bool first_field) const;
+	//! Outputs deinterlaced cur_ in yadif mode
+	void push_yadif(const core::RawVideoFrame& next, duration_t interval);
+	//! Outputs the frame kept in yadif mode, using it also as the next frame, and forgets kept frames
+	void flush();
+
+	deinterlace_mode_t		mode_;
+	field_order_t			field_order_;
+	bool					double_rate_;
+	bool					only_interlaced_;
+
+	kernels_t				kernels_;
+
+	//! Frames kept for yadif mode
+	core::pRawVideoFrame	prev_;
+	core::pRawVideoFrame	cur_;
+	//! Input pipe, to find out when it ends
+	core::pPipe				input_;
+	//! Timestamp of the last frame in bob mode
+	timestamp_t				last_timestamp_;
+	bool					timestamp_valid_;
+};
+
+} /* namespace deinterlace */
+} /* namespace yuri */
+#endif /* DEINTERLACE_H_ */
@@ -0,0 +1,350 @@
+/*!
+ * @file 		deinterlace_kernels.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "deinterlace_kernels.h"
+#include "yuri/core/utils/cpu_features.h"
+#include <algorithm>
+#include <cstdlib>
+#ifdef YURI_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef YURI_HAVE_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+namespace yuri {
+namespace deinterlace {
+
+namespace {
+
+inline int avg(int a, int b)
+{
+	return (a + b + 1) >> 1;
+}
+
+template<typename T>
+void bob_scalar(T* dst, const T* up, const T* down, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = static_cast<T>(avg(up[i], down[i]));
+	}
+}
+
+template<typename T>
+void blend_scalar(T* dst, const T* up, const T* mid, const T* down, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = static_cast<T>(avg(avg(up[i], down[i]), mid[i]));
+	}
+}
+
+template<typename T>
+yadif_lines_t<T> advance(const yadif_lines_t<T>& l, size_t offset)
+{
+	return {l.cur_up + offset, l.cur_down + offset,
+		l.prev_up + offset, l.prev_down + offset,
+		l.next_up + offset, l.next_down + offset,
+		l.prev2 + offset, l.next2 + offset,
+		l.prev2_up2 + offset, l.prev2_down2 + offset,
+		l.next2_up2 + offset, l.next2_down2 + offset};
+}
+
+template<typename T>
+void yadif_scalar(T* dst, const yadif_lines_t<T>& l, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		const int c = l.cur_up[i];
+		const int e = l.cur_down[i];
+		const int d = (l.prev2[i] + l.next2[i]) >> 1;
+		const int diff0 = std::abs(l.prev2[i] - l.next2[i]) >> 1;
+		const int diff1 = (std::abs(l.prev_up[i] - c) + std::abs(l.prev_down[i] - e)) >> 1;
+		const int diff2 = (std::abs(l.next_up[i] - c) + std::abs(l.next_down[i] - e)) >> 1;
+		int diff = std::max(std::max(diff0, diff1), diff2);
+
+		// Don't trust the temporal prediction where the missing field differs
+		// from both its neighbours in the same direction
+		const int b = (l.prev2_up2[i] + l.next2_up2[i]) >> 1;
+		const int f = (l.prev2_down2[i] + l.next2_down2[i]) >> 1;
+		const int max_ = std::max(std::max(d - e, d - c), std::min(b - c, f - e));
+		const int min_ = std::min(std::min(d - e, d - c), std::max(b - c, f - e));
+		diff = std::max(std::max(diff, min_), -max_);
+
+		const int spatial = (c + e) >> 1;
+		dst[i] = static_cast<T>(std::max(std::min(spatial, d + diff), d - diff));
+	}
+}
+
+#ifdef YURI_HAVE_SSE2
+inline __m128i load8_sse2(const uint8_t* p)
+{
+	return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128());
+}
+inline __m128i load8_sse2(const uint16_t* p)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+inline void store8_sse2(uint8_t* p, __m128i v)
+{
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(v, v));
+}
+inline void store8_sse2(uint16_t* p, __m128i v)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+inline __m128i absdiff_sse2(__m128i a, __m128i b)
+{
+	return _mm_sub_epi16(_mm_max_epi16(a, b), _mm_min_epi16(a, b));
+}
+
+void bob8_sse2(uint8_t* dst, const uint8_t* up, const uint8_t* down, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_avg_epu8(a, b));
+	}
+	bob_scalar(dst + i, up + i, down + i, count - i);
+}
+
+void bob16_sse2(uint16_t* dst, const uint16_t* up, const uint16_t* down, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_avg_epu16(a, b));
+	}
+	bob_scalar(dst + i, up + i, down + i, count - i);
+}
+
+void blend8_sse2(uint8_t* dst, const uint8_t* up, const uint8_t* mid, const uint8_t* down, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mid + i));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_avg_epu8(_mm_avg_epu8(a, c), b));
+	}
+	blend_scalar(dst + i, up + i, mid + i, down + i, count - i);
+}
+
+void blend16_sse2(uint16_t* dst, const uint16_t* up, const uint16_t* mid, const uint16_t* down, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mid + i));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_avg_epu16(_mm_avg_epu16(a, c), b));
+	}
+	blend_scalar(dst + i, up + i, mid + i, down + i, count - i);
+}
+
+template<typename T>
+void yadif_sse2(T* dst, const yadif_lines_t<T>& l, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i c = load8_sse2(l.cur_up + i);
+		const __m128i e = load8_sse2(l.cur_down + i);
+		const __m128i p2 = load8_sse2(l.prev2 + i);
+		const __m128i n2 = load8_sse2(l.next2 + i);
+		const __m128i d = _mm_srai_epi16(_mm_add_epi16(p2, n2), 1);
+		const __m128i diff0 = _mm_srai_epi16(absdiff_sse2(p2, n2), 1);
+		const __m128i diff1 = _mm_srai_epi16(_mm_add_epi16(
+				absdiff_sse2(load8_sse2(l.prev_up + i), c),
+				absdiff_sse2(load8_sse2(l.prev_down + i), e)), 1);
+		const __m128i diff2 = _mm_srai_epi16(_mm_add_epi16(
+				absdiff_sse2(load8_sse2(l.next_up + i), c),
+				absdiff_sse2(load8_sse2(l.next_down + i), e)), 1);
+		__m128i diff = _mm_max_epi16(_mm_max_epi16(diff0, diff1), diff2);
+
+		const __m128i b = _mm_srai_epi16(_mm_add_epi16(load8_sse2(l.prev2_up2 + i), load8_sse2(l.next2_up2 + i)), 1);
+		const __m128i f = _mm_srai_epi16(_mm_add_epi16(load8_sse2(l.prev2_down2 + i), load8_sse2(l.next2_down2 + i)), 1);
+		const __m128i de = _mm_sub_epi16(d, e);
+		const __m128i dc = _mm_sub_epi16(d, c);
+		const __m128i bc = _mm_sub_epi16(b, c);
+		const __m128i fe = _mm_sub_epi16(f, e);
+		const __m128i max_ = _mm_max_epi16(_mm_max_epi16(de, dc), _mm_min_epi16(bc, fe));
+		const __m128i min_ = _mm_min_epi16(_mm_min_epi16(de, dc), _mm_max_epi16(bc, fe));
+		diff = _mm_max_epi16(_mm_max_epi16(diff, min_), _mm_sub_epi16(_mm_setzero_si128(), max_));
+
+		const __m128i spatial = _mm_srai_epi16(_mm_add_epi16(c, e), 1);
+		store8_sse2(dst + i, _mm_max_epi16(_mm_min_epi16(spatial, _mm_add_epi16(d, diff)), _mm_sub_epi16(d, diff)));
+	}
+	yadif_scalar(dst + i, advance(l, i), count - i);
+}
+
+void yadif8_sse2(uint8_t* dst, const yadif_lines_t<uint8_t>& lines, size_t count)
+{
+	yadif_sse2(dst, lines, count);
+}
+
+void yadif16_sse2(uint16_t* dst, const yadif_lines_t<uint16_t>& lines, size_t count)
+{
+	yadif_sse2(dst, lines, count);
+}
+#endif
+
+#ifdef YURI_HAVE_AVX2_TARGET
+YURI_TARGET_AVX2
+inline __m256i load16_avx2(const uint8_t* p)
+{
+	return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+YURI_TARGET_AVX2
+inline __m256i load16_avx2(const uint16_t* p)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+YURI_TARGET_AVX2
+inline void store16_avx2(uint8_t* p, __m256i v)
+{
+	const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0xD8);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(packed));
+}
+YURI_TARGET_AVX2
+inline void store16_avx2(uint16_t* p, __m256i v)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+YURI_TARGET_AVX2
+inline __m256i absdiff_avx2(__m256i a, __m256i b)
+{
+	return _mm256_sub_epi16(_mm256_max_epi16(a, b), _mm256_min_epi16(a, b));
+}
+
+YURI_TARGET_AVX2
+void bob8_avx2(uint8_t* dst, const uint8_t* up, const uint8_t* down, size_t count)
+{
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(down + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_avg_epu8(a, b));
+	}
+	bob_scalar(dst + i, up + i, down + i, count - i);
+}
+
+YURI_TARGET_AVX2
+void bob16_avx2(uint16_t* dst, const uint16_t* up, const uint16_t* down, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(down + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_avg_epu16(a, b));
+	}
+	bob_scalar(dst + i, up + i, down + i, count - i);
+}
+
+YURI_TARGET_AVX2
+void blend8_avx2(uint8_t* dst, const uint8_t* up, const uint8_t* mid, const uint8_t* down, size_t count)
+{
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mid + i));
+		const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(down + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_avg_epu8(_mm256_avg_epu8(a, c), b));
+	}
+	blend_scalar(dst + i, up + i, mid + i, down + i, count - i);
+}
+
+YURI_TARGET_AVX2
+void blend16_avx2(uint16_t* dst, const uint16_t* up, const uint16_t* mid, const uint16_t* down, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mid + i));
+		const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(down + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_avg_epu16(_mm256_avg_epu16(a, c), b));
+	}
+	blend_scalar(dst + i, up + i, mid + i, down + i, count - i);
+}
+
+template<typename T>
+YURI_TARGET_AVX2
+void yadif_avx2(T* dst, const yadif_lines_t<T>& l, size_t count)
+{
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m256i c = load16_avx2(l.cur_up + i);
+		const __m256i e = load16_avx2(l.cur_down + i);
+		const __m256i p2 = load16_avx2(l.prev2 + i);
+		const __m256i n2 = load16_avx2(l.next2 + i);
+		const __m256i d = _mm256_srai_epi16(_mm256_add_epi16(p2, n2), 1);
+		const __m256i diff0 = _mm256_srai_epi16(absdiff_avx2(p2, n2), 1);
+		const __m256i diff1 = _mm256_srai_epi16(_mm256_add_epi16(
+				absdiff_avx2(load16_avx2(l.prev_up + i), c),
+				absdiff_avx2(load16_avx2(l.prev_down + i), e)), 1);
+		const __m256i diff2 = _mm256_srai_epi16(_mm256_add_epi16(
+				absdiff_avx2(load16_avx2(l.next_up + i), c),
+				absdiff_avx2(load16_avx2(l.next_down + i), e)), 1);
+		__m256i diff = _mm256_max_epi16(_mm256_max_epi16(diff0, diff1), diff2);
+
+		const __m256i b = _mm256_srai_epi16(_mm256_add_epi16(load16_avx2(l.prev2_up2 + i), load16_avx2(l.next2_up2 + i)), 1);
+		const __m256i f = _mm256_srai_epi16(_mm256_add_epi16(load16_avx2(l.prev2_down2 + i), load16_avx2(l.next2_down2 + i)), 1);
+		const __m256i de = _mm256_sub_epi16(d, e);
+		const __m256i dc = _mm256_sub_epi16(d, c);
+		const __m256i bc = _mm256_sub_epi16(b, c);
+		const __m256i fe = _mm256_sub_epi16(f, e);
+		const __m256i max_ = _mm256_max_epi16(_mm256_max_epi16(de, dc), _mm256_min_epi16(bc, fe));
+		const __m256i min_ = _mm256_min_epi16(_mm256_min_epi16(de, dc), _mm256_max_epi16(bc, fe));
+		diff = _mm256_max_epi16(_mm256_max_epi16(diff, min_), _mm256_sub_epi16(_mm256_setzero_si256(), max_));
+
+		const __m256i spatial = _mm256_srai_epi16(_mm256_add_epi16(c, e), 1);
+		store16_avx2(dst + i, _mm256_max_epi16(_mm256_min_epi16(spatial, _mm256_add_epi16(d, diff)), _mm256_sub_epi16(d, diff)));
+	}
+	yadif_scalar(dst + i, advance(l, i), count - i);
+}
+
+YURI_TARGET_AVX2
+void yadif8_avx2(uint8_t* dst, const yadif_lines_t<uint8_t>& lines, size_t count)
+{
+	yadif_avx2(dst, lines, count);
+}
+
+YURI_TARGET_AVX2
+void yadif16_avx2(uint16_t* dst, const yadif_lines_t<uint16_t>& lines, size_t count)
+{
+	yadif_avx2(dst, lines, count);
+}
+#endif
+
+}
+
+kernels_t get_scalar_kernels()
+{
+	return {&bob_scalar<uint8_t>, &bob_scalar<uint16_t>,
+			&blend_scalar<uint8_t>, &blend_scalar<uint16_t>,
+			&yadif_scalar<uint8_t>, &yadif_scalar<uint16_t>,
+			"scalar"};
+}
+
+kernels_t select_kernels()
+{
+#ifdef YURI_HAVE_AVX2_TARGET
+	if (core::utils::cpu_has_avx2()) {
+		return {&bob8_avx2, &bob16_avx2, &blend8_avx2, &blend16_avx2, &yadif8_avx2, &yadif16_avx2, "AVX2"};
+	}
+#endif
+#ifdef YURI_HAVE_SSE2
+	if (core::utils::cpu_has_sse2()) {
+		return {&bob8_sse2, &bob16_sse2, &blend8_sse2, &blend16_sse2, &yadif8_sse2, &yadif16_sse2, "SSE2"};
+	}
+#endif
+	return get_scalar_kernels();
+}
+
+}
+}
@@ -0,0 +1,71 @@
+/*!
+ * @file 		deinterlace_kernels.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Line kernels for the deinterlacer.
+ *
+ * All kernels work on separate samples and use only vertical and temporal
+ * neighbours, so they can process packed formats as well as single planes.
+ * 16 bit variants expect at most 10 significant bits.
+ * Scalar, SSE2 and AVX2 implementations produce identical results.
+ */
+
+#ifndef DEINTERLACE_KERNELS_H_
+#define DEINTERLACE_KERNELS_H_
+
+#include "yuri/core/utils/new_types.h"
+
+namespace yuri {
+namespace deinterlace {
+
+/*!
+ * Lines used to interpolate a missing line in yadif mode.
+ * @em cur_up and @em cur_down are neighbouring lines of the current frame,
+ * @em prev_* and @em next_* are the same lines in previous and next frame.
+ * @em prev2 and @em next2 are frames containing the missing field just before
+ * and just after the output field, @em *_up2 and @em *_down2 being lines two lines
+ * above and below the interpolated one.
+ */
+template<typename T>
+struct yadif_lines_t {
+	const T* cur_up;
+	const T* cur_down;
+	const T* prev_up;
+	const T* prev_down;
+	const T* next_up;
+	const T* next_down;
+	const T* prev2;
+	const T* next2;
+	const T* prev2_up2;
+	const T* prev2_down2;
+	const T* next2_up2;
+	const T* next2_down2;
+};
+
+struct kernels_t {
+	//! dst = (up + down + 1) / 2
+	void (*bob8)(uint8_t* dst, const uint8_t* up, const uint8_t* down, size_t count);
+	void (*bob16)(uint16_t* dst, const uint16_t* up, const uint16_t* down, size_t count);
+	//! dst ~ (up + 2*mid + down) / 4
+	void (*blend8)(uint8_t* dst, const uint8_t* up, const uint8_t* mid, const uint8_t* down, size_t count);
+	void (*blend16)(uint16_t* dst, const uint16_t* up, const uint16_t* mid, const uint16_t* down, size_t count);
+	//! Spatial interpolation limited by temporal prediction
+	void (*yadif8)(uint8_t* dst, const yadif_lines_t<uint8_t>& lines, size_t count);
+	void (*yadif16)(uint16_t* dst, const yadif_lines_t<uint16_t>& lines, size_t count);
+	const char* name;
+};
+
+/*!
+ * Returns the fastest kernels supported by current CPU.
+ */
+kernels_t select_kernels();
+
+kernels_t get_scalar_kernels();
+
+}
+}
+
+#endif /* DEINTERLACE_KERNELS_H_ */
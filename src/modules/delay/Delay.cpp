@@ -9,6 +9,11 @@
 
 #include "Delay.h"
 #include "yuri/core/Module.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/frame/CompressedVideoFrame.h"
+#include "yuri/core/frame/RawAudioFrame.h"
+#include "yuri/core/utils/make_unique.h"
+#include <stdexcept>
 
 namespace yuri {
 namespace delay {
@@ -25,14 +30,28 @@ core::Parameters Delay::configure()
 	core::Parameters p = core::IOThread::configure();
 	p.set_description("Delay");
 	p["delay"]["Delay of frame in seconds"]=5.0;
+	p["storage"]["Directory for a temporary file storing the delayed frames. Frames are kept in memory when empty."]=std::string();
+	p["segment_size"]["Size of segments of the file mapped to memory (in MiB). Larger frames are kept in memory."]=64;
+	p["segments"]["Number of segments in the file"]=16;
+	p["readahead"]["Number of frames read from the file in advance"]=8;
 	return p;
 }
 
 
 Delay::Delay(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
-core::IOThread(log_,parent,1,1,std::string("delay"))
+core::IOThread(log_,parent,1,1,std::string("delay")),segment_size_(64),segments_(16),
+readahead_(8),ring_full_reported_(false)
 {
 	IOTHREAD_INIT(parameters)
+	if (!storage_.empty()) {
+		try {
+			ring_ = make_unique<disk_ring_t>(storage_, segment_size_ * 1024 * 1024, segments_);
+		}
+		catch (std::runtime_error& e) {
+			throw exception::InitializationFailed(e.what());
+		}
+		log[log::info] << "Storing frames in " << storage_ << ", capacity " << (ring_->capacity() >> 20) << " MiB";
+	}
 }
 
 Delay::~Delay() noexcept
@@ -43,37 +62,138 @@ void Delay::run()
 {
 	while (still_running()) {
 		while (auto frame = pop_frame(0)) {
-			frames_.push_back({frame,{}});
+			store(std::move(frame));
 		}
 
-		duration_t next_wait = get_latency();
-
-		if (!frames_.empty()) {
-			timestamp_t current_time;
-			bool step_finished = false;
-			while (!step_finished && !frames_.empty()) {
-				auto& newest =  frames_.front();
-				const auto delta = current_time - newest.timestamp;
-				if (delta >= delay_) {
-					push_frame(0,newest.frame);
-					frames_.pop_front();
-				} else {
-					step_finished = true;
-					const auto& wanna_wait = (delay_ - delta)/2.0;
-					if (wanna_wait < next_wait) next_wait = wanna_wait;
-				}
+		const timestamp_t current_time;
+		timestamp_t deadline = current_time + get_latency();
+		while (!frames_.empty()) {
+			auto& oldest = frames_.front();
+			const auto delta = current_time - oldest.timestamp;
+			if (delta < delay_) {
+				// Waits exactly until the oldest frame is due (or until a new frame arrives)
+				deadline = oldest.timestamp + delay_;
+				break;
+			}
+			push_frame(0, oldest.spilled ? restore(*oldest.spilled) : oldest.frame);
+			frames_.pop_front();
+			if (readahead_ && frames_.size() >= readahead_) {
+				// Each frame is prefetched once, when it gets close to the front
+				const auto& next = frames_[readahead_ - 1];
+				if (next.spilled) ring_->prefetch(next.spilled->block);
 			}
 		}
 		if (!pipes_data_available()) {
-			wait_for(next_wait);
+			wait_until(deadline);
+		}
+	}
+}
+
+void Delay::store(core::pFrame frame)
+{
+	if (ring_) {
+		if (auto spilled = spill(frame)) {
+			frames_.push_back({{}, {}, std::move(spilled)});
+			return;
 		}
 	}
+	frames_.push_back({std::move(frame), {}, {}});
+}
+
+std::unique_ptr<Delay::spilled_frame_t> Delay::spill(const core::pFrame& frame)
+{
+	using type_t = spilled_frame_t::type_t;
+	auto spilled = make_unique<spilled_frame_t>();
+	std::vector<const uint8_t*> data;
+	if (auto f = std::dynamic_pointer_cast<core::RawVideoFrame>(frame)) {
+		spilled->type = type_t::raw_video;
+		spilled->resolution = f->get_resolution();
+		for (const auto& plane: *f) {
+			spilled->planes.push_back({plane.size(), plane.get_line_size(), plane.get_resolution()});
+			data.push_back(plane.data());
+		}
+	} else if (auto f2 = std::dynamic_pointer_cast<core::CompressedVideoFrame>(frame)) {
+		spilled->type = type_t::compressed_video;
+		spilled->resolution = f2->get_resolution();
+		for (const auto& s: f2->get_segments()) {
+			spilled->planes.push_back({s.size, 0, {}});
+			data.push_back(s.data);
+		}
+	} else if (auto f3 = std::dynamic_pointer_cast<core::RawAudioFrame>(frame)) {
+		spilled->type = type_t::raw_audio;
+		spilled->channel_count = f3->get_channel_count();
+		spilled->sampling_frequency = f3->get_sampling_frequency();
+		spilled->planes.push_back({f3->size(), 0, {}});
+		data.push_back(f3->data());
+	} else {
+		// Other frames are small, so they stay in memory
+		return {};
+	}
+	size_t size = 0;
+	for (const auto& p: spilled->planes) size += p.size;
+	if (!ring_->allocate(size, spilled->block)) {
+		if (!ring_full_reported_) {
+			log[log::warning] << "No space for a frame of " << size << " bytes in " << storage_
+					<< ", keeping frames in memory. Consider increasing segments or segment_size.";
+			ring_full_reported_ = true;
+		}
+		return {};
+	}
+	ring_full_reported_ = false;
+	auto dest = ring_->data(spilled->block);
+	for (size_t i = 0; i < data.size(); ++i) {
+		dest = std::copy(data[i], data[i] + spilled->planes[i].size, dest);
+	}
+	spilled->format = frame->get_format();
+	spilled->timestamp = frame->get_timestamp();
+	spilled->duration = frame->get_duration();
+	spilled->index = frame->get_index();
+	spilled->format_name = frame->get_format_name();
+	return spilled;
+}
+
+core::pFrame Delay::restore(const spilled_frame_t& spilled)
+{
+	using type_t = spilled_frame_t::type_t;
+	const uint8_t* data = ring_->data(spilled.block);
+	core::pFrame frame;
+	switch (spilled.type) {
+		case type_t::raw_video: {
+			auto f = std::make_shared<core::RawVideoFrame>(spilled.format, spilled.resolution, 0);
+			for (size_t i = 0; i < spilled.planes.size(); ++i) {
+				const auto& p = spilled.planes[i];
+				f->emplace_back(p.size, p.resolution, p.line_size);
+				std::copy(data, data + p.size, PLANE_RAW_DATA(f,i));
+				data += p.size;
+			}
+			frame = f;
+		} break;
+		case type_t::compressed_video: {
+			auto f = core::CompressedVideoFrame::create_empty(spilled.format, spilled.resolution, spilled.block.size);
+			std::copy(data, data + spilled.block.size, f->get_data().data());
+			frame = f;
+		} break;
+		case type_t::raw_audio:
+			frame = core::RawAudioFrame::create_empty(spilled.format, spilled.channel_count,
+					spilled.sampling_frequency, data, spilled.block.size);
+			break;
+	}
+	ring_->release(spilled.block);
+	frame->set_timestamp(spilled.timestamp);
+	frame->set_duration(spilled.duration);
+	frame->set_index(spilled.index);
+	frame->set_format_name(spilled.format_name);
+	return frame;
 }
 
 bool Delay::set_param(const core::Parameter& param)
 {
 	if (assign_parameters(param)
-			(delay_, "delay", [](const core::Parameter& p){ return 1_s * p.get<double>();}))
+			(delay_, "delay", [](const core::Parameter& p){ return 1_s * p.get<double>();})
+			(storage_, "storage")
+			(segment_size_, "segment_size")
+			(segments_, "segments")
+			(readahead_, "readahead"))
 		return true;
 	return core::IOThread::set_param(param);
 }
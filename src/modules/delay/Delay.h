@@ -11,7 +11,9 @@
 #define DELAY_H_
 
 #include "yuri/core/thread/IOThread.h"
+#include "disk_ring.h"
 #include <deque>
+#include <memory>
 
 namespace yuri {
 namespace delay {
@@ -27,14 +29,55 @@ private:
 	virtual void run();
 	virtual bool set_param(const core::Parameter& param);
 
+	//! Parameters needed to recreate a frame stored in the disk ring
+	struct spilled_frame_t {
+		enum class type_t {
+			raw_video,
+			compressed_video,
+			raw_audio
+		};
+		struct plane_t {
+			size_t size;
+			size_t line_size;
+			resolution_t resolution;
+		};
+		type_t type;
+		format_t format;
+		resolution_t resolution;
+		size_t channel_count;
+		size_t sampling_frequency;
+		std::vector<plane_t> planes;
+		timestamp_t timestamp;
+		duration_t duration;
+		index_t index;
+		std::string format_name;
+		disk_ring_t::block_t block;
+	};
+
 	struct frame_time_t {
+		//! Frame kept in memory, empty when it's in the disk ring
 		core::pFrame frame;
 		timestamp_t timestamp;
+		std::unique_ptr<spilled_frame_t> spilled;
 	};
 
+	//! Stores the frame in the disk ring if possible, keeps it in memory otherwise
+	void store(core::pFrame frame);
+	std::unique_ptr<spilled_frame_t> spill(const core::pFrame& frame);
+	//! Recreates the frame and releases its space in the ring
+	core::pFrame restore(const spilled_frame_t& spilled);
+
 	duration_t delay_;
 	std::deque<frame_time_t> frames_;
 
+	//! Directory for the file backing the delay line, frames are kept in memory if empty
+	std::string storage_;
+	size_t segment_size_;
+	size_t segments_;
+	size_t readahead_;
+	std::unique_ptr<disk_ring_t> ring_;
+	bool ring_full_reported_;
+
 };
 
 } /* namespace delay */
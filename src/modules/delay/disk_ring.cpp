@@ -0,0 +1,145 @@
+/*!
+ * @file 		disk_ring.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "disk_ring.h"
+#include "yuri/core/utils/platform.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#ifdef YURI_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace yuri {
+namespace delay {
+
+#ifdef YURI_POSIX
+
+namespace {
+const size_t page_size = ::sysconf(_SC_PAGESIZE);
+
+//! Segments are mapped separately, so their size has to be a multiple of page size
+size_t page_aligned(size_t size)
+{
+	return std::max<size_t>(1, (size + page_size - 1) / page_size) * page_size;
+}
+}
+
+disk_ring_t::disk_ring_t(const std::string& directory, size_t segment_size, size_t segment_count)
+:segment_size_(page_aligned(segment_size)),
+ capacity_(static_cast<uint64_t>(segment_size_) * std::max<size_t>(segment_count, 1)),
+ fd_(-1),head_(0),tail_(0)
+{
+	auto fail = [this](const std::string& msg) {
+		const auto reason = std::string(std::strerror(errno));
+		for (auto s: segments_) ::munmap(s, segment_size_);
+		if (fd_ >= 0) ::close(fd_);
+		throw std::runtime_error(msg + ": " + reason);
+	};
+	auto name = (directory.empty() ? std::string(".") : directory) + "/yuri_delay_XXXXXX";
+	std::vector<char> path(name.begin(), name.end());
+	path.push_back(0);
+	fd_ = ::mkstemp(path.data());
+	if (fd_ < 0) fail("Failed to create a file in " + directory);
+	// The file is removed right away, so it disappears even when the application crashes
+	::unlink(path.data());
+#ifdef YURI_LINUX
+	// Allocates the blocks, so writing to the mapping can't fail on a full disk
+	const int ret = ::posix_fallocate(fd_, 0, capacity_);
+	if (ret != 0) {
+		errno = ret;
+		fail("Failed to allocate " + std::to_string(capacity_) + " bytes");
+	}
+#else
+	if (::ftruncate(fd_, capacity_) != 0) fail("Failed to resize the file");
+#endif
+	for (size_t i = 0; i < std::max<size_t>(segment_count, 1); ++i) {
+		void* data = ::mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, static_cast<off_t>(i * segment_size_));
+		if (data == MAP_FAILED) fail("Failed to map segment " + std::to_string(i));
+		segments_.push_back(static_cast<uint8_t*>(data));
+	}
+}
+
+disk_ring_t::~disk_ring_t() noexcept
+{
+	for (auto s: segments_) ::munmap(s, segment_size_);
+	::close(fd_);
+}
+
+bool disk_ring_t::allocate(size_t size, block_t& block)
+{
+	if (size > segment_size_) return false;
+	auto start = head_;
+	const auto offset = start % segment_size_;
+	if (offset + size > segment_size_) start += segment_size_ - offset;
+	if (start + size - tail_ > capacity_) return false;
+	if (head_ > 0 && (head_ - 1) / segment_size_ != start / segment_size_) {
+		// The writer left the segment, so it's written back now instead of accumulating dirty pages
+		const auto index = segment_index(head_ - 1);
+#ifdef YURI_LINUX
+		::sync_file_range(fd_, static_cast<off64_t>(index * segment_size_), segment_size_, SYNC_FILE_RANGE_WRITE);
+#else
+		::msync(segments_[index], segment_size_, MS_ASYNC);
+#endif
+	}
+	block = {start, size};
+	head_ = start + size;
+	return true;
+}
+
+uint8_t* disk_ring_t::data(const block_t& block) const
+{
+	return segments_[segment_index(block.position)] + block.position % segment_size_;
+}
+
+void disk_ring_t::release(const block_t& block)
+{
+	const auto end = block.position + block.size;
+	for (auto s = tail_ / segment_size_; s < end / segment_size_; ++s) {
+		// The reader left the segment, its pages are not needed until the writer gets there again
+		const auto index = s % segments_.size();
+		::madvise(segments_[index], segment_size_, MADV_DONTNEED);
+#ifdef YURI_LINUX
+		::posix_fadvise(fd_, static_cast<off_t>(index * segment_size_), segment_size_, POSIX_FADV_DONTNEED);
+#endif
+	}
+	tail_ = end;
+}
+
+void disk_ring_t::prefetch(const block_t& block) const
+{
+	if (!block.size) return;
+	auto data = this->data(block);
+	const auto misalignment = reinterpret_cast<uintptr_t>(data) % page_size;
+	::madvise(data - misalignment, block.size + misalignment, MADV_WILLNEED);
+}
+
+#else
+
+disk_ring_t::disk_ring_t(const std::string&, size_t segment_size, size_t segment_count)
+:segment_size_(segment_size),capacity_(static_cast<uint64_t>(segment_size) * segment_count),
+ fd_(-1),head_(0),tail_(0)
+{
+	throw std::runtime_error("Storing delayed frames in a file is not supported on this platform");
+}
+
+disk_ring_t::~disk_ring_t() noexcept {}
+bool disk_ring_t::allocate(size_t, block_t&) { return false; }
+uint8_t* disk_ring_t::data(const block_t&) const { return nullptr; }
+void disk_ring_t::release(const block_t&) {}
+void disk_ring_t::prefetch(const block_t&) const {}
+
+#endif
+
+}
+}
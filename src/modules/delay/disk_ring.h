@@ -0,0 +1,75 @@
+/*!
+ * @file 		disk_ring.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Ring buffer in a preallocated temporary file, mapped to memory in segments.
+ */
+
+#ifndef MODULES_DELAY_DISK_RING_H_
+#define MODULES_DELAY_DISK_RING_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace yuri {
+namespace delay {
+
+/*!
+ * Blocks are allocated and released in FIFO order. A block never crosses
+ * segment boundary, space at the end of a segment is skipped if the block doesn't fit.
+ *
+ * Segments left by the writer are scheduled for writeback and segments left
+ * by the reader are dropped from page cache, so only few segments are kept in memory.
+ */
+class disk_ring_t {
+public:
+	struct block_t {
+		//! Position from the creation of the ring (not wrapped)
+		uint64_t position;
+		size_t size;
+	};
+
+	/*!
+	 * Creates an unlinked temporary file in @em directory and maps it.
+	 * @throw std::runtime_error when the file can't be created, preallocated or mapped
+	 */
+	disk_ring_t(const std::string& directory, size_t segment_size, size_t segment_count);
+	~disk_ring_t() noexcept;
+	disk_ring_t(const disk_ring_t&) = delete;
+	disk_ring_t& operator=(const disk_ring_t&) = delete;
+
+	/*!
+	 * Reserves @em size contiguous bytes after all previously allocated blocks.
+	 * @return false if there's not enough free space
+	 */
+	bool allocate(size_t size, block_t& block);
+	uint8_t* data(const block_t& block) const;
+	//! Frees @em block, which has to be the oldest allocated block
+	void release(const block_t& block);
+	//! Asks the kernel to read @em block in advance
+	void prefetch(const block_t& block) const;
+
+	size_t segment_size() const { return segment_size_; }
+	uint64_t capacity() const { return capacity_; }
+	uint64_t used() const { return head_ - tail_; }
+
+private:
+	size_t segment_index(uint64_t position) const { return (position / segment_size_) % segments_.size(); }
+
+	const size_t segment_size_;
+	const uint64_t capacity_;
+	int fd_;
+	std::vector<uint8_t*> segments_;
+	uint64_t head_;
+	uint64_t tail_;
+};
+
+}
+}
+
+#endif /* MODULES_DELAY_DISK_RING_H_ */
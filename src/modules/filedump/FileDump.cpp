@@ -18,6 +18,7 @@
 #include "yuri/core/utils/string_generator.h"
 #include "yuri/core/utils/DirectoryBrowser.h"
 #include "yuri/core/utils/assign_events.h"
+#include "yuri/core/utils/make_unique.h"
 namespace yuri
 {
 namespace dump
@@ -38,6 +39,9 @@ core::Parameters FileDump::configure()
 	p["frame_limit"]["Maximal number of frames to dump. 0 for unlimited"]=0;
 	p["info_string"]["Additional string to emit with each frame (as event 'info')"]="";
 	p["append"]["Append to the end of file"]=false;
+	p["direct_io"]["Write files with O_DIRECT, bypassing the page cache (Linux only)"]=false;
+	p["preallocate"]["Reserve disk space in chunks of this size (in MiB), 0 to disable (Linux only)"]=0;
+	p["queue_size"]["Maximal amount of data waiting to be written (in MiB). Processing is blocked when the queue is full."]=256;
 	return p;
 }
 
@@ -69,11 +73,13 @@ FileDump::FileDump(log::Log &log_,core::pwThreadBase parent, const core::Paramet
 	IOFilter(log_,parent,"Dump"),
 	event::BasicEventProducer(log),
 	event::BasicEventConsumer(log),
-	dump_file(),filename(),seq_chars(0),seq_number(0),dumped_frames(0),
-	dump_limit(0),use_regex_(false),single_file_(true),append_(false)
+	filename(),seq_chars(0),seq_number(0),dumped_frames(0),
+	dump_limit(0),use_regex_(false),single_file_(true),append_(false),
+	direct_io_(false),preallocate_(0),queue_size_(256)
 {
 	IOTHREAD_INIT(parameters);
 	if (filename.empty()) throw exception::InitializationFailed("No filename specified");
+	writer_ = make_unique<file_writer_t>(log, queue_size_ * 1024 * 1024, direct_io_, preallocate_ * 1024 * 1024);
 
 	if (core::utils::is_extended_generator_supported()) {
 		auto s = core::utils::analyze_string_specifiers(filename);
@@ -102,16 +108,12 @@ FileDump::FileDump(log::Log &log_,core::pwThreadBase parent, const core::Paramet
 
 FileDump::~FileDump() noexcept
 {
-	if (dump_file.is_open()) dump_file.close();
 }
 
 bool FileDump::open_file(const std::string& fname)
 {
 	core::filesystem::ensure_path_directory(fname);
-	auto flags = std::ios::binary | std::ios::out;
-	if (append_) flags|=std::ios::app;
-	if (dump_file.is_open()) dump_file.close();
-	dump_file.open(fname.c_str(), flags);
+	writer_->open(fname, append_);
 	return true;
 }
 std::string FileDump::generate_filename(const core::pFrame& frame)
@@ -138,19 +140,24 @@ core::pFrame FileDump::do_simple_single_step(core::pFrame frame)
 		emit_event("filename",seq_filename);
 	}
 	bool written = true;
+	// The frames are written without copying, the segments keep them alive until they're written
+	core::data_segments_t segments;
 	if (auto f = std::dynamic_pointer_cast<core::RawVideoFrame>(frame)) {
 		log[log::debug]<<"Dumping " << f->get_planes_count() << " planes";
 		for (yuri::size_t i=0; i<f->get_planes_count();++i) {
-			dump_file.write(reinterpret_cast<const char *>(PLANE_RAW_DATA(f,0)),PLANE_SIZE(f,0));
+			segments.push_back({PLANE_RAW_DATA(f,i), PLANE_SIZE(f,i), f});
 		}
 	} else if (auto f2 = std::dynamic_pointer_cast<core::CompressedVideoFrame>(frame)) {
-		dump_file.write(reinterpret_cast<const char *>(f2->begin()),f2->size());
+		segments = f2->get_segments();
+		for (auto& s: segments) {
+			if (!s.owner) s.owner = f2;
+		}
 	} else if (auto f3 = std::dynamic_pointer_cast<core::RawAudioFrame>(frame)) {
-		dump_file.write(reinterpret_cast<const char *>(f3->data()),f3->size());
+		segments.push_back({f3->data(), f3->size(), f3});
 	} else if (auto f4 = std::dynamic_pointer_cast<core::EventFrame>(frame)) {
 		try {
-			const auto text = event::lex_cast_value<std::string>(f4->get_event()) +"\n";
-			dump_file.write(text.c_str(),text.size());
+			auto text = std::make_shared<std::string>(event::lex_cast_value<std::string>(f4->get_event()) +"\n");
+			segments.push_back({reinterpret_cast<const uint8_t*>(text->data()), text->size(), text});
 		}
 		catch (std::exception& e) {
 			log[log::warning] << "Failed to store event " << f4->get_name();
@@ -159,11 +166,14 @@ core::pFrame FileDump::do_simple_single_step(core::pFrame frame)
 	} else {
 		written=false;
 	}
+	if (!segments.empty()) {
+		writer_->write(std::move(segments));
+	}
 	if (!info_string_.empty()) {
 		emit_event("info", core::utils::generate_string(info_string_, seq_number, frame));
 	}
 	if (!single_file_) {
-		dump_file.close();
+		writer_->close();
 	}
 	if (written) {
 		emit_event("frame");
@@ -187,7 +197,10 @@ bool FileDump::set_param(const core::Parameter &param)
 			(seq_chars, 	"sequence")
 			(dump_limit, 	"frame_limit")
 			(info_string_, 	"info_string")
-			(append_,		"append"))
+			(append_,		"append")
+			(direct_io_,	"direct_io")
+			(preallocate_,	"preallocate")
+			(queue_size_,	"queue_size"))
 		return true;
 	return IOFilter::set_param(param);
 }
@@ -13,7 +13,8 @@
 #include "yuri/core/thread/IOFilter.h"
 #include "yuri/event/BasicEventProducer.h"
 #include "yuri/event/BasicEventConsumer.h"
-#include <fstream>
+#include "file_writer.h"
+#include <memory>
 #include <string>
 
 namespace yuri
@@ -36,7 +37,7 @@ private:
 	virtual bool set_param(const core::Parameter &param) override;
 	std::string generate_filename(const core::pFrame& frame);
 	bool do_process_event(const std::string& event_name, const event::pBasicEvent& event);
-	std::ofstream dump_file;
+	std::unique_ptr<file_writer_t> writer_;
 	std::string filename;
 
 	int seq_chars;
@@ -47,6 +48,9 @@ private:
 	bool single_file_; //!< Output is in a single file
 
 	bool append_;
+	bool direct_io_;
+	size_t preallocate_;
+	size_t queue_size_;
 
 	std::string info_string_;
 };
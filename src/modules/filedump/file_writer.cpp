@@ -0,0 +1,337 @@
+/*!
+ * @file 		file_writer.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "file_writer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#ifdef YURI_POSIX
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace yuri {
+namespace dump {
+
+namespace {
+//! Pending data are written when they reach this size, even if more is queued
+const size_t max_write_size = 64 * 1024 * 1024;
+#ifdef YURI_POSIX
+#ifdef IOV_MAX
+const size_t max_iovecs = IOV_MAX;
+#else
+const size_t max_iovecs = 1024;
+#endif
+const size_t direct_alignment = 4096;
+const size_t direct_buffer_size = 8 * 1024 * 1024;
+#else
+const size_t max_iovecs = 1024;
+#endif
+}
+
+file_writer_t::file_writer_t(const log::Log& log_, size_t max_queued_bytes, bool direct, size_t preallocate)
+:log(log_),max_queued_bytes_(max_queued_bytes),direct_(direct),preallocate_(preallocate),
+ queued_bytes_(0),stop_(false),failed_(false),pending_size_(0)
+#ifdef YURI_POSIX
+ ,fd_(-1),file_direct_(false),offset_(0),file_preallocate_(false),allocated_(0),
+ direct_buffer_(nullptr, &std::free),direct_used_(0)
+#endif
+{
+	thread_ = std::thread([this]{ run(); });
+}
+
+file_writer_t::~file_writer_t() noexcept
+{
+	{
+		std::unique_lock<std::mutex> _(mutex_);
+		stop_ = true;
+		cond_.notify_all();
+	}
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+}
+
+void file_writer_t::open(const std::string& filename, bool append)
+{
+	enqueue({action_t::open, filename, append, {}, 0});
+}
+
+void file_writer_t::close()
+{
+	enqueue({action_t::close, {}, false, {}, 0});
+}
+
+void file_writer_t::write(core::data_segments_t segments)
+{
+	const auto size = core::get_segments_size(segments);
+	enqueue({action_t::write, {}, false, std::move(segments), size});
+}
+
+void file_writer_t::enqueue(job_t job)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	// Data larger than the limit are accepted when nothing else is queued
+	cond_.wait(lock, [&]{ return queued_bytes_ == 0 || queued_bytes_ + job.size <= max_queued_bytes_; });
+	queued_bytes_ += job.size;
+	jobs_.push_back(std::move(job));
+	cond_.notify_all();
+}
+
+void file_writer_t::run()
+{
+	std::deque<job_t> jobs;
+	size_t done = 0;
+	auto release = [&]{
+		flush_pending();
+		std::unique_lock<std::mutex> _(mutex_);
+		queued_bytes_ -= done;
+		done = 0;
+		cond_.notify_all();
+	};
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cond_.wait(lock, [this]{ return stop_ || !jobs_.empty(); });
+			if (jobs_.empty()) break;
+			jobs.swap(jobs_);
+		}
+		for (auto& job: jobs) {
+			switch (job.action) {
+				case action_t::open:
+					release();
+					close_file();
+					open_file(job.filename, job.append);
+					break;
+				case action_t::close:
+					release();
+					close_file();
+					break;
+				case action_t::write:
+					pending_.insert(pending_.end(), std::make_move_iterator(job.segments.begin()),
+							std::make_move_iterator(job.segments.end()));
+					pending_size_ += job.size;
+					done += job.size;
+					if (pending_.size() >= max_iovecs || pending_size_ >= max_write_size) {
+						release();
+					}
+					break;
+			}
+		}
+		jobs.clear();
+		release();
+	}
+	close_file();
+}
+
+void file_writer_t::report_error(const std::string& what)
+{
+	log[log::error] << "Failed to write " << filename_ << ": " << what;
+	failed_ = true;
+}
+
+#ifdef YURI_POSIX
+
+void file_writer_t::open_file(const std::string& filename, bool append)
+{
+	filename_ = filename;
+	failed_ = false;
+	const int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+	file_direct_ = false;
+#ifdef O_DIRECT
+	if (direct_) {
+		fd_ = ::open(filename.c_str(), flags | O_DIRECT, 0666);
+		if (fd_ >= 0) {
+			file_direct_ = true;
+		} else {
+			log[log::warning] << "Failed to open " << filename << " for direct I/O (" << std::strerror(errno) << "), using buffered writes";
+		}
+	}
+#endif
+	if (fd_ < 0) {
+		fd_ = ::open(filename.c_str(), flags, 0666);
+	}
+	if (fd_ < 0) {
+		report_error(std::string("failed to open the file: ") + std::strerror(errno));
+		return;
+	}
+	const auto end = ::lseek(fd_, 0, SEEK_END);
+	offset_ = end > 0 ? end : 0;
+	allocated_ = offset_;
+	file_preallocate_ = preallocate_ > 0;
+	direct_used_ = 0;
+	if (file_direct_ && !direct_buffer_) {
+		void* buffer = nullptr;
+		if (posix_memalign(&buffer, direct_alignment, direct_buffer_size) == 0) {
+			direct_buffer_.reset(static_cast<uint8_t*>(buffer));
+		}
+	}
+	if (file_direct_ && (!direct_buffer_ || offset_ % direct_alignment)) {
+		// Appending to a file with unaligned size
+		disable_direct();
+	}
+}
+
+void file_writer_t::close_file()
+{
+	if (fd_ < 0) return;
+	if (file_direct_ && direct_used_ > 0 && !failed_) {
+		const auto aligned = direct_used_ - direct_used_ % direct_alignment;
+		if (aligned == 0 || write_all(direct_buffer_.get(), aligned)) {
+			// The tail is not aligned, so it has to be written without O_DIRECT
+			disable_direct();
+			write_all(direct_buffer_.get() + aligned, direct_used_ - aligned);
+		}
+	}
+	direct_used_ = 0;
+	if (file_preallocate_ && allocated_ > offset_) {
+		// Releases space reserved beyond the end of the file
+		if (::ftruncate(fd_, offset_) != 0) {
+			log[log::warning] << "Failed to release preallocated space in " << filename_;
+		}
+	}
+	if (::close(fd_) != 0 && !failed_) {
+		report_error(std::strerror(errno));
+	}
+	fd_ = -1;
+}
+
+void file_writer_t::disable_direct()
+{
+#ifdef O_DIRECT
+	const auto flags = ::fcntl(fd_, F_GETFL);
+	if (flags >= 0) ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT);
+#endif
+	file_direct_ = false;
+}
+
+void file_writer_t::reserve(size_t size)
+{
+#ifdef YURI_LINUX
+	if (!file_preallocate_ || offset_ + size <= allocated_) return;
+	const auto length = std::max<uint64_t>(offset_ + size, allocated_ + preallocate_) - allocated_;
+	if (::fallocate(fd_, FALLOC_FL_KEEP_SIZE, allocated_, length) == 0) {
+		allocated_ += length;
+	} else {
+		log[log::warning] << "Failed to preallocate space for " << filename_ << ": " << std::strerror(errno);
+		file_preallocate_ = false;
+	}
+#else
+	(void)size;
+#endif
+}
+
+bool file_writer_t::write_all(const uint8_t* data, size_t size)
+{
+	while (size > 0) {
+		const auto written = ::write(fd_, data, size);
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) {
+			report_error(written < 0 ? std::strerror(errno) : "no data written");
+			return false;
+		}
+		data += written;
+		size -= written;
+		offset_ += written;
+	}
+	return true;
+}
+
+void file_writer_t::flush_pending()
+{
+	if (!pending_.empty() && !failed_ && fd_ >= 0) {
+		reserve(pending_size_);
+		if (file_direct_) {
+			auto buffer = direct_buffer_.get();
+			for (const auto& s: pending_) {
+				auto data = s.data;
+				auto size = s.size;
+				while (size > 0) {
+					const auto count = std::min(size, direct_buffer_size - direct_used_);
+					std::copy(data, data + count, buffer + direct_used_);
+					direct_used_ += count;
+					data += count;
+					size -= count;
+					if (direct_used_ == direct_buffer_size) {
+						if (!write_all(buffer, direct_used_)) break;
+						direct_used_ = 0;
+					}
+				}
+				if (failed_) break;
+			}
+		} else {
+			std::vector<iovec> iovecs;
+			iovecs.reserve(pending_.size());
+			for (const auto& s: pending_) {
+				if (s.size) iovecs.push_back({const_cast<uint8_t*>(s.data), s.size});
+			}
+			size_t index = 0;
+			while (index < iovecs.size()) {
+				const auto count = static_cast<int>(std::min(iovecs.size() - index, max_iovecs));
+				const auto written = ::writev(fd_, &iovecs[index], count);
+				if (written < 0 && errno == EINTR) continue;
+				if (written <= 0) {
+					report_error(written < 0 ? std::strerror(errno) : "no data written");
+					break;
+				}
+				offset_ += written;
+				// Skips fully written vectors and moves into partially written one
+				auto left = static_cast<size_t>(written);
+				while (index < iovecs.size() && left >= iovecs[index].iov_len) {
+					left -= iovecs[index].iov_len;
+					++index;
+				}
+				if (left > 0) {
+					iovecs[index].iov_base = static_cast<uint8_t*>(iovecs[index].iov_base) + left;
+					iovecs[index].iov_len -= left;
+				}
+			}
+		}
+	}
+	pending_.clear();
+	pending_size_ = 0;
+}
+
+#else
+
+void file_writer_t::open_file(const std::string& filename, bool append)
+{
+	filename_ = filename;
+	failed_ = false;
+	auto flags = std::ios::binary | std::ios::out;
+	if (append) flags |= std::ios::app;
+	file_.open(filename, flags);
+	if (!file_.is_open()) report_error("failed to open the file");
+}
+
+void file_writer_t::close_file()
+{
+	if (file_.is_open()) file_.close();
+}
+
+void file_writer_t::flush_pending()
+{
+	if (!failed_ && file_.is_open()) {
+		for (const auto& s: pending_) {
+			file_.write(reinterpret_cast<const char*>(s.data), s.size);
+		}
+		if (!file_) report_error("write failed");
+	}
+	pending_.clear();
+	pending_size_ = 0;
+}
+
+#endif
+
+}
+}
@@ -0,0 +1,121 @@
+/*!
+ * @file 		file_writer.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Asynchronous writer of data segments to files.
+ */
+
+#ifndef MODULES_FILEDUMP_FILE_WRITER_H_
+#define MODULES_FILEDUMP_FILE_WRITER_H_
+
+#include "yuri/log/Log.h"
+#include "yuri/core/utils/data_segment.h"
+#include "yuri/core/utils/platform.h"
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace yuri {
+namespace dump {
+
+/*!
+ * Writes data in a separate thread, so slow disks don't stall the thread producing the data.
+ *
+ * Segments queued between two writes of the thread are written with a single writev call.
+ * The segments are not copied, their owners keep the memory alive until it's written.
+ */
+class file_writer_t {
+public:
+	/*!
+	 * @param max_queued_bytes	write() blocks while there is more data waiting to be written
+	 * @param direct			Bypass page cache (O_DIRECT). Data are copied into aligned buffers
+	 * 							and the tail of each file is written without O_DIRECT.
+	 * @param preallocate		Reserve disk space in chunks of this size (in bytes), 0 to disable
+	 */
+	file_writer_t(const log::Log& log, size_t max_queued_bytes, bool direct, size_t preallocate);
+	//! Writes all queued data and closes the file
+	~file_writer_t() noexcept;
+	file_writer_t(const file_writer_t&) = delete;
+	file_writer_t& operator=(const file_writer_t&) = delete;
+
+	//! Closes current file (after writing all previously queued data) and opens @em filename
+	void open(const std::string& filename, bool append);
+	void close();
+	/*!
+	 * Queues @em segments to be written to the current file.
+	 * Blocks while there is too much data waiting to be written.
+	 */
+	void write(core::data_segments_t segments);
+
+private:
+	enum class action_t {
+		open,
+		close,
+		write
+	};
+	struct job_t {
+		action_t action;
+		std::string filename;
+		bool append;
+		core::data_segments_t segments;
+		size_t size;
+	};
+
+	void enqueue(job_t job);
+	void run();
+	void open_file(const std::string& filename, bool append);
+	void close_file();
+	void flush_pending();
+#ifdef YURI_POSIX
+	bool write_all(const uint8_t* data, size_t size);
+	void disable_direct();
+	void reserve(size_t size);
+#endif
+	void report_error(const std::string& what);
+
+	log::Log log;
+	const size_t max_queued_bytes_;
+	const bool direct_;
+	const size_t preallocate_;
+
+	std::deque<job_t> jobs_;
+	size_t queued_bytes_;
+	bool stop_;
+	std::mutex mutex_;
+	std::condition_variable cond_;
+
+	// Used only by the writing thread
+	std::string filename_;
+	bool failed_;
+	//! Segments collected for a single writev call
+	core::data_segments_t pending_;
+	size_t pending_size_;
+#ifdef YURI_POSIX
+	int fd_;
+	bool file_direct_;
+	uint64_t offset_;
+	//! Space reserved by fallocate (the file size is not changed by the reservation)
+	bool file_preallocate_;
+	uint64_t allocated_;
+	//! Aligned buffer for O_DIRECT writes
+	std::unique_ptr<uint8_t, void(*)(void*)> direct_buffer_;
+	size_t direct_used_;
+#else
+	std::ofstream file_;
+#endif
+
+	std::thread thread_;
+};
+
+}
+}
+
+#endif /* MODULES_FILEDUMP_FILE_WRITER_H_ */
@@ -32,7 +32,6 @@ FpsFixer::FpsFixer(log::Log &log_, core::pwThreadBase parent, const core::Parame
 		fps_(25.0)
 {
 	IOTHREAD_INIT(parameters)
-	set_latency(100_ms/fps_);
 }
 
 FpsFixer::~FpsFixer() noexcept
@@ -44,20 +43,19 @@ void FpsFixer::run()
 	IOThread::print_id();
 	core::pFrame frame;
 
-	frames_ = 0;
+	timer_.set_fps(fps_);
 	timer_.reset();
 	while(still_running()) {
 		process_events();
 		while (auto f = pop_frame(0)) {
 			frame = f;
 		}
-		if (timer_.get_duration() > frames_ * 1_s/fps_) {
+		// Wakes up at the deadline, or earlier to take a new frame
+		if (wait_until(timer_.next_deadline())) {
 			if (frame) {
 				push_frame(0,frame);
 			}
-			frames_++;
-		} else {
-			sleep(get_latency());
+			timer_.advance();
 		}
 	}
 
@@ -76,8 +74,7 @@ bool FpsFixer::do_process_event(const std::string& event_name, const event::pBas
 	if (assign_events(event_name, event)
 			(fps_, "fps"))
 	{
-		frames_ = 0;
-		timer_.reset();
+		timer_.set_fps(fps_);
 		return true;
 	}
 	return false;
@@ -28,8 +28,7 @@ private:
 	virtual void run() override;
 	virtual bool do_process_event(const std::string& event_name, const event::pBasicEvent& event) override;
 	double fps_;
-	yuri::size_t frames_;
-	Timer timer_;
+	FPSTimer timer_;
 };
 
 }
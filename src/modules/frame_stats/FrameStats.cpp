@@ -0,0 +1,398 @@
+/*!
+ * @file 		FrameStats.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "FrameStats.h"
+#include "yuri/core/Module.h"
+#include "yuri/core/frame/raw_frame_types.h"
+#include "yuri/core/utils/cpu_features.h"
+#include <cstdlib>
+#include <map>
+#ifdef YURI_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef YURI_HAVE_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+namespace yuri {
+namespace frame_stats {
+
+
+IOTHREAD_GENERATOR(FrameStats)
+
+MODULE_REGISTRATION_BEGIN("frame_stats")
+		REGISTER_IOTHREAD("frame_stats",FrameStats)
+MODULE_REGISTRATION_END()
+
+core::Parameters FrameStats::configure()
+{
+	core::Parameters p = base_type::configure();
+	p.set_description("Computes luma/chroma statistics, detects black and frozen frames and clipped values. "
+			"Statistics are sent as events every 'interval' frames, 'black' and 'freeze' events are sent immediately when the state changes.");
+	p["interval"]["Number of frames to accumulate before sending statistics"]=25;
+	p["step_x"]["Analyze only every n-th column"]=2;
+	p["step_y"]["Analyze only every n-th line"]=2;
+	p["bins"]["Number of bins in the histograms (1 - 256)"]=16;
+	p["black_level"]["Luma values below this level are considered black"]=32;
+	p["black_amount"]["Ratio of black samples for a frame to be considered black"]=0.98;
+	p["freeze_threshold"]["Maximal mean absolute difference of luma between two frames to be considered identical"]=0.5;
+	p["freeze_frames"]["Number of identical frames needed to report a freeze"]=10;
+	p["limited_range"]["Report values outside of limited range (16-235, 16-240) as clipped. If false, only 0 and 255 are considered clipped."]=true;
+	return p;
+}
+
+namespace {
+
+//! Position of a component inside a plane. Step is distance between samples in bytes.
+struct sample_layout_t {
+	size_t plane;
+	size_t offset;
+	size_t step;
+};
+
+struct format_layout_t {
+	sample_layout_t y;
+	sample_layout_t u;
+	sample_layout_t v;
+	dimension_t sub_x;
+	dimension_t sub_y;
+	bool has_chroma;
+};
+
+using namespace core::raw_format;
+
+const std::map<format_t, format_layout_t> supported_layouts = {
+		{y8, 		{{0, 0, 1}, {0, 0, 0}, {0, 0, 0}, 1, 1, false}},
+		{yuyv422,	{{0, 0, 2}, {0, 1, 4}, {0, 3, 4}, 2, 1, true}},
+		{yvyu422,	{{0, 0, 2}, {0, 3, 4}, {0, 1, 4}, 2, 1, true}},
+		{uyvy422,	{{0, 1, 2}, {0, 0, 4}, {0, 2, 4}, 2, 1, true}},
+		{vyuy422,	{{0, 1, 2}, {0, 2, 4}, {0, 0, 4}, 2, 1, true}},
+		{yuv444,	{{0, 0, 3}, {0, 1, 3}, {0, 2, 3}, 1, 1, true}},
+		{yuv444p,	{{0, 0, 1}, {1, 0, 1}, {2, 0, 1}, 1, 1, true}},
+		{yuv422p,	{{0, 0, 1}, {1, 0, 1}, {2, 0, 1}, 2, 1, true}},
+		{yuv420p,	{{0, 0, 1}, {1, 0, 1}, {2, 0, 1}, 2, 2, true}},
+		{yuv411p,	{{0, 0, 1}, {1, 0, 1}, {2, 0, 1}, 4, 1, true}},
+		{nv12,		{{0, 0, 1}, {1, 0, 2}, {1, 1, 2}, 2, 2, true}},
+};
+
+/*!
+ * Collects every step_x-th sample from every step_y-th line into a continuous buffer
+ * @return false if the plane is too small for specified dimensions
+ */
+bool gather_samples(const core::RawVideoFrame& frame, const sample_layout_t& layout,
+		dimension_t width, dimension_t height, dimension_t step_x, dimension_t step_y,
+		std::vector<uint8_t>& out)
+{
+	out.clear();
+	if (layout.plane >= frame.get_planes_count()) return false;
+	const auto& plane = frame[layout.plane];
+	const size_t line_size = plane.get_line_size();
+	if (!width || !height) return true;
+	if (plane.size() < (height - 1) * line_size + layout.offset + (width - 1) * layout.step + 1) return false;
+
+	const size_t stride = layout.step * step_x;
+	const size_t count = (width + step_x - 1) / step_x;
+	out.resize(count * ((height + step_y - 1) / step_y));
+	auto dest = out.begin();
+	const uint8_t* data = plane.data() + layout.offset;
+	for (dimension_t line = 0; line < height; line += step_y) {
+		const uint8_t* src = data + line * line_size;
+		if (stride == 1) {
+			dest = std::copy(src, src + count, dest);
+		} else {
+			for (size_t i = 0; i < count; ++i) {
+				*dest++ = *src;
+				src += stride;
+			}
+		}
+	}
+	return true;
+}
+
+/*!
+ * Histogram of samples. Uses 4 separate tables to avoid stalls when
+ * incrementing the same bin repeatedly.
+ */
+void update_histogram(const std::vector<uint8_t>& samples, histogram_t& hist)
+{
+	std::array<std::array<uint32_t, 256>, 4> h {};
+	const size_t count = samples.size();
+	const uint8_t* data = samples.data();
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		++h[0][data[i + 0]];
+		++h[1][data[i + 1]];
+		++h[2][data[i + 2]];
+		++h[3][data[i + 3]];
+	}
+	for (; i < count; ++i) {
+		++h[0][data[i]];
+	}
+	for (size_t v = 0; v < 256; ++v) {
+		hist[v] += h[0][v] + h[1][v] + h[2][v] + h[3][v];
+	}
+}
+
+uint64_t sad_scalar(const uint8_t* a, const uint8_t* b, size_t count)
+{
+	uint64_t sum = 0;
+	for (size_t i = 0; i < count; ++i) {
+		sum += std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i]));
+	}
+	return sum;
+}
+
+#ifdef YURI_HAVE_SSE2
+uint64_t sad_sse2(const uint8_t* a, const uint8_t* b, size_t count)
+{
+	__m128i acc = _mm_setzero_si128();
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+		acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+	}
+	const uint64_t sum = static_cast<uint64_t>(_mm_cvtsi128_si32(acc))
+			+ static_cast<uint64_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+	return sum + sad_scalar(a + i, b + i, count - i);
+}
+#endif
+
+#ifdef YURI_HAVE_AVX2_TARGET
+YURI_TARGET_AVX2
+uint64_t sad_avx2(const uint8_t* a, const uint8_t* b, size_t count)
+{
+	__m256i acc = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+		acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, vb));
+	}
+	alignas(32) uint64_t parts[4];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(parts), acc);
+	return parts[0] + parts[1] + parts[2] + parts[3] + sad_scalar(a + i, b + i, count - i);
+}
+#endif
+
+sad_function_t select_sad_function(log::Log& log)
+{
+#ifdef YURI_HAVE_AVX2_TARGET
+	if (core::utils::cpu_has_avx2()) {
+		log[log::debug] << "Using AVX2 implementation";
+		return &sad_avx2;
+	}
+#endif
+#ifdef YURI_HAVE_SSE2
+	if (core::utils::cpu_has_sse2()) {
+		log[log::debug] << "Using SSE2 implementation";
+		return &sad_sse2;
+	}
+#endif
+	(void)log;
+	return &sad_scalar;
+}
+
+uint64_t count_range(const histogram_t& hist, size_t first, size_t last)
+{
+	uint64_t count = 0;
+	for (size_t i = first; i < last; ++i) count += hist[i];
+	return count;
+}
+
+uint64_t count_samples(const histogram_t& hist)
+{
+	return count_range(hist, 0, 256);
+}
+
+double histogram_mean(const histogram_t& hist)
+{
+	uint64_t sum = 0;
+	for (size_t i = 0; i < 256; ++i) sum += i * hist[i];
+	const auto count = count_samples(hist);
+	return count ? static_cast<double>(sum) / count : 0.0;
+}
+
+event::pBasicEvent histogram_event(const histogram_t& hist, size_t bins)
+{
+	std::vector<int64_t> folded(bins, 0);
+	for (size_t i = 0; i < 256; ++i) {
+		folded[i * bins / 256] += hist[i];
+	}
+	std::vector<event::pBasicEvent> values;
+	values.reserve(bins);
+	for (auto v: folded) {
+		values.push_back(std::make_shared<event::EventInt>(v));
+	}
+	return std::make_shared<event::EventVector>(std::move(values));
+}
+
+}
+
+
+FrameStats::FrameStats(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
+base_type(log_,parent,std::string("frame_stats")),
+event::BasicEventProducer(log),
+interval_(25),step_x_(2),step_y_(2),bins_(16),black_level_(32),black_amount_(0.98),
+freeze_threshold_(0.5),freeze_frames_(10),limited_range_(true),
+black_(false),frozen_(false),still_frames_(0)
+{
+	IOTHREAD_INIT(parameters)
+	if (!interval_) interval_ = 1;
+	if (!step_x_) step_x_ = 1;
+	if (!step_y_) step_y_ = 1;
+	bins_ = std::min<size_t>(std::max<size_t>(bins_, 1), 256);
+	sad_ = select_sad_function(log);
+	set_supported_formats(supported_layouts);
+	reset_statistics();
+}
+
+FrameStats::~FrameStats() noexcept
+{
+}
+
+void FrameStats::reset_statistics()
+{
+	hist_y_.fill(0);
+	hist_u_.fill(0);
+	hist_v_.fill(0);
+	frames_ = 0;
+	black_frames_ = 0;
+	diff_frames_ = 0;
+	black_sum_ = 0.0;
+	diff_sum_ = 0.0;
+}
+
+bool FrameStats::analyze_frame(const core::pRawVideoFrame& frame)
+{
+	const auto it = supported_layouts.find(frame->get_format());
+	if (it == supported_layouts.end()) return false;
+	const auto& layout = it->second;
+	const auto res = frame->get_resolution();
+
+	if (!gather_samples(*frame, layout.y, res.width, res.height, step_x_, step_y_, luma_)) {
+		log[log::warning] << "Frame too small for its resolution, ignoring";
+		return false;
+	}
+	if (layout.has_chroma) {
+		const dimension_t cw = (res.width + layout.sub_x - 1) / layout.sub_x;
+		const dimension_t ch = (res.height + layout.sub_y - 1) / layout.sub_y;
+		if (!gather_samples(*frame, layout.u, cw, ch, step_x_, step_y_, chroma_u_) ||
+				!gather_samples(*frame, layout.v, cw, ch, step_x_, step_y_, chroma_v_)) {
+			log[log::warning] << "Frame too small for its resolution, ignoring";
+			return false;
+		}
+		update_histogram(chroma_u_, hist_u_);
+		update_histogram(chroma_v_, hist_v_);
+	}
+
+	histogram_t frame_hist {};
+	update_histogram(luma_, frame_hist);
+	for (size_t i = 0; i < 256; ++i) hist_y_[i] += frame_hist[i];
+
+	const auto samples = luma_.size();
+	const double black_ratio = samples ?
+			static_cast<double>(count_range(frame_hist, 0, black_level_)) / samples : 0.0;
+	black_sum_ += black_ratio;
+	const bool black = black_ratio >= black_amount_;
+	if (black) ++black_frames_;
+	if (black != black_) {
+		black_ = black;
+		emit_event("black", black_);
+	}
+
+	if (samples && last_luma_.size() == samples) {
+		const double diff = static_cast<double>(sad_(luma_.data(), last_luma_.data(), samples)) / samples;
+		diff_sum_ += diff;
+		++diff_frames_;
+		if (diff <= freeze_threshold_) {
+			++still_frames_;
+		} else {
+			still_frames_ = 0;
+		}
+	} else {
+		still_frames_ = 0;
+	}
+	const bool frozen = still_frames_ >= freeze_frames_;
+	if (frozen != frozen_) {
+		frozen_ = frozen;
+		emit_event("freeze", frozen_);
+	}
+	std::swap(luma_, last_luma_);
+	return true;
+}
+
+void FrameStats::emit_statistics()
+{
+	const auto y_count = count_samples(hist_y_);
+	if (y_count) {
+		size_t y_min = 0;
+		while (y_min < 255 && !hist_y_[y_min]) ++y_min;
+		size_t y_max = 255;
+		while (y_max > 0 && !hist_y_[y_max]) --y_max;
+		emit_event("y_min", y_min);
+		emit_event("y_max", y_max);
+		emit_event("y_mean", histogram_mean(hist_y_));
+		emit_event("y_histogram", histogram_event(hist_y_, bins_));
+	}
+
+	uint64_t clipped = 0;
+	if (limited_range_) {
+		clipped += count_range(hist_y_, 0, 16) + count_range(hist_y_, 236, 256);
+		clipped += count_range(hist_u_, 0, 16) + count_range(hist_u_, 241, 256);
+		clipped += count_range(hist_v_, 0, 16) + count_range(hist_v_, 241, 256);
+	} else {
+		clipped += hist_y_[0] + hist_y_[255] + hist_u_[0] + hist_u_[255] + hist_v_[0] + hist_v_[255];
+	}
+	const auto total = y_count + count_samples(hist_u_) + count_samples(hist_v_);
+
+	if (count_samples(hist_u_)) {
+		emit_event("u_mean", histogram_mean(hist_u_));
+		emit_event("v_mean", histogram_mean(hist_v_));
+		emit_event("u_histogram", histogram_event(hist_u_, bins_));
+		emit_event("v_histogram", histogram_event(hist_v_, bins_));
+	}
+	emit_event("clipped", clipped);
+	emit_event("clipped_ratio", total ? static_cast<double>(clipped) / total : 0.0);
+	emit_event("black_ratio", frames_ ? black_sum_ / frames_ : 0.0);
+	emit_event("black_frames", black_frames_);
+	emit_event("difference", diff_frames_ ? diff_sum_ / diff_frames_ : 0.0);
+	emit_event("frames", frames_);
+}
+
+core::pFrame FrameStats::do_special_single_step(core::pRawVideoFrame frame)
+{
+	if (analyze_frame(frame)) {
+		if (++frames_ >= interval_) {
+			emit_statistics();
+			reset_statistics();
+		}
+	}
+	return frame;
+}
+
+bool FrameStats::set_param(const core::Parameter& param)
+{
+	if (assign_parameters(param)
+			(interval_, "interval")
+			(step_x_, "step_x")
+			(step_y_, "step_y")
+			(bins_, "bins")
+			(black_level_, "black_level", [](const core::Parameter& p)
+					{ return static_cast<uint8_t>(std::min(std::max(p.get<int>(), 0), 255)); })
+			(black_amount_, "black_amount")
+			(freeze_threshold_, "freeze_threshold")
+			(freeze_frames_, "freeze_frames")
+			(limited_range_, "limited_range"))
+		return true;
+	return base_type::set_param(param);
+}
+
+} /* namespace frame_stats */
+} /* namespace yuri */
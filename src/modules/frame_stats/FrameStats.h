@@ -0,0 +1,75 @@
+/*!
+ * @file 		FrameStats.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef FRAMESTATS_H_
+#define FRAMESTATS_H_
+
+#include "yuri/core/thread/SpecializedIOFilter.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/event/BasicEventProducer.h"
+#include <array>
+
+namespace yuri {
+namespace frame_stats {
+
+using histogram_t = std::array<uint64_t, 256>;
+using sad_function_t = uint64_t (*)(const uint8_t*, const uint8_t*, size_t);
+
+class FrameStats: public core::SpecializedIOFilter<core::RawVideoFrame>, public event::BasicEventProducer
+{
+	using base_type = core::SpecializedIOFilter<core::RawVideoFrame>;
+public:
+	IOTHREAD_GENERATOR_DECLARATION
+	static core::Parameters configure();
+	FrameStats(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters);
+	virtual ~FrameStats() noexcept;
+private:
+	virtual core::pFrame do_special_single_step(core::pRawVideoFrame frame) override;
+	virtual bool set_param(const core::Parameter& param) override;
+
+	bool analyze_frame(const core::pRawVideoFrame& frame);
+	void emit_statistics();
+	void reset_statistics();
+
+	size_t			interval_;
+	dimension_t		step_x_;
+	dimension_t		step_y_;
+	size_t			bins_;
+	uint8_t			black_level_;
+	double			black_amount_;
+	double			freeze_threshold_;
+	size_t			freeze_frames_;
+	bool			limited_range_;
+
+	sad_function_t	sad_;
+
+	//! Subsampled luma of the current and previous frame
+	std::vector<uint8_t>	luma_;
+	std::vector<uint8_t>	last_luma_;
+	std::vector<uint8_t>	chroma_u_;
+	std::vector<uint8_t>	chroma_v_;
+
+	//! Statistics accumulated over current interval
+	histogram_t		hist_y_;
+	histogram_t		hist_u_;
+	histogram_t		hist_v_;
+	size_t			frames_;
+	size_t			black_frames_;
+	size_t			diff_frames_;
+	double			black_sum_;
+	double			diff_sum_;
+
+	bool			black_;
+	bool			frozen_;
+	size_t			still_frames_;
+};
+
+} /* namespace frame_stats */
+} /* namespace yuri */
+#endif /* FRAMESTATS_H_ */
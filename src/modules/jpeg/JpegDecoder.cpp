@@ -28,21 +28,13 @@ core::Parameters JpegDecoder::configure()
 	p.set_description("JpegDecoder");
 	p["format"]["Output format"]="RGB24";
 	p["fast"]["Faster decoding with slightly worse quality"]=false;
+	p["resolution"]["Smallest resolution needed. The image is downscaled by 1/2, 1/4 or 1/8 while decoding, as long as it stays at least this large. 0x0 decodes full resolution."]=resolution_t{0, 0};
 	return p;
 }
 
-namespace {
-
-void error_exit(jpeg_common_struct* /*cinfo*/)
-{
-	throw std::runtime_error("Error");
-}
-}
-
-
 JpegDecoder::JpegDecoder(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters)
 :core::SpecializedIOFilter<core::CompressedVideoFrame>(log_, parent, std::string("jpeg_decoder")),
- fast_(false),output_format_(core::raw_format::rgb24)
+ fast_(false),output_format_(core::raw_format::rgb24),resolution_{0, 0}
 {
 	IOTHREAD_INIT(parameters)
 }
@@ -69,91 +61,17 @@ core::pFrame JpegDecoder::do_special_single_step(core::pCompressedVideoFrame fra
 		return {};
 	}
 
-	std::unique_ptr<jpeg_decompress_struct, std::function<void(jpeg_decompress_struct*)>> cinfox
-			(new jpeg_decompress_struct,[](jpeg_decompress_struct* cinfo){
-		jpeg_destroy_decompress(cinfo);
-		delete cinfo;
-	});
-
-	// Pointer to decompress info owned by cinfox
-	// It' not neccessary, but it makes the code more eclipse friendly and it costs nothing.
-	jpeg_decompress_struct* const cinfo = cinfox.get();
-	try{
-		cinfo->client_data=reinterpret_cast<void*>(this);
-		struct jpeg_error_mgr jerr;
-		cinfo->err = jpeg_std_error(&jerr);
-		cinfo->err->error_exit=error_exit;
-
-		jpeg_create_decompress(cinfo);
-
-		jpeg_mem_src(cinfo, frame->data(), static_cast<unsigned long>(frame->size()));
-
-
-		if (jpeg_read_header(cinfo,true)!=JPEG_HEADER_OK) {
-			log[log::warning] << "Unrecognized file header!!";
-			return {};
-		}
-
-		cinfo->out_color_space = yuri_to_jpeg(output_format_);
-		if (cinfo->out_color_space == JCS_UNKNOWN) {
-			log[log::error] << "Unsupported color space";
+	try {
+		auto out_frame = decompressor_.decode(frame->data(), frame->size(), output_format_, resolution_, fast_);
+		if (!out_frame) {
+			log[log::warning] << "Failed to decode image into " << core::raw_format::get_format_name(output_format_);
 			return {};
 		}
-		cinfo->dct_method = JDCT_FLOAT;
-		if (fast_) {
-			cinfo->do_fancy_upsampling= false;
-			cinfo->do_block_smoothing = false;
-		}
-		jpeg_start_decompress(cinfo);
-
-
-		resolution_t res = {cinfo->image_width, cinfo->image_height};
-		core::pRawVideoFrame out_frame = core::RawVideoFrame::create_empty(output_format_, res);
 		out_frame->copy_video_params(*frame);
-		size_t out_linesize = PLANE_DATA(out_frame, 0).get_line_size();
-		size_t planes = 1; // Only 1 plane supported
-
-		std::vector<std::vector<JSAMPROW> > row_pointers(planes);
-		for (size_t p=0;p<planes;++p) {
-			size_t plane_height = res.height * cinfo->comp_info[p].h_samp_factor/cinfo->comp_info[0].h_samp_factor;
-			row_pointers[p].resize(plane_height);
-			auto ls = out_linesize*cinfo->comp_info[p].v_samp_factor/cinfo->comp_info[0].v_samp_factor;
-			for (size_t h = 0; h < plane_height; ++h) {
-				row_pointers[p][h]=PLANE_RAW_DATA(out_frame,p) + h*ls;
-			}
-		}
-		std::vector<JSAMPARRAY> arrays_pointers(planes);
-		for (size_t p=0;p<planes;++p) {
-			arrays_pointers[p]=&(row_pointers[p][0]);
-		}
-		yuri::size_t processed=0;
-
-		while (cinfo->output_scanline < cinfo->image_height) {
-			/*if (!raw_)*/ processed = jpeg_read_scanlines(cinfo, &row_pointers[0][cinfo->output_scanline], static_cast<JDIMENSION>(res.height - cinfo->output_scanline));
-	//		else {
-	//			log[log::info] << "processing raw line " << cinfo.output_scanline;
-	//			//JSAMPARRAY arr_pointer = &row_pointers[0];
-	//			for (int p=0;p<planes;++p) {
-	//				size_t off = cinfo.output_scanline*cinfo.comp_info[p].v_samp_factor/cinfo.comp_info[0].v_samp_factor;
-	//				arrays_pointers[p]=&row_pointers[p][off];
-	//				log[log::info] << p<< " Setting ptr at offset " << std::distance(row_pointers[p][0],row_pointers[p][off]);
-	//			}
-	//			JSAMPIMAGE img = &arrays_pointers[0];
-	//			processed = jpeg_read_raw_data(&cinfo, img, height-cinfo.output_scanline);
-	//			log[log::info] << "processed " << processed;
-	//		}
-
-			if (!processed) {
-				log[log::error] << "No lines processed ... corrupted file?";
-				return {};
-			}
-		}
-
-		jpeg_finish_decompress(cinfo);
 		return out_frame;
 	}
-	catch (std::runtime_error& ) {
-		log[log::warning] << "Decoding failed";
+	catch (std::runtime_error& e) {
+		log[log::warning] << "Decoding failed: " << e.what();
 	}
 	return {};
 }
@@ -162,7 +80,8 @@ bool JpegDecoder::set_param(const core::Parameter& param)
 {
 	if (assign_parameters(param)
 			(output_format_, "format", [](const core::Parameter&p){ return core::raw_format::parse_format(p.get<std::string>()); })
-			(fast_, "fast"))
+			(fast_, "fast")
+			(resolution_, "resolution"))
 		return true;
 	return core::SpecializedIOFilter<core::CompressedVideoFrame>::set_param(param);
 }
@@ -13,6 +13,7 @@
 #include "yuri/core/thread/SpecializedIOFilter.h"
 #include "yuri/core/frame/CompressedVideoFrame.h"
 #include "yuri/core/thread/ConverterThread.h"
+#include "jpeg_decompressor.h"
 
 
 namespace yuri {
@@ -33,6 +34,8 @@ private:
 
 	bool fast_;
 	format_t output_format_;
+	resolution_t resolution_;
+	jpeg_decompressor_t decompressor_;
 };
 
 } /* namespace jpeg */
@@ -13,6 +13,8 @@
 #include "yuri/core/frame/compressed_frame_types.h"
 #include "yuri/core/utils/assign_events.h"
 #include "jpeg_common.h"
+#include <algorithm>
+#include <future>
 namespace yuri {
 namespace jpeg {
 
@@ -25,96 +27,162 @@ core::Parameters JpegEncoder::configure()
 	p.set_description("JpegEncoder");
 	p["quality"]["Jpeg quality"]=90;
 	p["force_mjpeg"]["Force MJPEG format"]=false;
+	p["threads"]["Number of threads encoding each frame. With more than one thread, the image is split into stripes separated by restart markers."]=1;
 	return p;
 }
-namespace {
-
-void error_exit(jpeg_common_struct* /*cinfo*/)
-{
-	throw std::runtime_error("Error");
-}
-
-}
-
 JpegEncoder::JpegEncoder(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
 core::SpecializedIOFilter<core::RawVideoFrame>(log_,parent,std::string("jpeg_encoder")),
 BasicEventConsumer(log),
-quality_(90),force_mjpeg_(false)
+quality_(90),force_mjpeg_(false),threads_(1),stripes_valid_(false),stripes_quality_(0),mcu_height_(0)
 {
 	IOTHREAD_INIT(parameters)
+	if (!threads_) threads_ = 1;
     log[log::info] << "sf: " << get_jpeg_supported_formats().size();
-	set_supported_formats(get_jpeg_supported_formats());
+	auto formats = get_jpeg_supported_formats();
+	const auto raw_formats = get_jpeg_raw_formats();
+	formats.insert(formats.end(), raw_formats.begin(), raw_formats.end());
+	set_supported_formats(formats);
 }
 
 JpegEncoder::~JpegEncoder() noexcept
 {
 }
 
-core::pFrame JpegEncoder::do_special_single_step(core::pRawVideoFrame frame)
+bool JpegEncoder::encode(const core::pRawVideoFrame& frame, dimension_t first_line, dimension_t lines, bool restart, jpeg_output_t& buffer)
 {
-	process_events();
-	std::unique_ptr<jpeg_compress_struct, std::function<void(jpeg_compress_struct*)>> cinfox(
-			new jpeg_compress_struct, [](jpeg_compress_struct* ptr)
-			{
-				jpeg_destroy_compress(ptr);
-				delete ptr;
-			});
-	jpeg_compress_struct* cinfo = cinfox.get();
-	cinfo->client_data=reinterpret_cast<void*>(this);
-	struct jpeg_error_mgr jerr;
-	cinfo->err = jpeg_std_error(&jerr);
-	cinfo->err->error_exit=error_exit;
-	try {
-		jpeg_create_compress(cinfo);
+	if (!compressor_.encode(frame, first_line, lines, static_cast<int>(quality_), restart, buffer)) {
+		log[log::warning] << "Unsupported format";
+		return false;
+	}
+	mcu_height_ = compressor_.get_mcu_height();
+	log[log::verbose_debug] << "Buffer is now " << buffer.size() << " bytes long";
+	return true;
+}
 
-		format_t fmt = frame->get_format();
-		J_COLOR_SPACE cs = yuri_to_jpeg(fmt);
-		if (cs == JCS_UNKNOWN) {
-			log[log::warning] << "Unsupported format";
-			return {};
-		}
+bool JpegEncoder::encode_rows(const core::pRawVideoFrame& frame, size_t first_row, size_t end_row)
+{
+	const auto res = frame->get_resolution();
+	const int quality = static_cast<int>(quality_);
+	const size_t count = std::min(threads_, end_row - first_row);
+	while (bands_.size() < count) {
+		bands_.push_back(std::make_unique<band_encoder_t>());
+	}
 
-		uint8_t *buffer = nullptr;
-		unsigned long buffer_size = 0;
-		// Jpeg_mem_dest allocated buffer and it WILL BE LEAKED when an exception occurs...
-		jpeg_mem_dest(cinfo, &buffer, &buffer_size);
-		const auto& fi = core::raw_format::get_format_info(fmt);
-//		size_t bpp = core::raw_format::get_fmt_bpp(fmt)/8;
-		resolution_t res = frame->get_resolution();
-		cinfo->image_width = static_cast<JDIMENSION>(res.width);
-		cinfo->image_height = static_cast<JDIMENSION>(res.height);
-
-		// This is probably not correct for all formats, but it should work for all formats supported here.
-		cinfo->input_components = static_cast<int>(fi.planes[0].components.size());
-		cinfo->in_color_space = cs;
-
-		jpeg_set_defaults(cinfo);
-		jpeg_set_quality(cinfo, static_cast<int>(quality_), true);
-		jpeg_start_compress(cinfo, true);
-
-		uint8_t* data = PLANE_RAW_DATA(frame,0);
-		size_t line_size = PLANE_DATA(frame,0).get_line_size();
-		JSAMPROW row_pointer;
-
-		while (cinfo->next_scanline < cinfo->image_height) {
-			row_pointer = reinterpret_cast<JSAMPROW>(data+cinfo->next_scanline*line_size);
-			jpeg_write_scanlines(cinfo, &row_pointer, 1);
+	// Rows are encoded as standalone images of the same width,
+	// with restart markers their segments are identical to those of the whole image.
+	auto encode_band = [&frame, &res, quality, this](band_encoder_t& band, size_t row, size_t end) {
+		const dimension_t first_line = row * mcu_height_;
+		const dimension_t lines = std::min<dimension_t>(end * mcu_height_, res.height) - first_line;
+		return band.compressor.encode(frame, first_line, lines, quality, true, band.buffer) &&
+				split_jpeg(band.buffer.data(), band.buffer.size(), band.stripes) &&
+				band.stripes.segments.size() == end - row;
+	};
+
+	const size_t band_rows = (end_row - first_row) / count;
+	std::vector<size_t> starts(count + 1, end_row);
+	for (size_t i = 0; i < count; ++i) {
+		starts[i] = first_row + i * band_rows;
+	}
+	std::vector<std::future<bool>> results(count);
+	for (size_t i = 1; i < count; ++i) {
+		results[i] = std::async(std::launch::async, encode_band, std::ref(*bands_[i]), starts[i], starts[i + 1]);
+	}
+	bool valid = encode_band(*bands_[0], starts[0], starts[1]);
+	for (size_t i = 1; i < count; ++i) {
+		// All results have to be collected before the bands can be used again
+		valid = results[i].get() && valid;
+	}
+	if (!valid) return false;
+
+	if (first_row == 0) {
+		stripes_.header = std::move(bands_[0]->stripes.header);
+		if (!set_jpeg_height(stripes_.header, res.height)) return false;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		auto& segments = bands_[i]->stripes.segments;
+		std::move(segments.begin(), segments.end(), stripes_.segments.begin() + starts[i]);
+	}
+	return true;
+}
+
+bool JpegEncoder::encode_stripes(const core::pRawVideoFrame& frame)
+{
+	const auto res = frame->get_resolution();
+	mcu_height_ = compressor_.get_mcu_height(frame->get_format());
+	if (!mcu_height_) {
+		log[log::warning] << "Unsupported format";
+		return false;
+	}
+	stripes_.segments.resize((res.height + mcu_height_ - 1) / mcu_height_);
+	if (!encode_rows(frame, 0, stripes_.segments.size())) {
+		log[log::warning] << "Failed to encode image as stripes";
+		return false;
+	}
+	return true;
+}
+
+bool JpegEncoder::update_stripes(const core::pRawVideoFrame& frame)
+{
+	const auto res = frame->get_resolution();
+	std::vector<bool> dirty(stripes_.segments.size(), false);
+	for (const auto& rect: core::simplify_damage(frame->get_damage(), res)) {
+		const size_t last = std::min<size_t>((geometry_max_y(rect) - 1) / mcu_height_, dirty.size() - 1);
+		for (size_t row = rect.y / mcu_height_; row <= last; ++row) {
+			dirty[row] = true;
 		}
-		jpeg_finish_compress(cinfo);
+	}
+	for (size_t row = 0; row < dirty.size();) {
+		if (!dirty[row]) {
+			++row;
+			continue;
+		}
+		size_t end = row + 1;
+		while (end < dirty.size() && dirty[end]) ++end;
+		if (!encode_rows(frame, row, end)) return false;
+		row = end;
+	}
+	return true;
+}
 
-		log[log::verbose_debug] << "Buffer is now " << buffer_size << " bytes long";
-		auto out_fmt = force_mjpeg_?core::compressed_frame::mjpg:core::compressed_frame::jpeg;
-		if (buffer_size) {
-			auto outframe = core::CompressedVideoFrame::create_empty(out_fmt, res, buffer, buffer_size);
+core::pFrame JpegEncoder::do_special_single_step(core::pRawVideoFrame frame)
+{
+	process_events();
+	const resolution_t res = frame->get_resolution();
+	const auto out_fmt = force_mjpeg_?core::compressed_frame::mjpg:core::compressed_frame::jpeg;
+	try {
+		if (!frame->has_damage() && threads_ < 2) {
+			stripes_valid_ = false;
+			// The image is encoded directly into a new buffer that is then passed to the frame
+			jpeg_output_t buffer;
+			if (!encode(frame, 0, res.height, false, buffer)) return {};
+			auto outframe = core::CompressedVideoFrame::create_empty(out_fmt, res, std::move(buffer));
 			outframe->copy_video_params(*frame);
-			::free(buffer);
 			return outframe;
 		}
-		::free(buffer);
 
+		// Frames with damage info are encoded with restart marker after every MCU row,
+		// so only the damaged rows have to be encoded for following frames.
+		// Frames without damage info get here only when encoded by several threads,
+		// each of them encoding a band of MCU rows into its own segments.
+		bool valid = stripes_valid_ && stripes_quality_ == quality_ && damage_tracker_.follows(*frame) &&
+				update_stripes(frame);
+		if (!valid) {
+			valid = encode_stripes(frame);
+		}
+		stripes_valid_ = valid && frame->has_damage();
+		stripes_quality_ = quality_;
+		if (stripes_valid_) damage_tracker_.update(*frame);
+		if (!valid) return {};
+
+		auto outframe = core::CompressedVideoFrame::create_empty(out_fmt, res, get_joined_size(stripes_));
+		join_jpeg(stripes_, outframe->data());
+		outframe->copy_video_params(*frame);
+		outframe->copy_damage(*frame);
+		return outframe;
 	}
-	catch (std::runtime_error& ) {
-		log[log::error] << "Failed to encode frame";
+	catch (std::runtime_error& e) {
+		stripes_valid_ = false;
+		log[log::error] << "Failed to encode frame: " << e.what();
 	}
 	return {};
 }
@@ -129,7 +197,8 @@ bool JpegEncoder::set_param(const core::Parameter& param)
 {
 	if (assign_parameters(param)
 			(quality_, "quality")
-			(force_mjpeg_, "force_mjpeg"))
+			(force_mjpeg_, "force_mjpeg")
+			(threads_, "threads"))
 		return true;
 	return core::SpecializedIOFilter<core::RawVideoFrame>::set_param(param);
 }
@@ -138,7 +207,8 @@ bool JpegEncoder::do_process_event(const std::string& event_name, const event::p
 {
 	if (assign_events(event_name, event)
 			.ranged(quality_, 0, 100, "quality")
-			(force_mjpeg_, "force_mjpeg"))
+			(force_mjpeg_, "force_mjpeg")
+			.ranged(threads_, 1, 256, "threads"))
 		return true;
 	return false;
 }
@@ -16,6 +16,10 @@
 #include "yuri/core/thread/Convert.h"
 #include "yuri/core/frame/raw_frame_types.h"
 #include "yuri/event/BasicEventConsumer.h"
+#include "yuri/core/frame/damage.h"
+#include "jpeg_stripes.h"
+#include "jpeg_compressor.h"
+#include <memory>
 namespace yuri {
 namespace jpeg {
 
@@ -34,8 +38,41 @@ private:
 	virtual core::pFrame do_convert_frame(core::pFrame input_frame, format_t target_format) override;
 	virtual bool set_param(const core::Parameter& param) override;
 	virtual bool do_process_event(const std::string& event_name, const event::pBasicEvent& event) override;
+	/*!
+	 * Encodes @em lines lines of the frame, starting at @em first_line, as a standalone image
+	 * @param restart Insert restart marker after every MCU row
+	 */
+	bool encode(const core::pRawVideoFrame& frame, dimension_t first_line, dimension_t lines, bool restart, jpeg_output_t& buffer);
+	/*!
+	 * Encodes MCU rows [first_row, end_row) of the frame into stripes_,
+	 * splitting them into bands encoded concurrently by up to threads_ threads.
+	 * When starting at the first row, header of stripes_ is updated too.
+	 */
+	bool encode_rows(const core::pRawVideoFrame& frame, size_t first_row, size_t end_row);
+	//! Encodes whole frame into stripes_
+	bool encode_stripes(const core::pRawVideoFrame& frame);
+	//! Encodes damaged MCU rows of the frame and replaces them in stripes_
+	bool update_stripes(const core::pRawVideoFrame& frame);
 	size_t quality_;
 	bool force_mjpeg_;
+	size_t threads_;
+
+	jpeg_compressor_t compressor_;
+
+	//! State for encoding one band of MCU rows, kept between frames
+	struct band_encoder_t {
+		jpeg_compressor_t compressor;
+		jpeg_output_t buffer;
+		jpeg_stripes_t stripes;
+	};
+	std::vector<std::unique_ptr<band_encoder_t>> bands_;
+
+	//! Last encoded image, split at MCU rows
+	jpeg_stripes_t stripes_;
+	bool stripes_valid_;
+	size_t stripes_quality_;
+	dimension_t mcu_height_;
+	core::DamageTracker damage_tracker_;
 };
 
 } /* namespace jpeg */
@@ -7,6 +7,7 @@
 
 #include "jpeg_common.h"
 #include "yuri/core/frame/raw_frame_types.h"
+#include <stdexcept>
 #include <unordered_map>
 
 
@@ -48,6 +49,12 @@ std::unordered_map<J_COLOR_SPACE, format_t> jpeg_to_yuri_formats = {
 		{JCS_YCbCr,			yuv444},
 };
 
+const jpeg_raw_sampling_t raw_samplings[] = {
+		{yuv420p, 2, 2},
+		{yuv422p, 2, 1},
+		{yuv444p, 1, 1},
+};
+
 
 }
 
@@ -74,6 +81,34 @@ std::vector<format_t> get_jpeg_supported_formats()
 	}
 	return fmts;
 }
+
+void throw_jpeg_error(j_common_ptr cinfo)
+{
+	char message[JMSG_LENGTH_MAX];
+	cinfo->err->format_message(cinfo, message);
+	throw std::runtime_error(message);
+}
+
+void ignore_jpeg_message(j_common_ptr)
+{
+}
+
+std::vector<format_t> get_jpeg_raw_formats()
+{
+	std::vector<format_t> fmts;
+	for (const auto& s: raw_samplings) {
+		fmts.push_back(s.format);
+	}
+	return fmts;
+}
+
+const jpeg_raw_sampling_t* get_jpeg_raw_sampling(format_t fmt)
+{
+	for (const auto& s: raw_samplings) {
+		if (s.format == fmt) return &s;
+	}
+	return nullptr;
+}
 }
 }
 
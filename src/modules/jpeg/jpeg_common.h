@@ -16,6 +16,26 @@ namespace jpeg {
 format_t jpeg_to_yuri(J_COLOR_SPACE colspace);
 J_COLOR_SPACE  yuri_to_jpeg(format_t fmt);
 std::vector<format_t> get_jpeg_supported_formats();
+
+//! libjpeg error handler throwing std::runtime_error with the libjpeg message
+void throw_jpeg_error(j_common_ptr cinfo);
+//! libjpeg message handler ignoring warnings
+void ignore_jpeg_message(j_common_ptr cinfo);
+
+//! Sampling factors of luma plane for planar YUV formats, chroma planes have factors 1x1
+struct jpeg_raw_sampling_t {
+	format_t format;
+	int h_samp;
+	int v_samp;
+};
+
+/*!
+ * Planar YUV formats that are passed to/from libjpeg as raw (downsampled) data,
+ * skipping its colour conversion and resampling.
+ */
+std::vector<format_t> get_jpeg_raw_formats();
+//! Returns sampling for a raw format, or nullptr for other formats
+const jpeg_raw_sampling_t* get_jpeg_raw_sampling(format_t fmt);
 }
 }
 
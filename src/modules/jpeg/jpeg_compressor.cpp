@@ -0,0 +1,248 @@
+/*!
+ * @file 		jpeg_compressor.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "jpeg_compressor.h"
+#include "jpeg_common.h"
+#include "yuri/core/frame/raw_frame_params.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace yuri {
+namespace jpeg {
+
+namespace {
+
+//! Initial size of output buffer, when there's no previous image to estimate the size from
+const size_t min_output_size = 64 * 1024;
+
+jpeg_output_destination_t& get_destination(j_compress_ptr cinfo)
+{
+	return *reinterpret_cast<jpeg_output_destination_t*>(cinfo->dest);
+}
+
+void init_destination(j_compress_ptr cinfo)
+{
+	auto& dest = get_destination(cinfo);
+	auto& buffer = *dest.buffer;
+	buffer.resize(std::max(buffer.capacity(), dest.size_hint));
+	dest.mgr.next_output_byte = buffer.data();
+	dest.mgr.free_in_buffer = buffer.size();
+}
+
+boolean empty_output_buffer(j_compress_ptr cinfo)
+{
+	// Whole buffer is full, so it's grown while keeping the data already written
+	auto& dest = get_destination(cinfo);
+	auto& buffer = *dest.buffer;
+	const size_t used = buffer.size();
+	buffer.resize(used * 2);
+	dest.mgr.next_output_byte = buffer.data() + used;
+	dest.mgr.free_in_buffer = buffer.size() - used;
+	return TRUE;
+}
+
+void term_destination(j_compress_ptr cinfo)
+{
+	auto& dest = get_destination(cinfo);
+	auto& buffer = *dest.buffer;
+	buffer.resize(buffer.size() - dest.mgr.free_in_buffer);
+	dest.size_hint = std::max(min_output_size, buffer.size() + buffer.size() / 8);
+}
+
+}
+
+jpeg_compressor_t::jpeg_compressor_t():mcu_height_(DCTSIZE)
+{
+	cinfo_.err = jpeg_std_error(&jerr_);
+	jerr_.error_exit = throw_jpeg_error;
+	jerr_.output_message = ignore_jpeg_message;
+	jpeg_create_compress(&cinfo_);
+
+	dest_.mgr.init_destination = init_destination;
+	dest_.mgr.empty_output_buffer = empty_output_buffer;
+	dest_.mgr.term_destination = term_destination;
+	dest_.buffer = nullptr;
+	dest_.size_hint = min_output_size;
+	cinfo_.dest = &dest_.mgr;
+}
+
+jpeg_compressor_t::~jpeg_compressor_t() noexcept
+{
+	jpeg_destroy_compress(&cinfo_);
+}
+
+bool jpeg_compressor_t::encode(const core::pRawVideoFrame& frame, dimension_t first_line, dimension_t lines,
+		int quality, bool restart, jpeg_output_t& buffer)
+{
+	const format_t fmt = frame->get_format();
+	const bool raw = get_jpeg_raw_sampling(fmt) != nullptr;
+	dest_.buffer = &buffer;
+	try {
+		if (!configure(fmt, frame->get_width(), lines, quality, restart)) {
+			dest_.buffer = nullptr;
+			return false;
+		}
+		jpeg_start_compress(&cinfo_, TRUE);
+		if (raw) {
+			write_raw_data(frame, first_line, lines);
+		} else {
+			write_scanlines(frame, first_line);
+		}
+		jpeg_finish_compress(&cinfo_);
+	}
+	catch (std::runtime_error&) {
+		// Resets the compressor, so it can be used for next image
+		jpeg_abort_compress(&cinfo_);
+		dest_.buffer = nullptr;
+		throw;
+	}
+	dest_.buffer = nullptr;
+	return !buffer.empty();
+}
+
+dimension_t jpeg_compressor_t::get_mcu_height(format_t fmt)
+{
+	try {
+		if (!configure(fmt, DCTSIZE, DCTSIZE, 75, false)) return 0;
+	}
+	catch (std::runtime_error&) {
+		jpeg_abort_compress(&cinfo_);
+		return 0;
+	}
+	return mcu_height_;
+}
+
+bool jpeg_compressor_t::configure(format_t fmt, dimension_t width, dimension_t lines, int quality, bool restart)
+{
+	const jpeg_raw_sampling_t* sampling = get_jpeg_raw_sampling(fmt);
+	const J_COLOR_SPACE cs = sampling ? JCS_YCbCr : yuri_to_jpeg(fmt);
+	if (cs == JCS_UNKNOWN) return false;
+
+	cinfo_.image_width = static_cast<JDIMENSION>(width);
+	cinfo_.image_height = static_cast<JDIMENSION>(lines);
+	// This is probably not correct for all formats, but it should work for all formats supported here.
+	cinfo_.input_components = sampling ? 3 :
+			static_cast<int>(core::raw_format::get_format_info(fmt).planes[0].components.size());
+	cinfo_.in_color_space = cs;
+
+	jpeg_set_defaults(&cinfo_);
+	jpeg_set_quality(&cinfo_, quality, TRUE);
+	cinfo_.raw_data_in = sampling ? TRUE : FALSE;
+	if (sampling) {
+		cinfo_.comp_info[0].h_samp_factor = sampling->h_samp;
+		cinfo_.comp_info[0].v_samp_factor = sampling->v_samp;
+		for (int i = 1; i < 3; ++i) {
+			cinfo_.comp_info[i].h_samp_factor = 1;
+			cinfo_.comp_info[i].v_samp_factor = 1;
+		}
+#if JPEG_LIB_VERSION >= 70
+		cinfo_.do_fancy_downsampling = FALSE;
+#endif
+	}
+	int max_v_samp = 1;
+	for (int i = 0; i < cinfo_.num_components; ++i) {
+		max_v_samp = std::max(max_v_samp, cinfo_.comp_info[i].v_samp_factor);
+	}
+	mcu_height_ = DCTSIZE * max_v_samp;
+	cinfo_.restart_in_rows = restart ? 1 : 0;
+	return true;
+}
+
+void jpeg_compressor_t::write_scanlines(const core::pRawVideoFrame& frame, dimension_t first_line)
+{
+	const auto& plane = PLANE_DATA(frame, 0);
+	const size_t line_size = plane.get_line_size();
+	auto data = const_cast<uint8_t*>(plane.data()) + first_line * line_size;
+	rows_.resize(cinfo_.image_height);
+	for (JDIMENSION i = 0; i < cinfo_.image_height; ++i) {
+		rows_[i] = data + i * line_size;
+	}
+	while (cinfo_.next_scanline < cinfo_.image_height) {
+		jpeg_write_scanlines(&cinfo_, &rows_[cinfo_.next_scanline], cinfo_.image_height - cinfo_.next_scanline);
+	}
+}
+
+void jpeg_compressor_t::write_raw_data(const core::pRawVideoFrame& frame, dimension_t first_line, dimension_t lines)
+{
+	const int max_h_samp = cinfo_.comp_info[0].h_samp_factor;
+	const int max_v_samp = cinfo_.comp_info[0].v_samp_factor;
+	const JDIMENSION mcu_width = DCTSIZE * max_h_samp;
+	const JDIMENSION mcus_per_row = (cinfo_.image_width + mcu_width - 1) / mcu_width;
+
+	// libjpeg reads whole MCUs, so rows shorter than that have to be padded
+	// and lines past the end of the image are replaced by the last line.
+	struct component_t {
+		const uint8_t* data;
+		size_t line_size;
+		size_t width;
+		size_t padded_width;
+		size_t rows;
+		dimension_t first;
+		dimension_t last;
+		JSAMPARRAY row_pointers;
+		uint8_t* padded;
+	};
+	component_t comps[3];
+	bool padding = false;
+	size_t total_rows = 0;
+	size_t padded_size = 0;
+	for (int c = 0; c < 3; ++c) {
+		const auto& plane = PLANE_DATA(frame, c);
+		const int h_samp = cinfo_.comp_info[c].h_samp_factor;
+		const int v_samp = cinfo_.comp_info[c].v_samp_factor;
+		auto& comp = comps[c];
+		comp.data = plane.data();
+		comp.line_size = plane.get_line_size();
+		comp.width = plane.get_resolution().width;
+		comp.padded_width = mcus_per_row * h_samp * DCTSIZE;
+		comp.rows = DCTSIZE * v_samp;
+		comp.first = first_line * v_samp / max_v_samp;
+		const dimension_t comp_lines = (lines * v_samp + max_v_samp - 1) / max_v_samp;
+		comp.last = std::min<dimension_t>(comp.first + comp_lines, plane.get_resolution().height) - 1;
+		padding = padding || comp.padded_width > comp.line_size;
+		total_rows += comp.rows;
+		padded_size += comp.rows * comp.padded_width;
+	}
+
+	rows_.resize(total_rows);
+	if (padding) {
+		padded_rows_.resize(padded_size);
+	}
+	size_t row_offset = 0;
+	size_t padded_offset = 0;
+	for (auto& comp: comps) {
+		comp.row_pointers = &rows_[row_offset];
+		comp.padded = padding ? &padded_rows_[padded_offset] : nullptr;
+		row_offset += comp.rows;
+		padded_offset += comp.rows * comp.padded_width;
+	}
+
+	JSAMPARRAY planes[3] = {comps[0].row_pointers, comps[1].row_pointers, comps[2].row_pointers};
+	while (cinfo_.next_scanline < cinfo_.image_height) {
+		const dimension_t mcu_row = cinfo_.next_scanline / (DCTSIZE * max_v_samp);
+		for (auto& comp: comps) {
+			for (size_t i = 0; i < comp.rows; ++i) {
+				const dimension_t line = std::min<dimension_t>(comp.first + mcu_row * comp.rows + i, comp.last);
+				const uint8_t* src = comp.data + line * comp.line_size;
+				if (comp.padded) {
+					uint8_t* dest = comp.padded + i * comp.padded_width;
+					std::copy(src, src + comp.width, dest);
+					std::fill(dest + comp.width, dest + comp.padded_width, comp.width ? src[comp.width - 1] : 0);
+					comp.row_pointers[i] = dest;
+				} else {
+					comp.row_pointers[i] = const_cast<uint8_t*>(src);
+				}
+			}
+		}
+		jpeg_write_raw_data(&cinfo_, planes, DCTSIZE * max_v_samp);
+	}
+}
+
+}
+}
@@ -0,0 +1,82 @@
+/*!
+ * @file 		jpeg_compressor.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Reusable libjpeg compressor writing directly to frame buffers.
+ */
+
+#ifndef JPEG_COMPRESSOR_H_
+#define JPEG_COMPRESSOR_H_
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/utils/uvector.h"
+#include <cstdio>
+#include <jpeglib.h>
+#include <vector>
+
+namespace yuri {
+namespace jpeg {
+
+using jpeg_output_t = uvector<uint8_t>;
+
+//! libjpeg destination manager writing into jpeg_output_t
+struct jpeg_output_destination_t {
+	jpeg_destination_mgr mgr;
+	jpeg_output_t* buffer;
+	//! Size of the last image, used to preallocate the buffer for the next one
+	size_t size_hint;
+};
+
+/*!
+ * Wrapper around jpeg_compress_struct, that is kept for the whole lifetime of the object,
+ * so the libjpeg state doesn't have to be allocated for every image.
+ */
+class jpeg_compressor_t {
+public:
+	jpeg_compressor_t();
+	~jpeg_compressor_t() noexcept;
+	jpeg_compressor_t(const jpeg_compressor_t&) = delete;
+	jpeg_compressor_t& operator=(const jpeg_compressor_t&) = delete;
+
+	/*!
+	 * Encodes @em lines lines of the frame, starting at @em first_line, as a standalone image.
+	 * @param restart	Insert restart marker after every MCU row
+	 * @param buffer	Output buffer, resized to the size of the encoded image.
+	 * 					If it's too small, it is reallocated to fit size of previous images.
+	 * @return false if the format of the frame is not supported
+	 * @throw std::runtime_error on libjpeg errors
+	 */
+	bool encode(const core::pRawVideoFrame& frame, dimension_t first_line, dimension_t lines,
+			int quality, bool restart, jpeg_output_t& buffer);
+
+	//! Height of MCU row (in lines of the frame) for the last encoded image
+	dimension_t get_mcu_height() const { return mcu_height_; }
+
+	/*!
+	 * Height of MCU row (in lines of the frame) for images in format @em fmt,
+	 * without encoding anything.
+	 * @return 0 if the format is not supported
+	 */
+	dimension_t get_mcu_height(format_t fmt);
+
+private:
+	//! Sets up cinfo_ for an image, without starting the compression
+	bool configure(format_t fmt, dimension_t width, dimension_t lines, int quality, bool restart);
+	void write_scanlines(const core::pRawVideoFrame& frame, dimension_t first_line);
+	void write_raw_data(const core::pRawVideoFrame& frame, dimension_t first_line, dimension_t lines);
+
+	jpeg_compress_struct cinfo_;
+	jpeg_error_mgr jerr_;
+	jpeg_output_destination_t dest_;
+	dimension_t mcu_height_;
+	std::vector<JSAMPROW> rows_;
+	//! Copies of rows extended to full MCU width, used when the planes are narrower
+	std::vector<uint8_t> padded_rows_;
+};
+
+}
+}
+
+#endif /* JPEG_COMPRESSOR_H_ */
@@ -0,0 +1,315 @@
+/*!
+ * @file 		jpeg_decompressor.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "jpeg_decompressor.h"
+#include "yuri/core/frame/raw_frame_params.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace yuri {
+namespace jpeg {
+
+namespace {
+
+// libjpeg 7 introduced separate horizontal and vertical DCT scaling
+int get_dct_width(const jpeg_component_info& comp)
+{
+#if JPEG_LIB_VERSION >= 70
+	return comp.DCT_h_scaled_size;
+#else
+	return comp.DCT_scaled_size;
+#endif
+}
+
+int get_dct_height(const jpeg_component_info& comp)
+{
+#if JPEG_LIB_VERSION >= 70
+	return comp.DCT_v_scaled_size;
+#else
+	return comp.DCT_scaled_size;
+#endif
+}
+
+int get_min_dct_width(const jpeg_decompress_struct& cinfo)
+{
+#if JPEG_LIB_VERSION >= 70
+	return cinfo.min_DCT_h_scaled_size;
+#else
+	return cinfo.min_DCT_scaled_size;
+#endif
+}
+
+int get_min_dct_height(const jpeg_decompress_struct& cinfo)
+{
+#if JPEG_LIB_VERSION >= 70
+	return cinfo.min_DCT_v_scaled_size;
+#else
+	return cinfo.min_DCT_scaled_size;
+#endif
+}
+
+/*!
+ * Returns the largest denominator (up to 8), that keeps the image at least as large as @em min_resolution.
+ * libjpeg rounds the scaled dimensions up.
+ */
+unsigned int get_scale_denom(resolution_t res, resolution_t min_resolution)
+{
+	if (!min_resolution.width && !min_resolution.height) return 1;
+	unsigned int denom = 1;
+	while (denom < 8) {
+		const unsigned int next = denom * 2;
+		if ((res.width + next - 1) / next < min_resolution.width ||
+				(res.height + next - 1) / next < min_resolution.height) break;
+		denom = next;
+	}
+	return denom;
+}
+
+}
+
+jpeg_decompressor_t::jpeg_decompressor_t()
+{
+	cinfo_.err = jpeg_std_error(&jerr_);
+	jerr_.error_exit = throw_jpeg_error;
+	jerr_.output_message = ignore_jpeg_message;
+	jpeg_create_decompress(&cinfo_);
+}
+
+jpeg_decompressor_t::~jpeg_decompressor_t() noexcept
+{
+	jpeg_destroy_decompress(&cinfo_);
+}
+
+core::pRawVideoFrame jpeg_decompressor_t::decode(const uint8_t* data, size_t size, format_t format,
+		resolution_t min_resolution, bool fast)
+{
+	const jpeg_raw_sampling_t* sampling = get_jpeg_raw_sampling(format);
+	const J_COLOR_SPACE cs = sampling ? JCS_YCbCr : yuri_to_jpeg(format);
+	if (cs == JCS_UNKNOWN) return {};
+
+	core::pRawVideoFrame frame;
+	try {
+		jpeg_mem_src(&cinfo_, const_cast<uint8_t*>(data), static_cast<unsigned long>(size));
+		if (jpeg_read_header(&cinfo_, TRUE) != JPEG_HEADER_OK) {
+			jpeg_abort_decompress(&cinfo_);
+			return {};
+		}
+		cinfo_.out_color_space = cs;
+		cinfo_.dct_method = JDCT_FLOAT;
+		if (fast) {
+			cinfo_.do_fancy_upsampling = FALSE;
+			cinfo_.do_block_smoothing = FALSE;
+		}
+		cinfo_.scale_num = 1;
+		cinfo_.scale_denom = get_scale_denom({cinfo_.image_width, cinfo_.image_height}, min_resolution);
+		const bool raw = sampling && raw_compatible(*sampling);
+		cinfo_.raw_data_out = raw ? TRUE : FALSE;
+		jpeg_start_decompress(&cinfo_);
+
+		frame = core::RawVideoFrame::create_empty(format, {cinfo_.output_width, cinfo_.output_height});
+		if (!frame) {
+			jpeg_abort_decompress(&cinfo_);
+			return {};
+		}
+		if (raw) {
+			read_raw_data(frame);
+		} else if (sampling) {
+			read_resampled(frame);
+		} else {
+			read_scanlines(frame);
+		}
+		jpeg_finish_decompress(&cinfo_);
+	}
+	catch (std::runtime_error&) {
+		// Resets the decompressor, so it can be used for next image
+		jpeg_abort_decompress(&cinfo_);
+		throw;
+	}
+	return frame;
+}
+
+bool jpeg_decompressor_t::raw_compatible(const jpeg_raw_sampling_t& sampling) const
+{
+	if (cinfo_.jpeg_color_space != JCS_YCbCr || cinfo_.num_components != 3) return false;
+	if (cinfo_.comp_info[0].h_samp_factor != sampling.h_samp ||
+			cinfo_.comp_info[0].v_samp_factor != sampling.v_samp) return false;
+	for (int c = 1; c < 3; ++c) {
+		if (cinfo_.comp_info[c].h_samp_factor != 1 || cinfo_.comp_info[c].v_samp_factor != 1) return false;
+	}
+	return true;
+}
+
+void jpeg_decompressor_t::read_scanlines(const core::pRawVideoFrame& frame)
+{
+	const size_t line_size = PLANE_DATA(frame, 0).get_line_size();
+	uint8_t* data = PLANE_RAW_DATA(frame, 0);
+	rows_.resize(cinfo_.output_height);
+	for (JDIMENSION i = 0; i < cinfo_.output_height; ++i) {
+		rows_[i] = data + i * line_size;
+	}
+	while (cinfo_.output_scanline < cinfo_.output_height) {
+		if (!jpeg_read_scanlines(&cinfo_, &rows_[cinfo_.output_scanline], cinfo_.output_height - cinfo_.output_scanline)) {
+			throw std::runtime_error("No lines decoded");
+		}
+	}
+}
+
+void jpeg_decompressor_t::read_raw_data(const core::pRawVideoFrame& frame)
+{
+	const JDIMENSION lines = cinfo_.max_v_samp_factor * get_min_dct_height(cinfo_);
+
+	// When the image is scaled, libjpeg may decode chroma at a larger DCT size instead of upsampling it later,
+	// so these components are decoded into scratch rows and reduced to the plane resolution.
+	struct component_t {
+		uint8_t* data;
+		size_t line_size;
+		size_t width;
+		size_t height;
+		size_t padded_width;
+		size_t rows;
+		size_t step_x;
+		size_t step_y;
+		bool direct;
+		JSAMPARRAY row_pointers;
+		uint8_t* scratch;
+	};
+	component_t comps[3];
+	size_t total_rows = 0;
+	size_t scratch_size = 0;
+	for (int c = 0; c < 3; ++c) {
+		const auto& info = cinfo_.comp_info[c];
+		auto& plane = PLANE_DATA(frame, c);
+		auto& comp = comps[c];
+		comp.data = PLANE_RAW_DATA(frame, c);
+		comp.line_size = plane.get_line_size();
+		comp.width = plane.get_resolution().width;
+		comp.height = plane.get_resolution().height;
+		comp.padded_width = info.width_in_blocks * get_dct_width(info);
+		comp.rows = info.v_samp_factor * get_dct_height(info);
+		comp.step_x = get_dct_width(info) / get_min_dct_width(cinfo_);
+		comp.step_y = get_dct_height(info) / get_min_dct_height(cinfo_);
+		comp.direct = comp.step_x == 1 && comp.step_y == 1 && comp.padded_width <= comp.line_size;
+		total_rows += comp.rows;
+		scratch_size += comp.rows * comp.padded_width;
+	}
+	rows_.resize(total_rows);
+	scratch_.resize(scratch_size);
+	size_t row_offset = 0;
+	size_t scratch_offset = 0;
+	for (auto& comp: comps) {
+		comp.row_pointers = &rows_[row_offset];
+		comp.scratch = &scratch_[scratch_offset];
+		row_offset += comp.rows;
+		scratch_offset += comp.rows * comp.padded_width;
+	}
+
+	JSAMPARRAY planes[3] = {comps[0].row_pointers, comps[1].row_pointers, comps[2].row_pointers};
+	while (cinfo_.output_scanline < cinfo_.output_height) {
+		const size_t imcu_row = cinfo_.output_scanline / lines;
+		for (auto& comp: comps) {
+			for (size_t i = 0; i < comp.rows; ++i) {
+				const size_t line = imcu_row * comp.rows + i;
+				comp.row_pointers[i] = (comp.direct && line < comp.height) ?
+						comp.data + line * comp.line_size :
+						comp.scratch + i * comp.padded_width;
+			}
+		}
+		if (!jpeg_read_raw_data(&cinfo_, planes, lines)) {
+			throw std::runtime_error("No lines decoded");
+		}
+		for (auto& comp: comps) {
+			const size_t plane_rows = comp.rows / comp.step_y;
+			for (size_t i = 0; i < plane_rows; ++i) {
+				const size_t line = imcu_row * plane_rows + i;
+				if (line >= comp.height) break;
+				if (comp.direct) continue;
+				uint8_t* dest = comp.data + line * comp.line_size;
+				if (comp.step_x == 1 && comp.step_y == 1) {
+					std::copy(comp.row_pointers[i], comp.row_pointers[i] + comp.width, dest);
+					continue;
+				}
+				if (comp.step_x == 2 && comp.step_y == 2) {
+					const uint8_t* src0 = comp.row_pointers[i * 2];
+					const uint8_t* src1 = comp.row_pointers[i * 2 + 1];
+					for (size_t x = 0; x < comp.width; ++x) {
+						dest[x] = static_cast<uint8_t>((src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2) >> 2);
+					}
+					continue;
+				}
+				const size_t count = comp.step_x * comp.step_y;
+				for (size_t x = 0; x < comp.width; ++x) {
+					size_t sum = count / 2;
+					for (size_t dy = 0; dy < comp.step_y; ++dy) {
+						const uint8_t* src = comp.row_pointers[i * comp.step_y + dy] + x * comp.step_x;
+						for (size_t dx = 0; dx < comp.step_x; ++dx) {
+							sum += src[dx];
+						}
+					}
+					dest[x] = static_cast<uint8_t>(sum / count);
+				}
+			}
+		}
+	}
+}
+
+void jpeg_decompressor_t::read_resampled(const core::pRawVideoFrame& frame)
+{
+	// Image sampling differs from the output format, so it's decoded as packed YCbCr
+	// and chroma is averaged over blocks of the output subsampling.
+	const auto& info = core::raw_format::get_format_info(frame->get_format());
+	const size_t sub_x = info.planes[1].sub_x;
+	const size_t sub_y = info.planes[1].sub_y;
+	const size_t width = cinfo_.output_width;
+	const size_t count = sub_x * sub_y;
+	auto& y_plane = PLANE_DATA(frame, 0);
+	const size_t chroma_width = PLANE_DATA(frame, 1).get_resolution().width;
+	const size_t chroma_height = PLANE_DATA(frame, 1).get_resolution().height;
+
+	scratch_.resize(sub_y * width * 3);
+	rows_.resize(sub_y);
+	for (size_t i = 0; i < sub_y; ++i) {
+		rows_[i] = &scratch_[i * width * 3];
+	}
+	for (size_t line = 0; cinfo_.output_scanline < cinfo_.output_height; ++line) {
+		const JDIMENSION first = cinfo_.output_scanline;
+		size_t read = 0;
+		while (read < sub_y && cinfo_.output_scanline < cinfo_.output_height) {
+			const JDIMENSION processed = jpeg_read_scanlines(&cinfo_, &rows_[read], static_cast<JDIMENSION>(sub_y - read));
+			if (!processed) {
+				throw std::runtime_error("No lines decoded");
+			}
+			read += processed;
+		}
+		for (size_t i = 0; i < read; ++i) {
+			uint8_t* dest = PLANE_RAW_DATA(frame, 0) + (first + i) * y_plane.get_line_size();
+			const uint8_t* src = rows_[i];
+			for (size_t x = 0; x < width; ++x) {
+				dest[x] = src[x * 3];
+			}
+		}
+		// Plane resolution is rounded down, so incomplete blocks at the edges are never needed
+		if (line >= chroma_height) continue;
+		for (int c = 1; c < 3; ++c) {
+			uint8_t* dest = PLANE_RAW_DATA(frame, c) + line * PLANE_DATA(frame, c).get_line_size();
+			for (size_t x = 0; x < chroma_width; ++x) {
+				size_t sum = count / 2;
+				for (size_t dy = 0; dy < sub_y; ++dy) {
+					const uint8_t* src = rows_[dy] + x * sub_x * 3 + c;
+					for (size_t dx = 0; dx < sub_x; ++dx) {
+						sum += src[dx * 3];
+					}
+				}
+				dest[x] = static_cast<uint8_t>(sum / count);
+			}
+		}
+	}
+}
+
+}
+}
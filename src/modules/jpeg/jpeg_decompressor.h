@@ -0,0 +1,65 @@
+/*!
+ * @file 		jpeg_decompressor.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Reusable libjpeg decompressor with DCT scaling and planar output.
+ */
+
+#ifndef JPEG_DECOMPRESSOR_H_
+#define JPEG_DECOMPRESSOR_H_
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "jpeg_common.h"
+#include <cstdio>
+#include <jpeglib.h>
+#include <vector>
+
+namespace yuri {
+namespace jpeg {
+
+/*!
+ * Wrapper around jpeg_decompress_struct, that is kept for the whole lifetime of the object,
+ * so the libjpeg state doesn't have to be allocated for every image.
+ */
+class jpeg_decompressor_t {
+public:
+	jpeg_decompressor_t();
+	~jpeg_decompressor_t() noexcept;
+	jpeg_decompressor_t(const jpeg_decompressor_t&) = delete;
+	jpeg_decompressor_t& operator=(const jpeg_decompressor_t&) = delete;
+
+	/*!
+	 * Decodes an image into a new frame.
+	 *
+	 * Planar YUV formats with the same sampling as the image are read directly as raw data,
+	 * other planar YUV formats are resampled from decoded YCbCr.
+	 * @param min_resolution	Smallest resolution needed, the image is downscaled in DCT domain
+	 * 							by 1/2, 1/4 or 1/8 as long as it stays at least this large.
+	 * 							Zero dimensions are ignored.
+	 * @param fast				Faster decoding with slightly worse quality
+	 * @return empty pointer if the image can't be decoded into @em format
+	 * @throw std::runtime_error on libjpeg errors
+	 */
+	core::pRawVideoFrame decode(const uint8_t* data, size_t size, format_t format,
+			resolution_t min_resolution, bool fast);
+
+private:
+	void read_scanlines(const core::pRawVideoFrame& frame);
+	void read_raw_data(const core::pRawVideoFrame& frame);
+	void read_resampled(const core::pRawVideoFrame& frame);
+	//! Checks whether the image can be read as raw data in sampling @em sampling
+	bool raw_compatible(const jpeg_raw_sampling_t& sampling) const;
+
+	jpeg_decompress_struct cinfo_;
+	jpeg_error_mgr jerr_;
+	std::vector<JSAMPROW> rows_;
+	//! Rows that don't fit into the output frame
+	std::vector<uint8_t> scratch_;
+};
+
+}
+}
+
+#endif /* JPEG_DECOMPRESSOR_H_ */
@@ -0,0 +1,112 @@
+/*!
+ * @file 		jpeg_stripes.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "jpeg_stripes.h"
+#include <algorithm>
+#include <cstring>
+
+namespace yuri {
+namespace jpeg {
+
+namespace {
+const uint8_t marker_soi = 0xD8;
+const uint8_t marker_eoi = 0xD9;
+const uint8_t marker_sos = 0xDA;
+const uint8_t marker_rst0 = 0xD0;
+const uint8_t marker_rst7 = 0xD7;
+
+bool is_sof_marker(uint8_t marker)
+{
+	// 0xC4, 0xC8 and 0xCC are DHT, JPG and DAC
+	return marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+}
+}
+
+bool split_jpeg(const uint8_t* data, size_t size, jpeg_stripes_t& stripes)
+{
+	if (size < 4 || data[0] != 0xFF || data[1] != marker_soi) return false;
+	size_t pos = 2;
+	while (true) {
+		if (pos + 4 > size || data[pos] != 0xFF) return false;
+		const uint8_t marker = data[pos + 1];
+		const size_t length = (data[pos + 2] << 8) | data[pos + 3];
+		pos += 2 + length;
+		if (pos > size) return false;
+		if (marker == marker_sos) break;
+	}
+	stripes.header.assign(data, data + pos);
+	stripes.segments.clear();
+
+	size_t start = pos;
+	while (pos + 1 < size) {
+		const auto next = static_cast<const uint8_t*>(std::memchr(data + pos, 0xFF, size - pos - 1));
+		if (!next) return false;
+		pos = next - data;
+		const uint8_t marker = data[pos + 1];
+		if (marker == 0x00) {
+			// Stuffed 0xFF byte
+			pos += 2;
+		} else if (marker == 0xFF) {
+			// Fill byte
+			++pos;
+		} else if (marker >= marker_rst0 && marker <= marker_rst7) {
+			stripes.segments.emplace_back(data + start, data + pos);
+			pos += 2;
+			start = pos;
+		} else if (marker == marker_eoi) {
+			stripes.segments.emplace_back(data + start, data + pos);
+			return true;
+		} else {
+			// Any other marker means there's more than one scan
+			return false;
+		}
+	}
+	return false;
+}
+
+bool set_jpeg_height(std::vector<uint8_t>& header, dimension_t height)
+{
+	size_t pos = 2;
+	while (pos + 4 <= header.size() && header[pos] == 0xFF) {
+		const uint8_t marker = header[pos + 1];
+		const size_t length = (header[pos + 2] << 8) | header[pos + 3];
+		if (is_sof_marker(marker)) {
+			// Segment starts with length (2 bytes) and precision (1 byte)
+			if (length < 5 || pos + 7 > header.size() || height > 0xFFFF) return false;
+			header[pos + 5] = static_cast<uint8_t>(height >> 8);
+			header[pos + 6] = static_cast<uint8_t>(height & 0xFF);
+			return true;
+		}
+		pos += 2 + length;
+	}
+	return false;
+}
+
+size_t get_joined_size(const jpeg_stripes_t& stripes)
+{
+	size_t size = stripes.header.size();
+	for (const auto& segment: stripes.segments) {
+		size += segment.size() + 2;
+	}
+	return size;
+}
+
+void join_jpeg(const jpeg_stripes_t& stripes, uint8_t* dest)
+{
+	dest = std::copy(stripes.header.begin(), stripes.header.end(), dest);
+	for (size_t i = 0; i < stripes.segments.size(); ++i) {
+		const auto& segment = stripes.segments[i];
+		dest = std::copy(segment.begin(), segment.end(), dest);
+		*dest++ = 0xFF;
+		*dest++ = (i + 1 < stripes.segments.size()) ? static_cast<uint8_t>(marker_rst0 + i % 8) : marker_eoi;
+	}
+}
+
+}
+}
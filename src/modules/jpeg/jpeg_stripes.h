@@ -0,0 +1,58 @@
+/*!
+ * @file 		jpeg_stripes.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Splitting and joining of baseline jpeg images at restart markers.
+ *
+ * When an image is encoded with a restart marker after every MCU row,
+ * entropy coded data for each row are independent of the other rows.
+ * So rows can be encoded separately (as a standalone image of the same width)
+ * and joined under the header of the complete image.
+ */
+
+#ifndef JPEG_STRIPES_H_
+#define JPEG_STRIPES_H_
+#include "yuri/core/utils/new_types.h"
+#include <vector>
+
+namespace yuri {
+namespace jpeg {
+
+struct jpeg_stripes_t {
+	//! Everything up to the end of SOS segment
+	std::vector<uint8_t> header;
+	//! Entropy coded data between restart markers
+	std::vector<std::vector<uint8_t>> segments;
+};
+
+/*!
+ * Splits baseline jpeg image into header and entropy coded segments.
+ * @return false if the image is not a baseline jpeg with a single scan
+ */
+bool split_jpeg(const uint8_t* data, size_t size, jpeg_stripes_t& stripes);
+
+/*!
+ * Sets image height in the SOF segment of the header.
+ * Used to put segments of several partial images under the header of one of them.
+ * @return false if there's no SOF segment in the header
+ */
+bool set_jpeg_height(std::vector<uint8_t>& header, dimension_t height);
+
+/*!
+ * Returns size of the image assembled by join_jpeg()
+ */
+size_t get_joined_size(const jpeg_stripes_t& stripes);
+
+/*!
+ * Assembles the image, inserting restart markers between segments.
+ * @param dest Destination buffer, at least get_joined_size() bytes long
+ */
+void join_jpeg(const jpeg_stripes_t& stripes, uint8_t* dest);
+
+}
+}
+
+#endif /* JPEG_STRIPES_H_ */
@@ -0,0 +1,118 @@
+/*!
+ * @file 		jpeg_stripes_test.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "tests/catch.hpp"
+#include "jpeg_compressor.h"
+#include "jpeg_stripes.h"
+#include "yuri/core/frame/raw_frame_types.h"
+
+namespace yuri {
+namespace jpeg {
+
+namespace {
+
+const int quality = 90;
+
+core::pRawVideoFrame make_frame(format_t fmt, resolution_t res, int seed)
+{
+	auto frame = core::RawVideoFrame::create_empty(fmt, res, true);
+	for (auto& plane: *frame) {
+		const size_t lines = plane.size() / plane.get_line_size();
+		for (size_t line = 0; line < lines; ++line) {
+			auto data = plane.data() + line * plane.get_line_size();
+			for (size_t i = 0; i < plane.get_line_size(); ++i) {
+				data[i] = static_cast<uint8_t>((i * 7 + line * 3 + (i ^ line) * seed) & 0xFF);
+			}
+		}
+	}
+	return frame;
+}
+
+std::vector<uint8_t> encode_stripes(jpeg_compressor_t& compressor, const core::pRawVideoFrame& frame,
+		dimension_t first_line, dimension_t lines, jpeg_stripes_t& stripes)
+{
+	jpeg_output_t buffer;
+	REQUIRE(compressor.encode(frame, first_line, lines, quality, true, buffer));
+	REQUIRE(split_jpeg(buffer.data(), buffer.size(), stripes));
+	return {buffer.begin(), buffer.end()};
+}
+
+std::vector<uint8_t> join(const jpeg_stripes_t& stripes)
+{
+	std::vector<uint8_t> joined(get_joined_size(stripes));
+	join_jpeg(stripes, joined.data());
+	return joined;
+}
+
+}
+
+TEST_CASE("jpeg stripes", "[jpeg]")
+{
+	jpeg_compressor_t compressor;
+	for (auto fmt: {core::raw_format::rgb24, core::raw_format::y8, core::raw_format::yuv420p, core::raw_format::yuv422p}) {
+		// The last MCU row is incomplete
+		const resolution_t res = {72, 53};
+		const dimension_t mcu_height = compressor.get_mcu_height(fmt);
+		REQUIRE(mcu_height > 0);
+		const size_t rows = (res.height + mcu_height - 1) / mcu_height;
+		INFO("format " << fmt << ", MCU height " << mcu_height);
+
+		const auto frame = make_frame(fmt, res, 1);
+		jpeg_stripes_t whole;
+		const auto image = encode_stripes(compressor, frame, 0, res.height, whole);
+		REQUIRE(whole.segments.size() == rows);
+
+		// Split and join of a single image
+		REQUIRE(join(whole) == image);
+
+		// Bands encoded separately and joined under the header of the first one
+		jpeg_stripes_t joined;
+		for (size_t row = 0; row < rows; row += 2) {
+			const dimension_t first_line = row * mcu_height;
+			const dimension_t lines = std::min<dimension_t>(res.height - first_line, 2 * mcu_height);
+			jpeg_stripes_t band;
+			encode_stripes(compressor, frame, first_line, lines, band);
+			REQUIRE(band.segments.size() == (lines + mcu_height - 1) / mcu_height);
+			if (row == 0) {
+				joined.header = band.header;
+				REQUIRE(set_jpeg_height(joined.header, res.height));
+			}
+			joined.segments.insert(joined.segments.end(), band.segments.begin(), band.segments.end());
+		}
+		REQUIRE(join(joined) == image);
+
+		// Re-encoding a single row of a changed frame
+		const auto changed = make_frame(fmt, res, 5);
+		jpeg_stripes_t changed_whole;
+		const auto changed_image = encode_stripes(compressor, changed, 0, res.height, changed_whole);
+		REQUIRE(changed_image != image);
+		for (size_t row = 0; row < rows; ++row) {
+			const dimension_t first_line = row * mcu_height;
+			const dimension_t lines = std::min<dimension_t>(res.height - first_line, mcu_height);
+			jpeg_stripes_t band;
+			encode_stripes(compressor, changed, first_line, lines, band);
+			REQUIRE(band.segments.size() == 1);
+			joined.segments[row] = band.segments[0];
+		}
+		REQUIRE(join(joined) == changed_image);
+	}
+}
+
+TEST_CASE("jpeg stripes invalid data", "[jpeg]")
+{
+	jpeg_stripes_t stripes;
+	const std::vector<uint8_t> garbage = {0xFF, 0xD8, 0x12, 0x34, 0x56, 0x78, 0xFF, 0xD9};
+	REQUIRE(!split_jpeg(garbage.data(), garbage.size(), stripes));
+	REQUIRE(!split_jpeg(garbage.data(), 1, stripes));
+	std::vector<uint8_t> header = {0xFF, 0xD8, 0xFF, 0xDA, 0x00, 0x02};
+	REQUIRE(!set_jpeg_height(header, 100));
+}
+
+}
+}
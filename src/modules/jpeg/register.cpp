@@ -23,6 +23,10 @@ MODULE_REGISTRATION_BEGIN("jpeg")
 		REGISTER_CONVERTER(compressed_frame::jpeg, raw_format::rgb24, "jpeg_decoder", 30)
 		REGISTER_CONVERTER(compressed_frame::jpeg, raw_format::yuv444, "jpeg_decoder", 25)
 		REGISTER_CONVERTER(compressed_frame::jpeg, raw_format::y8, "jpeg_decoder", 35)
+		// Planar YUV is read from libjpeg without colour conversion
+		REGISTER_CONVERTER(compressed_frame::jpeg, raw_format::yuv420p, "jpeg_decoder", 20)
+		REGISTER_CONVERTER(compressed_frame::jpeg, raw_format::yuv422p, "jpeg_decoder", 20)
+		REGISTER_CONVERTER(compressed_frame::jpeg, raw_format::yuv444p, "jpeg_decoder", 20)
 #if defined(JCS_EXTENSIONS) && defined(JCS_ALPHA_EXTENSIONS)
 		REGISTER_CONVERTER(compressed_frame::jpeg, raw_format::bgr24, "jpeg_decoder", 30)
 
@@ -42,6 +46,10 @@ MODULE_REGISTRATION_BEGIN("jpeg")
 #endif
 		REGISTER_CONVERTER(raw_format::yuv444, compressed_frame::jpeg, "jpeg_encoder", 200)
 		REGISTER_CONVERTER(raw_format::y8, compressed_frame::jpeg, "jpeg_encoder", 200)
+		// Planar YUV is passed to libjpeg without colour conversion
+		REGISTER_CONVERTER(raw_format::yuv420p, compressed_frame::jpeg, "jpeg_encoder", 150)
+		REGISTER_CONVERTER(raw_format::yuv422p, compressed_frame::jpeg, "jpeg_encoder", 150)
+		REGISTER_CONVERTER(raw_format::yuv444p, compressed_frame::jpeg, "jpeg_encoder", 150)
 
 MODULE_REGISTRATION_END()
 
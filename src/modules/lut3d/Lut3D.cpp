@@ -0,0 +1,233 @@
+/*!
+ * @file 		Lut3D.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "Lut3D.h"
+#include "yuri/core/Module.h"
+#include "yuri/core/frame/raw_frame_types.h"
+#include "yuri/core/utils/assign_events.h"
+#include "yuri/core/utils/irange.h"
+#include <map>
+
+namespace yuri {
+namespace lut3d {
+
+
+IOTHREAD_GENERATOR(Lut3D)
+
+MODULE_REGISTRATION_BEGIN("lut3d")
+		REGISTER_IOTHREAD("lut3d",Lut3D)
+MODULE_REGISTRATION_END()
+
+core::Parameters Lut3D::configure()
+{
+	core::Parameters p = base_type::configure();
+	p.set_description("Applies 3D LUT loaded from a .cube file. YUV frames are processed directly, "
+			"using a LUT converted to YUV. LUT can be replaced by sending event 'file', "
+			"it's loaded in background and frames are processed with the old LUT until it's ready.");
+	p["file"]["Path to .cube file. Frames are passed unchanged until a LUT is loaded."]="";
+	p["matrix"]["YUV matrix used for YUV frames (bt601, bt709, bt2020)"]="bt709";
+	p["limited_range"]["YUV frames use limited range"]=true;
+	p["threads"]["Number of threads to process each frame"]=1;
+	return p;
+}
+
+namespace {
+
+using namespace core::raw_format;
+
+enum class sample_t {
+	packed8,
+	packed16,
+	yuv422
+};
+
+struct format_layout_t {
+	sample_t		type;
+	bool			yuv;
+	pixel_layout_t	packed;
+	layout_422_t	yuv422;
+};
+
+const std::map<format_t, format_layout_t> supported_formats = {
+		{rgb24, 	{sample_t::packed8, false, {3, 0, 1, 2, -1}, {}}},
+		{bgr24, 	{sample_t::packed8, false, {3, 2, 1, 0, -1}, {}}},
+		{rgba32, 	{sample_t::packed8, false, {4, 0, 1, 2, 3}, {}}},
+		{bgra32, 	{sample_t::packed8, false, {4, 2, 1, 0, 3}, {}}},
+		{argb32, 	{sample_t::packed8, false, {4, 1, 2, 3, 0}, {}}},
+		{abgr32, 	{sample_t::packed8, false, {4, 3, 2, 1, 0}, {}}},
+		{rgb48, 	{sample_t::packed16, false, {3, 0, 1, 2, -1}, {}}},
+		{bgr48, 	{sample_t::packed16, false, {3, 2, 1, 0, -1}, {}}},
+		{rgba64, 	{sample_t::packed16, false, {4, 0, 1, 2, 3}, {}}},
+		{yuv444, 	{sample_t::packed8, true, {3, 0, 1, 2, -1}, {}}},
+		{yuyv422, 	{sample_t::yuv422, true, {}, {0, 1, 2, 3}}},
+		{yvyu422, 	{sample_t::yuv422, true, {}, {0, 3, 2, 1}}},
+		{uyvy422, 	{sample_t::yuv422, true, {}, {1, 0, 3, 2}}},
+		{vyuy422, 	{sample_t::yuv422, true, {}, {1, 2, 3, 0}}},
+};
+
+//! Kr and Kb coefficients of YUV matrices
+const std::map<std::string, std::pair<double, double>> matrices = {
+		{"bt601", {0.299, 0.114}},
+		{"bt709", {0.2126, 0.0722}},
+		{"bt2020", {0.2627, 0.0593}},
+};
+
+lut_set_t load_luts(const std::string& file, const std::string& matrix, bool limited_range)
+{
+	const auto cube = load_cube(file);
+	auto it = matrices.find(matrix);
+	if (it == matrices.end()) throw std::runtime_error("Unknown matrix " + matrix);
+	return {make_rgb_lut(cube), make_yuv_lut(cube, it->second.first, it->second.second, limited_range)};
+}
+
+void process_lines(const lut_functions_t& f, const lut3d_t& lut, const format_layout_t& layout,
+		const core::Plane& in, core::Plane& out, dimension_t width, dimension_t first, dimension_t last)
+{
+	const size_t in_line = in.get_line_size();
+	const size_t out_line = out.get_line_size();
+	for (dimension_t y = first; y < last; ++y) {
+		const uint8_t* src = in.data() + y * in_line;
+		uint8_t* dst = out.data() + y * out_line;
+		switch (layout.type) {
+			case sample_t::packed8:
+				f.apply8(lut, src, dst, width, layout.packed);
+				break;
+			case sample_t::packed16:
+				f.apply16(lut, reinterpret_cast<const uint16_t*>(src), reinterpret_cast<uint16_t*>(dst), width, layout.packed);
+				break;
+			case sample_t::yuv422:
+				f.apply422(lut, src, dst, width, layout.yuv422);
+				break;
+		}
+	}
+}
+
+}
+
+
+Lut3D::Lut3D(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
+base_type(log_,parent,std::string("lut3d")),
+event::BasicEventConsumer(log),
+matrix_("bt709"),limited_range_(true),threads_(1),
+functions_(select_lut_functions()),reload_(false)
+{
+	IOTHREAD_INIT(parameters)
+	if (!threads_) threads_ = 1;
+	log[log::debug] << "Using " << functions_.name << " implementation";
+	set_supported_formats(supported_formats);
+	if (!file_.empty()) {
+		try {
+			luts_ = load_luts(file_, matrix_, limited_range_);
+		}
+		catch (std::exception& e) {
+			throw exception::InitializationFailed(std::string("Failed to load LUT: ") + e.what());
+		}
+		log[log::info] << "Loaded " << luts_.rgb->size << "^3 LUT from " << file_;
+	}
+}
+
+Lut3D::~Lut3D() noexcept
+{
+}
+
+void Lut3D::start_loading()
+{
+	if (pending_.valid()) {
+		// Waiting for the previous loading to finish would block processing
+		reload_ = true;
+		return;
+	}
+	log[log::debug] << "Loading LUT from " << file_;
+	pending_ = std::async(std::launch::async, load_luts, file_, matrix_, limited_range_);
+}
+
+void Lut3D::check_loading()
+{
+	if (!pending_.valid() || pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+	try {
+		luts_ = pending_.get();
+		log[log::info] << "Loaded " << luts_.rgb->size << "^3 LUT from " << file_;
+	}
+	catch (std::exception& e) {
+		log[log::error] << "Failed to load LUT: " << e.what();
+	}
+	if (reload_) {
+		reload_ = false;
+		start_loading();
+	}
+}
+
+core::pFrame Lut3D::do_special_single_step(core::pRawVideoFrame frame)
+{
+	process_events();
+	check_loading();
+	if (!luts_.rgb) return frame;
+
+	const auto it = supported_formats.find(frame->get_format());
+	if (it == supported_formats.end()) return frame;
+	const auto& layout = it->second;
+	const auto& lut = layout.yuv ? *luts_.yuv : *luts_.rgb;
+
+	const auto res = frame->get_resolution();
+	auto outframe = core::RawVideoFrame::create_empty(frame->get_format(), res, true);
+	outframe->copy_video_params(*frame);
+	const auto& in = (*frame)[0];
+	auto& out = (*outframe)[0];
+	if (in.get_line_size() * res.height > in.size()) {
+		log[log::warning] << "Frame too small for its resolution, ignoring";
+		return {};
+	}
+
+	if (threads_ < 2 || res.height < threads_) {
+		process_lines(functions_, lut, layout, in, out, res.width, 0, res.height);
+	} else {
+		const dimension_t task_lines = res.height / threads_;
+		std::vector<std::future<void>> results(threads_);
+		dimension_t start = 0;
+		for (auto i: irange(threads_)) {
+			const dimension_t end = (i == threads_ - 1) ? res.height : start + task_lines;
+			results[i] = std::async(std::launch::async, process_lines, std::cref(functions_), std::cref(lut),
+					std::cref(layout), std::cref(in), std::ref(out), res.width, start, end);
+			start = end;
+		}
+		for (auto& r: results) r.get();
+	}
+	return outframe;
+}
+
+bool Lut3D::set_param(const core::Parameter& param)
+{
+	if (assign_parameters(param)
+			(file_, "file")
+			(matrix_, "matrix")
+			(limited_range_, "limited_range")
+			(threads_, "threads"))
+		return true;
+	return base_type::set_param(param);
+}
+
+bool Lut3D::do_process_event(const std::string& event_name, const event::pBasicEvent& event)
+{
+	if (assign_events(event_name, event)
+			(file_, "file")
+			(matrix_, "matrix")
+			(limited_range_, "limited_range")) {
+		start_loading();
+		return true;
+	}
+	if (assign_events(event_name, event)
+			(threads_, "threads")) {
+		if (!threads_) threads_ = 1;
+		return true;
+	}
+	return false;
+}
+
+} /* namespace lut3d */
+} /* namespace yuri */
@@ -0,0 +1,60 @@
+/*!
+ * @file 		Lut3D.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef LUT3D_MODULE_H_
+#define LUT3D_MODULE_H_
+
+#include "yuri/core/thread/SpecializedIOFilter.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/event/BasicEventConsumer.h"
+#include "lut3d.h"
+#include <future>
+
+namespace yuri {
+namespace lut3d {
+
+//! LUTs prepared from a single .cube file
+struct lut_set_t {
+	pLut3d rgb;
+	pLut3d yuv;
+};
+
+class Lut3D: public core::SpecializedIOFilter<core::RawVideoFrame>, public event::BasicEventConsumer
+{
+	using base_type = core::SpecializedIOFilter<core::RawVideoFrame>;
+public:
+	IOTHREAD_GENERATOR_DECLARATION
+	static core::Parameters configure();
+	Lut3D(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters);
+	virtual ~Lut3D() noexcept;
+private:
+	virtual core::pFrame do_special_single_step(core::pRawVideoFrame frame) override;
+	virtual bool set_param(const core::Parameter& param) override;
+	virtual bool do_process_event(const std::string& event_name, const event::pBasicEvent& event) override;
+
+	//! Starts loading the LUT in background
+	void start_loading();
+	//! Replaces current LUTs if the new ones are already loaded
+	void check_loading();
+
+	std::string				file_;
+	std::string				matrix_;
+	bool					limited_range_;
+	size_t					threads_;
+
+	lut_functions_t			functions_;
+	lut_set_t				luts_;
+	std::future<lut_set_t>	pending_;
+	//! Another reload was requested while loading
+	bool					reload_;
+};
+
+} /* namespace lut3d */
+} /* namespace yuri */
+#endif /* LUT3D_MODULE_H_ */
@@ -0,0 +1,408 @@
+/*!
+ * @file 		lut3d.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "lut3d.h"
+#include "yuri/core/utils/cpu_features.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#ifdef YURI_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace yuri {
+namespace lut3d {
+
+namespace {
+
+//! Value representing 1.0 in lut_entry_t
+const int lut_one = 1 << 14;
+//! Value representing 1.0 in the interpolated result
+const int result_shift = 22;
+
+bool is_number_start(char c)
+{
+	return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+}
+
+/*!
+ * Sorts the fractional positions and returns the strides of the largest axis
+ * and of the two largest axes, that define the tetrahedron containing the point.
+ * Ties can be resolved arbitrarily, as the corresponding weights are zero.
+ */
+template<typename T, typename S>
+void sort_axes(T f0, T f1, T f2, S s0, S s1, S s2, T& fa, T& fb, T& fc, S& sa, S& sab)
+{
+	if (f0 >= f1) {
+		if (f1 >= f2) 		{ fa = f0; fb = f1; fc = f2; sa = s0; sab = s0 + s1; }
+		else if (f0 >= f2)	{ fa = f0; fb = f2; fc = f1; sa = s0; sab = s0 + s2; }
+		else 				{ fa = f2; fb = f0; fc = f1; sa = s2; sab = s2 + s0; }
+	} else {
+		if (f2 >= f1) 		{ fa = f2; fb = f1; fc = f0; sa = s2; sab = s2 + s1; }
+		else if (f2 >= f0)	{ fa = f1; fb = f2; fc = f0; sa = s1; sab = s1 + s2; }
+		else 				{ fa = f1; fb = f0; fc = f2; sa = s1; sab = s1 + s0; }
+	}
+}
+
+struct tetra_t {
+	const lut_entry_t* e0;
+	uint32_t o1;
+	uint32_t o2;
+	uint32_t o3;
+	int w0;
+	int w1;
+	int w2;
+	int w3;
+};
+
+inline tetra_t get_tetra(const lut3d_t& lut, uint32_t cell, int f0, int f1, int f2)
+{
+	const uint32_t s1 = static_cast<uint32_t>(lut.size);
+	const uint32_t s2 = s1 * s1;
+	int fa, fb, fc;
+	uint32_t sa, sab;
+	sort_axes(f0, f1, f2, 1U, s1, s2, fa, fb, fc, sa, sab);
+	return {lut.entries.data() + cell, sa, sab, 1 + s1 + s2, 256 - fa, fa - fb, fb - fc, fc};
+}
+
+inline void split_position(const lut3d_t& lut, int64_t pos, size_t stride, uint32_t& cell, int& frac)
+{
+	const int64_t max_pos = static_cast<int64_t>(lut.size - 1) * 256;
+	pos = std::min(std::max(pos, int64_t{0}), max_pos);
+	int64_t index = pos >> 8;
+	frac = static_cast<int>(pos & 0xFF);
+	if (index >= static_cast<int64_t>(lut.size - 1)) {
+		index = lut.size - 2;
+		frac = 256;
+	}
+	cell = static_cast<uint32_t>(index * stride);
+}
+
+inline int64_t position16(const lut3d_t& lut, size_t channel, uint16_t value)
+{
+	return (value * lut.scale[channel] + lut.offset[channel]) >> 16;
+}
+
+struct interpolate_scalar {
+	static void interpolate(const tetra_t& t, int32_t out[3])
+	{
+		const auto& e0 = t.e0[0];
+		const auto& e1 = t.e0[t.o1];
+		const auto& e2 = t.e0[t.o2];
+		const auto& e3 = t.e0[t.o3];
+		for (int k = 0; k < 3; ++k) {
+			out[k] = t.w0 * e0.c[k] + t.w1 * e1.c[k] + t.w2 * e2.c[k] + t.w3 * e3.c[k];
+		}
+	}
+	static void to8(const tetra_t& t, uint8_t out[4])
+	{
+		int32_t res[3];
+		interpolate(t, res);
+		for (int k = 0; k < 3; ++k) {
+			out[k] = static_cast<uint8_t>((res[k] * 255 + (1 << (result_shift - 1))) >> result_shift);
+		}
+	}
+	static void to16(const tetra_t& t, uint16_t out[4])
+	{
+		int32_t res[3];
+		interpolate(t, res);
+		for (int k = 0; k < 3; ++k) {
+			const int32_t v = (res[k] + 32) >> (result_shift - 16);
+			out[k] = static_cast<uint16_t>(v - (v >> 16));
+		}
+	}
+};
+
+#ifdef YURI_HAVE_SSE2
+struct interpolate_sse2 {
+	static __m128i interpolate(const tetra_t& t)
+	{
+		const __m128i a = _mm_unpacklo_epi16(
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(t.e0)),
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(t.e0 + t.o1)));
+		const __m128i b = _mm_unpacklo_epi16(
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(t.e0 + t.o2)),
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(t.e0 + t.o3)));
+		return _mm_add_epi32(
+				_mm_madd_epi16(a, _mm_set1_epi32((t.w1 << 16) | t.w0)),
+				_mm_madd_epi16(b, _mm_set1_epi32((t.w3 << 16) | t.w2)));
+	}
+	static void to8(const tetra_t& t, uint8_t out[4])
+	{
+		const __m128i res = interpolate(t);
+		__m128i v = _mm_sub_epi32(_mm_slli_epi32(res, 8), res);
+		v = _mm_srli_epi32(_mm_add_epi32(v, _mm_set1_epi32(1 << (result_shift - 1))), result_shift);
+		v = _mm_packus_epi16(_mm_packs_epi32(v, v), v);
+		const int32_t packed = _mm_cvtsi128_si32(v);
+		std::memcpy(out, &packed, 4);
+	}
+	static void to16(const tetra_t& t, uint16_t out[4])
+	{
+		const __m128i res = interpolate(t);
+		__m128i v = _mm_srli_epi32(_mm_add_epi32(res, _mm_set1_epi32(32)), result_shift - 16);
+		v = _mm_sub_epi32(v, _mm_srli_epi32(v, 16));
+		// Take low 16 bits of each 32 bit value
+		v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 2, 0));
+		v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(3, 3, 2, 0));
+		v = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 2, 0));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out), v);
+	}
+};
+#endif
+
+template<class Interp>
+void apply8(const lut3d_t& lut, const uint8_t* src, uint8_t* dst, size_t pixels, const pixel_layout_t& l)
+{
+	uint8_t out[4];
+	for (size_t i = 0; i < pixels; ++i) {
+		const uint8_t v0 = src[l.c0];
+		const uint8_t v1 = src[l.c1];
+		const uint8_t v2 = src[l.c2];
+		const auto t = get_tetra(lut, lut.cell8[0][v0] + lut.cell8[1][v1] + lut.cell8[2][v2],
+				lut.frac8[0][v0], lut.frac8[1][v1], lut.frac8[2][v2]);
+		Interp::to8(t, out);
+		dst[l.c0] = out[0];
+		dst[l.c1] = out[1];
+		dst[l.c2] = out[2];
+		if (l.copy >= 0) dst[l.copy] = src[l.copy];
+		src += l.step;
+		dst += l.step;
+	}
+}
+
+template<class Interp>
+void apply16(const lut3d_t& lut, const uint16_t* src, uint16_t* dst, size_t pixels, const pixel_layout_t& l)
+{
+	const size_t strides[3] = {1, lut.size, lut.size * lut.size};
+	const size_t pos[3] = {l.c0, l.c1, l.c2};
+	uint16_t out[4];
+	for (size_t i = 0; i < pixels; ++i) {
+		uint32_t cell = 0;
+		int frac[3];
+		for (size_t c = 0; c < 3; ++c) {
+			uint32_t channel_cell;
+			split_position(lut, position16(lut, c, src[pos[c]]), strides[c], channel_cell, frac[c]);
+			cell += channel_cell;
+		}
+		Interp::to16(get_tetra(lut, cell, frac[0], frac[1], frac[2]), out);
+		dst[l.c0] = out[0];
+		dst[l.c1] = out[1];
+		dst[l.c2] = out[2];
+		if (l.copy >= 0) dst[l.copy] = src[l.copy];
+		src += l.step;
+		dst += l.step;
+	}
+}
+
+template<class Interp>
+void apply422(const lut3d_t& lut, const uint8_t* src, uint8_t* dst, size_t pixels, const layout_422_t& l)
+{
+	uint8_t out0[4];
+	uint8_t out1[4];
+	for (size_t i = 0; i < pixels / 2; ++i) {
+		const uint8_t y0 = src[l.y0];
+		const uint8_t y1 = src[l.y1];
+		const uint8_t u = src[l.u];
+		const uint8_t v = src[l.v];
+		const uint32_t uv_cell = lut.cell8[1][u] + lut.cell8[2][v];
+		Interp::to8(get_tetra(lut, lut.cell8[0][y0] + uv_cell, lut.frac8[0][y0], lut.frac8[1][u], lut.frac8[2][v]), out0);
+		Interp::to8(get_tetra(lut, lut.cell8[0][y1] + uv_cell, lut.frac8[0][y1], lut.frac8[1][u], lut.frac8[2][v]), out1);
+		dst[l.y0] = out0[0];
+		dst[l.y1] = out1[0];
+		dst[l.u] = static_cast<uint8_t>((out0[1] + out1[1] + 1) >> 1);
+		dst[l.v] = static_cast<uint8_t>((out0[2] + out1[2] + 1) >> 1);
+		src += 4;
+		dst += 4;
+	}
+}
+
+}
+
+cube_lut_t load_cube(const std::string& filename)
+{
+	std::ifstream file(filename);
+	if (!file.is_open()) throw std::runtime_error("Failed to open " + filename);
+
+	cube_lut_t cube;
+	cube.size = 0;
+	cube.domain_min = {{0.0, 0.0, 0.0}};
+	cube.domain_max = {{1.0, 1.0, 1.0}};
+	std::string line;
+	size_t line_number = 0;
+	while (std::getline(file, line)) {
+		++line_number;
+		const auto comment = line.find('#');
+		if (comment != std::string::npos) line.erase(comment);
+		const auto start = line.find_first_not_of(" \t\r");
+		if (start == std::string::npos) continue;
+
+		if (is_number_start(line[start])) {
+			if (!cube.size) throw std::runtime_error("LUT data before LUT_3D_SIZE in " + filename);
+			std::array<float, 3> value;
+			const char* p = line.c_str() + start;
+			for (auto& v: value) {
+				char* end = nullptr;
+				v = std::strtof(p, &end);
+				if (end == p) throw std::runtime_error("Failed to parse line " + std::to_string(line_number) + " in " + filename);
+				p = end;
+			}
+			if (cube.data.size() >= cube.size * cube.size * cube.size) throw std::runtime_error("Too many values in " + filename);
+			cube.data.push_back(value);
+			continue;
+		}
+
+		std::istringstream ss(line.substr(start));
+		std::string keyword;
+		ss >> keyword;
+		if (keyword == "TITLE") {
+			std::getline(ss, cube.title);
+			const auto first = cube.title.find('"');
+			const auto last = cube.title.rfind('"');
+			if (first != std::string::npos && last > first) cube.title = cube.title.substr(first + 1, last - first - 1);
+		} else if (keyword == "LUT_3D_SIZE") {
+			ss >> cube.size;
+			if (!ss || cube.size < 2 || cube.size > 256) throw std::runtime_error("Unsupported LUT size in " + filename);
+			cube.data.reserve(cube.size * cube.size * cube.size);
+		} else if (keyword == "LUT_1D_SIZE") {
+			throw std::runtime_error("1D LUTs are not supported (" + filename + ")");
+		} else if (keyword == "DOMAIN_MIN") {
+			ss >> cube.domain_min[0] >> cube.domain_min[1] >> cube.domain_min[2];
+		} else if (keyword == "DOMAIN_MAX") {
+			ss >> cube.domain_max[0] >> cube.domain_max[1] >> cube.domain_max[2];
+		} else if (keyword == "LUT_3D_INPUT_RANGE") {
+			double min_value = 0.0, max_value = 1.0;
+			ss >> min_value >> max_value;
+			cube.domain_min = {{min_value, min_value, min_value}};
+			cube.domain_max = {{max_value, max_value, max_value}};
+		}
+		// Other keywords are ignored
+	}
+	if (!cube.size) throw std::runtime_error("No LUT_3D_SIZE specified in " + filename);
+	if (cube.data.size() != cube.size * cube.size * cube.size) {
+		throw std::runtime_error("Wrong number of values in " + filename);
+	}
+	for (size_t c = 0; c < 3; ++c) {
+		if (cube.domain_max[c] <= cube.domain_min[c]) throw std::runtime_error("Invalid domain in " + filename);
+	}
+	return cube;
+}
+
+std::array<float, 3> sample_cube(const cube_lut_t& cube, const std::array<float, 3>& rgb)
+{
+	const size_t strides[3] = {1, cube.size, cube.size * cube.size};
+	size_t cell = 0;
+	float frac[3];
+	for (size_t c = 0; c < 3; ++c) {
+		const double range = cube.domain_max[c] - cube.domain_min[c];
+		const double pos = std::min(std::max((rgb[c] - cube.domain_min[c]) / range, 0.0), 1.0) * (cube.size - 1);
+		const size_t index = std::min(static_cast<size_t>(pos), cube.size - 2);
+		frac[c] = static_cast<float>(pos - index);
+		cell += index * strides[c];
+	}
+	float fa, fb, fc;
+	size_t sa, sab;
+	sort_axes(frac[0], frac[1], frac[2], strides[0], strides[1], strides[2], fa, fb, fc, sa, sab);
+	const auto& e0 = cube.data[cell];
+	const auto& e1 = cube.data[cell + sa];
+	const auto& e2 = cube.data[cell + sab];
+	const auto& e3 = cube.data[cell + strides[0] + strides[1] + strides[2]];
+	std::array<float, 3> out;
+	for (size_t c = 0; c < 3; ++c) {
+		out[c] = (1.0f - fa) * e0[c] + (fa - fb) * e1[c] + (fb - fc) * e2[c] + fc * e3[c];
+	}
+	return out;
+}
+
+pLut3d make_rgb_lut(const cube_lut_t& cube)
+{
+	auto lut = std::make_shared<lut3d_t>();
+	lut->size = cube.size;
+	lut->entries.resize(cube.data.size());
+	std::transform(cube.data.begin(), cube.data.end(), lut->entries.begin(), [](const std::array<float, 3>& v) {
+		lut_entry_t e;
+		for (size_t c = 0; c < 3; ++c) {
+			e.c[c] = static_cast<int16_t>(std::min(std::max(std::lround(v[c] * lut_one), 0L), static_cast<long>(lut_one)));
+		}
+		e.c[3] = 0;
+		return e;
+	});
+
+	const size_t strides[3] = {1, cube.size, cube.size * cube.size};
+	for (size_t c = 0; c < 3; ++c) {
+		// Position in 1/256 of grid step, in 16.16 fixed point
+		const double range = cube.domain_max[c] - cube.domain_min[c];
+		const double steps = (cube.size - 1) * 256.0 * 65536.0;
+		lut->scale[c] = std::llround(steps / (65535.0 * range));
+		lut->offset[c] = std::llround(-cube.domain_min[c] / range * steps) + 32768;
+		for (size_t v = 0; v < 256; ++v) {
+			int frac;
+			split_position(*lut, position16(*lut, c, static_cast<uint16_t>(v * 257)), strides[c], lut->cell8[c][v], frac);
+			lut->frac8[c][v] = static_cast<uint16_t>(frac);
+		}
+	}
+	return lut;
+}
+
+pLut3d make_yuv_lut(const cube_lut_t& cube, double kr, double kb, bool limited_range)
+{
+	const double kg = 1.0 - kr - kb;
+	const double y_scale = limited_range ? 219.0 : 255.0;
+	const double c_scale = limited_range ? 224.0 : 255.0;
+	const double y_offset = limited_range ? 16.0 : 0.0;
+
+	cube_lut_t yuv_cube;
+	yuv_cube.size = cube.size;
+	yuv_cube.domain_min = {{0.0, 0.0, 0.0}};
+	yuv_cube.domain_max = {{1.0, 1.0, 1.0}};
+	yuv_cube.data.reserve(cube.data.size());
+	const double step = 255.0 / (cube.size - 1);
+	for (size_t iv = 0; iv < cube.size; ++iv) {
+		for (size_t iu = 0; iu < cube.size; ++iu) {
+			for (size_t iy = 0; iy < cube.size; ++iy) {
+				const double y = (iy * step - y_offset) / y_scale;
+				const double cb = (iu * step - 128.0) / c_scale;
+				const double cr = (iv * step - 128.0) / c_scale;
+				const double r = y + 2.0 * (1.0 - kr) * cr;
+				const double b = y + 2.0 * (1.0 - kb) * cb;
+				const double g = (y - kr * r - kb * b) / kg;
+				const auto rgb = sample_cube(cube, {{static_cast<float>(r), static_cast<float>(g), static_cast<float>(b)}});
+				const double y2 = kr * rgb[0] + kg * rgb[1] + kb * rgb[2];
+				const double cb2 = (rgb[2] - y2) / (2.0 * (1.0 - kb));
+				const double cr2 = (rgb[0] - y2) / (2.0 * (1.0 - kr));
+				yuv_cube.data.push_back({{
+					static_cast<float>((y2 * y_scale + y_offset) / 255.0),
+					static_cast<float>((cb2 * c_scale + 128.0) / 255.0),
+					static_cast<float>((cr2 * c_scale + 128.0) / 255.0)}});
+			}
+		}
+	}
+	return make_rgb_lut(yuv_cube);
+}
+
+lut_functions_t get_scalar_lut_functions()
+{
+	return {&apply8<interpolate_scalar>, &apply16<interpolate_scalar>, &apply422<interpolate_scalar>, "scalar"};
+}
+
+lut_functions_t select_lut_functions()
+{
+#ifdef YURI_HAVE_SSE2
+	if (core::utils::cpu_has_sse2()) {
+		return {&apply8<interpolate_sse2>, &apply16<interpolate_sse2>, &apply422<interpolate_sse2>, "SSE2"};
+	}
+#endif
+	return get_scalar_lut_functions();
+}
+
+}
+}
@@ -0,0 +1,119 @@
+/*!
+ * @file 		lut3d.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Loading of .cube 3D LUTs and their application in fixed point.
+ *
+ * LUT is interpolated tetrahedrally, with 8 bit fractional positions and
+ * LUT values stored as 14 bit integers. Scalar and SSE2 implementations
+ * produce identical results.
+ */
+
+#ifndef LUT3D_H_
+#define LUT3D_H_
+
+#include "yuri/core/utils/new_types.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace yuri {
+namespace lut3d {
+
+//! LUT as loaded from a .cube file
+struct cube_lut_t {
+	std::string title;
+	size_t size;
+	std::array<double, 3> domain_min;
+	std::array<double, 3> domain_max;
+	//! RGB values, red index changing fastest
+	std::vector<std::array<float, 3>> data;
+};
+
+/*!
+ * Parses a .cube file.
+ * @throw std::runtime_error when the file can't be read or is not a valid 3D LUT
+ */
+cube_lut_t load_cube(const std::string& filename);
+
+/*!
+ * Evaluates the LUT for a normalized RGB value (using tetrahedral interpolation).
+ */
+std::array<float, 3> sample_cube(const cube_lut_t& cube, const std::array<float, 3>& rgb);
+
+//! One LUT entry. Values are 0 - 16384, the last value is unused.
+struct lut_entry_t {
+	int16_t c[4];
+};
+
+/*!
+ * Fixed point LUT. Position of an input value in the LUT is kept in 1/256
+ * of the grid step.
+ */
+struct lut3d_t {
+	size_t size;
+	std::vector<lut_entry_t> entries;
+	//! Mapping of 16 bit input values to position in the LUT (pos = (value * scale + offset) >> 16)
+	std::array<int64_t, 3> scale;
+	std::array<int64_t, 3> offset;
+	//! Offset of the grid cell (in entries) and the fractional position for 8 bit inputs
+	std::array<std::array<uint32_t, 256>, 3> cell8;
+	std::array<std::array<uint16_t, 256>, 3> frac8;
+};
+
+using pLut3d = std::shared_ptr<lut3d_t>;
+
+/*!
+ * Prepares LUT for RGB values.
+ */
+pLut3d make_rgb_lut(const cube_lut_t& cube);
+
+/*!
+ * Prepares LUT processing YUV values directly. YUV values are converted to RGB
+ * with given coefficients, passed through the LUT and converted back.
+ * @param kr Red coefficient of the matrix (e.g. 0.2126 for BT.709)
+ * @param kb Blue coefficient of the matrix (e.g. 0.0722 for BT.709)
+ * @param limited_range Use limited (16 - 235/240) range
+ */
+pLut3d make_yuv_lut(const cube_lut_t& cube, double kr, double kb, bool limited_range);
+
+//! Positions of components in a packed pixel (in samples)
+struct pixel_layout_t {
+	size_t	step;
+	size_t	c0;
+	size_t	c1;
+	size_t	c2;
+	//! Position of the component to be copied unchanged (alpha), or -1
+	int		copy;
+};
+
+//! Positions of components in 4:2:2 macropixel
+struct layout_422_t {
+	size_t	y0;
+	size_t	u;
+	size_t	y1;
+	size_t	v;
+};
+
+struct lut_functions_t {
+	void (*apply8)(const lut3d_t& lut, const uint8_t* src, uint8_t* dst, size_t pixels, const pixel_layout_t& layout);
+	void (*apply16)(const lut3d_t& lut, const uint16_t* src, uint16_t* dst, size_t pixels, const pixel_layout_t& layout);
+	void (*apply422)(const lut3d_t& lut, const uint8_t* src, uint8_t* dst, size_t pixels, const layout_422_t& layout);
+	const char* name;
+};
+
+/*!
+ * Returns the fastest implementation supported by current CPU.
+ */
+lut_functions_t select_lut_functions();
+
+lut_functions_t get_scalar_lut_functions();
+
+}
+}
+
+#endif /* LUT3D_H_ */
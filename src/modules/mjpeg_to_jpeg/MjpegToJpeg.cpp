@@ -118,6 +118,10 @@ const uint8_t huffman_tables[] = {
     0xf9, 0xfa
 };
 
+const size_t dht_size = sizeof(huffman_tables) + 2;
+//! DHT marker and length of the segment containing huffman_tables
+const uint8_t dht_header[] = {0xff, huffman_table_marker,
+		static_cast<uint8_t>((dht_size >> 8) & 0xFF), static_cast<uint8_t>(dht_size & 0xFF)};
 
 template<class Iter>
 uint8_t get_header_type(Iter it) {
@@ -174,10 +178,14 @@ core::pFrame MjpegToJpeg::do_special_single_step(core::pCompressedVideoFrame fra
 {
 	if (!frame || frame->get_format() != core::compressed_frame::mjpg) return {};
 
-	// If the frame already has a huffman table, then there's no work to do, we just have to change it's identifier to mjpeg
-	if (find_huffman_table(frame->begin(), frame->end()))
+	// If the frame already has a huffman table, then there's no work to do, we just have to change it's identifier to mjpeg.
+	// The new frame only references data of the original one, so nothing gets copied.
+	if (find_huffman_table(frame->begin(), frame->end())) {
+		core::CompressedVideoFrame::segments_t segments {
+			core::CompressedVideoFrame::make_segment(frame, 0, frame->size())};
 		return core::CompressedVideoFrame::create_empty(
-			core::compressed_frame::jpeg, frame->get_resolution(), frame->data(), frame->size());
+			core::compressed_frame::jpeg, frame->get_resolution(), std::move(segments));
+	}
 
 
 	/*
@@ -189,23 +197,16 @@ core::pFrame MjpegToJpeg::do_special_single_step(core::pCompressedVideoFrame fra
 		it = get_hext_header(it, frame->end());
 	}
 	if (it == frame->end()) return {};
-	// Create an empty frame for the new jpeg frame
-	core::pCompressedVideoFrame frame_out = core::CompressedVideoFrame::create_empty(
-			core::compressed_frame::jpeg, frame->get_resolution(), frame->size()+4+sizeof(huffman_tables));
-
-	// Copy everything before SOS marker
-	auto it2 = std::copy(frame->begin(),it,frame_out->begin());
-	// Add DHT marker
-	*it2++ = 0xff;
-	*it2++ = huffman_table_marker;
-	const size_t hheader_size = sizeof(huffman_tables)+2;
-	*it2++ = static_cast<uint8_t>((hheader_size>>8)&0xFF);
-	*it2++ = static_cast<uint8_t>(hheader_size&0xFF);
-	// Copy Huffman tables
-	it2 = std::copy(huffman_tables, huffman_tables+sizeof(huffman_tables), it2);
-	// Copy SOS marker and the rest of the frame
-	/*it2 = */std::copy(it,frame->end(), it2);
-	return frame_out;
+	const size_t sos_offset = std::distance(frame->begin(), it);
+	// The output frame is composed of everything before SOS marker, DHT marker with default tables
+	// and the rest of the original frame, without copying any of them.
+	core::CompressedVideoFrame::segments_t segments {
+		core::CompressedVideoFrame::make_segment(frame, 0, sos_offset),
+		{dht_header, sizeof(dht_header), {}},
+		{huffman_tables, sizeof(huffman_tables), {}},
+		core::CompressedVideoFrame::make_segment(frame, sos_offset, frame->size() - sos_offset)};
+	return core::CompressedVideoFrame::create_empty(
+			core::compressed_frame::jpeg, frame->get_resolution(), std::move(segments));
 }
 
 
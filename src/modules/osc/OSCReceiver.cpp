@@ -58,15 +58,21 @@ void OSCReceiver::run()
 		return;
 	}
 	log[log::info] << "Socket initialized";
-	std::vector<uint8_t> buffer(65536);
-	ssize_t read_bytes=0;
+	// Several messages are read at once, when they arrive in bursts
+	std::vector<std::vector<uint8_t>> buffers(16, std::vector<uint8_t>(65536));
+	std::vector<core::socket::received_datagram_t> datagrams(buffers.size());
+	for (size_t i = 0; i < buffers.size(); ++i) {
+		datagrams[i].data = buffers[i].data();
+		datagrams[i].capacity = buffers[i].size();
+	}
 	while(still_running()) {
 		if (socket_->wait_for_data(get_latency())) {
 			log[log::verbose_debug] << "reading data";
-			read_bytes = socket_->receive_datagram(&buffer[0],buffer.size());
-			if (read_bytes > 0) {
+			const auto count = socket_->receive_datagrams(datagrams);
+			for (size_t i = 0; i < count; ++i) {
+				const auto read_bytes = datagrams[i].size;
 				log[log::verbose_debug] << "Read " << read_bytes << " bytes";
-				auto first = buffer.begin();
+				auto first = buffers[i].begin();
 //				auto events_pair = process_data(first, first + read_bytes, log);
 				auto events_pair = parse_packet(first, first + read_bytes, log);
 				auto events = std::get<1>(events_pair);
@@ -12,6 +12,7 @@
 #include "yuri/event/EventHelpers.h"
 //#include "yuri/core/frame/raw_frame_params.h"
 #include "yuri/core/frame/raw_frame_types.h"
+#include <algorithm>
 #include <cassert>
 namespace yuri {
 namespace overlay {
@@ -35,7 +36,7 @@ core::Parameters Overlay::configure()
 
 Overlay::Overlay(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
 		SpecializedMultiIOFilter<core::RawVideoFrame, core::RawVideoFrame>(log_,parent,1,std::string("overlay")),
-event::BasicEventConsumer(log)
+event::BasicEventConsumer(log),x_(0),y_(0),last_overlay_rect_{0, 0, 0, 0}
 {
 	IOTHREAD_INIT(parameters)
 }
@@ -450,6 +451,34 @@ inline void fill_multiple_lines(ssize_t& line, const ssize_t& max_line,
 	}
 }
 
+/*!
+ * Combines the images in a rectangle @em rect of the destination image.
+ * @param overlay_pos	Position of the overlay image
+ * @param overlay_rect	Part of the destination image covered by the overlay image
+ */
+template<class kernel>
+void combine_region(const plane_t::const_iterator& src, const plane_t::const_iterator& overlay, const plane_t::iterator& dest,
+		const size_t linesize_0, const size_t linesize_1, const size_t linesize_out,
+		const coordinates_t& overlay_pos, const geometry_t& overlay_rect, const geometry_t& rect)
+{
+	const ssize_t end_x = geometry_max_x(rect);
+	for (ssize_t line = rect.y; line < geometry_max_y(rect); ++line) {
+		plane_t::const_iterator src_pix 	= src+line*linesize_0+rect.x*kernel::src_bpp;
+		plane_t::iterator 		dest_pix	= dest+line*linesize_out+rect.x*kernel::dest_bpp;
+		ssize_t pixel = rect.x;
+		if (line >= overlay_rect.y && line < geometry_max_y(overlay_rect)) {
+			const ssize_t ovr_start = std::min(std::max(overlay_rect.x, rect.x), end_x);
+			const ssize_t ovr_end = std::min(std::max(geometry_max_x(overlay_rect), ovr_start), end_x);
+			fill_line<kernel>(pixel, ovr_start, src_pix, dest_pix);
+			plane_t::const_iterator ovr_pix = overlay+(line-overlay_pos.y)*linesize_1+(pixel-overlay_pos.x)*kernel::ovr_bpp;
+			for (; pixel < ovr_end; pixel+=kernel::pix_step) {
+				kernel::compute(src_pix, ovr_pix, dest_pix);
+			}
+		}
+		fill_line<kernel>(pixel, end_x, src_pix, dest_pix);
+	}
+}
+
 template<bool rewrite>
 core::pRawVideoFrame get_out_frame(core::pRawVideoFrame& frame, format_t format, resolution_t res0);
 
@@ -482,7 +511,36 @@ core::pRawVideoFrame Overlay::combine(core::pRawVideoFrame frame_0, const core::
 	const size_t			step		= kernel::pix_step;
 	const ssize_t			x			= x_ - (x_ % step);
 	log[log::verbose_debug] << "Base " << width << "x" << height << " (" << linesize_0 << ") + " << w << "x" <<h << " (" << linesize_1 << ") -> ("<<linesize_out<<")";
+	const geometry_t		overlay_rect= intersection(geometry_t{res_1.width, res_1.height, x, y_}, res_0);
+	const std::vector<geometry_t> damage = get_damage(*frame_0, frame_1, {x, y_}, overlay_rect);
+	const bool				update		= frame_0->has_damage();
+
+	if (!rewrite && update && last_output_ && last_output_->get_format() == kernel::output_format() &&
+			damage_tracker_.follows(*frame_0)) {
+		// Only damaged regions have to be combined, the rest is reused from previous output
+		auto outframe = get_frame_unique(last_output_);
+		const plane_t::const_iterator src 		= PLANE_DATA(frame_0,0).begin();
+		const plane_t::const_iterator overlay 	= PLANE_DATA(frame_1,0).begin();
+		const plane_t::iterator 	  dest 		= PLANE_DATA(outframe,0).begin();
+		for (const auto& rect: damage) {
+			combine_region<kernel>(src, overlay, dest, linesize_0, linesize_1, linesize_out,
+					{x, y_}, overlay_rect, core::align_damage(rect, step, 1, res_0));
+		}
+		outframe->copy_video_params(*frame_0);
+		outframe->set_damage(damage);
+		store_state(frame_0, frame_1, outframe, overlay_rect);
+		return outframe;
+	}
+
 	auto 		outframe 	= get_out_frame<rewrite>(frame_0, kernel::output_format(), res_0);
+	if (update) {
+		outframe->set_damage(damage);
+		store_state(frame_0, frame_1, rewrite ? core::pRawVideoFrame{} : outframe, overlay_rect);
+	} else {
+		outframe->clear_damage();
+		last_output_.reset();
+		last_overlay_.reset();
+	}
 	const plane_t::const_iterator src 		= PLANE_DATA(frame_0,0).begin();
 	const plane_t::const_iterator overlay 	= PLANE_DATA(frame_1,0).begin();
 	const plane_t::iterator 	  dest 		= PLANE_DATA(outframe,0).begin();
@@ -523,6 +581,39 @@ core::pRawVideoFrame Overlay::combine(core::pRawVideoFrame frame_0, const core::
 	}
 	return outframe;
 }
+std::vector<geometry_t> Overlay::get_damage(const core::RawVideoFrame& frame_0, const core::pRawVideoFrame& frame_1,
+		const coordinates_t& overlay_pos, const geometry_t& overlay_rect) const
+{
+	const auto res = frame_0.get_resolution();
+	auto damage = frame_0.get_damage();
+	if (!last_overlay_ || overlay_rect.x != last_overlay_rect_.x || overlay_rect.y != last_overlay_rect_.y ||
+			overlay_rect.width != last_overlay_rect_.width || overlay_rect.height != last_overlay_rect_.height) {
+		// Overlay moved, both old and new position have to be updated
+		if (last_overlay_) damage.push_back(last_overlay_rect_);
+		damage.push_back(overlay_rect);
+	} else if (frame_1 != last_overlay_) {
+		if (overlay_tracker_.follows(*frame_1)) {
+			for (auto rect: frame_1->get_damage()) {
+				rect.x += overlay_pos.x;
+				rect.y += overlay_pos.y;
+				damage.push_back(intersection(rect, overlay_rect));
+			}
+		} else {
+			damage.push_back(overlay_rect);
+		}
+	}
+	return core::simplify_damage(damage, res);
+}
+
+void Overlay::store_state(const core::pRawVideoFrame& frame_0, const core::pRawVideoFrame& frame_1, core::pRawVideoFrame outframe, const geometry_t& overlay_rect)
+{
+	damage_tracker_.update(*frame_0);
+	overlay_tracker_.update(*frame_1);
+	last_output_ = std::move(outframe);
+	last_overlay_ = frame_1;
+	last_overlay_rect_ = overlay_rect;
+}
+
 std::vector<core::pFrame> Overlay::do_special_step(param_type frames)
 {
 	process_events();
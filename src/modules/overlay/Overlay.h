@@ -14,6 +14,7 @@
 #include "yuri/core/thread/SpecializedMultiIOFilter.h"
 #include "yuri/event/BasicEventConsumer.h"
 #include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/frame/damage.h"
 namespace yuri {
 namespace overlay {
 
@@ -35,8 +36,20 @@ private:
 	virtual bool do_process_event(const std::string& event_name, const event::pBasicEvent& event) override;
 //	core::pBasicFrame frame_0;
 //	core::pBasicFrame frame_1;
+	/*!
+	 * Returns regions of the output image that changed since previous output
+	 */
+	std::vector<geometry_t> get_damage(const core::RawVideoFrame& frame_0, const core::pRawVideoFrame& frame_1,
+			const coordinates_t& overlay_pos, const geometry_t& overlay_rect) const;
+	void store_state(const core::pRawVideoFrame& frame_0, const core::pRawVideoFrame& frame_1, core::pRawVideoFrame outframe, const geometry_t& overlay_rect);
 	ssize_t x_;
 	ssize_t y_;
+
+	core::pRawVideoFrame last_output_;
+	core::pRawVideoFrame last_overlay_;
+	geometry_t			last_overlay_rect_;
+	core::DamageTracker	damage_tracker_;
+	core::DamageTracker	overlay_tracker_;
 };
 
 } /* namespace overlay */
@@ -13,6 +13,7 @@
 #include "yuri/core/thread/SpecializedIOFilter.h"
 #include "yuri/core/frame/CompressedVideoFrame.h"
 #include "yuri/core/thread/ConverterThread.h"
+#include <vector>
 namespace yuri {
 namespace png {
 
@@ -29,6 +30,9 @@ private:
 	virtual core::pFrame do_convert_frame(core::pFrame input_frame, format_t target_format) override;
 	virtual bool set_param(const core::Parameter& param) override;
 	format_t requested_format_;
+	bool verify_checksums_;
+	//! Row pointers, reused between frames
+	std::vector<uint8_t*> rows_;
 };
 
 } /* namespace png */
@@ -14,7 +14,11 @@
 #include "yuri/core/frame/compressed_frame_types.h"
 #include "yuri/core/frame/CompressedVideoFrame.h"
 #include "yuri/core/utils/Timer.h"
+#include "yuri/core/utils/assign_parameters.h"
 #include <png.h>
+#include <zlib.h>
+#include <algorithm>
+#include <map>
 
 namespace yuri {
 namespace png {
@@ -26,6 +30,10 @@ core::Parameters PngEncoder::configure()
 {
 	core::Parameters p = core::SpecializedIOFilter<core::RawVideoFrame>::configure();
 	p.set_description("PngEncoder");
+	p["compression"]["zlib compression level (0-9, -1 for zlib default). Level 0 stores the data uncompressed, level 1 is the fastest compression."]=-1;
+	p["filter"]["Row filter (auto, none, sub, up, avg, paeth, all). Auto uses no filter for level 0, up for level 1 and adaptive filtering otherwise."]="auto";
+	p["strategy"]["zlib strategy (default, filtered, huffman, rle, fixed). Rle is fast and works well for screen content."]="default";
+	p["threads"]["Number of frames encoded concurrently. Frames are still output in the order they were received."]=1;
 	return p;
 }
 
@@ -33,8 +41,13 @@ namespace {
 void write_data(png_structp png_ptr, png_bytep data_in, png_size_t length)
 {
 	uvector<uint8_t>* data = reinterpret_cast<uvector<uint8_t>*>(png_get_io_ptr(png_ptr));
-//	printf("Writing %lu bytes\n",length);
-	data->insert(data->end(), data_in, data_in+length);
+	// The buffer grows geometrically, so large images are not copied too many times
+	const size_t used = data->size();
+	if (used + length > data->capacity()) {
+		data->reserve(std::max(used + length, data->capacity() * 2));
+	}
+	data->resize(used + length);
+	std::copy(data_in, data_in + length, data->data() + used);
 }
 void flush_data(png_structp)
 {
@@ -54,23 +67,47 @@ void report_warning(png_structp png_ptr, png_const_charp msg)
 using namespace core::raw_format;
 const std::vector<format_t> supported_formats = {
 y8, y16, rgb24, rgb48, bgr24, bgr48, rgba32, rgba64, bgra32, bgra64};
-}
-PngEncoder::PngEncoder(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
-core::SpecializedIOFilter<core::RawVideoFrame>(log_,parent,std::string("png_encoder"))
-{
-	IOTHREAD_INIT(parameters)
-	set_supported_formats(supported_formats);
-}
 
-PngEncoder::~PngEncoder() noexcept
+const std::map<std::string, int> filter_strings = {
+		{"auto", -1},
+		{"none", PNG_FILTER_NONE},
+		{"sub", PNG_FILTER_SUB},
+		{"up", PNG_FILTER_UP},
+		{"avg", PNG_FILTER_AVG},
+		{"paeth", PNG_FILTER_PAETH},
+		{"all", PNG_ALL_FILTERS},
+};
+
+const std::map<std::string, int> strategy_strings = {
+		{"default", Z_DEFAULT_STRATEGY},
+		{"filtered", Z_FILTERED},
+		{"huffman", Z_HUFFMAN_ONLY},
+		{"rle", Z_RLE},
+		{"fixed", Z_FIXED},
+};
+
+//! Initial size of output buffer, when there's no previous image to estimate the size from
+const size_t min_output_size = 64 * 1024;
+//! Size of IDAT chunks, larger chunks mean less calls to write_data
+const png_size_t compression_buffer_size = 256 * 1024;
+
+int get_filters(const png_settings_t& settings)
 {
+	if (settings.filters >= 0) return settings.filters;
+	// Filtering doesn't help when the data are not compressed
+	// and fast compression gains little from adaptive filtering
+	switch (settings.level) {
+		case 0: return PNG_FILTER_NONE;
+		case 1: return PNG_FILTER_UP;
+		default: return PNG_ALL_FILTERS;
+	}
 }
 
-core::pFrame PngEncoder::do_special_single_step(core::pRawVideoFrame frame)
+core::pCompressedVideoFrame encode_png(const core::pRawVideoFrame& frame, const png_settings_t& settings,
+		png_context_t& context, log::Log& log)
 {
 	Timer t;
 	format_t input_format = frame->get_format();
-	using namespace core::raw_format;
 	bool bgr = false;
 //	bool alpha_start = false;
 	int png_format = 0;
@@ -101,6 +138,8 @@ core::pFrame PngEncoder::do_special_single_step(core::pRawVideoFrame frame)
 		return {};
 	}
 
+	// libpng doesn't provide a way to reset write struct after an image was written,
+	// so it has to be created for every image.
 	png_infop info_ptr = nullptr;
 	std::unique_ptr<png_struct, std::function<void(png_structp)>> png_ptrx (png_create_write_struct(PNG_LIBPNG_VER_STRING, &log, report_error, report_warning),
 			[&info_ptr](png_structp p){
@@ -120,48 +159,148 @@ core::pFrame PngEncoder::do_special_single_step(core::pRawVideoFrame frame)
 
 	try {
 		uvector<uint8_t> data;
-		data.reserve(10485760);
+		data.reserve(std::max(min_output_size, context.size_hint));
 		png_set_write_fn(png_ptr, &data, write_data, flush_data);
 
 		resolution_t res = frame->get_resolution();
+		const size_t linesize = PLANE_DATA(frame, 0).get_line_size();
+		if (linesize < res.width * bpp / 8 || linesize * res.height > PLANE_SIZE(frame, 0)) {
+			log[log::error] << "Providing libpng with " << linesize * res.height << " bytes, when only " <<  PLANE_SIZE(frame,0) << "was available...";
+			return {};
+		}
+
 		png_set_IHDR(png_ptr, info_ptr, res.width, res.height, depth, png_format,
 				PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
 				PNG_FILTER_TYPE_DEFAULT);
+		png_set_compression_level(png_ptr, settings.level < 0 ? Z_DEFAULT_COMPRESSION : settings.level);
+		png_set_compression_strategy(png_ptr, settings.strategy);
+		png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, get_filters(settings));
+		png_set_compression_buffer_size(png_ptr, compression_buffer_size);
 		if (bgr) png_set_bgr(png_ptr);
 
 		png_write_info(png_ptr, info_ptr);
-		std::vector<png_bytep> rows(res.height);
-		size_t linesize = res.width * bpp / 8;
+		context.rows.resize(res.height);
 		png_bytep out_data = PLANE_RAW_DATA(frame,0);
 		for (dimension_t i = 0; i < res.height; ++i) {
-			rows[i] = out_data;
-			out_data += linesize;
+			context.rows[i] = out_data + i * linesize;
 		}
-		if (std::distance(PLANE_RAW_DATA(frame,0),out_data) > static_cast<ptrdiff_t>(PLANE_SIZE(frame,0))) {
-			log[log::error] << "Providing libpng with " << std::distance(PLANE_RAW_DATA(frame,0),out_data) << " bytes, when only " <<  PLANE_SIZE(frame,0) << "was available...";
-			return {};
-		}
-		png_write_image(png_ptr, rows.data());
+		png_write_image(png_ptr, context.rows.data());
 		png_write_end(png_ptr, info_ptr);
 
-		// TODO: This copies the data, it would be better to provide a way to just move them in...
-		core::pCompressedVideoFrame frame_out = core::CompressedVideoFrame::create_empty(
-				core::compressed_frame::png, res, data.data(), data.size());
+		context.size_hint = data.size() + data.size() / 8;
+		auto frame_out = core::CompressedVideoFrame::create_empty(core::compressed_frame::png, res, std::move(data));
+		frame_out->copy_video_params(*frame);
 		log[log::verbose_debug] << "PNG encoding took " << t.get_duration();
 		return frame_out;
 	}
 	catch (std::runtime_error&) {}
 	return {};
 }
+
+}
+PngEncoder::PngEncoder(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
+core::SpecializedIOFilter<core::RawVideoFrame>(log_,parent,std::string("png_encoder")),
+settings_{-1, -1, Z_DEFAULT_STRATEGY},threads_(1),context_{{}, 0},next_context_(0)
+{
+	IOTHREAD_INIT(parameters)
+	if (settings_.level > 9) settings_.level = 9;
+	if (threads_ > 1) thread_contexts_.resize(threads_, png_context_t{{}, 0});
+	set_supported_formats(supported_formats);
+}
+
+PngEncoder::~PngEncoder() noexcept
+{
+}
+
+bool PngEncoder::step()
+{
+	if (!core::SpecializedIOFilter<core::RawVideoFrame>::step()) {
+		flush();
+		return false;
+	}
+	// Output pipes are closed when the thread exits, so all frames have to be pushed
+	// when the input ends or the thread is about to exit
+	if (!still_running() || (input_ && input_->is_finished())) {
+		flush();
+	} else {
+		// Frames finished while there was no new input
+		push_encoded(false);
+	}
+	return true;
+}
+
+void PngEncoder::do_connect_in(position_t position, core::pPipe pipe)
+{
+	input_ = pipe;
+	core::SpecializedIOFilter<core::RawVideoFrame>::do_connect_in(position, std::move(pipe));
+}
+
+void PngEncoder::push_encoded(bool wait)
+{
+	while (!pending_.empty()) {
+		auto& front = pending_.front();
+		if (!wait && front.wait_for(std::chrono::seconds(0)) != std::future_status::ready) break;
+		auto frame = front.get();
+		pending_.pop_front();
+		if (frame) push_frame(0, std::move(frame));
+		wait = false;
+	}
+}
+
+void PngEncoder::flush()
+{
+	while (!pending_.empty()) {
+		push_encoded(true);
+	}
+}
+
+core::pFrame PngEncoder::do_special_single_step(core::pRawVideoFrame frame)
+{
+	if (threads_ < 2) {
+		return encode_png(frame, settings_, context_, log);
+	}
+	if (pending_.size() >= threads_) {
+		push_encoded(true);
+	}
+	// Context used threads_ frames ago is free, as the frame was already pushed out
+	auto& context = thread_contexts_[next_context_];
+	next_context_ = (next_context_ + 1) % thread_contexts_.size();
+	pending_.push_back(std::async(std::launch::async, encode_png, std::move(frame), settings_,
+			std::ref(context), std::ref(log)));
+	push_encoded(false);
+	return {};
+}
 core::pFrame PngEncoder::do_convert_frame(core::pFrame input_frame, format_t target_format)
 {
 	if(target_format != core::compressed_frame::png) return {};
 	core::pRawVideoFrame frame = std::dynamic_pointer_cast<core::RawVideoFrame>(input_frame);
 	if (!frame) return {};
-	return do_special_single_step(frame);
+	return encode_png(frame, settings_, context_, log);
 }
 bool PngEncoder::set_param(const core::Parameter& param)
 {
+	if (assign_parameters(param)
+			(settings_.level, "compression")
+			.parsed<std::string>
+				(settings_.filters, "filter", [this](const std::string& s){
+					auto it = filter_strings.find(s);
+					if (it == filter_strings.end()) {
+						log[log::warning] << "Unknown filter " << s << ", using auto";
+						return -1;
+					}
+					return it->second;
+				})
+			.parsed<std::string>
+				(settings_.strategy, "strategy", [this](const std::string& s){
+					auto it = strategy_strings.find(s);
+					if (it == strategy_strings.end()) {
+						log[log::warning] << "Unknown strategy " << s << ", using default";
+						return static_cast<int>(Z_DEFAULT_STRATEGY);
+					}
+					return it->second;
+				})
+			(threads_, "threads"))
+		return true;
 	return core::SpecializedIOFilter<core::RawVideoFrame>::set_param(param);
 }
 
@@ -13,9 +13,31 @@
 #include "yuri/core/thread/SpecializedIOFilter.h"
 #include "yuri/core/frame/RawVideoFrame.h"
 #include "yuri/core/thread/ConverterThread.h"
+#include "yuri/core/frame/CompressedVideoFrame.h"
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
 namespace yuri {
 namespace png {
 
+//! Compression settings for a single image
+struct png_settings_t {
+	//! zlib compression level, -1 for zlib default
+	int level;
+	//! PNG_FILTER_* flags, or -1 to select them according to level
+	int filters;
+	//! zlib strategy
+	int strategy;
+};
+
+//! Buffers reused between images encoded by one thread
+struct png_context_t {
+	std::vector<uint8_t*> rows;
+	//! Size of the last image, used to preallocate output for the next one
+	size_t size_hint;
+};
+
 class PngEncoder: public core::SpecializedIOFilter<core::RawVideoFrame>, public core::ConverterThread
 {
 public:
@@ -25,9 +47,27 @@ public:
 	virtual ~PngEncoder() noexcept;
 private:
 	
+	virtual bool step() override;
+	virtual void do_connect_in(position_t position, core::pPipe pipe) override;
 	virtual core::pFrame do_special_single_step(core::pRawVideoFrame frame) override;
 	virtual core::pFrame do_convert_frame(core::pFrame input_frame, format_t target_format) override;
 	virtual bool set_param(const core::Parameter& param) override;
+	/*!
+	 * Pushes frames encoded in worker threads in the order they were received.
+	 * @param wait	Wait for the oldest frame, even if it's not encoded yet
+	 */
+	void push_encoded(bool wait);
+	//! Waits for all frames being encoded and pushes them
+	void flush();
+
+	png_settings_t settings_;
+	size_t threads_;
+	png_context_t context_;
+	std::vector<png_context_t> thread_contexts_;
+	size_t next_context_;
+	std::deque<std::future<core::pCompressedVideoFrame>> pending_;
+	//! Input pipe, to find out when it ends
+	core::pPipe input_;
 };
 
 } /* namespace png */
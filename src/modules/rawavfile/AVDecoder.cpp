@@ -23,6 +23,7 @@ core::Parameters AVDecoder::configure()
     core::Parameters p                                             = base_type::configure();
     p["threads"]["Number of threads. Set to 0 to auto select"]     = 0;
     p["thread_type"]["Type of threaded decoding - slice, frame or any"] = "any";
+    p["allow_padding"]["Output decoded frames with padded lines as they are, instead of copying them"] = false;
     return p;
 }
 
@@ -32,6 +33,7 @@ AVDecoder::AVDecoder(const log::Log& _log, core::pwThreadBase parent, const core
       format_(0),
       threads_(0),
       thread_type_(libav::thread_type_t::any),
+      allow_padding_(false),
       ctx_(nullptr, [](AVCodecContext* ctx) { avcodec_free_context(&ctx); }),
       codec_(nullptr)
 {
@@ -122,7 +124,7 @@ bool AVDecoder::step()
             if (!fmt) {
                 log[log::warning] << "Frame decoded into an unsupported format";
             } else {
-                auto out_frame = libav::yuri_frame_from_av(*avframe);
+                auto out_frame = libav::yuri_frame_from_av(*avframe, allow_padding_);
                 push_frame(0, std::move(out_frame));
             }
         } else if (ret == AVERROR(EAGAIN)){
@@ -142,6 +144,7 @@ bool AVDecoder::set_param(const core::Parameter& param)
     if (assign_parameters(param) //
         (threads_, "threads")    //
             .parsed<std::string>(thread_type_, "thread_type", libav::parse_thread_type)//
+        (allow_padding_, "allow_padding")   //
         )
         return true;
     return base_type::set_param(param);
@@ -41,6 +41,7 @@ private:
     format_t                                      format_;
     int                                           threads_;
     libav::thread_type_t                          thread_type_;
+    bool                                          allow_padding_;
     core::utils::managed_resource<AVCodecContext> ctx_;
     const AVCodec*                                      codec_;
     AVFrame*                                      avframe;
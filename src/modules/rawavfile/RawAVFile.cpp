@@ -52,6 +52,13 @@ const std::string& get_format_name_no_throw(format_t fmt)
     }
     return unknown_format;
 }
+
+//! Converts timestamp of a stream to time from the start of the stream
+duration_t get_stream_time(const AVStream* stream, int64_t ts)
+{
+    const auto start = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+    return 1_us * av_rescale_q(ts - start, stream->time_base, AVRational{ 1, 1000000 });
+}
 }
 
 struct RawAVFile::stream_detail_t {
@@ -138,6 +145,14 @@ core::Parameters RawAVFile::configure()
     p["thread_type"]["Type of threaded decoding - slice, frame or any"]                            = "any";
     p["keep_open"]["Keep player running after ending file in no-loop mode, waiting for next filename"] = false;
     p["black_on_end"]["Send a black frame after finishing playback"] = false;
+    p["allow_padding"]["Output decoded frames with padded lines as they are, instead of copying them"] = false;
+    p["readahead_bytes"]["Maximal size of packets read ahead of decoding (in bytes)"] = 64 * 1024 * 1024;
+    p["readahead_time"]["Maximal duration of packets read ahead of decoding (in seconds)"] = 2.0;
+    p["seek_index"]["Keyframe index used for seeking - none, container (index stored in the file) "
+                    "or scan (reads the whole file if the container has no index)"] = "container";
+    p["cache_index"]["Store scanned keyframe index next to the file (as filename.keyframes) and reuse it"] = false;
+    p["in_point"]["Time (in seconds) to start playback and loops at"] = 0.0;
+    p["out_point"]["Time (in seconds) to end playback or loop at, negative to play to the end"] = -1.0;
     return p;
 }
 
@@ -165,9 +180,28 @@ RawAVFile::RawAVFile(const log::Log& _log, core::pwThreadBase parent, const core
       emit_params_interval_{ 1 },
       last_params_emitted_{ -1 },
       separate_extra_data_{false},
-      paused_(false)
+      paused_(false),
+      keep_open_(false),
+      black_on_end_(false),
+      allow_padding_(false),
+      readahead_bytes_(64 * 1024 * 1024),
+      readahead_time_(2.0),
+      demuxer_(readahead_bytes_, 2_s),
+      reading_(false),
+      audio_stop_(false),
+      audio_done_(false),
+      video_position_valid_(false),
+      video_done_(false),
+      seek_index_mode_(seek_index_mode_t::container),
+      cache_index_(false),
+      in_point_(0.0),
+      out_point_(-1.0),
+      seek_time_(0.0),
+      seek_requested_(false),
+      seek_target_valid_(false)
 {
     IOTHREAD_INIT(parameters)
+    demuxer_.set_limits(readahead_bytes_, 1_us * static_cast<int64_t>(readahead_time_ * 1e6));
     set_latency(10_us);
 #ifdef BROKEN_FFMPEG
     // We probably using BROKEN fork of ffmpeg (libav) or VERY old ffmpeg.
@@ -194,6 +228,7 @@ RawAVFile::RawAVFile(const log::Log& _log, core::pwThreadBase parent, const core
 
 bool RawAVFile::open_file(const std::string& filename)
 {
+    stop_reading();
     video_streams_.clear();
     audio_streams_.clear();
     frames_.clear();
@@ -328,10 +363,81 @@ bool RawAVFile::open_file(const std::string& filename)
     }
 
     next_times_.resize(video_streams_.size(), timestamp_t{});
+    build_seek_index();
+    seek_target_valid_ = false;
+    if (in_point_ > 0.0) {
+        seek_requested_ = true;
+        seek_time_      = in_point_;
+    }
     emit_event("filename", filename_);
     return true;
 }
 
+void RawAVFile::build_seek_index()
+{
+    seek_index_.clear();
+    if (video_streams_.empty() || seek_index_mode_ == seek_index_mode_t::none)
+        return;
+    const int   stream     = video_streams_[0].stream->index;
+    const auto  cache_path = filename_ + ".keyframes";
+    if (seek_index_.build_from_container(fmtctx_, stream)) {
+        log[log::info] << "Using keyframe index from container with " << seek_index_.size() << " keyframes";
+        return;
+    }
+    if (seek_index_mode_ != seek_index_mode_t::scan)
+        return;
+    if (cache_index_ && seek_index_.load(cache_path, filename_, stream)) {
+        log[log::info] << "Loaded keyframe index with " << seek_index_.size() << " keyframes from " << cache_path;
+        return;
+    }
+    const timestamp_t start;
+    if (!seek_index_.build_from_file(filename_, stream)) {
+        log[log::warning] << "Failed to build keyframe index";
+        return;
+    }
+    log[log::info] << "Built keyframe index with " << seek_index_.size() << " keyframes in " << (timestamp_t{} - start);
+    if (cache_index_ && !seek_index_.save(cache_path, filename_, stream)) {
+        log[log::warning] << "Failed to store keyframe index to " << cache_path;
+    }
+}
+
+bool RawAVFile::past_out_point(duration_t time) const
+{
+    return out_point_ >= 0.0 && time.value >= static_cast<int64_t>(out_point_ * 1e6);
+}
+
+bool RawAVFile::seek_to(duration_t time)
+{
+    if (!fmtctx_ || video_streams_.empty())
+        return false;
+    stop_reading();
+    const auto* st         = video_streams_[0].stream;
+    const auto  start      = st->start_time != AV_NOPTS_VALUE ? st->start_time : 0;
+    const auto  target_pts = start + av_rescale_q(time.value, AVRational{ 1, 1000000 }, st->time_base);
+    // Seeking to a known keyframe, as libavformat may land on a non-keyframe for some containers
+    const auto* keyframe = seek_index_.find(target_pts);
+    const auto  seek_pts = keyframe ? keyframe->pts : target_pts;
+    if (av_seek_frame(fmtctx_, st->index, seek_pts, AVSEEK_FLAG_BACKWARD) < 0) {
+        log[log::warning] << "Failed to seek to " << time;
+        return false;
+    }
+    if (decode_) {
+        for (auto& s : video_streams_) {
+            avcodec_flush_buffers(s.ctx.get());
+        }
+    }
+    for (auto& s : audio_streams_) {
+        avcodec_flush_buffers(s.ctx.get());
+    }
+    for (auto& f : frames_) {
+        f.reset();
+    }
+    log[log::debug] << "Seeking to " << time << (keyframe ? " from indexed keyframe at " : " from ") << get_stream_time(st, seek_pts);
+    seek_target_       = time;
+    seek_target_valid_ = decode_;
+    return true;
+}
+
 bool RawAVFile::push_ready_frames()
 {
     bool ready = false;
@@ -363,10 +469,16 @@ bool RawAVFile::push_ready_frames()
 
 bool RawAVFile::process_file_end()
 {
+    stop_reading();
     emit_event("end", true);
 
             if (loop_ && !has_next_filename() && fmtctx_) {
+                if (in_point_ > 0.0 && !video_streams_.empty()) {
+                    log[log::debug] << "Seeking to in point";
+                    return seek_to(1_us * static_cast<int64_t>(in_point_ * 1e6));
+                }
                 log[log::debug] << "Seeking to the beginning";
+                seek_target_valid_ = false;
                 av_seek_frame(fmtctx_, 0, 0, AVSEEK_FLAG_BACKWARD);
                 if (decode_) {
                     for (auto &s: video_streams_) {
@@ -493,10 +605,8 @@ bool RawAVFile::process_undecoded_frame(index_t idx, const AVPacket& packet)
 /*
 Parameter packet should be const, but the woudn't work with the fake ffmpeg (libav). Oh well...
 */
-bool RawAVFile::decode_video_frame(index_t idx, AVPacket& packet, AVFrame* av_frame, bool& keep_packet)
+bool RawAVFile::decode_video_frame(index_t idx, AVPacket& packet, AVFrame* av_frame)
 {
-    keep_packet      = false;
-
     if (avcodec_send_packet(video_streams_[idx].ctx.get(), &packet) < 0) {
         log[log::warning] << "Failed to send packet to video decoder";
     }
@@ -511,7 +621,20 @@ bool RawAVFile::decode_video_frame(index_t idx, AVPacket& packet, AVFrame* av_fr
         return false;
     }
 
-    auto f = libav::yuri_frame_from_av(*av_frame);
+    const auto ts = av_frame->best_effort_timestamp != AV_NOPTS_VALUE ? av_frame->best_effort_timestamp : av_frame->pts;
+    if (ts != AV_NOPTS_VALUE) {
+        const auto time = get_stream_time(video_streams_[idx].stream, ts);
+        if (seek_target_valid_ && time < seek_target_) {
+            // Decoding forward from a keyframe to the seek target
+            return false;
+        }
+        if (past_out_point(time)) {
+            reset_ = true;
+            return false;
+        }
+    }
+
+    auto f = libav::yuri_frame_from_av(*av_frame, allow_padding_);
     if (!f) {
         log[log::warning] << "Failed to convert avframe, probably unsupported pixelformat";
         return false;
@@ -526,19 +649,16 @@ bool RawAVFile::decode_video_frame(index_t idx, AVPacket& packet, AVFrame* av_fr
     return true;
 }
 
-bool RawAVFile::decode_audio_frame(index_t idx, const AVPacket& packet, AVFrame* av_frame, bool& keep_packet)
+bool RawAVFile::decode_audio_frame(index_t idx, const AVPacket& packet, AVFrame* av_frame)
 {
 #ifdef BROKEN_FFMPEG
     // We are probably using BROKEN port of ffmpeg (libav) or VERY old ffmpeg.
     (void)idx;
     (void)packet;
     (void)av_frame;
-    (void)keep_packet;
 
     return false;
 #else
-    keep_packet     = false;
-
     if (avcodec_send_packet(audio_streams_[idx].ctx.get(), &packet) < 0) {
         log[log::warning] << "Failed to send packet to video decoder";
     }
@@ -566,7 +686,8 @@ bool RawAVFile::decode_audio_frame(index_t idx, const AVPacket& packet, AVFrame*
                 log[log::warning] << "Failed to convert avframe, probably unsupported pixelformat";
                 return false;
             }
-            push_frame(idx + max_video_streams_, std::move(f));
+            lock_t _(audio_mutex_);
+            audio_frames_.emplace_back(idx + max_video_streams_, std::move(f));
         }
         catch (const std::runtime_error& e) {
             log[log::error] << "Failed to get format info for audio: " << e.what();
@@ -584,40 +705,150 @@ bool RawAVFile::decode_audio_frame(index_t idx, const AVPacket& packet, AVFrame*
         log[log::verbose_debug] << "Received " << av_frame->nb_samples << " samples, expected to convert to " << output_sample_count << ", actually got " << ret2
                                 << " stored in " << f->size() << " bytes, real size: " << real_buffer_size;
         f->resize(real_buffer_size);
-        push_frame(idx + max_video_streams_, std::move(f));
+        lock_t _(audio_mutex_);
+        audio_frames_.emplace_back(idx + max_video_streams_, std::move(f));
     }
     return true;
 #endif
 }
 
 namespace {
-int find_in_stream_group(int index, const std::vector<RawAVFile::stream_detail_t>& streams)
+//! Maximal number of decoded audio frames waiting to be pushed out
+const size_t max_audio_frames = 16;
+}
+
+void RawAVFile::start_reading()
 {
-    for (auto i : irange(streams.size())) {
-        if (index == streams[i].stream->index) {
-            return i;
-        }
+    std::vector<int>  streams;
+    std::vector<bool> no_starve;
+    // Video decoding must never wait for packets hidden behind audio packets,
+    // audio is decoded only up to the video position, so it can always wait.
+    for (const auto& s : video_streams_) {
+        streams.push_back(s.stream->index);
+        no_starve.push_back(true);
+    }
+    for (const auto& s : audio_streams_) {
+        streams.push_back(s.stream->index);
+        no_starve.push_back(false);
+    }
+    {
+        lock_t _(audio_mutex_);
+        audio_frames_.clear();
+        audio_stop_           = false;
+        audio_done_           = audio_streams_.empty();
+        video_position_valid_ = false;
+        video_done_           = video_streams_.empty();
+    }
+    demuxer_.start(fmtctx_, streams, no_starve);
+    if (!audio_streams_.empty()) {
+        audio_thread_ = std::thread([this] { decode_audio(); });
     }
-    return -1;
+    reading_ = true;
 }
 
+void RawAVFile::stop_reading()
+{
+    {
+        lock_t _(audio_mutex_);
+        audio_stop_ = true;
+        audio_cond_.notify_all();
+    }
+    if (audio_thread_.joinable()) {
+        audio_thread_.join();
+    }
+    demuxer_.stop();
+    lock_t _(audio_mutex_);
+    audio_frames_.clear();
+    reading_ = false;
 }
-void RawAVFile::run()
+
+void RawAVFile::update_video_position(index_t idx, const AVPacket& packet)
 {
+    duration_t time;
+    if (!get_packet_time(packet, video_streams_[idx].stream->time_base, time)) {
+        return;
+    }
+    lock_t _(audio_mutex_);
+    if (!video_position_valid_ || time > video_position_) {
+        video_position_       = time;
+        video_position_valid_ = true;
+        audio_cond_.notify_all();
+    }
+}
 
-    auto p_packet = std::unique_ptr<AVPacket, AVPacketDeleter>(av_packet_alloc());
-    auto p_empty_packet = std::unique_ptr<AVPacket, AVPacketDeleter>(av_packet_alloc());
+void RawAVFile::push_audio_frames()
+{
+    std::deque<std::pair<index_t, core::pFrame>> frames;
+    {
+        lock_t _(audio_mutex_);
+        std::swap(frames, audio_frames_);
+        audio_cond_.notify_all();
+    }
+    for (auto& f : frames) {
+        push_frame(f.first, std::move(f.second));
+    }
+}
 
-    auto& packet = *p_packet;
-    auto& empty_packet = *p_empty_packet;
+void RawAVFile::decode_audio()
+{
+    AVFrame*          av_frame = av_frame_alloc();
+    const auto        first    = video_streams_.size();
+    std::vector<bool> ended(audio_streams_.size(), false);
+    size_t            ended_count = 0;
+    while (ended_count < audio_streams_.size()) {
+        bool progress = false;
+        for (auto i : irange(audio_streams_.size())) {
+            if (ended[i])
+                continue;
+            {
+                lock_t lock(audio_mutex_);
+                audio_cond_.wait(lock, [this] { return audio_stop_ || audio_frames_.size() < max_audio_frames; });
+                if (audio_stop_)
+                    break;
+            }
+            demuxer_t::packet_t packet;
+            const auto          status = demuxer_.pop(first + i, packet, 5_ms);
+            if (status == demuxer_t::status_t::end) {
+                ended[i] = true;
+                ++ended_count;
+                continue;
+            }
+            if (status == demuxer_t::status_t::empty)
+                continue;
+            progress = true;
+            const auto ts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+            if (seek_target_valid_ && ts != AV_NOPTS_VALUE && get_stream_time(audio_streams_[i].stream, ts) < seek_target_) {
+                continue;
+            }
+            duration_t time;
+            if (get_packet_time(*packet, audio_streams_[i].stream->time_base, time)) {
+                // Keeps audio decoding paced by video, as it would be when decoding interleaved packets
+                lock_t lock(audio_mutex_);
+                audio_cond_.wait(lock, [&] { return audio_stop_ || video_done_ || !video_position_valid_ || time <= video_position_; });
+            }
+            decode_audio_frame(i, *packet, av_frame);
+        }
+        lock_t _(audio_mutex_);
+        if (audio_stop_)
+            break;
+        if (!progress && ended_count < audio_streams_.size()) {
+            audio_cond_.wait_for(_, std::chrono::milliseconds(1));
+        }
+    }
+    av_frame_free(&av_frame);
+    lock_t _(audio_mutex_);
+    audio_done_ = true;
+}
 
-//    AVPacket empty_packet;
-//    av_init_packet(&empty_packet);
+void RawAVFile::run()
+{
+    auto p_empty_packet = std::unique_ptr<AVPacket, AVPacketDeleter>(av_packet_alloc());
+    auto& empty_packet = *p_empty_packet;
     empty_packet.data    = nullptr;
     empty_packet.size    = 0;
-    bool     keep_packet = false;
-    bool     finishing   = false;
     AVFrame* av_frame    = av_frame_alloc();
+    // Streams that reached end of file and were completely drained from the decoder
+    std::vector<bool> video_ended;
 
     next_times_.resize(video_streams_.size(), timestamp_t{});
 
@@ -645,56 +876,72 @@ void RawAVFile::run()
             }
         }
 
+        if (seek_requested_) {
+            seek_requested_ = false;
+            seek_to(1_us * static_cast<int64_t>(seek_time_ * 1e6));
+        }
+        if (!reading_) {
+            start_reading();
+            video_ended.assign(video_streams_.size(), false);
+        }
+        push_audio_frames();
+
         if (paused_ || !push_ready_frames()) {
             sleep(get_latency());
             continue;
         }
 
-        if (!keep_packet) {
-            av_packet_unref(&packet);
-            if (av_read_frame(fmtctx_, &packet) < 0) {
-                finishing = true;
-            }
-        }
-
-        if (finishing) {
-            bool done = true;
-            for (auto i : irange(video_streams_.size())) {
-                if (!frames_[i]) {
-                    decode_video_frame(i, empty_packet, av_frame, keep_packet);
+        bool progress = false;
+        bool all_ended = true;
+        for (auto i : irange(video_streams_.size())) {
+            if (video_ended[i])
+                continue;
+            all_ended = false;
+            if (frames_[i])
+                continue;
+            demuxer_t::packet_t packet;
+            const auto status = demuxer_.pop(i, packet, 0_us);
+            if (status == demuxer_t::status_t::empty)
+                continue;
+            progress = true;
+            if (status == demuxer_t::status_t::end) {
+                // Drains frames remaining in the decoder
+                if (!decode_ || !decode_video_frame(i, empty_packet, av_frame)) {
+                    video_ended[i] = true;
                 }
-                if (frames_[i])
-                    done = false;
+                continue;
             }
-            if (done) {
-                finishing = false;
-                reset_    = true;
+            update_video_position(i, *packet);
+            const auto ts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+            if (!decode_ && ts != AV_NOPTS_VALUE && past_out_point(get_stream_time(video_streams_[i].stream, ts))) {
+                reset_ = true;
+                break;
             }
-            continue;
-        }
-
-        auto idx = find_in_stream_group(packet.stream_index, video_streams_);
-        if (idx >= 0) {
             if (!decode_) {
-                process_undecoded_frame(idx, packet);
+                process_undecoded_frame(i, *packet);
             } else {
-                if (!decode_video_frame(idx, packet, av_frame, keep_packet))
-                    continue;
-            }
-        } else {
-            idx = find_in_stream_group(packet.stream_index, audio_streams_);
-            if (idx < 0) {
-                continue;
+                decode_video_frame(i, *packet, av_frame);
             }
+        }
 
-            if (!decode_audio_frame(idx, packet, av_frame, keep_packet)) {
+        if (all_ended) {
+            lock_t lock(audio_mutex_);
+            if (!video_done_) {
+                video_done_ = true;
+                audio_cond_.notify_all();
+            }
+            if (audio_done_ && audio_frames_.empty()) {
+                reset_ = true;
                 continue;
             }
         }
+        if (!progress) {
+            // Waiting for demuxer or audio decoder
+            sleep(1_ms);
+        }
     }
+    stop_reading();
     av_free(av_frame);
-
-    av_packet_unref(&empty_packet);
 }
 
 void RawAVFile::jump_times(const duration_t& delta)
@@ -725,6 +972,13 @@ bool RawAVFile::set_param(const core::Parameter& parameter)
         (threads_, "threads")                                                     //
         (keep_open_, "keep_open")                                                 //
         (black_on_end_, "black_on_end")                                           //
+        (allow_padding_, "allow_padding")                                         //
+        (readahead_bytes_, "readahead_bytes")                                     //
+        (readahead_time_, "readahead_time")                                       //
+        .parsed<std::string>(seek_index_mode_, "seek_index", parse_seek_index_mode) //
+        (cache_index_, "cache_index")                                             //
+        (in_point_, "in_point")                                                   //
+        (out_point_, "out_point")                                                 //
         .parsed<std::string>(thread_type_, "thread_type", libav::parse_thread_type)//
         )
         return true;
@@ -765,6 +1019,22 @@ bool RawAVFile::do_process_event(const std::string& event_name, const event::pBa
             }
         }
     }
+    if (assign_events(event_name, event) //
+        (in_point_, "in_point")          //
+        (out_point_, "out_point"))
+        return true;
+    if (event_name == "seek") {
+        seek_time_      = event::lex_cast_value<double>(event);
+        seek_requested_ = true;
+        return true;
+    }
+    if (event_name == "seek_frame") {
+        if (video_streams_.empty())
+            return false;
+        seek_time_      = event::lex_cast_value<int64_t>(event) * video_streams_[0].delta.value / 1e6;
+        seek_requested_ = true;
+        return true;
+    }
     duration_t skip_time;
     if (assign_events(event_name, event)(skip_time, "skip", "skip_time")) {
         jump_times(-skip_time);
@@ -788,7 +1058,10 @@ std::string RawAVFile::get_next_filename() {
     return n;
 }
 
-RawAVFile::~RawAVFile() noexcept = default;
+RawAVFile::~RawAVFile() noexcept
+{
+    stop_reading();
+}
 
 } /* namespace video */
 } /* namespace yuri */
@@ -12,6 +12,8 @@
 #define AVDEMUXER_H_
 
 #include "avcommon.h"
+#include "demuxer.h"
+#include "seek_index.h"
 #include "yuri/core/thread/IOFilter.h"
 #include "yuri/event/BasicEventConsumer.h"
 #include "yuri/event/BasicEventProducer.h"
@@ -21,6 +23,7 @@ extern "C" {
 #include <libavformat/avformat.h>
 }
 
+#include <deque>
 #include <vector>
 
 namespace yuri {
@@ -45,8 +48,25 @@ protected:
     bool process_file_end();
 
     bool process_undecoded_frame(index_t idx, const AVPacket& packet);
-    bool decode_video_frame(index_t idx, AVPacket& packet, AVFrame* av_frame, bool& keep_packet);
-    bool decode_audio_frame(index_t idx, const AVPacket& packet, AVFrame* av_frame, bool& keep_packet);
+    bool decode_video_frame(index_t idx, AVPacket& packet, AVFrame* av_frame);
+    bool decode_audio_frame(index_t idx, const AVPacket& packet, AVFrame* av_frame);
+
+    //! Starts demuxing and audio decoding threads for current file
+    void start_reading();
+    //! Stops demuxing and audio decoding, so the file can be seeked or closed
+    void stop_reading();
+    //! Body of audio decoding thread
+    void decode_audio();
+    void push_audio_frames();
+    void update_video_position(index_t idx, const AVPacket& packet);
+
+    void build_seek_index();
+    /*!
+     * Seeks to the keyframe before @em time (relative to the start of the first video stream)
+     * and makes decoding drop all frames before @em time.
+     */
+    bool seek_to(duration_t time);
+    bool past_out_point(duration_t time) const;
 
     bool emit_extradata(index_t idx, format_t format);
     void jump_times(const duration_t& delta);
@@ -90,9 +110,39 @@ private:
     bool        paused_;
     bool        keep_open_;
     bool        black_on_end_;
+    bool        allow_padding_;
     timestamp_t pause_start_;
 
     std::unique_ptr<core::Convert> blank_converter_;
+
+    size_t    readahead_bytes_;
+    double    readahead_time_;
+    demuxer_t demuxer_;
+    bool      reading_;
+
+    std::thread       audio_thread_;
+    std::mutex        audio_mutex_;
+    std::condition_variable audio_cond_;
+    //! Decoded audio frames with their output index, pushed out from the main thread
+    std::deque<std::pair<index_t, core::pFrame>> audio_frames_;
+    bool              audio_stop_;
+    bool              audio_done_;
+    //! Time of the last video packet taken for decoding, audio is not decoded past this time
+    duration_t        video_position_;
+    bool              video_position_valid_;
+    bool              video_done_;
+
+    seek_index_mode_t seek_index_mode_;
+    bool              cache_index_;
+    seek_index_t      seek_index_;
+    //! Start and end of played part of the file, in seconds (negative out point plays to the end)
+    double            in_point_;
+    double            out_point_;
+    double            seek_time_;
+    bool              seek_requested_;
+    //! After seek, frames and audio packets before this time (from the start of their stream) are dropped
+    duration_t        seek_target_;
+    bool              seek_target_valid_;
 };
 
 } /* namespace video */
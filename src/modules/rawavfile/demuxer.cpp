@@ -0,0 +1,145 @@
+/*!
+ * @file 		demuxer.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "demuxer.h"
+#include <chrono>
+
+namespace yuri {
+namespace rawavfile {
+
+bool get_packet_time(const AVPacket& packet, AVRational time_base, duration_t& time)
+{
+	const int64_t ts = packet.pts != AV_NOPTS_VALUE ? packet.pts : packet.dts;
+	if (ts == AV_NOPTS_VALUE) return false;
+	time = 1_us * av_rescale_q(ts, time_base, AVRational{1, 1000000});
+	return true;
+}
+
+demuxer_t::demuxer_t(size_t max_bytes, duration_t max_duration)
+:ctx_(nullptr),max_bytes_(max_bytes),max_duration_(max_duration),
+ bytes_(0),eof_(false),stop_(false)
+{
+}
+
+demuxer_t::~demuxer_t() noexcept
+{
+	stop();
+}
+
+void demuxer_t::set_limits(size_t max_bytes, duration_t max_duration)
+{
+	std::unique_lock<std::mutex> _(mutex_);
+	max_bytes_ = max_bytes;
+	max_duration_ = max_duration;
+	cond_.notify_all();
+}
+
+void demuxer_t::start(AVFormatContext* ctx, const std::vector<int>& streams, const std::vector<bool>& no_starve)
+{
+	stop();
+	ctx_ = ctx;
+	slots_.assign(ctx->nb_streams, -1);
+	// Constructed at once, as queue_t can't be copied when the vector grows
+	queues_ = std::vector<queue_t>(streams.size());
+	for (size_t i = 0; i < streams.size(); ++i) {
+		slots_[streams[i]] = static_cast<int>(i);
+		queues_[i].time_base = ctx->streams[streams[i]]->time_base;
+		queues_[i].no_starve = i < no_starve.size() && no_starve[i];
+	}
+	bytes_ = 0;
+	eof_ = false;
+	stop_ = false;
+	thread_ = std::thread([this]{ read_packets(); });
+}
+
+void demuxer_t::stop()
+{
+	{
+		std::unique_lock<std::mutex> _(mutex_);
+		stop_ = true;
+		cond_.notify_all();
+	}
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+	std::unique_lock<std::mutex> _(mutex_);
+	queues_.clear();
+	bytes_ = 0;
+	ctx_ = nullptr;
+}
+
+demuxer_t::status_t demuxer_t::pop(size_t slot, packet_t& packet, duration_t timeout)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (slot >= queues_.size()) return status_t::end;
+	auto& queue = queues_[slot].packets;
+	cond_.wait_for(lock, std::chrono::microseconds(timeout.value),
+			[&]{ return !queue.empty() || eof_ || stop_; });
+	if (queue.empty()) {
+		return eof_ ? status_t::end : status_t::empty;
+	}
+	packet = std::move(queue.front());
+	queue.pop_front();
+	bytes_ -= packet->size;
+	cond_.notify_all();
+	return status_t::packet;
+}
+
+bool demuxer_t::limits_reached() const
+{
+	if (bytes_ >= max_bytes_) return true;
+	for (const auto& q: queues_) {
+		if (q.packets.size() < 2) continue;
+		duration_t first, last;
+		if (get_packet_time(*q.packets.front(), q.time_base, first) &&
+				get_packet_time(*q.packets.back(), q.time_base, last) &&
+				last - first >= max_duration_) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool demuxer_t::starving() const
+{
+	for (const auto& q: queues_) {
+		if (q.no_starve && q.packets.empty()) return true;
+	}
+	return false;
+}
+
+void demuxer_t::read_packets()
+{
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cond_.wait(lock, [this]{ return stop_ || !limits_reached() || starving(); });
+			if (stop_) return;
+		}
+		packet_t packet(av_packet_alloc());
+		// The context is used only by this thread, so it's read without holding the lock
+		const bool ok = packet && av_read_frame(ctx_, packet.get()) >= 0;
+		std::unique_lock<std::mutex> _(mutex_);
+		if (!ok) {
+			eof_ = true;
+			cond_.notify_all();
+			return;
+		}
+		const auto index = packet->stream_index;
+		if (index < 0 || static_cast<size_t>(index) >= slots_.size() || slots_[index] < 0) {
+			continue;
+		}
+		bytes_ += packet->size;
+		queues_[slots_[index]].packets.push_back(std::move(packet));
+		cond_.notify_all();
+	}
+}
+
+}
+}
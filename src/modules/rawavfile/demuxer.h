@@ -0,0 +1,106 @@
+/*!
+ * @file 		demuxer.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Demuxing thread with bounded per-stream packet queues.
+ */
+
+#ifndef MODULES_RAWAVFILE_DEMUXER_H_
+#define MODULES_RAWAVFILE_DEMUXER_H_
+
+#include "yuri/core/utils/time_types.h"
+extern "C" {
+#include <libavformat/avformat.h>
+}
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yuri {
+namespace rawavfile {
+
+/*!
+ * Presentation time of a packet (or decoding time if presentation time is missing).
+ * @return false if the packet has no timestamp
+ */
+bool get_packet_time(const AVPacket& packet, AVRational time_base, duration_t& time);
+
+/*!
+ * Reads packets from a format context in a separate thread, so slow reads don't stall decoding.
+ *
+ * Packets are read ahead into a queue for each stream, until the queues hold
+ * @em max_bytes bytes or @em max_duration of any stream.
+ */
+class demuxer_t {
+public:
+	struct packet_deleter_t {
+		void operator()(AVPacket* p) const { av_packet_free(&p); }
+	};
+	using packet_t = std::unique_ptr<AVPacket, packet_deleter_t>;
+	enum class status_t {
+		packet,
+		empty,
+		end
+	};
+
+	demuxer_t(size_t max_bytes, duration_t max_duration);
+	~demuxer_t() noexcept;
+	demuxer_t(const demuxer_t&) = delete;
+	demuxer_t& operator=(const demuxer_t&) = delete;
+
+	void set_limits(size_t max_bytes, duration_t max_duration);
+
+	/*!
+	 * Starts reading packets from @em ctx. The context must not be used by anyone else until stop() is called.
+	 * @param streams		Indices of streams to read. Packets of other streams are dropped.
+	 * @param no_starve		For each stream, whether reading should continue when the queue of the stream
+	 * 						is empty, even if the limits were reached (to avoid deadlock on badly interleaved files)
+	 */
+	void start(AVFormatContext* ctx, const std::vector<int>& streams, const std::vector<bool>& no_starve);
+	//! Stops the reading thread and drops all queued packets
+	void stop();
+	bool running() const { return thread_.joinable(); }
+
+	/*!
+	 * Takes next packet of a stream.
+	 * @param slot		Position of the stream in the vector passed to start()
+	 * @param timeout	Maximal time to wait for a packet
+	 * @return status_t::end if there are no more packets for the stream
+	 */
+	status_t pop(size_t slot, packet_t& packet, duration_t timeout);
+
+private:
+	struct queue_t {
+		std::deque<packet_t> packets;
+		AVRational time_base;
+		bool no_starve;
+	};
+
+	void read_packets();
+	bool limits_reached() const;
+	bool starving() const;
+
+	AVFormatContext* ctx_;
+	//! Maps stream index to position in queues_ (or -1)
+	std::vector<int> slots_;
+	std::vector<queue_t> queues_;
+	size_t max_bytes_;
+	duration_t max_duration_;
+	size_t bytes_;
+	bool eof_;
+	bool stop_;
+	mutable std::mutex mutex_;
+	std::condition_variable cond_;
+	std::thread thread_;
+};
+
+}
+}
+
+#endif /* MODULES_RAWAVFILE_DEMUXER_H_ */
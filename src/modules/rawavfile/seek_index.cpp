@@ -0,0 +1,92 @@
+/*!
+ * @file 		seek_index.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "seek_index.h"
+#include <algorithm>
+#include <fstream>
+
+namespace yuri {
+namespace rawavfile {
+
+namespace {
+const std::string index_magic = "yuri-keyframes";
+const int index_version = 1;
+
+int64_t get_file_size(const std::string& filename)
+{
+	std::ifstream f(filename, std::ios::binary | std::ios::ate);
+	if (!f) return -1;
+	return static_cast<int64_t>(f.tellg());
+}
+}
+
+seek_index_mode_t parse_seek_index_mode(const std::string& mode)
+{
+	if (mode == "none") {
+		return seek_index_mode_t::none;
+	} else if (mode == "scan") {
+		return seek_index_mode_t::scan;
+	}
+	return seek_index_mode_t::container;
+}
+
+bool seek_index_t::load(const std::string& path, const std::string& filename, int stream)
+{
+	entries_.clear();
+	std::ifstream f(path);
+	std::string magic;
+	int version = 0, index_stream = -1;
+	int64_t file_size = -1;
+	size_t count = 0;
+	if (!(f >> magic >> version >> index_stream >> file_size >> count)) return false;
+	if (magic != index_magic || version != index_version || index_stream != stream ||
+			file_size != get_file_size(filename)) {
+		return false;
+	}
+	entries_.reserve(count);
+	entry_t e;
+	while (entries_.size() < count && (f >> e.pts >> e.pos)) {
+		entries_.push_back(e);
+	}
+	if (entries_.size() != count) {
+		entries_.clear();
+		return false;
+	}
+	sort();
+	return !entries_.empty();
+}
+
+bool seek_index_t::save(const std::string& path, const std::string& filename, int stream) const
+{
+	std::ofstream f(path);
+	if (!f) return false;
+	f << index_magic << " " << index_version << " " << stream << " "
+			<< get_file_size(filename) << " " << entries_.size() << "\n";
+	for (const auto& e: entries_) {
+		f << e.pts << " " << e.pos << "\n";
+	}
+	return static_cast<bool>(f);
+}
+
+const seek_index_t::entry_t* seek_index_t::find(int64_t pts) const
+{
+	auto it = std::upper_bound(entries_.begin(), entries_.end(), pts,
+			[](int64_t p, const entry_t& e) { return p < e.pts; });
+	if (it == entries_.begin()) return nullptr;
+	return &*(it - 1);
+}
+
+void seek_index_t::sort()
+{
+	std::sort(entries_.begin(), entries_.end(),
+			[](const entry_t& a, const entry_t& b) { return a.pts < b.pts; });
+}
+
+}
+}
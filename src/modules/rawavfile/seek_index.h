@@ -0,0 +1,81 @@
+/*!
+ * @file 		seek_index.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Index of keyframes in a stream, used for accurate seeking.
+ */
+
+#ifndef MODULES_RAWAVFILE_SEEK_INDEX_H_
+#define MODULES_RAWAVFILE_SEEK_INDEX_H_
+
+#include "yuri/core/utils/new_types.h"
+#include <string>
+#include <vector>
+
+struct AVFormatContext;
+
+namespace yuri {
+namespace rawavfile {
+
+enum class seek_index_mode_t {
+	//! No index, seeking relies on libavformat only
+	none,
+	//! Keyframes known to the container (e.g. from mp4 or mkv index)
+	container,
+	//! Keyframes from the container, or from reading the whole stream if the container doesn't have any
+	scan
+};
+
+seek_index_mode_t parse_seek_index_mode(const std::string& mode);
+
+class seek_index_t {
+public:
+	struct entry_t {
+		//! Presentation time in time base of the stream
+		int64_t pts;
+		//! Position in the file, -1 if unknown
+		int64_t pos;
+	};
+
+	// build_from_container() and build_from_file() are implemented in seek_index_libav.cpp
+	/*!
+	 * Collects keyframes of stream @em stream from the index already loaded by libavformat.
+	 * @return false if the container doesn't provide any keyframes
+	 */
+	bool build_from_container(const AVFormatContext* ctx, int stream);
+	/*!
+	 * Opens @em filename separately and reads all packets of stream @em stream to find keyframes.
+	 * @return false if the file can't be read or there are no keyframes
+	 */
+	bool build_from_file(const std::string& filename, int stream);
+
+	/*!
+	 * Loads index stored by save(). The index is rejected if it was created
+	 * for a different stream or a file with different size.
+	 */
+	bool load(const std::string& path, const std::string& filename, int stream);
+	bool save(const std::string& path, const std::string& filename, int stream) const;
+
+	bool empty() const { return entries_.empty(); }
+	size_t size() const { return entries_.size(); }
+	void clear() { entries_.clear(); }
+
+	/*!
+	 * Finds last keyframe at or before @em pts
+	 * @return nullptr if there's no such keyframe
+	 */
+	const entry_t* find(int64_t pts) const;
+
+private:
+	void sort();
+
+	std::vector<entry_t> entries_;
+};
+
+}
+}
+
+#endif /* MODULES_RAWAVFILE_SEEK_INDEX_H_ */
@@ -0,0 +1,79 @@
+/*!
+ * @file 		seek_index_libav.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Parts of seek_index_t reading the index from libavformat.
+ */
+
+#include "seek_index.h"
+#include "avcommon.h"
+extern "C" {
+#include <libavformat/avformat.h>
+}
+#include <memory>
+
+namespace yuri {
+namespace rawavfile {
+
+bool seek_index_t::build_from_container(const AVFormatContext* ctx, int stream)
+{
+	entries_.clear();
+	if (!ctx || stream < 0 || static_cast<unsigned>(stream) >= ctx->nb_streams) return false;
+	AVStream* st = ctx->streams[stream];
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+	const int count = avformat_index_get_entries_count(st);
+	for (int i = 0; i < count; ++i) {
+		const AVIndexEntry* e = avformat_index_get_entry(st, i);
+		if (e && (e->flags & AVINDEX_KEYFRAME)) {
+			entries_.push_back({e->timestamp, e->pos});
+		}
+	}
+#else
+	for (int i = 0; i < st->nb_index_entries; ++i) {
+		const AVIndexEntry& e = st->index_entries[i];
+		if (e.flags & AVINDEX_KEYFRAME) {
+			entries_.push_back({e.timestamp, e.pos});
+		}
+	}
+#endif
+	sort();
+	return !entries_.empty();
+}
+
+bool seek_index_t::build_from_file(const std::string& filename, int stream)
+{
+	entries_.clear();
+	AVFormatContext* ctx = nullptr;
+	{
+		auto lock = libav::get_libav_lock();
+		if (avformat_open_input(&ctx, filename.c_str(), nullptr, nullptr) < 0) return false;
+	}
+	if (stream >= 0 && static_cast<unsigned>(stream) < ctx->nb_streams) {
+		// Only packet headers of a single stream are needed
+		for (unsigned i = 0; i < ctx->nb_streams; ++i) {
+			if (static_cast<int>(i) != stream) ctx->streams[i]->discard = AVDISCARD_ALL;
+		}
+		std::unique_ptr<AVPacket, AVPacketDeleter> packet(av_packet_alloc());
+		while (packet && av_read_frame(ctx, packet.get()) >= 0) {
+			if (packet->stream_index == stream && (packet->flags & AV_PKT_FLAG_KEY)) {
+				const int64_t pts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+				if (pts != AV_NOPTS_VALUE) {
+					entries_.push_back({pts, packet->pos});
+				}
+			}
+			av_packet_unref(packet.get());
+		}
+	}
+	{
+		auto lock = libav::get_libav_lock();
+		avformat_close_input(&ctx);
+	}
+	sort();
+	return !entries_.empty();
+}
+
+}
+}
@@ -0,0 +1,241 @@
+/*!
+ * @file 		RawContainerDump.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "RawContainerDump.h"
+#include "yuri/core/Module.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/frame/CompressedVideoFrame.h"
+#include "yuri/core/frame/RawAudioFrame.h"
+#include "yuri/core/utils/DirectoryBrowser.h"
+#include "yuri/core/utils/platform.h"
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yuri {
+namespace rawcontainer {
+
+IOTHREAD_GENERATOR(RawContainerDump)
+
+namespace {
+#ifdef IOV_MAX
+const size_t max_iovecs = IOV_MAX;
+#else
+const size_t max_iovecs = 1024;
+#endif
+const uint8_t zero_padding[chunk_alignment] = {};
+
+int64_t to_us(const timestamp_t& ts)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(ts.value.time_since_epoch()).count();
+}
+}
+
+core::Parameters RawContainerDump::configure()
+{
+	core::Parameters p = core::IOFilter::configure();
+	p.set_description("Records frames into a raw container with format, resolution and timing of every frame. Supports raw video, compressed video and raw audio.");
+	p["filename"]["Required parameter. Path of the file to record to"]=std::string();
+	p["append"]["Append to existing file. Index of a file that wasn't closed properly is rebuilt."]=false;
+	p["sync"]["Flush data to the disk after every N frames, 0 to leave it to the system"]=0;
+	return p;
+}
+
+RawContainerDump::RawContainerDump(log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
+core::IOFilter(log_,parent,std::string("raw_container_dump")),append_(false),sync_frames_(0),
+fd_(-1),offset_(0),next_timestamp_(0),timestamp_shift_(0),shift_known_(true),
+failed_(false),unsupported_reported_(false)
+{
+	IOTHREAD_INIT(parameters)
+	if (filename_.empty()) throw exception::InitializationFailed("No filename specified");
+	open_file();
+}
+
+RawContainerDump::~RawContainerDump() noexcept
+{
+	close_file();
+}
+
+void RawContainerDump::open_file()
+{
+	core::filesystem::ensure_path_directory(filename_);
+	fd_ = ::open(filename_.c_str(), O_RDWR | O_CREAT | (append_ ? 0 : O_TRUNC), 0666);
+	if (fd_ < 0) {
+		throw exception::InitializationFailed("Failed to open " + filename_ + ": " + std::strerror(errno));
+	}
+	struct stat st;
+	const uint64_t file_size = ::fstat(fd_, &st) == 0 ? st.st_size : 0;
+	if (file_size == 0) {
+		const auto header = make_file_header();
+		if (::pwrite(fd_, &header, sizeof(header), 0) != sizeof(header)) {
+			throw exception::InitializationFailed("Failed to write header to " + filename_);
+		}
+		offset_ = sizeof(header);
+		return;
+	}
+	file_header_t header;
+	if (!read_at(fd_, 0, &header, sizeof(header)) || !check_file_header(header)) {
+		throw exception::InitializationFailed(filename_ + " is not a raw container, refusing to append to it");
+	}
+	auto index = read_index(fd_, file_size);
+	if (index.recovered) {
+		log[log::warning] << filename_ << " wasn't closed properly, recovered " << index.entries.size() << " frames";
+	}
+	entries_ = std::move(index.entries);
+	offset_ = index.data_end;
+	// Removes the index and any incomplete chunk, new frames are written over them
+	if (::ftruncate(fd_, offset_) != 0) {
+		throw exception::InitializationFailed("Failed to truncate " + filename_ + ": " + std::strerror(errno));
+	}
+	chunk_t last;
+	if (!entries_.empty() && read_chunk(fd_, entries_.back().offset, offset_, last)) {
+		next_timestamp_ = last.header.timestamp + last.header.duration;
+		shift_known_ = false;
+	}
+	log[log::info] << "Appending to " << filename_ << " after " << entries_.size() << " frames";
+}
+
+void RawContainerDump::close_file()
+{
+	if (fd_ < 0) return;
+	if (!failed_) {
+		// The index is written after the data, so a crash while writing it leaves the chunks intact
+		const auto trailer = make_trailer(offset_, entries_);
+		std::vector<iovec> vectors {
+			{const_cast<index_entry_t*>(entries_.data()), entries_.size() * sizeof(index_entry_t)},
+			{const_cast<trailer_t*>(&trailer), sizeof(trailer)}};
+		if (!write_vectors(vectors)) {
+			log[log::error] << "Failed to write index to " << filename_;
+		}
+	}
+	::close(fd_);
+	fd_ = -1;
+}
+
+bool RawContainerDump::write_vectors(std::vector<iovec>& vectors)
+{
+	size_t index = 0;
+	while (index < vectors.size()) {
+		if (!vectors[index].iov_len) {
+			++index;
+			continue;
+		}
+		const auto count = static_cast<int>(std::min(vectors.size() - index, max_iovecs));
+		const auto written = ::pwritev(fd_, &vectors[index], count, offset_);
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) {
+			log[log::error] << "Failed to write to " << filename_ << ": " << (written < 0 ? std::strerror(errno) : "no data written");
+			return false;
+		}
+		offset_ += written;
+		auto left = static_cast<size_t>(written);
+		while (index < vectors.size() && left >= vectors[index].iov_len) {
+			left -= vectors[index].iov_len;
+			++index;
+		}
+		if (left > 0) {
+			vectors[index].iov_base = static_cast<uint8_t*>(vectors[index].iov_base) + left;
+			vectors[index].iov_len -= left;
+		}
+	}
+	return true;
+}
+
+core::pFrame RawContainerDump::do_simple_single_step(core::pFrame frame)
+{
+	if (failed_) return {};
+	chunk_header_t header;
+	std::memset(&header, 0, sizeof(header));
+	std::vector<plane_info_t> planes;
+	// The first vector is reserved for the header
+	std::vector<iovec> vectors(1);
+	auto add_plane = [&](const uint8_t* data, size_t size, size_t line_size) {
+		planes.push_back({size, static_cast<uint32_t>(line_size), 0});
+		vectors.push_back({const_cast<uint8_t*>(data), size});
+		header.payload_size += size;
+	};
+	if (auto f = std::dynamic_pointer_cast<core::RawVideoFrame>(frame)) {
+		header.type = static_cast<uint32_t>(frame_type_t::raw_video);
+		header.width = f->get_width();
+		header.height = f->get_height();
+		for (size_t i = 0; i < f->get_planes_count() && i < max_planes; ++i) {
+			add_plane(PLANE_RAW_DATA(f,i), PLANE_SIZE(f,i), PLANE_DATA(f,i).get_line_size());
+		}
+	} else if (auto f2 = std::dynamic_pointer_cast<core::CompressedVideoFrame>(frame)) {
+		header.type = static_cast<uint32_t>(frame_type_t::compressed_video);
+		header.width = f2->get_width();
+		header.height = f2->get_height();
+		// Segments are stored as a single plane
+		planes.push_back({0, 0, 0});
+		for (const auto& s: f2->get_segments()) {
+			vectors.push_back({const_cast<uint8_t*>(s.data), s.size});
+			planes[0].size += s.size;
+		}
+		header.payload_size = planes[0].size;
+	} else if (auto f3 = std::dynamic_pointer_cast<core::RawAudioFrame>(frame)) {
+		header.type = static_cast<uint32_t>(frame_type_t::raw_audio);
+		header.width = f3->get_channel_count();
+		header.height = f3->get_sampling_frequency();
+		add_plane(f3->data(), f3->size(), 0);
+	} else {
+		if (!unsupported_reported_) {
+			log[log::warning] << "Only raw video, compressed video and raw audio frames can be recorded, ignoring other frames";
+			unsupported_reported_ = true;
+		}
+		return {};
+	}
+	const auto timestamp = to_us(frame->get_timestamp());
+	if (!shift_known_) {
+		timestamp_shift_ = next_timestamp_ - timestamp;
+		shift_known_ = true;
+	}
+	header.format = frame->get_format();
+	header.timestamp = timestamp + timestamp_shift_;
+	header.duration = frame->get_duration().value;
+	header.index = frame->get_index();
+	seal_chunk_header(header, planes);
+
+	std::vector<uint8_t> head(header.header_size, 0);
+	std::copy_n(reinterpret_cast<const uint8_t*>(&header), sizeof(header), head.begin());
+	std::copy_n(reinterpret_cast<const uint8_t*>(planes.data()), planes.size() * sizeof(plane_info_t), head.begin() + sizeof(header));
+	vectors[0] = {head.data(), head.size()};
+	const auto chunk_offset = offset_;
+	const auto padding = align_size(chunk_offset + header.header_size + header.payload_size) - (chunk_offset + header.header_size + header.payload_size);
+	vectors.push_back({const_cast<uint8_t*>(zero_padding), padding});
+
+	if (!write_vectors(vectors)) {
+		failed_ = true;
+		return {};
+	}
+	entries_.push_back({chunk_offset, header.timestamp});
+	if (sync_frames_ && entries_.size() % sync_frames_ == 0) {
+#ifdef YURI_LINUX
+		::fdatasync(fd_);
+#else
+		::fsync(fd_);
+#endif
+	}
+	return {};
+}
+
+bool RawContainerDump::set_param(const core::Parameter& param)
+{
+	if (assign_parameters(param)
+			(filename_, "filename")
+			(append_, "append")
+			(sync_frames_, "sync"))
+		return true;
+	return core::IOFilter::set_param(param);
+}
+
+}
+}
@@ -0,0 +1,56 @@
+/*!
+ * @file 		RawContainerDump.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef RAWCONTAINERDUMP_H_
+#define RAWCONTAINERDUMP_H_
+
+#include "yuri/core/thread/IOFilter.h"
+#include "container_format.h"
+#include <sys/uio.h>
+#include <string>
+#include <vector>
+
+namespace yuri {
+namespace rawcontainer {
+
+class RawContainerDump: public core::IOFilter
+{
+public:
+	IOTHREAD_GENERATOR_DECLARATION
+	static core::Parameters configure();
+	RawContainerDump(log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters);
+	virtual ~RawContainerDump() noexcept;
+private:
+	virtual core::pFrame do_simple_single_step(core::pFrame frame) override;
+	virtual bool set_param(const core::Parameter& param) override;
+	void open_file();
+	//! Writes the index and the trailer and closes the file
+	void close_file();
+	bool write_vectors(std::vector<iovec>& vectors);
+
+	std::string filename_;
+	bool append_;
+	size_t sync_frames_;
+
+	int fd_;
+	uint64_t offset_;
+	std::vector<index_entry_t> entries_;
+	//! Timestamp following the last frame of the file opened for appending
+	int64_t next_timestamp_;
+	//! Shift of timestamps of appended frames, so they continue after the frames already in the file
+	int64_t timestamp_shift_;
+	bool shift_known_;
+	bool failed_;
+	bool unsupported_reported_;
+};
+
+}
+}
+
+#endif /* RAWCONTAINERDUMP_H_ */
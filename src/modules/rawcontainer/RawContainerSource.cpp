@@ -0,0 +1,302 @@
+/*!
+ * @file 		RawContainerSource.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "RawContainerSource.h"
+#include "yuri/core/Module.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/frame/CompressedVideoFrame.h"
+#include "yuri/core/frame/RawAudioFrame.h"
+#include "yuri/core/frame/raw_frame_params.h"
+#include "yuri/core/utils/assign_events.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yuri {
+namespace rawcontainer {
+
+IOTHREAD_GENERATOR(RawContainerSource)
+
+//! File mapped to memory, unmapped when the last frame referencing it is released
+struct mapped_file_t {
+	uint8_t* data;
+	size_t size;
+	mapped_file_t(uint8_t* data, size_t size):data(data),size(size) {}
+	~mapped_file_t() noexcept {
+		::munmap(data, size);
+	}
+};
+
+namespace {
+
+//! Keeps the mapping alive as long as a frame references it
+struct mapping_deleter {
+	std::shared_ptr<mapped_file_t> mapping;
+	void operator()(void*) const noexcept {}
+};
+
+/*!
+ * The mapping is private and writable, so consumers modifying the frames
+ * change only their copy of the pages, never the file. The changes stay in the mapping
+ * though, so frames played again have to come from a new mapping (see RawContainerSource::seek).
+ */
+std::shared_ptr<mapped_file_t> map_file(int fd, uint64_t size)
+{
+	if (!size) return {};
+	void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) return {};
+	return std::make_shared<mapped_file_t>(static_cast<uint8_t*>(data), size);
+}
+
+//! Inverse of the conversion in RawContainerDump, restores the recorded timestamp
+timestamp_t from_us(int64_t us)
+{
+	return timestamp_t{detail::time_point{} + std::chrono::microseconds(us)};
+}
+
+//! Playback that fell behind more than this continues from the current frame, instead of catching up
+const duration_t max_delay = 1_s;
+
+}
+
+core::Parameters RawContainerSource::configure()
+{
+	core::Parameters p = core::IOThread::configure();
+	p.set_description("Plays frames recorded by raw_container_dump, with their original format, resolution and timing.");
+	p["path"]["Path to the file"]=std::string();
+	p["loop"]["Start again from the beginning after reaching the end of the file"]=false;
+	p["keep_alive"]["Stay idle after playing the file (setting to false will cause the object to quit afterward)"]=true;
+	p["speed"]["Playback speed relative to the original timing, 0 to output frames as fast as possible"]=1.0;
+	p["mmap"]["Map the file to memory and output frames referencing it, without copying"]=true;
+	p["readahead"]["Number of frames to prefetch"]=4;
+	p["start_frame"]["Index of the first frame to play"]=0;
+	return p;
+}
+
+RawContainerSource::RawContainerSource(log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
+core::IOThread(log_,parent,0,1,std::string("raw_container_source")),
+event::BasicEventConsumer(log),
+loop_(false),keep_alive_(true),speed_(1.0),mmap_(true),readahead_(4),position_(0),
+fd_(-1),file_size_(0),base_timestamp_(0),rebase_(true)
+{
+	IOTHREAD_INIT(parameters)
+	fd_ = ::open(path_.c_str(), O_RDONLY);
+	if (fd_ < 0) {
+		throw exception::InitializationFailed("Failed to open " + path_ + ": " + std::strerror(errno));
+	}
+	struct stat st;
+	file_size_ = ::fstat(fd_, &st) == 0 ? st.st_size : 0;
+	file_header_t header;
+	if (!read_at(fd_, 0, &header, sizeof(header)) || !check_file_header(header)) {
+		::close(fd_);
+		throw exception::InitializationFailed(path_ + " is not a raw container");
+	}
+	auto index = read_index(fd_, file_size_);
+	if (index.recovered) {
+		log[log::warning] << path_ << " wasn't closed properly, index rebuilt with " << index.entries.size() << " frames";
+	}
+	entries_ = std::move(index.entries);
+	log[log::info] << "Opened " << path_ << " with " << entries_.size() << " frames";
+	if (mmap_) {
+		mapping_ = map_file(fd_, file_size_);
+		if (!mapping_) {
+			log[log::warning] << "Failed to map " << path_ << ", reading the file instead";
+		}
+	}
+	if (position_ >= entries_.size()) {
+		log[log::warning] << "Start frame " << position_ << " is beyond the end of the file";
+	}
+}
+
+RawContainerSource::~RawContainerSource() noexcept
+{
+	if (fd_ >= 0) ::close(fd_);
+}
+
+void RawContainerSource::seek(size_t position)
+{
+	position = std::min(position, entries_.size());
+	if (mapping_ && position < position_) {
+		// Frames already sent may have been modified in place, the old mapping is released with them
+		mapping_ = map_file(fd_, file_size_);
+		if (!mapping_) {
+			log[log::warning] << "Failed to map " << path_ << " again, reading the file instead";
+		}
+	}
+	position_ = position;
+	rebase_ = true;
+}
+
+void RawContainerSource::run()
+{
+	while (still_running()) {
+		process_events();
+		if (position_ >= entries_.size()) {
+			if (!loop_ || entries_.empty()) break;
+			seek(0);
+		}
+		const auto& entry = entries_[position_];
+		if (rebase_) {
+			start_time_ = timestamp_t{};
+			base_timestamp_ = entry.timestamp;
+			rebase_ = false;
+		}
+		if (speed_ > 0.0) {
+			const auto due = start_time_ + duration_t{static_cast<int64_t>((entry.timestamp - base_timestamp_) / speed_)};
+			if (!wait_until(due)) {
+				continue;
+			}
+			const timestamp_t now;
+			if (now - due > max_delay) {
+				start_time_ = now;
+				base_timestamp_ = entry.timestamp;
+			}
+		}
+		if (auto frame = read_frame(position_)) {
+			push_frame(0, frame);
+		}
+		++position_;
+		if (readahead_ && position_ < entries_.size()) {
+			const auto start = entries_[position_].offset;
+			const auto last = std::min(position_ + readahead_, entries_.size());
+			const auto end = last < entries_.size() ? entries_[last].offset : file_size_;
+			if (mapping_) {
+				static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+				const auto aligned = start - start % page_size;
+				::madvise(mapping_->data + aligned, end - aligned, MADV_WILLNEED);
+			} else {
+				::posix_fadvise(fd_, start, end - start, POSIX_FADV_WILLNEED);
+			}
+		}
+	}
+	close_pipes();
+	if (keep_alive_) while (still_running()) {
+		ThreadBase::sleep(get_latency());
+	}
+	request_end();
+}
+
+core::pFrame RawContainerSource::read_frame(size_t position)
+{
+	chunk_t chunk;
+	if (!read_chunk(fd_, entries_[position].offset, file_size_, chunk)) {
+		log[log::warning] << "Frame " << position << " is damaged, skipping it";
+		return {};
+	}
+	const auto& header = chunk.header;
+	auto offset = chunk.data_offset();
+	try {
+		core::pFrame frame;
+		switch (static_cast<frame_type_t>(header.type)) {
+			case frame_type_t::raw_video: {
+				const resolution_t res {header.width, header.height};
+				const auto& fi = core::raw_format::get_format_info(header.format);
+				auto rframe = std::make_shared<core::RawVideoFrame>(header.format, res, 0);
+				for (size_t i = 0; i < chunk.planes.size(); ++i) {
+					const auto& plane = chunk.planes[i];
+					size_t line_size = plane.line_size;
+					resolution_t plane_res = res;
+					if (i < fi.planes.size()) {
+						size_t default_line_size;
+						std::tie(default_line_size, std::ignore, plane_res) = core::RawVideoFrame::get_plane_params(fi, i, res);
+						if (!line_size) line_size = default_line_size;
+					}
+					if (mapping_) {
+						core::Plane::vector_type data{mapping_->data + offset, plane.size, mapping_deleter{mapping_}};
+						rframe->emplace_back(std::move(data), plane_res, line_size);
+					} else {
+						rframe->emplace_back(plane.size, plane_res, line_size);
+						if (!read_at(fd_, offset, PLANE_RAW_DATA(rframe,i), plane.size)) return {};
+					}
+					offset += plane.size;
+				}
+				frame = rframe;
+			} break;
+			case frame_type_t::compressed_video: {
+				const resolution_t res {header.width, header.height};
+				if (mapping_) {
+					frame = std::make_shared<core::CompressedVideoFrame>(header.format, res,
+							core::CompressedVideoFrame::segments_t{{mapping_->data + offset, header.payload_size, mapping_}});
+				} else {
+					auto cframe = core::CompressedVideoFrame::create_empty(header.format, res, header.payload_size);
+					if (!read_at(fd_, offset, cframe->get_data().data(), header.payload_size)) return {};
+					frame = cframe;
+				}
+			} break;
+			case frame_type_t::raw_audio: {
+				if (mapping_) {
+					frame = core::RawAudioFrame::create_empty(header.format, header.width, header.height,
+							mapping_->data + offset, header.payload_size, mapping_deleter{mapping_});
+				} else {
+					uvector<uint8_t> data(header.payload_size);
+					if (!read_at(fd_, offset, data.data(), data.size())) return {};
+					frame = core::RawAudioFrame::create_empty(header.format, header.width, header.height, std::move(data));
+				}
+			} break;
+			default:
+				log[log::warning] << "Frame " << position << " has unsupported type " << header.type;
+				return {};
+		}
+		frame->set_timestamp(from_us(header.timestamp));
+		frame->set_duration(duration_t{header.duration});
+		frame->set_index(header.index);
+		return frame;
+	}
+	catch (std::exception& e) {
+		log[log::warning] << "Failed to read frame " << position << ": " << e.what();
+	}
+	return {};
+}
+
+bool RawContainerSource::set_param(const core::Parameter& param)
+{
+	if (assign_parameters(param)
+			(path_, "path")
+			(loop_, "loop")
+			(keep_alive_, "keep_alive")
+			(speed_, "speed")
+			(mmap_, "mmap")
+			(readahead_, "readahead")
+			(position_, "start_frame"))
+		return true;
+	return core::IOThread::set_param(param);
+}
+
+bool RawContainerSource::do_process_event(const std::string& event_name, const event::pBasicEvent& event)
+{
+	if (assign_events(event_name, event)
+			(loop_, "loop"))
+		return true;
+	if (event_name == "speed") {
+		speed_ = event::lex_cast_value<double>(event);
+		rebase_ = true;
+		return true;
+	}
+	if (event_name == "seek_frame") {
+		seek(event::lex_cast_value<size_t>(event));
+		return true;
+	}
+	if (event_name == "seek") {
+		// Time in seconds from the first frame
+		if (entries_.empty()) return true;
+		const auto target = entries_.front().timestamp + static_cast<int64_t>(event::lex_cast_value<double>(event) * 1e6);
+		const auto it = std::find_if(entries_.begin(), entries_.end(),
+				[target](const index_entry_t& e){ return e.timestamp >= target; });
+		seek(std::distance(entries_.begin(), it));
+		return true;
+	}
+	return false;
+}
+
+}
+}
@@ -0,0 +1,61 @@
+/*!
+ * @file 		RawContainerSource.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef RAWCONTAINERSOURCE_H_
+#define RAWCONTAINERSOURCE_H_
+
+#include "yuri/core/thread/IOThread.h"
+#include "yuri/event/BasicEventConsumer.h"
+#include "container_format.h"
+#include <memory>
+#include <string>
+
+namespace yuri {
+namespace rawcontainer {
+
+struct mapped_file_t;
+
+class RawContainerSource: public core::IOThread, public event::BasicEventConsumer
+{
+public:
+	IOTHREAD_GENERATOR_DECLARATION
+	static core::Parameters configure();
+	RawContainerSource(log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters);
+	virtual ~RawContainerSource() noexcept;
+private:
+	virtual void run() override;
+	virtual bool set_param(const core::Parameter& param) override;
+	virtual bool do_process_event(const std::string& event_name, const event::pBasicEvent& event) override;
+	//! Reads frame @em position from the file, referencing the mapping in mmap mode
+	core::pFrame read_frame(size_t position);
+	//! Continues playback from @em position, with timing relative to it. Going back maps the file again.
+	void seek(size_t position);
+
+	std::string path_;
+	bool loop_;
+	bool keep_alive_;
+	double speed_;
+	bool mmap_;
+	size_t readahead_;
+	size_t position_;
+
+	int fd_;
+	uint64_t file_size_;
+	std::vector<index_entry_t> entries_;
+	std::shared_ptr<mapped_file_t> mapping_;
+	//! Time when the frame with timestamp base_timestamp_ was (or would be) sent
+	timestamp_t start_time_;
+	int64_t base_timestamp_;
+	bool rebase_;
+};
+
+}
+}
+
+#endif /* RAWCONTAINERSOURCE_H_ */
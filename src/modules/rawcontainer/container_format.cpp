@@ -0,0 +1,150 @@
+/*!
+ * @file 		container_format.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "container_format.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+namespace yuri {
+namespace rawcontainer {
+
+namespace {
+const char file_magic[8] = {'Y', 'U', 'R', 'I', 'R', 'A', 'W', 'C'};
+//! "YCHK"
+const uint32_t chunk_magic = 0x4b484359;
+//! "YIDX"
+const uint32_t trailer_magic = 0x58444959;
+//! Limits size of headers read from damaged files
+const uint32_t max_header_size = 4096;
+
+//! FNV-1a
+uint64_t checksum(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL)
+{
+	auto p = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= p[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+uint64_t header_checksum(chunk_header_t header, const std::vector<plane_info_t>& planes)
+{
+	header.checksum = 0;
+	return checksum(planes.data(), planes.size() * sizeof(plane_info_t), checksum(&header, sizeof(header)));
+}
+
+}
+
+uint64_t chunk_t::end() const
+{
+	return align_size(data_offset() + header.payload_size);
+}
+
+file_header_t make_file_header()
+{
+	file_header_t header;
+	std::memset(&header, 0, sizeof(header));
+	std::copy(std::begin(file_magic), std::end(file_magic), header.magic);
+	header.version = format_version;
+	header.header_size = sizeof(file_header_t);
+	return header;
+}
+
+bool check_file_header(const file_header_t& header)
+{
+	return std::equal(std::begin(file_magic), std::end(file_magic), header.magic) &&
+			header.version == format_version &&
+			header.header_size == sizeof(file_header_t);
+}
+
+void seal_chunk_header(chunk_header_t& header, const std::vector<plane_info_t>& planes)
+{
+	header.magic = chunk_magic;
+	header.plane_count = static_cast<uint32_t>(planes.size());
+	header.header_size = static_cast<uint32_t>(align_size(sizeof(chunk_header_t) + planes.size() * sizeof(plane_info_t)));
+	header.checksum = header_checksum(header, planes);
+}
+
+trailer_t make_trailer(uint64_t index_offset, const std::vector<index_entry_t>& entries)
+{
+	trailer_t trailer;
+	trailer.magic = trailer_magic;
+	trailer.version = format_version;
+	trailer.index_offset = index_offset;
+	trailer.count = entries.size();
+	trailer.checksum = checksum(entries.data(), entries.size() * sizeof(index_entry_t));
+	return trailer;
+}
+
+bool read_at(int fd, uint64_t offset, void* data, size_t size)
+{
+	auto p = static_cast<uint8_t*>(data);
+	while (size > 0) {
+		const auto count = ::pread(fd, p, size, offset);
+		if (count < 0 && errno == EINTR) continue;
+		if (count <= 0) return false;
+		p += count;
+		size -= count;
+		offset += count;
+	}
+	return true;
+}
+
+bool read_chunk(int fd, uint64_t offset, uint64_t file_size, chunk_t& chunk)
+{
+	chunk.offset = offset;
+	auto& header = chunk.header;
+	if (offset + sizeof(header) > file_size || !read_at(fd, offset, &header, sizeof(header))) return false;
+	if (header.magic != chunk_magic || header.plane_count > max_planes ||
+			header.header_size > max_header_size ||
+			header.header_size < sizeof(header) + header.plane_count * sizeof(plane_info_t)) {
+		return false;
+	}
+	chunk.planes.resize(header.plane_count);
+	if (!read_at(fd, offset + sizeof(header), chunk.planes.data(), chunk.planes.size() * sizeof(plane_info_t))) return false;
+	if (header.checksum != header_checksum(header, chunk.planes)) return false;
+	uint64_t payload = 0;
+	for (const auto& p: chunk.planes) payload += p.size;
+	return payload == header.payload_size &&
+			header.payload_size <= file_size &&
+			chunk.end() <= file_size;
+}
+
+container_index_t read_index(int fd, uint64_t file_size)
+{
+	container_index_t index {{}, sizeof(file_header_t), false};
+	trailer_t trailer;
+	if (file_size >= sizeof(file_header_t) + sizeof(trailer) &&
+			read_at(fd, file_size - sizeof(trailer), &trailer, sizeof(trailer)) &&
+			trailer.magic == trailer_magic && trailer.version == format_version &&
+			trailer.index_offset >= sizeof(file_header_t) &&
+			trailer.count <= file_size / sizeof(index_entry_t) &&
+			trailer.index_offset + trailer.count * sizeof(index_entry_t) + sizeof(trailer) == file_size) {
+		index.entries.resize(trailer.count);
+		if (read_at(fd, trailer.index_offset, index.entries.data(), index.entries.size() * sizeof(index_entry_t)) &&
+				make_trailer(trailer.index_offset, index.entries).checksum == trailer.checksum) {
+			index.data_end = trailer.index_offset;
+			return index;
+		}
+		index.entries.clear();
+	}
+	index.recovered = true;
+	chunk_t chunk;
+	while (read_chunk(fd, index.data_end, file_size, chunk)) {
+		index.entries.push_back({chunk.offset, chunk.header.timestamp});
+		index.data_end = chunk.end();
+	}
+	return index;
+}
+
+}
+}
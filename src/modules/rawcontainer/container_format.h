@@ -0,0 +1,144 @@
+/*!
+ * @file 		container_format.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Layout of raw container files and functions to read their index.
+ *
+ * The file starts with file_header_t, followed by one chunk per frame.
+ * Every chunk consists of chunk_header_t, a table of plane_info_t and frame data
+ * and it's padded to a multiple of chunk_alignment bytes, so the data are aligned
+ * when the file is mapped to memory. A closed file ends with an index
+ * of all chunks (index_entry_t) and trailer_t.
+ *
+ * Chunks describe themselves and their headers are protected by a checksum,
+ * so the index of a file that wasn't closed properly can be rebuilt by reading the chunks.
+ *
+ * All values are stored in the byte order of the host (little endian is expected).
+ */
+
+#ifndef MODULES_RAWCONTAINER_CONTAINER_FORMAT_H_
+#define MODULES_RAWCONTAINER_CONTAINER_FORMAT_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace yuri {
+namespace rawcontainer {
+
+const uint32_t format_version = 1;
+const size_t chunk_alignment = 64;
+const size_t max_planes = 4;
+
+enum class frame_type_t: uint32_t {
+	raw_video = 1,
+	compressed_video = 2,
+	raw_audio = 3
+};
+
+struct file_header_t {
+	char magic[8];
+	uint32_t version;
+	uint32_t header_size;
+	uint8_t reserved[48];
+};
+
+struct chunk_header_t {
+	uint32_t magic;
+	//! Size of this header, plane table and padding, data start right after it
+	uint32_t header_size;
+	//! Sum of sizes of all planes
+	uint64_t payload_size;
+	uint32_t type;
+	int32_t format;
+	//! Channel count for audio frames
+	uint32_t width;
+	//! Sampling frequency for audio frames
+	uint32_t height;
+	uint32_t plane_count;
+	uint32_t reserved;
+	//! Timestamp of the frame in microseconds (with arbitrary origin)
+	int64_t timestamp;
+	int64_t duration;
+	uint64_t index;
+	//! Checksum of the header (with this field set to 0) and of the plane table
+	uint64_t checksum;
+};
+
+struct plane_info_t {
+	uint64_t size;
+	//! Line size of raw video planes, 0 otherwise
+	uint32_t line_size;
+	uint32_t reserved;
+};
+
+struct index_entry_t {
+	uint64_t offset;
+	int64_t timestamp;
+};
+
+struct trailer_t {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t index_offset;
+	uint64_t count;
+	//! Checksum of the index entries
+	uint64_t checksum;
+};
+
+static_assert(sizeof(file_header_t) == 64, "Unexpected size of file_header_t");
+static_assert(sizeof(chunk_header_t) == 72, "Unexpected size of chunk_header_t");
+static_assert(sizeof(plane_info_t) == 16, "Unexpected size of plane_info_t");
+static_assert(sizeof(index_entry_t) == 16, "Unexpected size of index_entry_t");
+static_assert(sizeof(trailer_t) == 32, "Unexpected size of trailer_t");
+
+//! Chunk as read from a file
+struct chunk_t {
+	uint64_t offset;
+	chunk_header_t header;
+	std::vector<plane_info_t> planes;
+
+	uint64_t data_offset() const { return offset + header.header_size; }
+	//! Offset of the next chunk
+	uint64_t end() const;
+};
+
+struct container_index_t {
+	std::vector<index_entry_t> entries;
+	//! End of the last complete chunk
+	uint64_t data_end;
+	//! The index was rebuilt by reading the chunks, because the file wasn't closed properly
+	bool recovered;
+};
+
+inline uint64_t align_size(uint64_t size)
+{
+	return (size + chunk_alignment - 1) / chunk_alignment * chunk_alignment;
+}
+
+file_header_t make_file_header();
+bool check_file_header(const file_header_t& header);
+/*!
+ * Fills magic, header_size, plane_count and checksum of @em header.
+ * Payload size and the other values have to be set beforehand.
+ */
+void seal_chunk_header(chunk_header_t& header, const std::vector<plane_info_t>& planes);
+trailer_t make_trailer(uint64_t index_offset, const std::vector<index_entry_t>& entries);
+
+//! Reads exactly @em size bytes from @em offset
+bool read_at(int fd, uint64_t offset, void* data, size_t size);
+//! Reads and validates chunk at @em offset, the whole chunk has to fit into @em file_size
+bool read_chunk(int fd, uint64_t offset, uint64_t file_size, chunk_t& chunk);
+/*!
+ * Reads index of a file with valid file header. When the trailer is missing or damaged,
+ * the index is rebuilt from chunks, up to the first incomplete or damaged one.
+ */
+container_index_t read_index(int fd, uint64_t file_size);
+
+}
+}
+
+#endif /* MODULES_RAWCONTAINER_CONTAINER_FORMAT_H_ */
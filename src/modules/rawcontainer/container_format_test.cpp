@@ -0,0 +1,267 @@
+/*!
+ * @file 		container_format_test.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "tests/catch.hpp"
+#include "container_format.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace yuri {
+namespace rawcontainer {
+
+namespace {
+
+const std::string test_file = "container_format_test.yrc";
+
+//! Writes a container the same way RawContainerDump does, removes it at the end of a test
+class test_writer_t {
+public:
+	test_writer_t()
+	:fd_(::open(test_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)),offset_(0)
+	{
+		const auto header = make_file_header();
+		write(&header, sizeof(header));
+	}
+	~test_writer_t() noexcept
+	{
+		::close(fd_);
+		std::remove(test_file.c_str());
+	}
+	int fd() const { return fd_; }
+	uint64_t size() const { return offset_; }
+	const std::vector<index_entry_t>& entries() const { return entries_; }
+
+	//! Writes a chunk with one plane for every item of @em planes, returns its offset
+	uint64_t add_chunk(int64_t timestamp, const std::vector<std::vector<uint8_t>>& planes)
+	{
+		chunk_header_t header;
+		std::memset(&header, 0, sizeof(header));
+		header.type = static_cast<uint32_t>(frame_type_t::compressed_video);
+		header.format = 42;
+		header.width = 320;
+		header.height = 240;
+		header.timestamp = timestamp;
+		header.duration = 40000;
+		header.index = entries_.size();
+		std::vector<plane_info_t> infos;
+		for (const auto& p: planes) {
+			infos.push_back({p.size(), 0, 0});
+			header.payload_size += p.size();
+		}
+		seal_chunk_header(header, infos);
+
+		const auto offset = offset_;
+		std::vector<uint8_t> head(header.header_size, 0);
+		std::memcpy(head.data(), &header, sizeof(header));
+		std::memcpy(head.data() + sizeof(header), infos.data(), infos.size() * sizeof(plane_info_t));
+		write(head.data(), head.size());
+		for (const auto& p: planes) write(p.data(), p.size());
+		const std::vector<uint8_t> padding(align_size(offset_) - offset_, 0);
+		write(padding.data(), padding.size());
+		entries_.push_back({offset, timestamp});
+		return offset;
+	}
+	void write_index()
+	{
+		const auto trailer = make_trailer(offset_, entries_);
+		write(entries_.data(), entries_.size() * sizeof(index_entry_t));
+		write(&trailer, sizeof(trailer));
+	}
+	void overwrite(uint64_t offset, uint8_t value)
+	{
+		REQUIRE(::pwrite(fd_, &value, 1, offset) == 1);
+	}
+	void truncate(uint64_t size)
+	{
+		REQUIRE(::ftruncate(fd_, size) == 0);
+		offset_ = size;
+	}
+private:
+	void write(const void* data, size_t size)
+	{
+		REQUIRE(::pwrite(fd_, data, size, offset_) == static_cast<ssize_t>(size));
+		offset_ += size;
+	}
+
+	int fd_;
+	uint64_t offset_;
+	std::vector<index_entry_t> entries_;
+};
+
+std::vector<uint8_t> make_data(size_t size, uint8_t seed)
+{
+	std::vector<uint8_t> data(size);
+	for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(seed + i * 7);
+	return data;
+}
+
+void require_entries(const container_index_t& index, const std::vector<index_entry_t>& expected)
+{
+	REQUIRE(index.entries.size() == expected.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		REQUIRE(index.entries[i].offset == expected[i].offset);
+		REQUIRE(index.entries[i].timestamp == expected[i].timestamp);
+	}
+}
+
+}
+
+TEST_CASE("container file header", "[rawcontainer]")
+{
+	auto header = make_file_header();
+	REQUIRE(check_file_header(header));
+	header.version = format_version + 1;
+	REQUIRE(!check_file_header(header));
+	header = make_file_header();
+	header.magic[0] = 'X';
+	REQUIRE(!check_file_header(header));
+}
+
+TEST_CASE("container chunks", "[rawcontainer]")
+{
+	test_writer_t writer;
+	const auto first = make_data(100, 1);
+	const auto second_y = make_data(64, 2);
+	const auto second_uv = make_data(31, 3);
+	const auto off0 = writer.add_chunk(1000, {first});
+	const auto off1 = writer.add_chunk(41000, {second_y, second_uv});
+	const auto off2 = writer.add_chunk(81000, {{}});
+	REQUIRE(off0 == sizeof(file_header_t));
+
+	chunk_t chunk;
+	REQUIRE(read_chunk(writer.fd(), off0, writer.size(), chunk));
+	REQUIRE(chunk.offset == off0);
+	REQUIRE(chunk.header.type == static_cast<uint32_t>(frame_type_t::compressed_video));
+	REQUIRE(chunk.header.format == 42);
+	REQUIRE(chunk.header.width == 320);
+	REQUIRE(chunk.header.height == 240);
+	REQUIRE(chunk.header.timestamp == 1000);
+	REQUIRE(chunk.header.duration == 40000);
+	REQUIRE(chunk.header.index == 0);
+	REQUIRE(chunk.header.payload_size == first.size());
+	REQUIRE(chunk.planes.size() == 1);
+	REQUIRE(chunk.data_offset() % chunk_alignment == 0);
+	REQUIRE(chunk.end() == off1);
+	std::vector<uint8_t> data(first.size());
+	REQUIRE(read_at(writer.fd(), chunk.data_offset(), data.data(), data.size()));
+	REQUIRE(data == first);
+
+	REQUIRE(read_chunk(writer.fd(), off1, writer.size(), chunk));
+	REQUIRE(chunk.header.timestamp == 41000);
+	REQUIRE(chunk.header.index == 1);
+	REQUIRE(chunk.header.payload_size == second_y.size() + second_uv.size());
+	REQUIRE(chunk.planes.size() == 2);
+	REQUIRE(chunk.planes[0].size == second_y.size());
+	REQUIRE(chunk.planes[1].size == second_uv.size());
+	REQUIRE(chunk.end() == off2);
+	data.resize(second_uv.size());
+	REQUIRE(read_at(writer.fd(), chunk.data_offset() + second_y.size(), data.data(), data.size()));
+	REQUIRE(data == second_uv);
+
+	REQUIRE(read_chunk(writer.fd(), off2, writer.size(), chunk));
+	REQUIRE(chunk.header.payload_size == 0);
+	REQUIRE(chunk.end() == writer.size());
+
+	// Chunks have to fit into the file
+	REQUIRE(!read_chunk(writer.fd(), off1, off2 - 1, chunk));
+	REQUIRE(!read_chunk(writer.fd(), writer.size(), writer.size(), chunk));
+	// Reading past the end of the file fails
+	REQUIRE(!read_at(writer.fd(), writer.size() - 10, data.data(), 20));
+}
+
+TEST_CASE("container chunk checksum", "[rawcontainer]")
+{
+	test_writer_t writer;
+	const auto offset = writer.add_chunk(1000, {make_data(100, 1), make_data(10, 2)});
+	chunk_t chunk;
+	REQUIRE(read_chunk(writer.fd(), offset, writer.size(), chunk));
+
+	SECTION("header") {
+		writer.overwrite(offset + offsetof(chunk_header_t, timestamp), 0xff);
+		REQUIRE(!read_chunk(writer.fd(), offset, writer.size(), chunk));
+	}
+	SECTION("plane table") {
+		writer.overwrite(offset + sizeof(chunk_header_t) + sizeof(plane_info_t) + offsetof(plane_info_t, line_size), 1);
+		REQUIRE(!read_chunk(writer.fd(), offset, writer.size(), chunk));
+	}
+	SECTION("magic") {
+		writer.overwrite(offset, 0);
+		REQUIRE(!read_chunk(writer.fd(), offset, writer.size(), chunk));
+	}
+	SECTION("payload is not covered") {
+		writer.overwrite(chunk.data_offset() + 5, 0);
+		REQUIRE(read_chunk(writer.fd(), offset, writer.size(), chunk));
+	}
+}
+
+TEST_CASE("container index", "[rawcontainer]")
+{
+	test_writer_t writer;
+	for (int64_t i = 0; i < 5; ++i) {
+		writer.add_chunk(1000 + i * 40000, {make_data(100 + i * 50, static_cast<uint8_t>(i))});
+	}
+	const auto data_end = writer.size();
+	const auto entries = writer.entries();
+
+	SECTION("trailer") {
+		writer.write_index();
+		const auto index = read_index(writer.fd(), writer.size());
+		REQUIRE(!index.recovered);
+		REQUIRE(index.data_end == data_end);
+		require_entries(index, entries);
+	}
+	SECTION("empty file") {
+		const auto index = read_index(writer.fd(), sizeof(file_header_t));
+		REQUIRE(index.entries.empty());
+		REQUIRE(index.data_end == sizeof(file_header_t));
+	}
+	SECTION("missing index") {
+		const auto index = read_index(writer.fd(), writer.size());
+		REQUIRE(index.recovered);
+		REQUIRE(index.data_end == data_end);
+		require_entries(index, entries);
+	}
+	SECTION("damaged index") {
+		writer.write_index();
+		writer.overwrite(data_end + sizeof(index_entry_t) + 2, 0xff);
+		const auto index = read_index(writer.fd(), writer.size());
+		REQUIRE(index.recovered);
+		REQUIRE(index.data_end == data_end);
+		require_entries(index, entries);
+	}
+	SECTION("truncated index") {
+		writer.write_index();
+		writer.truncate(writer.size() - sizeof(trailer_t) / 2);
+		const auto index = read_index(writer.fd(), writer.size());
+		REQUIRE(index.recovered);
+		REQUIRE(index.data_end == data_end);
+		require_entries(index, entries);
+	}
+	SECTION("truncated chunk") {
+		// Recovery stops at the last complete chunk
+		writer.truncate(data_end - 20);
+		const auto index = read_index(writer.fd(), writer.size());
+		REQUIRE(index.recovered);
+		REQUIRE(index.data_end == entries.back().offset);
+		require_entries(index, std::vector<index_entry_t>(entries.begin(), entries.end() - 1));
+	}
+	SECTION("damaged chunk") {
+		writer.overwrite(entries[2].offset + offsetof(chunk_header_t, duration), 0xff);
+		const auto index = read_index(writer.fd(), writer.size());
+		REQUIRE(index.recovered);
+		REQUIRE(index.data_end == entries[2].offset);
+		require_entries(index, std::vector<index_entry_t>(entries.begin(), entries.begin() + 2));
+	}
+}
+
+}
+}
@@ -0,0 +1,21 @@
+/*!
+ * @file 		register.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "RawContainerDump.h"
+#include "RawContainerSource.h"
+#include "yuri/core/Module.h"
+
+namespace yuri {
+
+MODULE_REGISTRATION_BEGIN("rawcontainer")
+	REGISTER_IOTHREAD("raw_container_dump", rawcontainer::RawContainerDump)
+	REGISTER_IOTHREAD("raw_container_source", rawcontainer::RawContainerSource)
+MODULE_REGISTRATION_END()
+
+}
@@ -14,9 +14,17 @@
 #include "yuri/core/frame/CompressedVideoFrame.h"
 #include "yuri/core/frame/raw_frame_params.h"
 #include "yuri/core/frame/compressed_frame_params.h"
+#include "yuri/core/utils/platform.h"
 #include <fstream>
 #include <boost/regex.hpp>
 #include <iomanip>
+#include <numeric>
+#ifdef YURI_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 namespace yuri {
 
 namespace rawfilesource {
@@ -28,6 +36,70 @@ MODULE_REGISTRATION_END()
 
 IOTHREAD_GENERATOR(RawFileSource)
 
+//! File mapped to memory, unmapped when the last frame referencing it is released
+struct mapped_file_t {
+	uint8_t* data;
+	size_t size;
+	mapped_file_t(uint8_t* data, size_t size):data(data),size(size) {}
+	~mapped_file_t() noexcept {
+#ifdef YURI_POSIX
+		::munmap(data, size);
+#endif
+	}
+};
+
+namespace {
+
+//! Keeps the mapping alive as long as a plane references it
+struct mapping_deleter {
+	std::shared_ptr<mapped_file_t> mapping;
+	void operator()(void*) const noexcept {}
+};
+
+/*!
+ * Maps whole file to memory. The mapping is private and writable,
+ * so consumers modifying the frames get their own copy of the pages.
+ */
+std::shared_ptr<mapped_file_t> map_file(const std::string& path, bool sequential)
+{
+#ifdef YURI_POSIX
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) return {};
+	struct stat st;
+	void* data = MAP_FAILED;
+	if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+		data = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	}
+	::close(fd);
+	if (data == MAP_FAILED) return {};
+	// Pages read sequentially may be dropped right after use, which is not wanted when looping
+	if (sequential) ::madvise(data, st.st_size, MADV_SEQUENTIAL);
+	return std::make_shared<mapped_file_t>(static_cast<uint8_t*>(data), st.st_size);
+#else
+	(void)path;
+	(void)sequential;
+	return {};
+#endif
+}
+
+//! Asks the kernel to start reading @em length bytes from @em offset
+void prefetch(const mapped_file_t& mapping, size_t offset, size_t length)
+{
+#ifdef YURI_POSIX
+	static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+	if (offset >= mapping.size || !length) return;
+	const auto start = offset - offset % page_size;
+	const auto end = std::min(offset + length, mapping.size);
+	::madvise(mapping.data + start, end - start, MADV_WILLNEED);
+#else
+	(void)mapping;
+	(void)offset;
+	(void)length;
+#endif
+}
+
+}
+
 
 core::Parameters RawFileSource::configure()
 {
@@ -42,6 +114,8 @@ core::Parameters RawFileSource::configure()
 	p["loop"]["Start again from beginning of the file after reaching end"]=true;
 	p["offset"]["skip offset bytes from beginning"]=0;
 	p["block"]["Threat output pipes as blocking. Specify as max number of frames in output pipe."]=0;
+	p["mmap"]["Map the file to memory and output frames referencing it, without copying (POSIX only)"]=false;
+	p["readahead"]["Number of frames to prefetch in mmap mode"]=4;
 	return p;
 }
 
@@ -51,10 +125,16 @@ RawFileSource::RawFileSource(log::Log &_log, core::pwThreadBase parent,const cor
 			chunk_size(0), width(0), height(0),output_format(0),
 			fps(25.0),keep_alive(true),loop(true),
 			failed_read(false),sequence(false),block(0),loop_number(0),sequence_pos(0),
-			frame_type_(frame_type_t::raw_video)
+			frame_type_(frame_type_t::raw_video),mmap_(false),readahead_(4),
+			mapped_position_(0)
 {
 	IOTHREAD_INIT(parameters)
-	set_latency(1_ms);
+#ifndef YURI_POSIX
+	if (mmap_) {
+		log[log::warning] << "mmap is not supported on this platform, reading the file instead";
+		mmap_ = false;
+	}
+#endif
 }
 
 RawFileSource::~RawFileSource() noexcept {
@@ -63,20 +143,24 @@ RawFileSource::~RawFileSource() noexcept {
 void RawFileSource::run()
 {
 //	IOTHREAD_PRE_RUN
+	// First frame is sent immediately
+	timer_.set_fps(fps);
+	timer_.reset();
 	while (still_running()) {
-		ThreadBase::sleep(get_latency());
 		if (!frame) if (!read_chunk()) break;
 		if (failed_read) break;
-		if (!frame) continue;
+		if (!frame) {
+			ThreadBase::sleep(get_latency());
+			continue;
+		}
 //		if (block && out_[0] && out[0]->get_count() >= block) continue;
 
-		duration_t delta;
-		if (fps!=0.0)
-			delta = 1_s/fps;
-		else delta = 0_s;
-
-		if ((timestamp_t{} - last_send) < delta) continue;
-		last_send+=delta;
+		if (!wait_until(timer_.next_deadline())) {
+			continue;
+		}
+		// Deadlines are kept regular, unless the output fell behind by more than a frame
+		if (timestamp_t{} - timer_.next_deadline() > timer_.get_period()) timer_.reset();
+		timer_.advance();
 		push_frame(0,frame);
 		if (chunk_size) frame.reset();
 		else if (sequence && !chunk_size) frame.reset();
@@ -89,8 +173,31 @@ void RawFileSource::run()
 //	IO_THREAD_POST_RUN
 }
 
+std::vector<yuri::size_t> RawFileSource::get_planes(yuri::size_t available) const
+{
+	if (frame_type_ == frame_type_t::raw_video && width && height) {
+		const auto& fi = core::raw_format::get_format_info(output_format);
+		const auto bd = fi.planes[0].bit_depth;
+		const yuri::size_t length = width*bd.first/bd.second/8*height;
+		if (fi.planes.size() > 1) {
+			std::vector<yuri::size_t> planes;
+			for (yuri::size_t i=0;i<fi.planes.size();++i)
+			{
+				const auto& p = fi.planes[i];
+				planes.push_back(length / p.sub_x / p.sub_y);
+			}
+			return planes;
+		}
+		return {length};
+	} else if (!chunk_size) {
+		return {available};
+	}
+	return {chunk_size};
+}
+
 bool RawFileSource::read_chunk()
 {
+	if (mmap_) return read_mapped_chunk();
 	try {
 		frame.reset();
 		bool first_read = false;
@@ -114,33 +221,15 @@ bool RawFileSource::read_chunk()
 			file.seekg(position,std::ios_base::beg);
 			first_read = true;
 		}
-		yuri::size_t length = chunk_size;
-		std::vector<yuri::size_t> planes= {length};
-//		if (frame_type_ == frame_type_t::compressed_viceo) {
-//
-//
-//		} else
-
-		if (frame_type_ == frame_type_t::raw_video && width && height) {
-			const auto& fi = core::raw_format::get_format_info(output_format);
-			const auto bd = fi.planes[0].bit_depth;
-			length = width*bd.first/bd.second/8*height;
-			if (fi.planes.size() > 1) {
-				planes.clear();
-				for (yuri::size_t i=0;i<fi.planes.size();++i)
-				{
-					const auto& p = fi.planes[i];
-					planes.push_back(length / p.sub_x / p.sub_y);
-				}
-			} else {
-				planes = {length};
-			}
-		} else if (!chunk_size) {
+		yuri::size_t available = 0;
+		if (!chunk_size) {
+			const auto current = file.tellg();
 			file.seekg(0,std::ios_base::end);
-			length = static_cast<yuri::size_t>(file.tellg()) - position;
-			file.seekg(position,std::ios_base::beg);
-			planes={length};
+			available = static_cast<yuri::size_t>(file.tellg()) - position;
+			file.seekg(current,std::ios_base::beg);
 		}
+		const auto planes = get_planes(available);
+		const yuri::size_t length = planes[0];
 
 		if (frame_type_ == frame_type_t::raw_video) {
 			auto rframe = core::RawVideoFrame::create_empty(output_format, {width, height});
@@ -184,7 +273,7 @@ bool RawFileSource::read_chunk()
 			}
 
 		}
-		frame->set_duration(1_s/fps);
+		if (frame) frame->set_duration(1_s/fps);
 		if (file.eof()) {
 			log[log::info] << "EOF";
 			file.close();
@@ -209,6 +298,77 @@ bool RawFileSource::read_chunk()
 	}
 	return true;
 }
+bool RawFileSource::read_mapped_chunk()
+{
+	frame.reset();
+	bool first_read = false;
+	if (!mapping_) {
+		const auto filepath = sequence ? next_file() : path;
+		mapping_ = map_file(filepath, !loop);
+		if (!mapping_) {
+			log[log::warning] << "Failed to map " << filepath;
+			if (sequence_pos) {
+				log[log::info] << "Resetting sequence to the beginning";
+				sequence_pos=0;
+				loop_number++;
+			}
+			return true;
+		}
+		mapped_position_ = position;
+		first_read = true;
+	}
+	const yuri::size_t available = mapping_->size > mapped_position_ ? mapping_->size - mapped_position_ : 0;
+	const auto planes = get_planes(available);
+	const auto length = std::accumulate(planes.begin(), planes.end(), yuri::size_t{0});
+	if (!length || length > available) {
+		if (first_read) {
+			if (!sequence || sequence_pos == 0) {
+				failed_read=true;
+				log[log::warning]<< "Wrong length of the file (available " << available << ", expected " << length << ")";
+			} else {
+				sequence_pos = 0;
+			}
+		}
+		mapping_.reset();++loop_number;
+		return !failed_read;
+	}
+
+	uint8_t* data = mapping_->data + mapped_position_;
+	if (frame_type_ == frame_type_t::raw_video) {
+		const resolution_t res {width, height};
+		const auto& fi = core::raw_format::get_format_info(output_format);
+		auto rframe = std::make_shared<core::RawVideoFrame>(output_format, res, 0);
+		for (yuri::size_t i=0;i<planes.size();++i) {
+			size_t line_size, plane_size;
+			resolution_t plane_res;
+			std::tie(line_size, plane_size, plane_res) = core::RawVideoFrame::get_plane_params(fi, i, res);
+			if (plane_size <= planes[i]) {
+				core::Plane::vector_type plane_data{data, plane_size, mapping_deleter{mapping_}};
+				rframe->emplace_back(std::move(plane_data), plane_res, line_size);
+			} else {
+				// The plane is larger than the data in the file
+				rframe->emplace_back(plane_size, plane_res, line_size);
+				std::copy(data, data + planes[i], PLANE_RAW_DATA(rframe,i));
+			}
+			data += planes[i];
+		}
+		frame = rframe;
+	} else if (frame_type_ == frame_type_t::compressed_viceo) {
+		frame = std::make_shared<core::CompressedVideoFrame>(output_format, resolution_t{width, height},
+				core::CompressedVideoFrame::segments_t{{data, length, mapping_}});
+	}
+	if (frame) frame->set_duration(1_s/fps);
+
+	mapped_position_ += length;
+	prefetch(*mapping_, mapped_position_, readahead_ * length);
+	if (mapping_->size - mapped_position_ < length || (sequence && !chunk_size)) {
+		log[log::info] << "EOF";
+		mapping_.reset();
+		++loop_number;
+	}
+	return true;
+}
+
 bool RawFileSource::set_param(const core::Parameter &parameter)
 {
 	if (parameter.get_name() == "chunk") {
@@ -243,6 +403,10 @@ bool RawFileSource::set_param(const core::Parameter &parameter)
 		loop=parameter.get<bool>();
 	} else if (parameter.get_name() == "block") {
 		block=parameter.get<size_t>();
+	} else if (parameter.get_name() == "mmap") {
+		mmap_=parameter.get<bool>();
+	} else if (parameter.get_name() == "readahead") {
+		readahead_=parameter.get<size_t>();
 	} else return base_type::set_param(parameter);
 	return true;
 }
@@ -12,6 +12,8 @@
 #define RAWFILESOURCE_H_
 
 #include "yuri/core/thread/IOThread.h"
+#include "yuri/core/utils/Timer.h"
+#include <memory>
 //#include <boost/date_time/posix_time/posix_time.hpp>
 
 namespace yuri {
@@ -26,6 +28,8 @@ enum class frame_type_t {
 	raw_audio
 };
 
+struct mapped_file_t;
+
 class RawFileSource: public core::IOThread
 {
 	using base_type = core::IOThread;
@@ -38,13 +42,16 @@ public:
 protected:
 	virtual bool set_param(const core::Parameter &parameter);
 	bool read_chunk();
+	bool read_mapped_chunk();
+	//! Sizes of planes of a frame, @em available is size of the rest of the file
+	std::vector<yuri::size_t> get_planes(yuri::size_t available) const;
 	std::string next_file();
 	core::pFrame frame;
 	yuri::size_t position, chunk_size, width, height;
 	yuri::format_t output_format;
 	double fps;
 	std::string path;
-	timestamp_t last_send;
+	FPSTimer timer_;
 	std::ifstream file;
 	bool keep_alive,loop, failed_read, sequence;
 	size_t block;
@@ -52,6 +59,13 @@ protected:
 	size_t sequence_pos;
 
 	frame_type_t frame_type_;
+
+	//! Output frames reference memory mapped file instead of copies
+	bool mmap_;
+	//! Number of frames to prefetch ahead in mmap mode
+	size_t readahead_;
+	std::shared_ptr<mapped_file_t> mapping_;
+	size_t mapped_position_;
 };
 
 }
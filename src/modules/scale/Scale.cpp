@@ -12,6 +12,7 @@
 #include "yuri/core/frame/raw_frame_types.h"
 #include "yuri/core/utils/assign_events.h"
 #include "yuri/core/utils/irange.h"
+#include <cmath>
 #include <future>
 
 namespace yuri {
@@ -51,10 +52,11 @@ namespace {
 template <size_t pixel_size>
 struct scale_line_bilinear {
     inline static void eval(uint8_t* it, const uint8_t* top, const uint8_t* bottom, const dimension_t new_width, const dimension_t old_width,
-                            const double unscale_x, const double y_ratio)
+                            const double unscale_x, const double y_ratio, const dimension_t x0, const dimension_t x1)
     {
         const double y_ratio2 = 1.0 - y_ratio;
-        for (dimension_t pixel = 0; pixel < new_width - 1; ++pixel) {
+        it += x0 * pixel_size;
+        for (dimension_t pixel = x0; pixel < std::min(x1, new_width - 1); ++pixel) {
             const dimension_t left     = static_cast<dimension_t>(pixel * unscale_x);
             const dimension_t right    = left + 1;
             const double      x_ratio  = pixel * unscale_x - left;
@@ -64,6 +66,8 @@ struct scale_line_bilinear {
                                              + bottom[left * pixel_size + i] * x_ratio2 * y_ratio + bottom[right * pixel_size + i] * x_ratio * y_ratio);
             }
         }
+        if (x1 < new_width)
+            return;
         for (size_t i = 0; i < pixel_size; ++i) {
             *it++ = static_cast<uint8_t>(top[(old_width - 1) * pixel_size + i] * y_ratio2 + bottom[(old_width - 1) * pixel_size + i] * y_ratio);
         }
@@ -73,10 +77,11 @@ struct scale_line_bilinear {
 template <size_t pixel_size>
 struct scale_line_bilinear_fast {
     inline static void eval(uint8_t* it, const uint8_t* top, const uint8_t* bottom, const dimension_t new_width, const dimension_t old_width,
-                            const uint64_t unscale_x, const uint64_t y_ratio)
+                            const uint64_t unscale_x, const uint64_t y_ratio, const dimension_t x0, const dimension_t x1)
     {
         const uint64_t y_ratio2 = 256 - y_ratio;
-        for (dimension_t pixel = 0; pixel < new_width - 1; ++pixel) {
+        it += x0 * pixel_size;
+        for (dimension_t pixel = x0; pixel < std::min(x1, new_width - 1); ++pixel) {
             const dimension_t left     = pixel * unscale_x;
             const dimension_t right    = left + 1;
             const uint64_t    x_ratio  = pixel * unscale_x - left;
@@ -88,6 +93,8 @@ struct scale_line_bilinear_fast {
                                              / 65536);
             }
         }
+        if (x1 < new_width)
+            return;
         for (size_t i = 0; i < pixel_size; ++i) {
             *it++ = static_cast<uint8_t>((top[(old_width - 1) * pixel_size + i] * y_ratio2 + bottom[(old_width - 1) * pixel_size + i] * y_ratio) / 256);
         }
@@ -118,15 +125,18 @@ inline uint8_t get_uv(const dimension_t pixel, const double unscale_x, const uin
 
 struct scale_line_bilinear_yuyv {
     inline static void eval(uint8_t* it, const uint8_t* top, const uint8_t* bottom, const dimension_t new_width, const dimension_t /*old_width*/,
-                            const double unscale_x, const double y_ratio)
+                            const double unscale_x, const double y_ratio, const dimension_t x0, const dimension_t x1)
     {
         const double y_ratio2 = 1.0 - y_ratio;
-        for (dimension_t pixel = 0; pixel < new_width - 2; pixel += 2) {
+        it += x0 * 2;
+        for (dimension_t pixel = x0; pixel < std::min(x1, new_width - 2); pixel += 2) {
             *it++ = get_y(pixel, unscale_x, top, bottom, y_ratio, y_ratio2);
             *it++ = get_uv<0>(pixel, unscale_x, top, bottom, y_ratio, y_ratio2);
             *it++ = get_y(pixel + 1, unscale_x, top, bottom, y_ratio, y_ratio2);
             *it++ = get_uv<1>(pixel + 1, unscale_x, top, bottom, y_ratio, y_ratio2);
         }
+        if (x1 < new_width)
+            return;
         *it++ = get_y((new_width - 2), unscale_x, top, bottom, y_ratio, y_ratio2);
         *it++ = get_uv<0>((new_width - 2), unscale_x, top, bottom, y_ratio, y_ratio2);
         *it++ = get_y((new_width - 1), unscale_x, top, bottom, y_ratio, y_ratio2);
@@ -135,15 +145,18 @@ struct scale_line_bilinear_yuyv {
 };
 struct scale_line_bilinear_uyvy {
     inline static void eval(uint8_t* it, const uint8_t* top, const uint8_t* bottom, const dimension_t new_width, const dimension_t /*old_width*/,
-                            const double unscale_x, const double y_ratio)
+                            const double unscale_x, const double y_ratio, const dimension_t x0, const dimension_t x1)
     {
         const double y_ratio2 = 1.0 - y_ratio;
-        for (dimension_t pixel = 0; pixel < new_width - 2; pixel += 2) {
+        it += x0 * 2;
+        for (dimension_t pixel = x0; pixel < std::min(x1, new_width - 2); pixel += 2) {
             *it++ = get_uv<0>(pixel, unscale_x, top - 1, bottom - 1, y_ratio, y_ratio2);
             *it++ = get_y(pixel, unscale_x, top + 1, bottom + 1, y_ratio, y_ratio2);
             *it++ = get_uv<1>(pixel + 1, unscale_x, top - 1, bottom - 1, y_ratio, y_ratio2);
             *it++ = get_y(pixel + 1, unscale_x, top + 1, bottom + 1, y_ratio, y_ratio2);
         }
+        if (x1 < new_width)
+            return;
         *it++ = get_uv<0>((new_width - 2), unscale_x, top - 1, bottom - 1, y_ratio, y_ratio2);
         *it++ = get_y((new_width - 2), unscale_x, top + 1, bottom + 1, y_ratio, y_ratio2);
         *it++ = get_uv<1>((new_width - 1), unscale_x, top - 1, bottom - 1, y_ratio, y_ratio2);
@@ -181,15 +194,18 @@ inline uint8_t get_uv_fast(const dimension_t pixel, const uint64_t unscale_x, co
 
 struct scale_line_bilinear_yuyv_fast {
     inline static void eval(uint8_t* it, const uint8_t* top, const uint8_t* bottom, const dimension_t new_width, const dimension_t /*old_width*/,
-                            const uint64_t unscale_x, const uint64_t y_ratio)
+                            const uint64_t unscale_x, const uint64_t y_ratio, const dimension_t x0, const dimension_t x1)
     {
         const uint64_t y_ratio2 = 256 - y_ratio;
-        for (dimension_t pixel = 0; pixel < new_width - 2; pixel += 2) {
+        it += x0 * 2;
+        for (dimension_t pixel = x0; pixel < std::min(x1, new_width - 2); pixel += 2) {
             *it++ = get_y_fast(pixel, unscale_x, top, bottom, y_ratio, y_ratio2);
             *it++ = get_uv_fast<0>(pixel, unscale_x, top, bottom, y_ratio, y_ratio2);
             *it++ = get_y_fast(pixel + 1, unscale_x, top, bottom, y_ratio, y_ratio2);
             *it++ = get_uv_fast<1>(pixel + 1, unscale_x, top, bottom, y_ratio, y_ratio2);
         }
+        if (x1 < new_width)
+            return;
         *it++ = get_y_fast((new_width - 2), unscale_x, top, bottom, y_ratio, y_ratio2);
         *it++ = get_uv_fast<0>((new_width - 2), unscale_x, top, bottom, y_ratio, y_ratio2);
         *it++ = get_y_fast((new_width - 1), unscale_x, top, bottom, y_ratio, y_ratio2);
@@ -199,10 +215,11 @@ struct scale_line_bilinear_yuyv_fast {
 
 struct scale_line_bilinear_uyvy_fast {
     inline static void eval(uint8_t* it, const uint8_t* top, const uint8_t* bottom, const dimension_t new_width, const dimension_t /*old_width*/,
-                            const uint64_t unscale_x, const uint64_t y_ratio)
+                            const uint64_t unscale_x, const uint64_t y_ratio, const dimension_t x0, const dimension_t x1)
     {
         const uint64_t y_ratio2 = 256 - y_ratio;
-        for (dimension_t pixel = 0; pixel < new_width - 2; pixel += 2) {
+        it += x0 * 2;
+        for (dimension_t pixel = x0; pixel < std::min(x1, new_width - 2); pixel += 2) {
             // Using top - 1 and bottom - 1 to reuse methods for yuv
             *it++ = get_uv_fast<0>(pixel, unscale_x, top - 1, bottom - 1, y_ratio, y_ratio2);
             // Using top + 1 and bottom + 1 to reuse methods for yuv
@@ -210,6 +227,8 @@ struct scale_line_bilinear_uyvy_fast {
             *it++ = get_uv_fast<1>(pixel + 1, unscale_x, top - 1, bottom - 1, y_ratio, y_ratio2);
             *it++ = get_y_fast(pixel + 1, unscale_x, top + 1, bottom + 1, y_ratio, y_ratio2);
         }
+        if (x1 < new_width)
+            return;
         *it++ = get_uv_fast<0>((new_width - 2), unscale_x, top - 1, bottom - 1, y_ratio, y_ratio2);
         *it++ = get_y_fast((new_width - 2), unscale_x, top + 1, bottom + 1, y_ratio, y_ratio2);
         *it++ = get_uv_fast<1>((new_width - 1), unscale_x, top - 1, bottom - 1, y_ratio, y_ratio2);
@@ -217,103 +236,136 @@ struct scale_line_bilinear_uyvy_fast {
     }
 };
 
-template <class kernel>
-core::pRawVideoFrame scale_image(const core::pRawVideoFrame& frame, const resolution_t new_resolution, size_t threads)
-{
-    auto           outframe     = core::RawVideoFrame::create_empty(frame->get_format(), new_resolution);
-    const auto     res          = frame->get_resolution();
-    const double   unscale_x    = static_cast<double>(res.width - 1) / (new_resolution.width - 1);
-    const double   unscale_y    = static_cast<double>(res.height - 1) / (new_resolution.height - 1);
-    const auto     linesize_in  = PLANE_DATA(frame, 0).get_line_size();
-    const auto     linesize_out = PLANE_DATA(outframe, 0).get_line_size();
-    const uint8_t* it_in        = PLANE_RAW_DATA(frame, 0);
-    uint8_t*       it           = PLANE_RAW_DATA(outframe, 0);
+/*!
+ * Position of source lines and interpolation ratios for bilinear scaling
+ */
+struct position_bilinear {
+    using ratio_t = double;
+    static ratio_t unscale(const dimension_t old_size, const dimension_t new_size) { return static_cast<double>(old_size - 1) / (new_size - 1); }
+    static double  unscale_factor(const dimension_t old_size, const dimension_t new_size) { return unscale(old_size, new_size); }
+    static dimension_t source_line(const dimension_t line, const ratio_t unscale_y, ratio_t& y_ratio)
+    {
+        const dimension_t top = static_cast<dimension_t>(line * unscale_y);
+        y_ratio               = line * unscale_y - top;
+        return top;
+    }
+};
 
-    if (threads < 2) {
-        for (dimension_t line = 0; line < new_resolution.height - 1; ++line) {
-            const dimension_t top     = static_cast<dimension_t>(line * unscale_y);
-            const dimension_t bottom  = top + 1;
-            const double      y_ratio = line * unscale_y - top;
-            kernel::eval(it, it_in + top * linesize_in, it_in + bottom * linesize_in, new_resolution.width, res.width, unscale_x, y_ratio);
+/*!
+ * Position of source lines and interpolation ratios for fast scaling (in 1/256 of pixel)
+ */
+struct position_fast {
+    using ratio_t = uint64_t;
+    static ratio_t unscale(const dimension_t old_size, const dimension_t new_size) { return 256 * (old_size - 1) / (new_size - 1); }
+    static double  unscale_factor(const dimension_t old_size, const dimension_t new_size) { return unscale(old_size, new_size) / 256.0; }
+    static dimension_t source_line(const dimension_t line, const ratio_t unscale_y, ratio_t& y_ratio)
+    {
+        const dimension_t top = line * unscale_y;
+        y_ratio               = line * unscale_y - top;
+        return top / 256;
+    }
+};
 
-            it += linesize_out;
-        }
-    } else {
-        const size_t                   task_lines = new_resolution.height / threads;
-        std::vector<std::future<void>> results(threads);
-        size_t                         start_line = 0;
-        auto f                                    = [&](size_t start, size_t end) {
-            auto it2 = it + start * linesize_out;
+/*!
+ * Scales specified regions of the output image. Parts of @em outframe outside the regions are left untouched.
+ */
+template <class kernel, class position>
+void scale_regions(const core::pRawVideoFrame& frame, core::pRawVideoFrame& outframe, const std::vector<geometry_t>& regions, size_t threads)
+{
+    const auto     res            = frame->get_resolution();
+    const auto     new_resolution = outframe->get_resolution();
+    const auto     unscale_x      = position::unscale(res.width, new_resolution.width);
+    const auto     unscale_y      = position::unscale(res.height, new_resolution.height);
+    const auto     linesize_in    = PLANE_DATA(frame, 0).get_line_size();
+    const auto     linesize_out   = PLANE_DATA(outframe, 0).get_line_size();
+    const uint8_t* it_in          = PLANE_RAW_DATA(frame, 0);
+    uint8_t*       it             = PLANE_RAW_DATA(outframe, 0);
+
+    for (const auto& region : regions) {
+        const dimension_t x0 = region.x;
+        const dimension_t x1 = x0 + region.width;
+        auto              f  = [&](dimension_t start, dimension_t end) {
             for (dimension_t line = start; line < end; ++line) {
-                const dimension_t top     = static_cast<dimension_t>(line * unscale_y);
-                const dimension_t bottom  = top + 1;
-                const double      y_ratio = line * unscale_y - top;
-                kernel::eval(it2, it_in + top * linesize_in, it_in + bottom * linesize_in, new_resolution.width, res.width, unscale_x, y_ratio);
-                it2 += linesize_out;
+                if (line == new_resolution.height - 1) {
+                    // The last line is interpolated from the last source line only
+                    const uint8_t* last = it_in + (res.height - 1) * linesize_in;
+                    kernel::eval(it + line * linesize_out, last, last, new_resolution.width, res.width, unscale_x, 0, x0, x1);
+                } else {
+                    typename position::ratio_t y_ratio;
+                    const dimension_t          top = position::source_line(line, unscale_y, y_ratio);
+                    kernel::eval(it + line * linesize_out, it_in + top * linesize_in, it_in + (top + 1) * linesize_in, new_resolution.width, res.width,
+                                 unscale_x, y_ratio, x0, x1);
+                }
             }
         };
+        const dimension_t start_line = region.y;
+        const dimension_t end_line   = region.y + region.height;
+        if (threads < 2 || region.height < threads) {
+            f(start_line, end_line);
+            continue;
+        }
+        const dimension_t              task_lines = region.height / threads;
+        std::vector<std::future<void>> results(threads);
+        dimension_t                    start = start_line;
         for (auto i : irange(threads)) {
-            results[i] = std::async(std::launch::async, f, start_line, std::min(start_line + task_lines, new_resolution.height - 1));
-            start_line += task_lines;
+            const dimension_t end = (i == threads - 1) ? end_line : start + task_lines;
+            results[i]            = std::async(std::launch::async, f, start, end);
+            start                 = end;
         }
         for (auto& t : results) {
             t.get();
         }
     }
-    kernel::eval(PLANE_RAW_DATA(outframe, 0) + (new_resolution.height - 1) * linesize_out, PLANE_RAW_DATA(frame, 0) + (res.height - 1) * linesize_in,
-                 PLANE_RAW_DATA(frame, 0) + (res.height - 1) * linesize_in, new_resolution.width, res.width, unscale_x, 0.0);
-    outframe->copy_video_params(*frame);
-    return outframe;
 }
 
-template <class kernel>
-core::pRawVideoFrame scale_image_fast(const core::pRawVideoFrame& frame, const resolution_t new_resolution, size_t threads)
+template <class position, template <size_t> class kernel_packed, class kernel_yuyv, class kernel_uyvy>
+bool scale_image(const core::pRawVideoFrame& frame, core::pRawVideoFrame& outframe, const std::vector<geometry_t>& regions, size_t threads)
 {
-    auto           outframe     = core::RawVideoFrame::create_empty(frame->get_format(), new_resolution);
-    const auto     res          = frame->get_resolution();
-    const uint64_t unscale_x    = 256 * (res.width - 1) / (new_resolution.width - 1);
-    const uint64_t unscale_y    = 256 * (res.height - 1) / (new_resolution.height - 1);
-    const auto     linesize_in  = PLANE_DATA(frame, 0).get_line_size();
-    const auto     linesize_out = PLANE_DATA(outframe, 0).get_line_size();
-    const uint8_t* it_in        = PLANE_RAW_DATA(frame, 0);
-    uint8_t*       it           = PLANE_RAW_DATA(outframe, 0);
-
-    if (threads < 2) {
-        for (dimension_t line = 0; line < new_resolution.height - 1; ++line) {
-            const dimension_t top     = line * unscale_y;
-            const dimension_t bottom  = top + 256;
-            const uint64_t    y_ratio = line * unscale_y - top;
-            kernel::eval(it, it_in + top / 256 * linesize_in, it_in + bottom / 256 * linesize_in, new_resolution.width, res.width, unscale_x, y_ratio);
-
-            it += linesize_out;
-        }
-    } else {
-        const size_t                   task_lines = new_resolution.height / threads;
-        std::vector<std::future<void>> results(threads);
-        size_t                         start_line = 0;
-        auto f                                    = [&](size_t start, size_t end) {
-            auto it2 = it + start * linesize_out;
-            for (dimension_t line = start; line < end; ++line) {
-                const dimension_t top     = line * unscale_y;
-                const dimension_t bottom  = top + 256;
-                const uint64_t    y_ratio = line * unscale_y - top;
-                kernel::eval(it2, it_in + top / 256 * linesize_in, it_in + bottom / 256 * linesize_in, new_resolution.width, res.width, unscale_x, y_ratio);
+    using namespace core::raw_format;
+    switch (frame->get_format()) {
+    case rgb24:
+    case bgr24:
+    case yuv444:
+        scale_regions<kernel_packed<3>, position>(frame, outframe, regions, threads);
+        return true;
+    case rgba32:
+    case argb32:
+    case bgra32:
+    case abgr32:
+    case yuva4444:
+        scale_regions<kernel_packed<4>, position>(frame, outframe, regions, threads);
+        return true;
+    case yuyv422:
+    case yvyu422:
+        scale_regions<kernel_yuyv, position>(frame, outframe, regions, threads);
+        return true;
+    case uyvy422:
+    case vyuy422:
+        scale_regions<kernel_uyvy, position>(frame, outframe, regions, threads);
+        return true;
+    }
+    return false;
+}
 
-                it2 += linesize_out;
-            }
-        };
-        for (auto i : irange(threads)) {
-            results[i] = std::async(std::launch::async, f, start_line, std::min(start_line + task_lines, new_resolution.height - 1));
-            start_line += task_lines;
-        }
-        for (auto& t : results) {
-            t.get();
-        }
+/*!
+ * Returns region of the output image affected by a change of @em rect in the source image.
+ * Each output pixel is interpolated from 2 neighbouring source pixels (4 for chroma in YUV 4:2:2),
+ * so the rectangle is extended accordingly.
+ */
+geometry_t scale_damage(geometry_t rect, const resolution_t resolution, const double unscale_x, const double unscale_y, const resolution_t new_resolution)
+{
+    if (unscale_x <= 0.0 || unscale_y <= 0.0)
+        return new_resolution.get_geometry();
+    if (rect.x < 4 || geometry_max_x(rect) + 4 > static_cast<position_t>(resolution.width)) {
+        // Kernels for YUV 4:2:2 read pixels of neighbouring lines at the edges of the image
+        rect = { resolution.width, rect.height + 2, 0, rect.y - 1 };
     }
-    kernel::eval(PLANE_RAW_DATA(outframe, 0) + (new_resolution.height - 1) * linesize_out, PLANE_RAW_DATA(frame, 0) + (res.height - 1) * linesize_in,
-                 PLANE_RAW_DATA(frame, 0) + (res.height - 1) * linesize_in, new_resolution.width, res.width, unscale_x, 0.0);
-    outframe->copy_video_params(*frame);
-    return outframe;
+    const auto x0 = static_cast<position_t>(std::floor((rect.x - 3) / unscale_x));
+    const auto y0 = static_cast<position_t>(std::floor((rect.y - 1) / unscale_y));
+    const auto x1 = static_cast<position_t>(std::ceil(geometry_max_x(rect) / unscale_x)) + 1;
+    const auto y1 = static_cast<position_t>(std::ceil(geometry_max_y(rect) / unscale_y)) + 1;
+    // Kernels for YUV 4:2:2 process pixels in pairs
+    return core::align_damage({ static_cast<dimension_t>(x1 - x0), static_cast<dimension_t>(y1 - y0), x0, y0 }, 2, 1, new_resolution);
 }
 }
 
@@ -327,49 +379,49 @@ core::pFrame Scale::do_special_single_step(core::pRawVideoFrame frame)
     // Simple sanity check
     if (resolution_.width > 1e5 || resolution_.height > 1e5)
         return {};
-    using namespace core::raw_format;
-    if (fast_) {
-        switch (frame->get_format()) {
-        case rgb24:
-        case bgr24:
-        case yuv444:
-            return scale_image_fast<scale_line_bilinear_fast<3>>(frame, resolution_, threads_);
 
-        case rgba32:
-        case argb32:
-        case bgra32:
-        case abgr32:
-        case yuva4444:
-            return scale_image_fast<scale_line_bilinear_fast<4>>(frame, resolution_, threads_);
-        case yuyv422:
-        case yvyu422:
-            return scale_image_fast<scale_line_bilinear_yuyv_fast>(frame, resolution_, threads_);
-        case uyvy422:
-        case vyuy422:
-            return scale_image_fast<scale_line_bilinear_uyvy_fast>(frame, resolution_, threads_);
+    const auto              res = frame->get_resolution();
+    std::vector<geometry_t> damage;
+    if (frame->has_damage()) {
+        const double unscale_x = fast_ ? position_fast::unscale_factor(res.width, resolution_.width)
+                                       : position_bilinear::unscale_factor(res.width, resolution_.width);
+        const double unscale_y = fast_ ? position_fast::unscale_factor(res.height, resolution_.height)
+                                       : position_bilinear::unscale_factor(res.height, resolution_.height);
+        for (const auto& rect : core::simplify_damage(frame->get_damage(), res)) {
+            const auto scaled = scale_damage(rect, res, unscale_x, unscale_y, resolution_);
+            if (scaled)
+                damage.push_back(scaled);
         }
+    }
+
+    // When the frame directly follows the previous one, only damaged regions are scaled
+    // and the rest is reused from the previous output.
+    core::pRawVideoFrame    outframe;
+    std::vector<geometry_t> regions;
+    if (last_output_ && last_output_->get_resolution() == resolution_ && damage_tracker_.follows(*frame)) {
+        outframe = get_frame_unique(last_output_);
+        regions  = damage;
     } else {
-        switch (frame->get_format()) {
-        case rgb24:
-        case bgr24:
-        case yuv444:
-            return scale_image<scale_line_bilinear<3>>(frame, resolution_, threads_);
+        outframe = core::RawVideoFrame::create_empty(frame->get_format(), resolution_);
+        regions  = { resolution_.get_geometry() };
+    }
 
-        case rgba32:
-        case argb32:
-        case bgra32:
-        case abgr32:
-        case yuva4444:
-            return scale_image<scale_line_bilinear<4>>(frame, resolution_, threads_);
-        case yuyv422:
-        case yvyu422:
-            return scale_image<scale_line_bilinear_yuyv>(frame, resolution_, threads_);
-        case uyvy422:
-        case vyuy422:
-            return scale_image<scale_line_bilinear_uyvy>(frame, resolution_, threads_);
-        }
+    const bool scaled = fast_ ? scale_image<position_fast, scale_line_bilinear_fast, scale_line_bilinear_yuyv_fast, scale_line_bilinear_uyvy_fast>(
+                                    frame, outframe, regions, threads_)
+                              : scale_image<position_bilinear, scale_line_bilinear, scale_line_bilinear_yuyv, scale_line_bilinear_uyvy>(
+                                    frame, outframe, regions, threads_);
+    if (!scaled)
+        return {};
+    outframe->copy_video_params(*frame);
+    if (frame->has_damage()) {
+        outframe->set_damage(std::move(damage));
+        damage_tracker_.update(*frame);
+        last_output_ = outframe;
+    } else {
+        outframe->clear_damage();
+        last_output_.reset();
     }
-    return {};
+    return outframe;
 }
 bool Scale::set_param(const core::Parameter& param)
 {
@@ -388,8 +440,11 @@ bool Scale::do_process_event(const std::string& event_name, const event::pBasicE
         (resolution_, "resolution")      //
         (fast_, "fast")                  //
         (threads_, "threads")            //
-        )
+        ) {
+        // Output for previous frame is not valid anymore
+        last_output_.reset();
         return true;
+    }
     return false;
 }
 } /* namespace scale */
@@ -12,6 +12,7 @@
 
 #include "yuri/core/thread/SpecializedIOFilter.h"
 #include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/frame/damage.h"
 #include "yuri/event/BasicEventConsumer.h"
 
 namespace yuri {
@@ -34,6 +35,9 @@ private:
     resolution_t resolution_;
     bool         fast_;
     size_t       threads_;
+
+    core::pRawVideoFrame last_output_;
+    core::DamageTracker  damage_tracker_;
 };
 
 } /* namespace scale */
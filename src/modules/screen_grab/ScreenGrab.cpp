@@ -12,6 +12,7 @@
 #include "X11/Xutil.h"
 #include "X11/Xatom.h"
 #include <string>
+#include <cstring>
 namespace yuri {
 namespace screen {
 
@@ -34,6 +35,7 @@ core::Parameters ScreenGrab::configure()
 	p["win_name"]["Window name (set to empty string to grab whole screen)"]=std::string();
 	p["pid"]["PID of application that created the window (set to 0 to grab whole screen)"]=0;
 	p["win_id"]["Window ID (set to 0 to grab whole screen)"]=0;
+	p["damage"]["Compare grabbed images and mark changed regions in output frames"]=true;
 	return p;
 }
 namespace {
@@ -95,11 +97,54 @@ Window find_child(Display* dpy, Window top, T val, F func)
 	XFree(childs);
 	return found_win;
 }
+
+//! Size of tiles used to find changed regions
+const int damage_tile = 32;
+
+/*!
+ * Compares two images tile by tile and returns list of changed regions.
+ * Changed tiles adjacent in a row are merged into a single rectangle.
+ */
+std::vector<geometry_t> compare_images(const XImage& img, const XImage& last, int w, int h)
+{
+	std::vector<geometry_t> damage;
+	const int bpp = img.bits_per_pixel / 8;
+	const int tiles_x = (w + damage_tile - 1) / damage_tile;
+	std::vector<bool> dirty(tiles_x);
+	for (int y0 = 0; y0 < h; y0 += damage_tile) {
+		const int y1 = std::min(h, y0 + damage_tile);
+		std::fill(dirty.begin(), dirty.end(), false);
+		for (int line = y0; line < y1; ++line) {
+			const char* a = img.data + line * img.bytes_per_line;
+			const char* b = last.data + line * last.bytes_per_line;
+			if (!std::memcmp(a, b, w * bpp)) continue;
+			for (int tile = 0; tile < tiles_x; ++tile) {
+				if (dirty[tile]) continue;
+				const int x0 = tile * damage_tile;
+				const int x1 = std::min(w, x0 + damage_tile);
+				if (std::memcmp(a + x0 * bpp, b + x0 * bpp, (x1 - x0) * bpp)) dirty[tile] = true;
+			}
+		}
+		for (int tile = 0; tile < tiles_x;) {
+			if (!dirty[tile]) {
+				++tile;
+				continue;
+			}
+			int end = tile + 1;
+			while (end < tiles_x && dirty[end]) ++end;
+			const int x0 = tile * damage_tile;
+			const int x1 = std::min(w, end * damage_tile);
+			damage.push_back({static_cast<dimension_t>(x1 - x0), static_cast<dimension_t>(y1 - y0), x0, y0});
+			tile = end;
+		}
+	}
+	return damage;
+}
 }
 
 ScreenGrab::ScreenGrab(const log::Log &log_, core::pwThreadBase parent, const core::Parameters &parameters):
 core::IOThread(log_,parent,1,1,std::string("screen_grab")),fps_(0.0), win(0),position_{0,0},
-resolution_{0,0},cursor_(false),pid(0),win_id_(0)
+resolution_{0,0},cursor_(false),pid(0),win_id_(0),damage_(true)
 {
 	IOTHREAD_INIT(parameters)
 	XInitThreads();
@@ -161,6 +206,7 @@ void ScreenGrab::run()
 		step();
 	}
 	close_pipes();
+	last_image_.reset();
 	XSetErrorHandler(nullptr);
 	dpy.reset();
 }
@@ -226,6 +272,13 @@ bool ScreenGrab::step()
 				std::copy(data+img->bytes_per_line*line,data+img->bytes_per_line*line+copy_bytes,out);
 				out+=copy_bytes;
 			}
+			if (damage_) {
+				if (last_image_ && last_image_->width == img->width && last_image_->height == img->height &&
+						last_image_->bits_per_pixel == img->bits_per_pixel) {
+					frame->set_damage(compare_images(*img, *last_image_, w, h));
+				}
+				last_image_ = img;
+			}
 			push_frame(0,frame);
 		}
 		return true;
@@ -245,7 +298,8 @@ bool ScreenGrab::set_param(const core::Parameter &param)
 			(cursor_, "cursor")
 			(win_name, "win_name")
 			(pid, "pid")
-			(win_id_, "win_id"))
+			(win_id_, "win_id")
+			(damage_, "damage"))
 		return true;
 
 	return core::IOThread::set_param(param);
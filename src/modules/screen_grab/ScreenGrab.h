@@ -35,6 +35,9 @@ private:
 	std::string win_name;
 	size_t pid;
 	Window win_id_;
+	bool damage_;
+	//! Previously grabbed image, used to find changed regions
+	std::shared_ptr<XImage> last_image_;
 
 };
 
@@ -26,11 +26,14 @@ core::Parameters SimpleH264RtpReceiver::configure()
     p["address"]["Remote address"] = "127.0.0.1";
     p["socket_type"]               = "yuri_udp";
     p["port"]                      = 57120;
+    p["receive_buffer"]["Size of the socket receive buffer in bytes, 0 to keep the system default"] = 4194304;
+    p["batch"]["Maximal number of packets read at once"] = 32;
     return p;
 }
 
 SimpleH264RtpReceiver::SimpleH264RtpReceiver(const log::Log& log_, core::pwThreadBase parent, const core::Parameters& parameters)
-    : core::IOThread(log_, parent, 0, 1, std::string("simple_rtp")), sequence_{ 0 }, address_{ "127.0.0.1" }, port_{ 0x1256 }, socket_type_{ "yuri_udp" }
+    : core::IOThread(log_, parent, 0, 1, std::string("simple_rtp")), sequence_{ 0 }, address_{ "127.0.0.1" }, port_{ 0x1256 }, socket_type_{ "yuri_udp" },
+      receive_buffer_{ 4194304 }, batch_{ 32 }
 {
     IOTHREAD_INIT(parameters)
 }
@@ -59,18 +62,30 @@ void SimpleH264RtpReceiver::run()
         request_end(core::yuri_exit_interrupted);
         return;
     }
+    if (receive_buffer_)
+        socket_->set_receive_buffer_size(receive_buffer_);
     log[log::info] << "Socket initialized";
 
     std::vector<uint8_t> buffer;
 
-    // Allocate large packet
-    RTPPacket    packet(65535, 0, 0, 0, 0);
+    // Allocate large packets
+    std::vector<RTPPacket>                         packets(std::max<size_t>(batch_, 1), RTPPacket(65535, 0, 0, 0, 0));
+    std::vector<core::socket::received_datagram_t> datagrams(packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        datagrams[i].data     = packets[i].data.data();
+        datagrams[i].capacity = packets[i].data.size();
+    }
     resolution_t res{ 0, 0 };
     uint32_t     last_timestamp_ = 0;
+    timestamp_t  frame_time;
     while (still_running()) {
-        if (socket_->wait_for_data(get_latency())) {
-            log[log::verbose_debug] << "reading data";
-            const auto read_bytes = socket_->receive_datagram(&packet.data[0], packet.data.size());
+        if (!socket_->wait_for_data(get_latency()))
+            continue;
+        log[log::verbose_debug] << "reading data";
+        const auto count = socket_->receive_datagrams(datagrams);
+        for (size_t i = 0; i < count; ++i) {
+            auto&      packet     = packets[i];
+            const auto read_bytes = datagrams[i].size;
             if (sequence_ != packet.get_sequence()) {
                 log[log::warning] << "Missing packet(s)! Expected sequence " << sequence_ << ", got " << packet.get_sequence();
             }
@@ -79,11 +94,14 @@ void SimpleH264RtpReceiver::run()
                 // We assume that frames with the same timestamp should be merged together
                 if (!buffer.empty()) {
                     auto frame = core::CompressedVideoFrame::create_empty(core::compressed_frame::h264, res, buffer.data(), buffer.size());
+                    // Frame gets the time its first packet arrived
+                    frame->set_timestamp(frame_time);
                     log[log::verbose_debug] << "Sending (single) frame with " << frame->size();
                     push_frame(0, std::move(frame));
                     buffer.clear();
                 }
                 last_timestamp_ = packet.get_timestamp();
+                frame_time      = datagrams[i].timestamp;
             }
             if (read_bytes > RTPPacket::header_size) {
                 // TODO: verify RTP headers and stuff ...
@@ -123,7 +141,9 @@ bool SimpleH264RtpReceiver::set_param(const core::Parameter& param)
     if (assign_parameters(param)       //
         (address_, "address")          //
         (port_, "port")                //
-        (socket_type_, "socket_type")) //
+        (socket_type_, "socket_type")  //
+        (receive_buffer_, "receive_buffer") //
+        (batch_, "batch"))             //
         return true;
 
     return core::IOThread::set_param(param);
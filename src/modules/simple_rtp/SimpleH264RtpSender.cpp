@@ -27,6 +27,10 @@ core::Parameters SimpleH264RtpSender::configure()
     p["address"]["Remote address"] = "127.0.0.1";
     p["socket_type"]               = "yuri_udp";
     p["port"]                      = 57120;
+    p["send_buffer"]["Size of the socket send buffer in bytes, 0 to keep the system default"] = 0;
+    p["bitrate"]["Maximal bitrate in bits per second. Packets of each frame are spread over the frame interval, "
+                 "faster than this bitrate if needed. Set to 0 to send whole frames at once."] = 0;
+    p["burst"]["Maximal number of bytes sent at once, when limiting bitrate"] = 65536;
     return p;
 }
 
@@ -37,7 +41,16 @@ SimpleH264RtpSender::SimpleH264RtpSender(const log::Log& log_, core::pwThreadBas
       sequence_{ 0 },
       address_{ "127.0.0.1" },
       port_{ 0x1256 },
-      socket_type_{ "yuri_udp" }
+      socket_type_{ "yuri_udp" },
+      send_buffer_{ 0 },
+      bitrate_{ 0 },
+      burst_{ 65536 },
+      sender_(log,
+              [this](timestamp_t deadline) {
+                  wait_until(deadline);
+                  return still_running();
+              }),
+      last_frame_time_{ timestamp_t{} - 1_s }
 {
     IOTHREAD_INIT(parameters)
 }
@@ -56,6 +69,10 @@ void SimpleH264RtpSender::run()
         request_end(core::yuri_exit_interrupted);
         return;
     }
+    if (send_buffer_)
+        socket_->set_send_buffer_size(send_buffer_);
+    sender_.set_socket(socket_);
+    sender_.set_pacing(bitrate_, burst_);
     log[log::info] << "Socket initialized";
     base_type::run();
 }
@@ -139,11 +156,11 @@ core::pFrame SimpleH264RtpSender::do_special_single_step(core::pCompressedVideoF
         if (d.size < (mtu_ + RTPPacket::header_size)) {
             // Packetize as single NAL unit packet
             // TODO: set payload type and timestamp
-            RTPPacket packet(d.size, 99, sequence_++, timestamp, ssrc_);
-            std::copy(d.ptr, d.ptr + d.size, packet.data_begin());
+            packets_.emplace_back(0, 99, sequence_++, timestamp, ssrc_);
+            auto& packet = packets_.back();
+            packet.set_external_payload(d.ptr, d.size);
             packet.set_marker_bit();
-            send_rtp_packet(packet);
-            log[log::verbose_debug] << "Sent small packet " << sequence_;
+            log[log::verbose_debug] << "Prepared small packet " << sequence_;
         } else {
             // Fragment into multiple packets
             auto    nal_head = d.ptr[0];
@@ -152,7 +169,8 @@ core::pFrame SimpleH264RtpSender::do_special_single_step(core::pCompressedVideoF
             size_t offset    = 1;
             for (auto remaining = d.size - 1; remaining > 0;) {
                 const auto size = std::min(mtu_ - 2, remaining);
-                RTPPacket  packet(size + 2, 99, sequence_++, timestamp, ssrc_);
+                packets_.emplace_back(2, 99, sequence_++, timestamp, ssrc_);
+                auto&      packet = packets_.back();
                 auto       data = &(*packet.data_begin());
                 data[0]         = fu_head;
                 if (remaining == size) {
@@ -161,11 +179,10 @@ core::pFrame SimpleH264RtpSender::do_special_single_step(core::pCompressedVideoF
                 }
                 data[1]  = nal_head;
                 nal_head = nal_head & 0x1F; // Unset S and R bits
-                std::copy(d.ptr + offset, d.ptr + offset + size, packet.data_begin() + 2);
-                send_rtp_packet(packet);
+                packet.set_external_payload(d.ptr + offset, size);
                 remaining -= size;
                 offset += size;
-                log[log::verbose_debug] << "Sent FU packet " << sequence_ << " (" << size << ")";
+                log[log::verbose_debug] << "Prepared FU packet " << sequence_ << " (" << size << ")";
             }
         }
         dv.ptr       = d.ptr + d.size;
@@ -174,22 +191,14 @@ core::pFrame SimpleH264RtpSender::do_special_single_step(core::pCompressedVideoF
 
         d = find_nal(dv, avc_size);
     }
+    // Frames without duration are expected to be spaced as the previous ones
+    const auto now      = timestamp_t{};
+    const auto interval = frame->get_duration().value > 0 ? frame->get_duration() : now - last_frame_time_;
+    last_frame_time_    = now;
+    sender_.send(packets_, interval);
     return {};
 }
 
-bool SimpleH264RtpSender::send_rtp_packet(const RTPPacket& packet)
-{
-    int i = 0;
-    while (i++ < 5) {
-        auto s = socket_->send_datagram(packet.data);
-        if (s == packet.data.size()) {
-            return true;
-        }
-    }
-    log[log::error] << "Failed to send packet with " << packet.data.size() << " bytes";
-    return false;
-}
-
 bool SimpleH264RtpSender::set_param(const core::Parameter& param)
 {
     if (assign_parameters(param)       //
@@ -197,7 +206,10 @@ bool SimpleH264RtpSender::set_param(const core::Parameter& param)
         (ssrc_, "ssrc")                //
         (address_, "address")          //
         (port_, "port")                //
-        (socket_type_, "socket_type")) //
+        (socket_type_, "socket_type")  //
+        (send_buffer_, "send_buffer")  //
+        (bitrate_, "bitrate")          //
+        (burst_, "burst"))             //
         return true;
     return base_type::set_param(param);
 }
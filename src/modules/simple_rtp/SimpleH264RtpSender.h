@@ -12,6 +12,7 @@
 #define SIMPLEH264RTPSENDER_H_
 
 #include "rtp_packet.h"
+#include "rtp_sender.h"
 #include "yuri/core/frame/CompressedVideoFrame.h"
 #include "yuri/core/socket/DatagramSocket.h"
 #include "yuri/core/thread/SpecializedIOFilter.h"
@@ -32,7 +33,6 @@ private:
     void         run() override;
     virtual bool set_param(const core::Parameter& param) override;
 
-    bool send_rtp_packet(const RTPPacket& packet);
     size_t                                        mtu_;
     uint32_t                                      ssrc_;
     uint16_t                                      sequence_;
@@ -40,6 +40,13 @@ private:
     std::string                                   address_;
     uint16_t                                      port_;
     std::string                                   socket_type_;
+    size_t                                        send_buffer_;
+    uint64_t                                      bitrate_;
+    size_t                                        burst_;
+    //! Packets of the current frame, sent together after the whole frame is packetized
+    std::vector<RTPPacket>                        packets_;
+    PacketSender                                  sender_;
+    timestamp_t                                   last_frame_time_;
 };
 
 } /* namespace simple_rtp */
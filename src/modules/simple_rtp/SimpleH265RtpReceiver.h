@@ -32,6 +32,8 @@ private:
     std::string                                   address_;
     uint16_t                                      port_;
     std::string                                   socket_type_;
+    size_t                                        receive_buffer_;
+    size_t                                        batch_;
 };
 
 } /* namespace simple_rtp */
@@ -11,6 +11,7 @@
 #ifndef SRC_MODULES_SIMPLE_RTP_RTP_PACKET_H_
 #define SRC_MODULES_SIMPLE_RTP_RTP_PACKET_H_
 
+#include "yuri/core/utils/data_segment.h"
 #include <vector>
 #include <cstdint>
 
@@ -37,6 +38,13 @@ struct RTPPacket {
         data[11] = (ssrc >> 0) & 0xFF;
     }
 
+    /*!
+     * Sets payload stored outside of the packet, that gets sent after @em data without copying.
+     * The memory has to stay valid until the packet is sent.
+     */
+    void set_external_payload(const uint8_t* ptr, size_type size) { external_payload = { ptr, size, {} }; }
+    size_type packet_size() const { return data.size() + external_payload.size; }
+
     std::vector<uint8_t>::iterator       data_begin() { return data.begin() + header_size; }
     std::vector<uint8_t>::const_iterator data_end() const { return data.end(); }
     size_type                            data_size() const { return data.size() - header_size; }
@@ -51,6 +59,7 @@ struct RTPPacket {
             | (static_cast<uint32_t>(data[7]) << 0);
     }
     std::vector<uint8_t> data;
+    core::data_segment_t external_payload{ nullptr, 0, {} };
 };
 }
 }
@@ -0,0 +1,107 @@
+/*!
+ * @file 		rtp_sender.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file
+ * doc/LICENSE
+ *
+ */
+
+#include "rtp_sender.h"
+#include <algorithm>
+
+namespace yuri {
+namespace simple_rtp {
+
+namespace {
+//! Upper bound of a single wait for the socket, so stopping the node is noticed
+const duration_t send_wait_timeout = 10_ms;
+}
+
+void PacketSender::set_pacing(uint64_t bitrate, size_t burst)
+{
+    bitrate_ = bitrate;
+    bucket_.set_burst(burst);
+}
+
+bool PacketSender::send(std::vector<RTPPacket>& packets, duration_t interval)
+{
+    bool ok = true;
+    if (!bitrate_) {
+        ok = send_range(packets, 0, packets.size());
+        packets.clear();
+        return ok;
+    }
+    size_t total = 0;
+    for (const auto& p : packets) {
+        total += p.packet_size();
+    }
+    // Frame has to be sent before the next one arrives, even if it exceeds the bitrate
+    auto rate = bitrate_ / 8.0;
+    if (interval.value > 0)
+        rate = std::max(rate, total * 1e6 / interval.value);
+    bucket_.set_rate(rate);
+
+    size_t first = 0;
+    while (ok && first < packets.size()) {
+        bucket_.update(timestamp_t{});
+        size_t last  = first;
+        size_t bytes = 0;
+        while (last < packets.size() && bytes + packets[last].packet_size() <= bucket_.available()) {
+            bytes += packets[last++].packet_size();
+        }
+        // Packet larger than the burst size is sent alone, when the bucket is full
+        if (last == first && bucket_.full())
+            bytes += packets[last++].packet_size();
+        if (last == first) {
+            if (!wait_(bucket_.when_available(packets[first].packet_size())))
+                break;
+            continue;
+        }
+        ok = send_range(packets, first, last);
+        bucket_.consume(bytes);
+        first = last;
+    }
+    packets.clear();
+    return ok;
+}
+
+bool PacketSender::send_range(const std::vector<RTPPacket>& packets, size_t first, size_t last)
+{
+    batch_.resize(last - first);
+    for (size_t i = first; i < last; ++i) {
+        const auto& packet   = packets[i];
+        auto&       segments = batch_[i - first];
+        segments.clear();
+        segments.push_back({ packet.data.data(), packet.data.size(), {} });
+        if (packet.external_payload.size)
+            segments.push_back(packet.external_payload);
+    }
+    bool reported = false;
+    while (!batch_.empty()) {
+        const auto sent = socket_->send_datagrams(batch_);
+        if (sent) {
+            batch_.erase(batch_.begin(), batch_.begin() + sent);
+            continue;
+        }
+        if (socket_->wait_for_send(send_wait_timeout)) {
+            // The socket was writable, but sending failed anyway, so back off instead of spinning
+            if (!reported) {
+                log[log::warning] << "Failed to send packets, retrying";
+                reported = true;
+            }
+            if (!wait_(timestamp_t{} + send_wait_timeout))
+                break;
+        } else if (!wait_(timestamp_t{})) {
+            break;
+        }
+    }
+    if (!batch_.empty()) {
+        log[log::error] << "Failed to send " << batch_.size() << " packets";
+        return false;
+    }
+    return true;
+}
+}
+}
@@ -0,0 +1,105 @@
+/*!
+ * @file 		rtp_sender.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file
+ * doc/LICENSE
+ *
+ */
+
+#ifndef SRC_MODULES_SIMPLE_RTP_RTP_SENDER_H_
+#define SRC_MODULES_SIMPLE_RTP_RTP_SENDER_H_
+
+#include "rtp_packet.h"
+#include "yuri/core/socket/DatagramSocket.h"
+#include "yuri/log/Log.h"
+#include <algorithm>
+#include <functional>
+
+namespace yuri {
+namespace simple_rtp {
+
+/*!
+ * Token bucket limiting the rate of sent data.
+ * Tokens (bytes) are added continuously at the given rate, up to the burst size.
+ */
+class TokenBucket {
+public:
+    TokenBucket() : rate_(0.0), burst_(0.0), tokens_(0.0) {}
+
+    //! @param rate Rate in bytes per second
+    void set_rate(double rate) { rate_ = rate; }
+    void set_burst(size_t burst) { burst_ = static_cast<double>(burst); }
+    double get_rate() const { return rate_; }
+
+    //! Adds tokens for the time passed since the last update
+    void update(timestamp_t now)
+    {
+        tokens_ = std::min(burst_, tokens_ + rate_ * (now - last_).value / 1e6);
+        last_   = now;
+    }
+    size_t available() const { return tokens_ > 0.0 ? static_cast<size_t>(tokens_) : 0; }
+    bool   full() const { return tokens_ >= burst_; }
+    //! Tokens may go negative, when sending a packet larger than burst size
+    void consume(size_t bytes) { tokens_ -= bytes; }
+    //! Time when @em bytes will be available (or the bucket gets full, when it's smaller)
+    timestamp_t when_available(size_t bytes) const
+    {
+        const auto needed = std::min(burst_, static_cast<double>(bytes));
+        if (tokens_ >= needed || rate_ <= 0.0)
+            return last_;
+        return last_ + duration_t{ static_cast<int64_t>((needed - tokens_) * 1e6 / rate_) + 1 };
+    }
+
+private:
+    double      rate_;
+    double      burst_;
+    double      tokens_;
+    timestamp_t last_;
+};
+
+/*!
+ * Sends RTP packets of a frame, either all at once or paced by a token bucket.
+ * Header and payload of each packet are sent as separate segments, so the payload
+ * is sent directly from the frame.
+ */
+class PacketSender {
+public:
+    //! Waits until the deadline, returns false if sending should be interrupted
+    using wait_function_t = std::function<bool(timestamp_t)>;
+
+    PacketSender(log::Log& log, wait_function_t wait) : log(log), wait_(std::move(wait)), bitrate_(0) {}
+
+    void set_socket(core::socket::pDatagramSocket socket) { socket_ = std::move(socket); }
+    /*!
+     * @param bitrate Bitrate in bits per second, 0 to send whole frames at once
+     * @param burst Maximal number of bytes sent at once
+     */
+    void set_pacing(uint64_t bitrate, size_t burst);
+
+    /*!
+     * Sends @em packets and clears them.
+     * @param interval Time until the next frame. When pacing, the packets are sent
+     * faster than the configured bitrate, if it's needed to send them within this interval.
+     */
+    bool send(std::vector<RTPPacket>& packets, duration_t interval);
+
+private:
+    /*!
+     * Sends packets in [first, last). When no packet could be sent, waits for the socket
+     * to become writable and retries, until all packets are sent or sending is interrupted.
+     */
+    bool send_range(const std::vector<RTPPacket>& packets, size_t first, size_t last);
+
+    log::Log&                          log;
+    wait_function_t                    wait_;
+    core::socket::pDatagramSocket      socket_;
+    uint64_t                           bitrate_;
+    TokenBucket                        bucket_;
+    std::vector<core::data_segments_t> batch_;
+};
+}
+}
+
+#endif /* SRC_MODULES_SIMPLE_RTP_RTP_SENDER_H_ */
@@ -13,6 +13,9 @@
 #include <sys/un.h>
 #include <poll.h>
 #include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
 
 
 
@@ -33,12 +36,56 @@ core::socket::DatagramSocket(log_),socket_(domain, SOCK_DGRAM, 0)
   		log[log::warning] << "Failed to set SO_REUSEPORT";
  }
 #endif
+#ifdef SO_TIMESTAMPNS
+ // Arrival times of datagrams are reported by receive_datagrams()
+ optval = 1;
+ if(setsockopt(get_socket(), SOL_SOCKET, SO_TIMESTAMPNS,(void *) &optval, sizeof(optval)) <0){
+  		log[log::debug] << "Failed to set SO_TIMESTAMPNS";
+ }
+#endif
 }
 
 YuriDatagram::~YuriDatagram() noexcept
 {
 }
 
+namespace {
+
+/*!
+ * Sets socket buffer size, using the privileged option to exceed system limit if possible.
+ * @return actual size of the buffer
+ */
+size_t set_buffer_size(int sock, int option, int force_option, size_t size)
+{
+	const int value = static_cast<int>(size);
+	::setsockopt(sock, SOL_SOCKET, option, &value, sizeof(value));
+	int actual = 0;
+	socklen_t len = sizeof(actual);
+	::getsockopt(sock, SOL_SOCKET, option, &actual, &len);
+	if (force_option && static_cast<size_t>(actual) < size) {
+		::setsockopt(sock, SOL_SOCKET, force_option, &value, sizeof(value));
+		::getsockopt(sock, SOL_SOCKET, option, &actual, &len);
+	}
+#ifdef YURI_LINUX
+	// Linux reports twice the requested size, the other half is reserved for bookkeeping
+	actual /= 2;
+#endif
+	return actual;
+}
+
+#ifdef YURI_LINUX
+//! Kernel timestamps use CLOCK_REALTIME, so they're usable only when timestamp_t uses system clock
+timestamp_t to_timestamp(const timespec& ts)
+{
+	using clock_t = yuri::detail::clock_t;
+	if (!std::is_same<clock_t, std::chrono::system_clock>::value) return {};
+	return std::chrono::time_point<clock_t, std::chrono::nanoseconds>{
+		std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec}};
+}
+#endif
+
+}
+
 
 
 size_t YuriDatagram::do_send_datagram(const uint8_t* data, size_t data_size)
@@ -46,12 +93,121 @@ size_t YuriDatagram::do_send_datagram(const uint8_t* data, size_t data_size)
 	ssize_t wrote = ::send(get_socket(), data, data_size, 0);
 	return (wrote>0)?wrote:0;
 }
+size_t YuriDatagram::do_send_datagram_segments(const core::data_segments_t& segments)
+{
+	iovecs_.resize(segments.size());
+	for (size_t i = 0; i < segments.size(); ++i) {
+		iovecs_[i].iov_base = const_cast<uint8_t*>(segments[i].data);
+		iovecs_[i].iov_len = segments[i].size;
+	}
+	msghdr msg {};
+	msg.msg_iov = iovecs_.data();
+	msg.msg_iovlen = iovecs_.size();
+	ssize_t wrote = ::sendmsg(get_socket(), &msg, 0);
+	return (wrote>0)?wrote:0;
+}
 size_t YuriDatagram::do_receive_datagram(uint8_t* data, size_t size)
 {
 	ssize_t read = ::recv(get_socket(), data, size, MSG_DONTWAIT);
 	return (read>0)?read:0;
 }
 
+#ifdef YURI_LINUX
+size_t YuriDatagram::do_send_datagrams(const std::vector<core::data_segments_t>& datagrams)
+{
+	size_t segment_count = 0;
+	for (const auto& d: datagrams) {
+		segment_count += d.size();
+	}
+	iovecs_.resize(segment_count);
+	headers_.resize(datagrams.size());
+	auto iov = iovecs_.data();
+	for (size_t i = 0; i < datagrams.size(); ++i) {
+		headers_[i] = {};
+		headers_[i].msg_hdr.msg_iov = iov;
+		headers_[i].msg_hdr.msg_iovlen = datagrams[i].size();
+		for (const auto& segment: datagrams[i]) {
+			iov->iov_base = const_cast<uint8_t*>(segment.data);
+			iov->iov_len = segment.size;
+			++iov;
+		}
+	}
+	size_t sent = 0;
+	while (sent < headers_.size()) {
+		// The kernel sends at most UIO_MAXIOV datagrams in a single call
+		const int ret = ::sendmmsg(get_socket(), headers_.data() + sent, headers_.size() - sent, 0);
+		if (ret < 0 && errno == EINTR) continue;
+		if (ret <= 0) break;
+		sent += ret;
+	}
+	return sent;
+}
+
+size_t YuriDatagram::do_receive_datagrams(std::vector<core::socket::received_datagram_t>& datagrams)
+{
+	const auto count = datagrams.size();
+	iovecs_.resize(count);
+	headers_.resize(count);
+	controls_.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		iovecs_[i].iov_base = datagrams[i].data;
+		iovecs_[i].iov_len = datagrams[i].capacity;
+		headers_[i] = {};
+		headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+		headers_[i].msg_hdr.msg_iovlen = 1;
+		headers_[i].msg_hdr.msg_control = controls_[i].data;
+		headers_[i].msg_hdr.msg_controllen = sizeof(controls_[i].data);
+	}
+	int ret;
+	while ((ret = ::recvmmsg(get_socket(), headers_.data(), count, MSG_DONTWAIT, nullptr)) < 0 && errno == EINTR) {}
+	if (ret <= 0) return 0;
+	const timestamp_t now;
+	for (int i = 0; i < ret; ++i) {
+		auto& d = datagrams[i];
+		d.size = headers_[i].msg_len;
+		d.timestamp = now;
+		auto& msg = headers_[i].msg_hdr;
+		for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+			if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+				timespec ts;
+				std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+				d.timestamp = to_timestamp(ts);
+			}
+		}
+	}
+	return ret;
+}
+#endif
+
+bool YuriDatagram::do_set_receive_buffer_size(size_t size)
+{
+#ifdef SO_RCVBUFFORCE
+	const auto actual = set_buffer_size(get_socket(), SO_RCVBUF, SO_RCVBUFFORCE, size);
+#else
+	const auto actual = set_buffer_size(get_socket(), SO_RCVBUF, 0, size);
+#endif
+	if (actual < size) {
+		log[log::warning] << "Receive buffer limited to " << actual << " bytes instead of " << size
+				<< ", the limit can be raised with sysctl net.core.rmem_max";
+		return false;
+	}
+	return true;
+}
+
+bool YuriDatagram::do_set_send_buffer_size(size_t size)
+{
+#ifdef SO_SNDBUFFORCE
+	const auto actual = set_buffer_size(get_socket(), SO_SNDBUF, SO_SNDBUFFORCE, size);
+#else
+	const auto actual = set_buffer_size(get_socket(), SO_SNDBUF, 0, size);
+#endif
+	if (actual < size) {
+		log[log::warning] << "Send buffer limited to " << actual << " bytes instead of " << size
+				<< ", the limit can be raised with sysctl net.core.wmem_max";
+		return false;
+	}
+	return true;
+}
 
 bool YuriDatagram::do_data_available()
 {
@@ -67,5 +223,9 @@ bool YuriDatagram::do_ready_to_send() {
 	return socket_.ready_to_send();
 }
 
+bool YuriDatagram::do_wait_for_send(duration_t duration) {
+	return socket_.wait_for_send(duration);
+}
+
 } /* namespace yuri_tcp */
 } /* namespace yuri */
@@ -12,6 +12,10 @@
 
 #include "yuri/core/socket/DatagramSocket.h"
 #include "YuriNetSocket.h"
+#include "yuri/core/utils/platform.h"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <vector>
 
 namespace yuri {
 namespace network {
@@ -26,13 +30,32 @@ protected:
 private:
 
 	virtual size_t do_send_datagram(const uint8_t* data, size_t size) override;
+	virtual size_t do_send_datagram_segments(const core::data_segments_t& segments) override;
 	virtual size_t do_receive_datagram(uint8_t* data, size_t size) override;
+#ifdef YURI_LINUX
+	virtual size_t do_send_datagrams(const std::vector<core::data_segments_t>& datagrams) override;
+	virtual size_t do_receive_datagrams(std::vector<core::socket::received_datagram_t>& datagrams) override;
+#endif
+	virtual bool do_set_receive_buffer_size(size_t size) override;
+	virtual bool do_set_send_buffer_size(size_t size) override;
 	virtual bool do_ready_to_send() override;
 
 	virtual bool do_data_available() override;
 	virtual bool do_wait_for_data(duration_t duration) override;
+	virtual bool do_wait_for_send(duration_t duration) override;
 protected:
 	YuriNetSocket socket_;
+private:
+	std::vector<iovec> iovecs_;
+#ifdef YURI_LINUX
+	//! Space for the receive timestamp of a single datagram
+	union control_buffer_t {
+		cmsghdr header;
+		char data[CMSG_SPACE(sizeof(timespec))];
+	};
+	std::vector<mmsghdr> headers_;
+	std::vector<control_buffer_t> controls_;
+#endif
 };
 
 }
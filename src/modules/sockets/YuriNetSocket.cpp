@@ -32,9 +32,13 @@ YuriNetSocket::~YuriNetSocket() noexcept
 	::close(socket_);
 }
 bool YuriNetSocket::ready_to_send()
+{
+	return wait_for_send(0_ms);
+}
+bool YuriNetSocket::wait_for_send(duration_t duration)
 {
 	pollfd fds = {socket_, POLLOUT, 0};
-	::poll(&fds, 1, 0);
+	::poll(&fds, 1, static_cast<int>(duration.value/1000));
 	return (fds.revents & POLLOUT);
 }
 bool YuriNetSocket::data_available()
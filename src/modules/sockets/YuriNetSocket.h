@@ -27,6 +27,7 @@ public:
 	int get_sock_domain() const { return sock_domain_; }
 
 	bool ready_to_send();
+	bool wait_for_send(duration_t duration);
 	bool data_available();
 	bool wait_for_data(duration_t duration);
 private:
@@ -12,6 +12,7 @@
 #include "yuri/core/frame/raw_frame_params.h"
 #include "yuri/core/frame/raw_frame_types.h"
 #include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/utils/Timer.h"
 namespace yuri {
 namespace testcard {
 
@@ -53,7 +54,12 @@ TestCard::~TestCard() noexcept
 
 void TestCard::run()
 {
+	FPSTimer timer(fps_);
 	while(still_running()) {
+		if (!wait_until(timer.next_deadline())) {
+			continue;
+		}
+		timer.advance();
 		core::pRawVideoFrame frame = core::RawVideoFrame::create_empty(core::raw_format::rgba32, resolution_, true);
 		const size_t cnum = pattern_colors.size();
 		auto it = PLANE_DATA(frame,0).begin();
@@ -68,6 +68,7 @@ core::Parameters V4l2Source::configure()
 	p["combine"]["Combine frames (if camera sends them in chunks)."]=false;
 	p["fps"]["Number of frames per second requested. The closest LOWER supported value will be selected."]=fraction_t{30,1};
 	p["repeat_headers"]["Repeat headers for compressed formats (H264)"]=true;
+	p["zero_copy"]["Output compressed frames referencing driver buffers (mmap capture only), instead of copying them"]=true;
 	return p;
 }
 
@@ -138,7 +139,7 @@ V4l2Source::V4l2Source(log::Log &log_,core::pwThreadBase parent, const core::Par
  event::BasicEventConsumer(log),
 filename_("/dev/video0"), method_(capture_method_t::none),input_(0),format_(0),
 resolution_({640,480}),fps_{30,1},imagesize_(0),allow_empty_(false),
-buffer_free_(0),illuminator_(true)
+buffer_free_(0),illuminator_(true),zero_copy_(true)
 {
 	IOTHREAD_INIT(parameters)
 
@@ -274,7 +275,11 @@ void V4l2Source::run()
 		}
 		if (device_->wait_for_data(get_latency())) {
 			//device_->read_frame([this](void*,size_t s)->bool{log[log::info]<<"GOt frame with " << s << " bytes"; return true;});
-			device_->read_frame([this](uint8_t*p,size_t s){return prepare_frame(p,s);});
+			if (zero_copy_) {
+				device_->read_shared_frame([this](uint8_t*p,size_t s, const std::shared_ptr<const void>& owner){return prepare_frame(p,s,owner);});
+			} else {
+				device_->read_frame([this](uint8_t*p,size_t s){return prepare_frame(p,s,{});});
+			}
 		}
 		if (!buffer_free_ && output_frame_) {
 			push_frame(0, std::move(output_frame_));
@@ -296,6 +301,7 @@ bool V4l2Source::set_param(const core::Parameter &param)
 			(fps_, "fps")
 				.parsed<std::string>(method_, "method", parse_method)
 			(repeat_headers_, "repeat_headers")
+			(zero_copy_, "zero_copy")
 			)
 		return true;
 
@@ -314,7 +320,7 @@ bool V4l2Source::set_param(const core::Parameter &param)
 
 
 }
-bool V4l2Source::prepare_frame(uint8_t *data, yuri::size_t size)
+bool V4l2Source::prepare_frame(uint8_t *data, yuri::size_t size, const std::shared_ptr<const void>& owner)
 {
 	if (!format_) return false;
 
@@ -378,7 +384,16 @@ bool V4l2Source::prepare_frame(uint8_t *data, yuri::size_t size)
 				}
 			}
 		}
-		if (add_headers) {
+		if (owner) {
+			// The frame references the driver buffer, which is queued again when the frame is released
+			core::CompressedVideoFrame::segments_t segments;
+			if (add_headers) {
+				auto headers = std::make_shared<std::vector<uint8_t>>(headers_);
+				segments.push_back({headers->data(), headers->size(), headers});
+			}
+			segments.push_back({data, size, owner});
+			cframe = core::CompressedVideoFrame::create_empty(format_, resolution_, std::move(segments));
+		} else if (add_headers) {
 			cframe = core::CompressedVideoFrame::create_empty(format_, resolution_, size + headers_.size());
 			std::copy(headers_.begin(), headers_.end(), cframe->begin());
 			std::copy(data, data+size, cframe->begin() + headers_.size());
@@ -48,7 +48,7 @@ private:
 	virtual bool set_param(const core::Parameter &param) override;
 
 	std::unique_ptr<v4l2_device> open_device();
-	bool prepare_frame(uint8_t *data, yuri::size_t size);
+	bool prepare_frame(uint8_t *data, yuri::size_t size, const std::shared_ptr<const void>& owner);
 	bool enum_controls();
 	virtual bool do_process_event(const std::string& event_name, const event::pBasicEvent& event) override;
 
@@ -76,6 +76,7 @@ private:
 	bool repeat_headers_;
 	// Used to store SPS/PPS for H264
 	std::vector<uint8_t> headers_;
+	bool zero_copy_;
 };
 
 }
@@ -13,6 +13,7 @@
 
 #include <vector>
 #include "yuri/core/utils/uvector.h"
+#include <memory>
 #include <string>
 
 namespace yuri {
@@ -21,6 +22,8 @@ namespace v4l2 {
 /** Structure to hold buffer informations */
 struct buffer_t {
 		uvector<uint8_t> data;
+		/** Owns the mmap'ed memory (empty for other methods), frames may keep it after the buffers are released */
+		std::shared_ptr<void> mapping;
 };
 
 /** Methods to read from v4l2 devices*/
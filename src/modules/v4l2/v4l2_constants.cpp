@@ -29,6 +29,20 @@ std::map<yuri::format_t, uint32_t> formats_map= {
 		{bayer_rggb,V4L2_PIX_FMT_SRGGB8},
 		{bayer_grbg,V4L2_PIX_FMT_SGRBG8},
 		{bayer_gbrg,V4L2_PIX_FMT_SGBRG8},
+		{bayer_bggr10,V4L2_PIX_FMT_SBGGR10},
+		{bayer_rggb10,V4L2_PIX_FMT_SRGGB10},
+		{bayer_grbg10,V4L2_PIX_FMT_SGRBG10},
+		{bayer_gbrg10,V4L2_PIX_FMT_SGBRG10},
+		{bayer_bggr12,V4L2_PIX_FMT_SBGGR12},
+		{bayer_rggb12,V4L2_PIX_FMT_SRGGB12},
+		{bayer_grbg12,V4L2_PIX_FMT_SGRBG12},
+		{bayer_gbrg12,V4L2_PIX_FMT_SGBRG12},
+		{bayer_bggr16,V4L2_PIX_FMT_SBGGR16},
+#ifdef V4L2_PIX_FMT_SRGGB16
+		{bayer_rggb16,V4L2_PIX_FMT_SRGGB16},
+		{bayer_grbg16,V4L2_PIX_FMT_SGRBG16},
+		{bayer_gbrg16,V4L2_PIX_FMT_SGBRG16},
+#endif
 
 		{mjpg, 		V4L2_PIX_FMT_MJPEG},
 		{jpeg, 		V4L2_PIX_FMT_JPEG},
@@ -30,10 +30,24 @@
 #include <stdlib.h>
 
 #include <cstring>
+#include <mutex>
 
 namespace yuri {
 namespace v4l2 {
 
+/*!
+ * State of mmap buffers shared with frames referencing them, so the buffers
+ * can be queued again after the frames are released (possibly from another thread).
+ */
+struct v4l2_device::kept_buffers_t {
+	std::mutex mutex;
+	//! Valid only while streaming
+	int fd = -1;
+	bool streaming = false;
+	std::vector<bool> kept;
+	size_t kept_count = 0;
+};
+
 namespace {
 	int xioctl(int fd, unsigned long int request, void *arg)
 	{
@@ -90,7 +104,7 @@ std::vector<std::string> enum_v4l2_devices()
 //}
 
 v4l2_device::v4l2_device(const std::string& path)
-:method_(capture_method_t::none),imagesize_(0),running_(false)
+:method_(capture_method_t::none),imagesize_(0),kept_(std::make_shared<kept_buffers_t>()),running_(false)
 {
 	fd_ = ::open(path.c_str(),O_RDWR|O_NONBLOCK);
 	if (fd_ < 0) throw std::runtime_error("Failed to open file " + path);
@@ -116,7 +130,7 @@ v4l2_device::v4l2_device(const std::string& path)
 }
 
 v4l2_device::v4l2_device(v4l2_device&& rhs) noexcept
-:fd_(rhs.fd_),method_(rhs.method_),imagesize_(0),running_(rhs.running_)
+:fd_(rhs.fd_),method_(rhs.method_),imagesize_(0),kept_(std::move(rhs.kept_)),running_(rhs.running_)
 {
 	rhs.fd_ = 0;
 	rhs.running_ = false;
@@ -125,6 +139,7 @@ v4l2_device& v4l2_device::operator=(v4l2_device&& rhs) noexcept
 {
 	fd_ = rhs.fd_;
 	method_ = rhs.method_;
+	kept_ = std::move(rhs.kept_);
 	running_ = rhs.running_;
 	rhs.fd_ = 0;
 	rhs.running_ = false;
@@ -132,6 +147,7 @@ v4l2_device& v4l2_device::operator=(v4l2_device&& rhs) noexcept
 }
 v4l2_device::~v4l2_device() noexcept
 {
+	reset_kept_buffers();
 	if (fd_>0) {
 		::close(fd_);
 	}
@@ -428,7 +444,8 @@ std::vector<buffer_t> v4l2_device::init_mmap()
 			return {};
 		}
 		auto len = buf.length;
-		buffers[i].data.set(reinterpret_cast<uint8_t*>(ptr), buf.length, [ptr,len](void*)noexcept{::munmap(ptr, len);});
+		buffers[i].mapping = std::shared_ptr<void>(ptr, [len](void* p)noexcept{::munmap(p, len);});
+		buffers[i].data.set(reinterpret_cast<uint8_t*>(ptr), buf.length, [](void*)noexcept{});
 	}
 	return buffers;
 }
@@ -492,6 +509,7 @@ bool v4l2_device::initialize_capture(size_t imagesize, capture_method_t method,
 		log[log::debug] << "Driver supports streaming operations, trying to initialize";
 		if (method == capture_method_t::none || method == capture_method_t::mmap) {
 			log[log::info] << "Initializing mmap";
+			reset_kept_buffers();
 			buffers_ = init_mmap();
 			if (!buffers_.empty()) {
 				log[log::info] << "Initialized capture using mmap";
@@ -533,8 +551,12 @@ bool v4l2_device::start_capture()
 		case capture_method_t::read:
 			running_ = true;
 			return true;
-		case capture_method_t::mmap:
+		case capture_method_t::mmap: {
+			std::unique_lock<std::mutex> _(kept_->mutex);
+			kept_->kept.resize(buffers_.size(), false);
 			for (auto i: irange(0, buffers_.size())) {
+				// Buffers kept by frames are queued when the frames are released
+				if (kept_->kept[i]) continue;
 //				if (buffers_[i].start == MAP_FAILED) {
 //						log[log::error] << "mmap failed (" << errno << ") - "
 //							<< strerror(errno) << std::endl;
@@ -557,9 +579,11 @@ bool v4l2_device::start_capture()
 //										<< ")" << std::endl;
 								return false;
 			}
+			kept_->fd = fd_;
+			kept_->streaming = true;
 			running_ = true;
 			return true;
-
+		}
 		case capture_method_t::user:
 			for (auto i: irange(0, buffers_.size())) {
 				struct v4l2_buffer buf;
@@ -597,6 +621,11 @@ bool v4l2_device::stop_capture()
 			return true;
 		case capture_method_t::mmap:
 		case capture_method_t::user:
+			{
+				// Buffers released after this point are queued by the next start_capture()
+				std::unique_lock<std::mutex> _(kept_->mutex);
+				kept_->streaming = false;
+			}
 			type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 			if (xioctl (fd_, VIDIOC_STREAMOFF, &type)==-1) {
 //				log[log::error] << "VIDIOC_STREAMOFF failed";
@@ -612,6 +641,56 @@ bool v4l2_device::stop_capture()
 
 
 bool v4l2_device::read_frame(std::function<bool(uint8_t*, size_t)> func)
+{
+	if (!func) return read_frame_impl({}, false);
+	return read_frame_impl([&func](uint8_t* data, size_t size, const std::shared_ptr<const void>&) {
+		return func(data, size);
+	}, false);
+}
+
+bool v4l2_device::read_shared_frame(std::function<bool(uint8_t*, size_t, const std::shared_ptr<const void>&)> func)
+{
+	return read_frame_impl(func, true);
+}
+
+std::shared_ptr<const void> v4l2_device::keep_buffer(uint32_t index)
+{
+	// Buffers left to the driver, so it doesn't have to drop frames
+	const size_t min_queued = 2;
+	auto kept = kept_;
+	std::unique_lock<std::mutex> _(kept->mutex);
+	if (!kept->streaming || index >= kept->kept.size() || kept->kept_count + min_queued >= buffers_.size()) {
+		return {};
+	}
+	kept->kept[index] = true;
+	++kept->kept_count;
+	auto mapping = buffers_[index].mapping;
+	return std::shared_ptr<const void>(buffers_[index].data.data(), [kept, mapping, index](const void*) noexcept {
+		std::unique_lock<std::mutex> _(kept->mutex);
+		kept->kept[index] = false;
+		--kept->kept_count;
+		if (kept->streaming) {
+			v4l2_buffer buf;
+			std::memset(&buf, 0, sizeof(buf));
+			buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+			buf.memory = V4L2_MEMORY_MMAP;
+			buf.index = index;
+			xioctl(kept->fd, VIDIOC_QBUF, &buf);
+		}
+	});
+}
+
+void v4l2_device::reset_kept_buffers()
+{
+	if (!kept_) return;
+	{
+		std::unique_lock<std::mutex> _(kept_->mutex);
+		kept_->streaming = false;
+	}
+	kept_ = std::make_shared<kept_buffers_t>();
+}
+
+bool v4l2_device::read_frame_impl(const shared_callback_t& func, bool keep)
 {
 	int res = 0;
 	struct v4l2_buffer buf;
@@ -625,7 +704,7 @@ bool v4l2_device::read_frame(std::function<bool(uint8_t*, size_t)> func)
 			}
 			if (!res)
 				return false; // Should never happen
-			return func(buffers_[0].data.data(), res);
+			return func(buffers_[0].data.data(), res, {});
 		case capture_method_t::mmap:
 			std::memset(&buf, 0, sizeof(buf));
 			buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -667,8 +746,14 @@ bool v4l2_device::read_frame(std::function<bool(uint8_t*, size_t)> func)
 
 //					log[log::verbose_debug] << "Pushing frame with " << buf.bytesused
 //							<< "bytes";
+			if (keep) {
+				if (auto owner = keep_buffer(buf.index)) {
+					// The buffer is queued again when the last copy of the owner is released
+					return func?func(buffers_[buf.index].data.data(),buf.bytesused,owner):false;
+				}
+			}
 			{
-				bool r = func?func(buffers_[buf.index].data.data(),buf.bytesused):false;
+				bool r = func?func(buffers_[buf.index].data.data(),buf.bytesused,{}):false;
 
 //					prepare_frame(reinterpret_cast<uint8_t*>(buffers[buf.index].start),buf.bytesused);
 				if (xioctl (fd_, VIDIOC_QBUF, &buf) == -1) {
@@ -694,7 +779,7 @@ bool v4l2_device::read_frame(std::function<bool(uint8_t*, size_t)> func)
 							}
 					}
 //					prepare_frame(reinterpret_cast<uint8_t*>(buf.m.userptr), buf.length);
-					func(buffers_[buf.index].data.data(),buf.bytesused);
+					if (func) func(buffers_[buf.index].data.data(),buf.bytesused,{});
 					if (xioctl (fd_, VIDIOC_QBUF, &buf)==-1) {
 //							log[log::error] << "VIDIOC_QBUF failed";
 							return false;
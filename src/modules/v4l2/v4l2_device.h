@@ -12,6 +12,8 @@
 
 #include <vector>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include "yuri/core/utils/new_types.h"
 #include "yuri/core/utils/time_types.h"
@@ -97,6 +99,13 @@ struct v4l2_device {
 	bool start_capture();
 	bool stop_capture();
 	bool read_frame(std::function<bool(uint8_t*, size_t)>);
+	/*!
+	 * Reads a frame like read_frame(), but with mmap capture the callback may keep the driver buffer
+	 * by keeping a copy of @em owner. The buffer is queued again when the last copy is released.
+	 * @em owner is empty, and the data have to be copied, for other capture methods
+	 * or when too many buffers are kept already.
+	 */
+	bool read_shared_frame(std::function<bool(uint8_t*, size_t, const std::shared_ptr<const void>& owner)>);
 
 	bool wait_for_data(duration_t duration);
 
@@ -109,11 +118,21 @@ struct v4l2_device {
 	bool set_user_control(uint32_t id, control_state_t state, int32_t value);
 	bool set_camera_control(uint32_t id, control_state_t state, int32_t value);
 private:
+	struct kept_buffers_t;
+	using shared_callback_t = std::function<bool(uint8_t*, size_t, const std::shared_ptr<const void>&)>;
+
+	bool read_frame_impl(const shared_callback_t& func, bool keep);
+	//! Returns owner of mmap buffer @em index, or nullptr if the buffer can't be kept
+	std::shared_ptr<const void> keep_buffer(uint32_t index);
+	//! Makes buffers kept by frames stay out of the driver, new buffers are tracked separately
+	void reset_kept_buffers();
+
 	int fd_;
 	v4l2_device_info info_;
 	capture_method_t method_;
 	size_t imagesize_;
 	std::vector<buffer_t> buffers_;
+	std::shared_ptr<kept_buffers_t> kept_;
 	bool running_;
 };
 
@@ -386,10 +386,13 @@ bool VNCClient::process_data()
 						log[log::error] << "Unimplemented encoding ";
 						break;
 				}
+				if (enc == 0 || enc == 1) damage_.push_back(geometry);
 				move_buffer(12+need);
 				if (!--remaining_rectangles) {
 					state = awaiting_data;
 					core::pRawVideoFrame frame = core::RawVideoFrame::create_empty(core::raw_format::rgb24, resolution_, image.data(), resolution_.width*resolution_.height*3,  true);
+					frame->set_damage(std::move(damage_));
+					damage_.clear();
 					push_frame(0,frame);
 					request_rect(resolution_.get_geometry(),true);
 				}
@@ -62,6 +62,8 @@ private:
 	pixel_format_t pixel_format;
 	receiving_states_t state;
 	yuri::size_t remaining_rectangles;
+	//! Rectangles updated since last output frame
+	std::vector<geometry_t> damage_;
 	timestamp_t last_read;
 	std::string socket_impl_;
 };
@@ -268,7 +268,7 @@ bool VorbisEncoder::process_packet(ogg_packet& packet)
 		std::copy(page.header, page.header+page.header_len, data.data());
 		std::copy(page.body, page.body+page.body_len, data.data()+page.header_len);
 // !!!!!!!!!!!! TODO This obviously should not produce compressed video....
-		auto frame  = core::CompressedVideoFrame::create_empty(core::compressed_frame::ogg, resolution_t{0,0}, data.data(), data.size());
+		auto frame  = core::CompressedVideoFrame::create_empty(core::compressed_frame::ogg, resolution_t{0,0}, std::move(data));
 //					frame->set_duration(frame_duration_); // ????
 		push_frame(0,frame);
 	}
@@ -163,7 +163,6 @@ core::pFrame X264Encoder::do_special_single_step(core::pRawVideoFrame frame)
 		}
 
 	}
-	frame_data_.clear();
 	picture_in_.img.i_csp = it->second;
 	picture_in_.i_pts = frame_number_++;
 	picture_in_.img.i_plane = frame->get_planes_count();
@@ -176,11 +175,7 @@ core::pFrame X264Encoder::do_special_single_step(core::pRawVideoFrame frame)
 	x264_nal_t* nals;
 	int nal_count = 0;
 	Timer t0;
-	if (x264_encoder_encode(encoder_, &nals, &nal_count, &picture_in_, &picture_out_)) {
-		for (int i=0;i<nal_count;++i) {
-			process_nal(nals[i]);
-		}
-	}
+	const int size = x264_encoder_encode(encoder_, &nals, &nal_count, &picture_in_, &picture_out_);
 	for (int i = 0;i < picture_in_.img.i_plane; ++i) {
 		picture_in_.img.plane[i]=orig_planes[i];
 	}
@@ -191,15 +186,13 @@ core::pFrame X264Encoder::do_special_single_step(core::pRawVideoFrame frame)
 		encoded_frames_ = 0;
 		encoding_time_=0_ms;
 	}
+	// Encoder may delay output (e.g. for B-frames)
+	if (size <= 0 || nal_count <= 0) return {};
+	// x264 stores payloads of all NALs from a single call sequentially in memory,
+	// so they are copied into the frame at once.
 	return {core::CompressedVideoFrame::create_empty(core::compressed_frame::h264,
 					resolution_t{static_cast<dimension_t>(params_.i_width), static_cast<dimension_t>(params_.i_height)},
-					&frame_data_[0], frame_data_.size())};
-}
-
-
-void X264Encoder::process_nal(x264_nal_t& nal)
-{
-	frame_data_.insert(frame_data_.end(), nal.p_payload, nal.p_payload + nal.i_payload);
+					nals[0].p_payload, static_cast<size_t>(size))};
 }
 
 bool X264Encoder::set_param(const core::Parameter& param)
@@ -35,7 +35,6 @@ private:
 	virtual core::pFrame do_special_single_step(core::pRawVideoFrame frame) override;
 	virtual bool set_param(const core::Parameter& param) override;
 
-	void process_nal(x264_nal_t& nal);
 	x264_param_t params_;
 	x264_picture_t picture_in_;
 	x264_picture_t picture_out_;
@@ -50,7 +49,6 @@ private:
 	bool cabac_;
 	int threads_;
 	fraction_t fps_;
-	std::vector<uint8_t> frame_data_;
 	duration_t encoding_time_;
 	size_t encoded_frames_;
 	int bframes_;
@@ -90,7 +90,17 @@ namespace yuri {
             auto it = converters_.find(conv_pair);
             if (it != converters_.end()) converter = it->second.first;
             if (converter) {
-                outframe = converter(frame, *this, threads_);
+                // For frames following directly the previous frame, only damaged regions are converted
+                const core::pRawVideoFrame no_frame;
+                const bool reuse = last_output_ && last_output_->get_format() == target_format &&
+                                   damage_tracker_.follows(*frame);
+                outframe = converter(frame, *this, threads_, reuse ? last_output_ : no_frame);
+                if (frame->has_damage()) {
+                    damage_tracker_.update(*frame);
+                    last_output_ = outframe;
+                } else {
+                    last_output_.reset();
+                }
             } else if (in_fmt == target_format) {
                 outframe = frame;
             } else {
@@ -106,6 +116,7 @@ namespace yuri {
 
                 // FIXME: This may update too many fields....
                 outframe->copy_video_params(*frame);
+                outframe->copy_damage(*frame);
             }
             return outframe;
         }
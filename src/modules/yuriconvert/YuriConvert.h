@@ -44,6 +44,8 @@ private:
 	yuri::format_t format_;
 	size_t threads_;
     converter_map converters_;
+	core::pRawVideoFrame last_output_;
+	core::DamageTracker damage_tracker_;
 };
 
 }
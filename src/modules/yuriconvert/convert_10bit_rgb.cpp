@@ -3,6 +3,10 @@
 //
 
 #include "convert_common.h"
+#include "yuri/core/utils/cpu_features.h"
+#ifdef YURI_HAVE_SSSE3_TARGET
+#include <tmmintrin.h>
+#endif
 
 namespace yuri {
     namespace video {
@@ -151,9 +155,9 @@ namespace yuri {
 
         template<>
         void convert_line<core::raw_format::rgb_r10k_le, core::raw_format::rgb48>
-                (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
+                (core::Plane::const_iterator src, core::Plane::iterator dest8, size_t width) {
+            auto dest = reinterpret_cast<uint16_t*>(dest8);
             for (size_t pixel = 0; pixel < width; ++pixel) {
-                // Skipping lowest 2 bits for every component
                 *dest++ = r10k_le::r10k_component_0(src) << 6;
                 *dest++ = r10k_le::r10k_component_1(src) << 6;
                 *dest++ = r10k_le::r10k_component_2(src) << 6;
@@ -163,9 +167,9 @@ namespace yuri {
 
         template<>
         void convert_line<core::raw_format::rgb_r10k_le, core::raw_format::bgr48>
-                (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
+                (core::Plane::const_iterator src, core::Plane::iterator dest8, size_t width) {
+            auto dest = reinterpret_cast<uint16_t*>(dest8);
             for (size_t pixel = 0; pixel < width; ++pixel) {
-                // Skipping lowest 2 bits for every component
                 *dest++ = r10k_le::r10k_component_2(src) << 6;
                 *dest++ = r10k_le::r10k_component_1(src) << 6;
                 *dest++ = r10k_le::r10k_component_0(src) << 6;
@@ -195,6 +199,219 @@ namespace yuri {
             }
         }
 
+        namespace {
+            /*
+             * Conversions between r10k and 16 bit planar RGB.
+             * 10 bit values are expanded to 16 bits by replicating the highest bits.
+             */
+            struct r10k_layout_t {
+                bool big_endian;
+                int r_shift;
+                int g_shift;
+                int b_shift;
+            };
+
+            constexpr r10k_layout_t r10k_be_layout = {true, 20, 10, 0};
+            constexpr r10k_layout_t r10k_le_layout = {false, 22, 12, 2};
+
+            inline uint16_t expand_10bit(uint32_t v) {
+                return static_cast<uint16_t>((v << 6) | (v >> 4));
+            }
+
+            void r10k_to_planar_scalar(const uint8_t* src, uint16_t* r, uint16_t* g, uint16_t* b, size_t width,
+                                       const r10k_layout_t& layout) {
+                for (size_t pixel = 0; pixel < width; ++pixel) {
+                    const uint32_t w = layout.big_endian ?
+                            (static_cast<uint32_t>(src[0]) << 24) | (src[1] << 16) | (src[2] << 8) | src[3] :
+                            (static_cast<uint32_t>(src[3]) << 24) | (src[2] << 16) | (src[1] << 8) | src[0];
+                    r[pixel] = expand_10bit((w >> layout.r_shift) & 0x3FF);
+                    g[pixel] = expand_10bit((w >> layout.g_shift) & 0x3FF);
+                    b[pixel] = expand_10bit((w >> layout.b_shift) & 0x3FF);
+                    src += 4;
+                }
+            }
+
+            void planar_to_r10k_scalar(const uint16_t* r, const uint16_t* g, const uint16_t* b, uint8_t* dst, size_t width,
+                                       const r10k_layout_t& layout) {
+                for (size_t pixel = 0; pixel < width; ++pixel) {
+                    const uint32_t w = (static_cast<uint32_t>(r[pixel] >> 6) << layout.r_shift) |
+                                       (static_cast<uint32_t>(g[pixel] >> 6) << layout.g_shift) |
+                                       (static_cast<uint32_t>(b[pixel] >> 6) << layout.b_shift);
+                    if (layout.big_endian) {
+                        *dst++ = (w >> 24) & 0xFF;
+                        *dst++ = (w >> 16) & 0xFF;
+                        *dst++ = (w >> 8) & 0xFF;
+                        *dst++ = w & 0xFF;
+                    } else {
+                        *dst++ = w & 0xFF;
+                        *dst++ = (w >> 8) & 0xFF;
+                        *dst++ = (w >> 16) & 0xFF;
+                        *dst++ = (w >> 24) & 0xFF;
+                    }
+                }
+            }
+
+#ifdef YURI_HAVE_SSSE3_TARGET
+            // SSSE3 is needed only to swap bytes of big endian words
+            YURI_TARGET_SSSE3
+            inline __m128i load_r10k_ssse3(const uint8_t* src, bool big_endian, __m128i swap) {
+                const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                return big_endian ? _mm_shuffle_epi8(w, swap) : w;
+            }
+
+            YURI_TARGET_SSSE3
+            inline __m128i extract_10bit_ssse3(__m128i w0, __m128i w1, int shift, __m128i mask) {
+                const __m128i count = _mm_cvtsi32_si128(shift);
+                const __m128i v = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(w0, count), mask),
+                                                  _mm_and_si128(_mm_srl_epi32(w1, count), mask));
+                return _mm_or_si128(_mm_slli_epi16(v, 6), _mm_srli_epi16(v, 4));
+            }
+
+            YURI_TARGET_SSSE3
+            void r10k_to_planar_ssse3(const uint8_t* src, uint16_t* r, uint16_t* g, uint16_t* b, size_t width,
+                                      const r10k_layout_t& layout) {
+                const __m128i swap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+                const __m128i mask = _mm_set1_epi32(0x3FF);
+                size_t pixel = 0;
+                for (; pixel + 8 <= width; pixel += 8) {
+                    const __m128i w0 = load_r10k_ssse3(src, layout.big_endian, swap);
+                    const __m128i w1 = load_r10k_ssse3(src + 16, layout.big_endian, swap);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(r + pixel), extract_10bit_ssse3(w0, w1, layout.r_shift, mask));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(g + pixel), extract_10bit_ssse3(w0, w1, layout.g_shift, mask));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(b + pixel), extract_10bit_ssse3(w0, w1, layout.b_shift, mask));
+                    src += 32;
+                }
+                r10k_to_planar_scalar(src, r + pixel, g + pixel, b + pixel, width - pixel, layout);
+            }
+
+            YURI_TARGET_SSSE3
+            void planar_to_r10k_ssse3(const uint16_t* r, const uint16_t* g, const uint16_t* b, uint8_t* dst, size_t width,
+                                      const r10k_layout_t& layout) {
+                const __m128i swap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i rs = _mm_cvtsi32_si128(layout.r_shift);
+                const __m128i gs = _mm_cvtsi32_si128(layout.g_shift);
+                const __m128i bs = _mm_cvtsi32_si128(layout.b_shift);
+                size_t pixel = 0;
+                for (; pixel + 8 <= width; pixel += 8) {
+                    const __m128i rv = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r + pixel)), 6);
+                    const __m128i gv = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(g + pixel)), 6);
+                    const __m128i bv = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + pixel)), 6);
+                    __m128i w0 = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(rv, zero), rs),
+                                                           _mm_sll_epi32(_mm_unpacklo_epi16(gv, zero), gs)),
+                                              _mm_sll_epi32(_mm_unpacklo_epi16(bv, zero), bs));
+                    __m128i w1 = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(rv, zero), rs),
+                                                           _mm_sll_epi32(_mm_unpackhi_epi16(gv, zero), gs)),
+                                              _mm_sll_epi32(_mm_unpackhi_epi16(bv, zero), bs));
+                    if (layout.big_endian) {
+                        w0 = _mm_shuffle_epi8(w0, swap);
+                        w1 = _mm_shuffle_epi8(w1, swap);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), w0);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), w1);
+                    dst += 32;
+                }
+                planar_to_r10k_scalar(r + pixel, g + pixel, b + pixel, dst, width - pixel, layout);
+            }
+#endif
+
+            struct r10k_kernels_t {
+                void (*to_planar)(const uint8_t* src, uint16_t* r, uint16_t* g, uint16_t* b, size_t width,
+                                  const r10k_layout_t& layout);
+                void (*from_planar)(const uint16_t* r, const uint16_t* g, const uint16_t* b, uint8_t* dst, size_t width,
+                                    const r10k_layout_t& layout);
+            };
+
+            const r10k_kernels_t& get_r10k_kernels() {
+                static const r10k_kernels_t kernels =
+#ifdef YURI_HAVE_SSSE3_TARGET
+                        core::utils::cpu_has_ssse3() ? r10k_kernels_t{&r10k_to_planar_ssse3, &planar_to_r10k_ssse3} :
+#endif
+                        r10k_kernels_t{&r10k_to_planar_scalar, &planar_to_r10k_scalar};
+                return kernels;
+            }
+
+            //! Indices of R, G and B planes in a planar format
+            template<format_t fmt>
+            struct rgb_planes;
+
+            template<>
+            struct rgb_planes<core::raw_format::rgb48p> {
+                static constexpr size_t r = 0, g = 1, b = 2;
+            };
+
+            template<>
+            struct rgb_planes<core::raw_format::gbr48p> {
+                static constexpr size_t r = 2, g = 0, b = 1;
+            };
+
+            template<format_t fmt_out>
+            core::pRawVideoFrame convert_r10k_planar(const core::pRawVideoFrame& frame, const r10k_layout_t& layout,
+                                                     size_t threads) {
+                using planes = rgb_planes<fmt_out>;
+                const resolution_t res = frame->get_resolution();
+                auto outframe = allocate_frame<fmt_out>(res.width, res.height);
+                const auto& in = PLANE_DATA(frame, 0);
+                auto& pr = PLANE_DATA(outframe, planes::r);
+                auto& pg = PLANE_DATA(outframe, planes::g);
+                auto& pb = PLANE_DATA(outframe, planes::b);
+                const auto& kernels = get_r10k_kernels();
+                convert_lines_parallel(res.height, threads, [&](size_t first, size_t last) {
+                    for (size_t line = first; line < last; ++line) {
+                        kernels.to_planar(in.data() + line * in.get_line_size(),
+                                          reinterpret_cast<uint16_t*>(pr.data() + line * pr.get_line_size()),
+                                          reinterpret_cast<uint16_t*>(pg.data() + line * pg.get_line_size()),
+                                          reinterpret_cast<uint16_t*>(pb.data() + line * pb.get_line_size()),
+                                          res.width, layout);
+                    }
+                });
+                return outframe;
+            }
+
+            template<format_t fmt_in, format_t fmt_out>
+            core::pRawVideoFrame convert_planar_r10k(const core::pRawVideoFrame& frame, const r10k_layout_t& layout,
+                                                     size_t threads) {
+                using planes = rgb_planes<fmt_in>;
+                const resolution_t res = frame->get_resolution();
+                auto outframe = allocate_frame<fmt_out>(res.width, res.height);
+                const auto& pr = PLANE_DATA(frame, planes::r);
+                const auto& pg = PLANE_DATA(frame, planes::g);
+                const auto& pb = PLANE_DATA(frame, planes::b);
+                auto& out = PLANE_DATA(outframe, 0);
+                const auto& kernels = get_r10k_kernels();
+                convert_lines_parallel(res.height, threads, [&](size_t first, size_t last) {
+                    for (size_t line = first; line < last; ++line) {
+                        kernels.from_planar(reinterpret_cast<const uint16_t*>(pr.data() + line * pr.get_line_size()),
+                                            reinterpret_cast<const uint16_t*>(pg.data() + line * pg.get_line_size()),
+                                            reinterpret_cast<const uint16_t*>(pb.data() + line * pb.get_line_size()),
+                                            out.data() + line * out.get_line_size(),
+                                            res.width, layout);
+                    }
+                });
+                return outframe;
+            }
+
+            template<format_t fmt_in, format_t fmt_out>
+            std::pair<const format_pair_t, std::pair<converter_t, size_t>> define_r10k_to_planar(size_t cost) {
+                const auto& layout = fmt_in == core::raw_format::rgb_r10k_be ? r10k_be_layout : r10k_le_layout;
+                converter_t conv = [&layout](const core::pRawVideoFrame& frame, const YuriConvertor&,
+                                             size_t threads, const core::pRawVideoFrame&) {
+                    return convert_r10k_planar<fmt_out>(frame, layout, threads);
+                };
+                return std::make_pair(std::make_pair(fmt_in, fmt_out), std::make_pair(conv, cost));
+            }
+
+            template<format_t fmt_in, format_t fmt_out>
+            std::pair<const format_pair_t, std::pair<converter_t, size_t>> define_planar_to_r10k(size_t cost) {
+                const auto& layout = fmt_out == core::raw_format::rgb_r10k_be ? r10k_be_layout : r10k_le_layout;
+                converter_t conv = [&layout](const core::pRawVideoFrame& frame, const YuriConvertor&,
+                                             size_t threads, const core::pRawVideoFrame&) {
+                    return convert_planar_r10k<fmt_in, fmt_out>(frame, layout, threads);
+                };
+                return std::make_pair(std::make_pair(fmt_in, fmt_out), std::make_pair(conv, cost));
+            }
+        }
+
         converter_map get_converters_rgb10bit() {
             static std::map<format_pair_t, std::pair<converter_t, size_t>> converters_rgb10bit = {
                     define_conversion<core::raw_format::rgb_r10k_be, core::raw_format::rgb24>(30),
@@ -207,6 +424,14 @@ namespace yuri {
                     define_conversion<core::raw_format::rgb_r10k_le, core::raw_format::bgr48>(30),
                     define_conversion<core::raw_format::rgb24, core::raw_format::rgb_r10k_le>(50),
                     define_conversion<core::raw_format::bgr24, core::raw_format::rgb_r10k_le>(50),
+                    define_r10k_to_planar<core::raw_format::rgb_r10k_be, core::raw_format::rgb48p>(10),
+                    define_r10k_to_planar<core::raw_format::rgb_r10k_be, core::raw_format::gbr48p>(10),
+                    define_r10k_to_planar<core::raw_format::rgb_r10k_le, core::raw_format::rgb48p>(10),
+                    define_r10k_to_planar<core::raw_format::rgb_r10k_le, core::raw_format::gbr48p>(10),
+                    define_planar_to_r10k<core::raw_format::rgb48p, core::raw_format::rgb_r10k_be>(15),
+                    define_planar_to_r10k<core::raw_format::gbr48p, core::raw_format::rgb_r10k_be>(15),
+                    define_planar_to_r10k<core::raw_format::rgb48p, core::raw_format::rgb_r10k_le>(15),
+                    define_planar_to_r10k<core::raw_format::gbr48p, core::raw_format::rgb_r10k_le>(15),
             };
             return converters_rgb10bit;
         }
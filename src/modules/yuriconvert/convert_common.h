@@ -6,6 +6,8 @@
 #define YURI2_CONVERT_COMMON_H
 #include "yuri/core/frame/raw_frame_types.h"
 #include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/frame/raw_frame_params.h"
+#include "yuri/core/frame/damage.h"
 #include <future>
 #include "yuri/core/utils/irange.h"
 
@@ -14,7 +16,7 @@ namespace yuri {
         class YuriConvertor;
 
         using converter_t = std::function<core::pRawVideoFrame(const core::pRawVideoFrame &, const YuriConvertor &,
-                                                               size_t)>;
+                                                               size_t, const core::pRawVideoFrame &)>;
         using format_pair_t = std::pair<yuri::format_t, yuri::format_t>;
 
         using converter_map = std::map<format_pair_t, std::pair<converter_t, size_t>>;
@@ -35,7 +37,8 @@ namespace yuri {
         void convert_line(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width);
 
         template<format_t fmt_in, format_t fmt_out>
-        core::pRawVideoFrame convert_formats(const core::pRawVideoFrame &frame, const YuriConvertor &, size_t threads);
+        core::pRawVideoFrame convert_formats(const core::pRawVideoFrame &frame, const YuriConvertor &, size_t threads,
+                                             const core::pRawVideoFrame &previous);
 
 
         template<format_t fmt_in, format_t fmt_out>
@@ -86,21 +89,40 @@ namespace yuri {
             }
         }
 
+        /*!
+         * Returns horizontal alignment (in pixels) of regions that can be converted separately.
+         * Returns @em width when only whole lines can be converted.
+         */
+        inline dimension_t get_region_alignment(format_t fmt_in, format_t fmt_out, dimension_t width)
+        {
+            const auto& depth_in    = core::raw_format::get_format_info(fmt_in).planes[0].bit_depth;
+            const auto& depth_out   = core::raw_format::get_format_info(fmt_out).planes[0].bit_depth;
+            if (depth_in.first % 8 || depth_out.first % 8) return width;
+            size_t a = depth_in.second, b = depth_out.second;
+            while (b) {
+                const size_t t = a % b;
+                a = b;
+                b = t;
+            }
+            return depth_in.second / a * depth_out.second;
+        }
+
         template<format_t fmt_in, format_t fmt_out>
-        core::pRawVideoFrame convert_formats(const core::pRawVideoFrame& frame, const YuriConvertor& conv, size_t threads)
+        void convert_region(const core::pRawVideoFrame& frame, core::pRawVideoFrame& outframe, const YuriConvertor& conv,
+                            const geometry_t& rect, size_t threads)
         {
-            const size_t width 			= frame->get_width();
-            const size_t height			= frame->get_height();
-            core::pRawVideoFrame outframe 	= allocate_frame<fmt_out>(width, height);
-            outframe->copy_video_params(*frame);
-//	const size_t linesize_in 	= get_linesize<fmt_in>(width);
-//	const size_t linesize_out 	= get_linesize<fmt_out>(width);
+            const auto& depth_in        = core::raw_format::get_format_info(fmt_in).planes[0].bit_depth;
+            const auto& depth_out       = core::raw_format::get_format_info(fmt_out).planes[0].bit_depth;
+            const size_t width 			= rect.width;
+            const size_t height			= rect.height;
             const size_t linesize_in 	= PLANE_DATA(frame,0).get_line_size();
             const size_t linesize_out 	= PLANE_DATA(outframe,0).get_line_size();
-            core::Plane::const_iterator src	= PLANE_DATA(frame,0).begin();
-            core::Plane::iterator dest		= PLANE_DATA(outframe,0).begin();
+            core::Plane::const_iterator src	= PLANE_DATA(frame,0).begin() + rect.y * linesize_in +
+                    rect.x / depth_in.second * depth_in.first / 8;
+            core::Plane::iterator dest		= PLANE_DATA(outframe,0).begin() + rect.y * linesize_out +
+                    rect.x / depth_out.second * depth_out.first / 8;
 
-            if (!threads || threads == 1) {
+            if (threads < 2 || height < threads) {
                 for (size_t line = 0; line < height; ++line) {
                     convert_line<fmt_in, fmt_out>(src, dest, width, conv);
                     src+=linesize_in;
@@ -110,8 +132,7 @@ namespace yuri {
                 size_t task_lines = height / threads;
                 std::vector<std::future<void>> results;
                 size_t start_line = 0;
-                size_t remaining = height;
-                auto f = [&](size_t s, size_t r) {
+                auto f = [&](size_t s, size_t lines) {
                     return convert_multiple_lines<fmt_in, fmt_out>(
                             linesize_in,
                             linesize_out,
@@ -119,22 +140,77 @@ namespace yuri {
                             dest + s * linesize_out,
                             width,
                             conv,
-                            std::min(task_lines, r)
+                            lines
                     );
                 };
                 for (auto t: irange(threads)) {
-                    (void)t;
+                    // Last task converts also the remaining lines
+                    const size_t lines = (t == threads - 1) ? height - start_line : task_lines;
                     results.push_back(
                             std::async(std::launch::async,
-                                       f, start_line, remaining)
+                                       f, start_line, lines)
                     );
                     start_line += task_lines;
-                    remaining -= task_lines;
                 }
                 for (auto& t: results) {
                     t.get();
                 }
             }
+        }
+
+        /*!
+         * Calls @em f(first_line, last_line) for parts of an image with @em height lines,
+         * splitting the work between @em threads threads.
+         * Used by converters that can't use convert_line (e.g. for planar formats).
+         */
+        template<class F>
+        void convert_lines_parallel(size_t height, size_t threads, F f)
+        {
+            if (threads < 2 || height < threads) {
+                f(0, height);
+                return;
+            }
+            const size_t task_lines = height / threads;
+            std::vector<std::future<void>> results;
+            size_t start_line = 0;
+            for (auto t: irange(threads)) {
+                // Last task converts also the remaining lines
+                const size_t end_line = (t == threads - 1) ? height : start_line + task_lines;
+                results.push_back(std::async(std::launch::async, f, start_line, end_line));
+                start_line = end_line;
+            }
+            for (auto& t: results) {
+                t.get();
+            }
+        }
+
+        /*!
+         * Converts @em frame to @em fmt_out.
+         *
+         * If @em previous is set, it has to be the output for the frame preceding @em frame.
+         * Then only damaged regions of @em frame are converted and the rest is reused from @em previous.
+         */
+        template<format_t fmt_in, format_t fmt_out>
+        core::pRawVideoFrame convert_formats(const core::pRawVideoFrame& frame, const YuriConvertor& conv, size_t threads,
+                                             const core::pRawVideoFrame& previous)
+        {
+            const resolution_t res 			= frame->get_resolution();
+            core::pRawVideoFrame outframe;
+            std::vector<geometry_t> regions;
+            if (previous) {
+                const dimension_t align = get_region_alignment(fmt_in, fmt_out, res.width);
+                outframe = get_frame_unique(previous);
+                for (const auto& rect: core::simplify_damage(frame->get_damage(), res)) {
+                    regions.push_back(core::align_damage(rect, align, 1, res));
+                }
+            } else {
+                outframe = allocate_frame<fmt_out>(res.width, res.height);
+                regions.push_back(res.get_geometry());
+            }
+            outframe->copy_video_params(*frame);
+            for (const auto& rect: regions) {
+                convert_region<fmt_in, fmt_out>(frame, outframe, conv, rect, threads);
+            }
             return outframe;
         }
 
@@ -6,18 +6,14 @@
  * 					RGB conversions
  *************************************************************************** */
 #include "convert_common.h"
+#include "yuri/core/utils/swizzle.h"
 
 namespace yuri {
     namespace video {
 
 
         void rgb_rgba(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width, uint8_t alpha) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *src++;
-                *dest++ = *src++;
-                *dest++ = *src++;
-                *dest++ = alpha;
-            }
+            core::utils::shuffle_pixels(src, 3, dest, 4, width, {{0, 1, 2, 3}}, alpha);
         }
 
         template<>
@@ -33,12 +29,7 @@ namespace yuri {
         }
 
         void rgb_argb(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width, uint8_t alpha) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = alpha;
-                *dest++ = *src++;
-                *dest++ = *src++;
-                *dest++ = *src++;
-            }
+            core::utils::shuffle_pixels(src, 3, dest, 4, width, {{3, 0, 1, 2}}, alpha);
         }
 
         template<>
@@ -54,12 +45,7 @@ namespace yuri {
         }
 
         void rgba_rgb(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *src++;
-                *dest++ = *src++;
-                *dest++ = *src++;
-                src++;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 3, width, {{0, 1, 2, 0}});
         }
 
         template<>
@@ -75,12 +61,7 @@ namespace yuri {
         }
 
         void argb_rgb(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                src++;
-                *dest++ = *src++;
-                *dest++ = *src++;
-                *dest++ = *src++;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 3, width, {{1, 2, 3, 0}});
         }
 
         template<>
@@ -96,13 +77,7 @@ namespace yuri {
         }
 
         void rgba_bgra(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 1);
-                *dest++ = *(src + 0);
-                *dest++ = *(src + 3);
-                src += 4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width, {{2, 1, 0, 3}});
         }
 
         template<>
@@ -118,13 +93,7 @@ namespace yuri {
         }
 
         void argb_abgr(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 0);
-                *dest++ = *(src + 3);
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 1);
-                src += 4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width, {{0, 3, 2, 1}});
         }
 
         template<>
@@ -140,13 +109,7 @@ namespace yuri {
         }
 
         void rgba_abgr(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 3);
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 1);
-                *dest++ = *(src + 0);
-                src += 4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width, {{3, 2, 1, 0}});
         }
 
         template<>
@@ -178,13 +141,7 @@ namespace yuri {
         }
 
         void rgba_argb(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 3);
-                *dest++ = *(src + 0);
-                *dest++ = *(src + 1);
-                *dest++ = *(src + 2);
-                src += 4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width, {{3, 0, 1, 2}});
         }
 
         template<>
@@ -200,13 +157,7 @@ namespace yuri {
         }
 
         void argb_rgba(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 1);
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 3);
-                *dest++ = *(src + 0);
-                src += 4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width, {{1, 2, 3, 0}});
         }
 
         template<>
@@ -223,13 +174,7 @@ namespace yuri {
 
 
         void rgb_bgra(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width, uint8_t alpha) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 1);
-                *dest++ = *(src + 0);
-                *dest++ = alpha;
-                src += 3;
-            }
+            core::utils::shuffle_pixels(src, 3, dest, 4, width, {{2, 1, 0, 3}}, alpha);
         }
 
         template<>
@@ -245,13 +190,7 @@ namespace yuri {
         }
 
         void rgb_abgr(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width, uint8_t alpha) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = alpha;
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 1);
-                *dest++ = *(src + 0);
-                src += 3;
-            }
+            core::utils::shuffle_pixels(src, 3, dest, 4, width, {{3, 2, 1, 0}}, alpha);
         }
 
         template<>
@@ -267,12 +206,7 @@ namespace yuri {
         }
 
         void bgra_rgb(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 1);
-                *dest++ = *(src + 0);
-                src += 4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 3, width, {{2, 1, 0, 0}});
         }
 
         template<>
@@ -288,12 +222,7 @@ namespace yuri {
         }
 
         void abgr_rgb(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 3);
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 1);
-                src += 4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 3, width, {{3, 2, 1, 0}});
         }
 
         template<>
@@ -309,12 +238,7 @@ namespace yuri {
         }
 
         void bgr_rgb(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 1);
-                *dest++ = *(src + 0);
-                src += 3;
-            }
+            core::utils::shuffle_pixels(src, 3, dest, 3, width, {{2, 1, 0, 0}});
         }
 
         template<>
@@ -330,12 +254,7 @@ namespace yuri {
         }
 
         void gbr_rgb(core::Plane::const_iterator src, core::Plane::iterator dest, size_t width) {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++ = *(src + 2);
-                *dest++ = *(src + 0);
-                *dest++ = *(src + 1);
-                src += 3;
-            }
+            core::utils::shuffle_pixels(src, 3, dest, 3, width, {{2, 0, 1, 0}});
         }
 
         template<>
@@ -0,0 +1,96 @@
+/*!
+ * @file 		convert_v210.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * Conversions between v210 and 8 bit or planar 10/16 bit YUV 4:2:2.
+ */
+
+#include "convert_common.h"
+#include "v210_kernels.h"
+
+namespace yuri {
+    namespace video {
+        namespace {
+            template<format_t fmt_out, int shift>
+            core::pRawVideoFrame convert_v210_planar(const core::pRawVideoFrame& frame, const YuriConvertor&, size_t threads,
+                                                     const core::pRawVideoFrame&)
+            {
+                const resolution_t res = frame->get_resolution();
+                auto outframe = allocate_frame<fmt_out>(res.width, res.height);
+                const auto& in = PLANE_DATA(frame, 0);
+                auto& py = PLANE_DATA(outframe, 0);
+                auto& pu = PLANE_DATA(outframe, 1);
+                auto& pv = PLANE_DATA(outframe, 2);
+                const size_t pairs = v210_pairs(res.width, in.get_line_size());
+                const auto& kernels = get_v210_kernels();
+                convert_lines_parallel(res.height, threads, [&](size_t first, size_t last) {
+                    for (size_t line = first; line < last; ++line) {
+                        kernels.to_planar(in.data() + line * in.get_line_size(),
+                                          reinterpret_cast<uint16_t*>(py.data() + line * py.get_line_size()),
+                                          reinterpret_cast<uint16_t*>(pu.data() + line * pu.get_line_size()),
+                                          reinterpret_cast<uint16_t*>(pv.data() + line * pv.get_line_size()),
+                                          pairs, shift);
+                    }
+                });
+                return outframe;
+            }
+
+            template<format_t fmt_in, int shift>
+            core::pRawVideoFrame convert_planar_v210(const core::pRawVideoFrame& frame, const YuriConvertor&, size_t threads,
+                                                     const core::pRawVideoFrame&)
+            {
+                const resolution_t res = frame->get_resolution();
+                auto outframe = allocate_frame<core::raw_format::yuv422_v210>(res.width, res.height);
+                const auto& py = PLANE_DATA(frame, 0);
+                const auto& pu = PLANE_DATA(frame, 1);
+                const auto& pv = PLANE_DATA(frame, 2);
+                auto& out = PLANE_DATA(outframe, 0);
+                const size_t pairs = v210_pairs(res.width, out.get_line_size());
+                const auto& kernels = get_v210_kernels();
+                convert_lines_parallel(res.height, threads, [&](size_t first, size_t last) {
+                    for (size_t line = first; line < last; ++line) {
+                        kernels.from_planar(reinterpret_cast<const uint16_t*>(py.data() + line * py.get_line_size()),
+                                            reinterpret_cast<const uint16_t*>(pu.data() + line * pu.get_line_size()),
+                                            reinterpret_cast<const uint16_t*>(pv.data() + line * pv.get_line_size()),
+                                            out.data() + line * out.get_line_size(),
+                                            pairs, shift);
+                    }
+                });
+                return outframe;
+            }
+        }
+
+        template<>
+        void convert_line<core::raw_format::yuv422_v210, core::raw_format::uyvy422>
+                (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width)
+        {
+            get_v210_kernels().to_uyvy(src, dest, v210_pairs(width));
+        }
+
+        template<>
+        void convert_line<core::raw_format::uyvy422, core::raw_format::yuv422_v210>
+                (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width)
+        {
+            get_v210_kernels().from_uyvy(src, dest, v210_pairs(width));
+        }
+
+        converter_map get_converters_v210() {
+            static std::map<format_pair_t, std::pair<converter_t, size_t>> converters_v210 = {
+                    {{core::raw_format::yuv422_v210, core::raw_format::yuv422p10},
+                            {&convert_v210_planar<core::raw_format::yuv422p10, 0>, 10}},
+                    {{core::raw_format::yuv422_v210, core::raw_format::yuv422p16},
+                            {&convert_v210_planar<core::raw_format::yuv422p16, 6>, 10}},
+                    {{core::raw_format::yuv422p10, core::raw_format::yuv422_v210},
+                            {&convert_planar_v210<core::raw_format::yuv422p10, 0>, 10}},
+                    {{core::raw_format::yuv422p16, core::raw_format::yuv422_v210},
+                            {&convert_planar_v210<core::raw_format::yuv422p16, 6>, 15}},
+                    define_conversion<core::raw_format::yuv422_v210, core::raw_format::uyvy422>(15),
+                    define_conversion<core::raw_format::uyvy422, core::raw_format::yuv422_v210>(15),
+            };
+            return converters_v210;
+        }
+    }
+}
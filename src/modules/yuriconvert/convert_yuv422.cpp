@@ -3,6 +3,7 @@
 //
 
 #include "convert_common.h"
+#include "yuri/core/utils/swizzle.h"
 
 namespace yuri {
     namespace video {
@@ -12,59 +13,35 @@ namespace yuri {
         inline void swap_yuv422_pairs
                 (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width)
         {
-            for (size_t pixel = 0; pixel < width; ++pixel) {
-                *dest++=*(src+1);
-                *dest++=*src;
-                src+=2;
+            core::utils::shuffle_pixels(src, 4, dest, 4, width / 2, {{1, 0, 3, 2}});
+            if (width % 2) {
+                dest[width * 2 - 2] = src[width * 2 - 1];
+                dest[width * 2 - 1] = src[width * 2 - 2];
             }
         }
 // Converts abcd -> cbad
         inline void swap_yuv422_0_2
                 (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width)
         {
-            for (size_t pixel = 0; pixel < width/2; ++pixel) {
-                *dest++=*(src+2);
-                *dest++=*(src+1);
-                *dest++=*(src+0);
-                *dest++=*(src+3);
-                src+=4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width / 2, {{2, 1, 0, 3}});
         }
 // Converts abcd -> adcb
         inline void swap_yuv422_1_3
                 (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width)
         {
-            for (size_t pixel = 0; pixel < width/2; ++pixel) {
-                *dest++=*(src+0);
-                *dest++=*(src+3);
-                *dest++=*(src+2);
-                *dest++=*(src+1);
-                src+=4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width / 2, {{0, 3, 2, 1}});
         }
 // Converts abcd -> bcda
         inline void swap_yuv422_pairs_1_3
                 (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width)
         {
-            for (size_t pixel = 0; pixel < width/2; ++pixel) {
-                *dest++=*(src+1);
-                *dest++=*(src+2);
-                *dest++=*(src+3);
-                *dest++=*(src+0);
-                src+=4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width / 2, {{1, 2, 3, 0}});
         }
 // Converts abcd -> dabc
         inline void swap_yuv422_pairs_0_2
                 (core::Plane::const_iterator src, core::Plane::iterator dest, size_t width)
         {
-            for (size_t pixel = 0; pixel < width/2; ++pixel) {
-                *dest++=*(src+3);
-                *dest++=*(src+0);
-                *dest++=*(src+1);
-                *dest++=*(src+2);
-                src+=4;
-            }
+            core::utils::shuffle_pixels(src, 4, dest, 4, width / 2, {{3, 0, 1, 2}});
         }
         template<>
         void convert_line<core::raw_format::yuyv422, core::raw_format::uyvy422>
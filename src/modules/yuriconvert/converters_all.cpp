@@ -14,6 +14,7 @@ namespace yuri {
         converter_map get_converters_yuv();
         converter_map get_converters_yuv422();
         converter_map get_converters_yuv_rgb();
+        converter_map get_converters_v210();
 
         namespace {
             void insert_partial_map(converter_map &conv, const converter_map &part) {
@@ -28,6 +29,7 @@ namespace yuri {
                 insert_partial_map(conv, get_converters_yuv_rgb());
                 insert_partial_map(conv, get_converters_rgb());
                 insert_partial_map(conv, get_converters_rgb10bit());
+                insert_partial_map(conv, get_converters_v210());
                 return conv;
             }
 
@@ -0,0 +1,273 @@
+/*!
+ * @file 		v210_kernels.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "v210_kernels.h"
+#include "yuri/core/frame/RawVideoFrame.h"
+#include "yuri/core/frame/raw_frame_types.h"
+#include "yuri/core/utils/cpu_features.h"
+#include <algorithm>
+#ifdef YURI_HAVE_SSSE3_TARGET
+#include <tmmintrin.h>
+#endif
+
+namespace yuri {
+    namespace video {
+        namespace {
+
+            inline uint32_t read_le32(const uint8_t* p)
+            {
+                return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+            }
+
+            inline void write_le32(uint8_t* p, uint32_t v)
+            {
+                p[0] = v & 0xFF;
+                p[1] = (v >> 8) & 0xFF;
+                p[2] = (v >> 16) & 0xFF;
+                p[3] = (v >> 24) & 0xFF;
+            }
+
+            //! Unpacks one block into 12 components in UYVY order
+            inline void unpack_block(const uint8_t* src, uint16_t* comp)
+            {
+                for (int i = 0; i < 4; ++i) {
+                    const uint32_t w = read_le32(src + 4 * i);
+                    comp[3 * i + 0] = w & 0x3FF;
+                    comp[3 * i + 1] = (w >> 10) & 0x3FF;
+                    comp[3 * i + 2] = (w >> 20) & 0x3FF;
+                }
+            }
+
+            inline void pack_block(const uint16_t* comp, uint8_t* dst)
+            {
+                for (int i = 0; i < 4; ++i) {
+                    write_le32(dst + 4 * i, (comp[3 * i] & 0x3FF) |
+                                            ((comp[3 * i + 1] & 0x3FF) << 10) |
+                                            (static_cast<uint32_t>(comp[3 * i + 2] & 0x3FF) << 20));
+                }
+            }
+
+            // Scalar versions
+            void v210_to_planar_scalar(const uint8_t* src, uint16_t* y, uint16_t* u, uint16_t* v, size_t pairs, int shift)
+            {
+                uint16_t comp[12];
+                for (size_t pair = 0; pair < pairs; pair += v210_block_pairs) {
+                    unpack_block(src, comp);
+                    for (size_t i = 0; i < v210_block_pairs && pair + i < pairs; ++i) {
+                        *u++ = comp[4 * i + 0] << shift;
+                        *y++ = comp[4 * i + 1] << shift;
+                        *v++ = comp[4 * i + 2] << shift;
+                        *y++ = comp[4 * i + 3] << shift;
+                    }
+                    src += v210_block_size;
+                }
+            }
+
+            void planar_to_v210_scalar(const uint16_t* y, const uint16_t* u, const uint16_t* v, uint8_t* dst, size_t pairs, int shift)
+            {
+                for (size_t pair = 0; pair < pairs; pair += v210_block_pairs) {
+                    uint16_t comp[12] = {};
+                    for (size_t i = 0; i < v210_block_pairs && pair + i < pairs; ++i) {
+                        comp[4 * i + 0] = *u++ >> shift;
+                        comp[4 * i + 1] = *y++ >> shift;
+                        comp[4 * i + 2] = *v++ >> shift;
+                        comp[4 * i + 3] = *y++ >> shift;
+                    }
+                    pack_block(comp, dst);
+                    dst += v210_block_size;
+                }
+            }
+
+            void v210_to_uyvy_scalar(const uint8_t* src, uint8_t* dst, size_t pairs)
+            {
+                uint16_t comp[12];
+                for (size_t pair = 0; pair < pairs; pair += v210_block_pairs) {
+                    unpack_block(src, comp);
+                    const size_t count = std::min(v210_block_pairs, pairs - pair) * 4;
+                    for (size_t i = 0; i < count; ++i) {
+                        *dst++ = static_cast<uint8_t>(comp[i] >> 2);
+                    }
+                    src += v210_block_size;
+                }
+            }
+
+            void uyvy_to_v210_scalar(const uint8_t* src, uint8_t* dst, size_t pairs)
+            {
+                for (size_t pair = 0; pair < pairs; pair += v210_block_pairs) {
+                    uint16_t comp[12] = {};
+                    const size_t count = std::min(v210_block_pairs, pairs - pair) * 4;
+                    for (size_t i = 0; i < count; ++i) {
+                        comp[i] = *src++ << 2;
+                    }
+                    pack_block(comp, dst);
+                    dst += v210_block_size;
+                }
+            }
+
+#ifdef YURI_HAVE_SSSE3_TARGET
+            /*
+             * SSSE3 versions process one block (6 pixels) per iteration.
+             * Some stores write past the block, so the vector loops stop early enough
+             * to keep all writes (and reads) inside the processed line.
+             */
+
+            //! 16 bit lanes to pshufb mask, -1 meaning zero
+            YURI_TARGET_SSSE3
+            inline __m128i lanes16(int l0, int l1, int l2, int l3, int l4, int l5, int l6, int l7)
+            {
+                const int l[8] = {l0, l1, l2, l3, l4, l5, l6, l7};
+                int8_t b[16];
+                for (int i = 0; i < 8; ++i) {
+                    b[2 * i] = l[i] < 0 ? -1 : static_cast<int8_t>(2 * l[i]);
+                    b[2 * i + 1] = l[i] < 0 ? -1 : static_cast<int8_t>(2 * l[i] + 1);
+                }
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+            }
+
+            YURI_TARGET_SSSE3
+            void v210_to_planar_ssse3(const uint8_t* src, uint16_t* y, uint16_t* u, uint16_t* v, size_t pairs, int shift)
+            {
+                const __m128i mask10 = _mm_set1_epi32(0x3FF);
+                // a = U0 Y1 V1 Y4, b = Y0 U1 Y3 V2, c = V0 Y2 U2 Y5, ab = a0-a3 b0-b3, cc = c0-c3
+                const __m128i y_ab = lanes16(4, 1, -1, 6, 3, -1, -1, -1);
+                const __m128i y_cc = lanes16(-1, -1, 1, -1, -1, 3, -1, -1);
+                // U in lanes 0 - 2, V in lanes 4 - 6
+                const __m128i uv_ab = lanes16(0, 5, -1, -1, -1, 2, 7, -1);
+                const __m128i uv_cc = lanes16(-1, -1, 2, -1, 0, -1, -1, -1);
+                const __m128i sh = _mm_cvtsi32_si128(shift);
+                size_t pair = 0;
+                // Y store writes 8 samples, U and V 4 samples
+                for (; pair * 2 + 8 <= pairs * 2; pair += v210_block_pairs) {
+                    const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                    const __m128i a = _mm_and_si128(w, mask10);
+                    const __m128i b = _mm_and_si128(_mm_srli_epi32(w, 10), mask10);
+                    const __m128i c = _mm_and_si128(_mm_srli_epi32(w, 20), mask10);
+                    const __m128i ab = _mm_packs_epi32(a, b);
+                    const __m128i cc = _mm_packs_epi32(c, c);
+                    const __m128i ys = _mm_or_si128(_mm_shuffle_epi8(ab, y_ab), _mm_shuffle_epi8(cc, y_cc));
+                    const __m128i uvs = _mm_sll_epi16(_mm_or_si128(_mm_shuffle_epi8(ab, uv_ab), _mm_shuffle_epi8(cc, uv_cc)), sh);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(y), _mm_sll_epi16(ys, sh));
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(u), uvs);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(v), _mm_unpackhi_epi64(uvs, uvs));
+                    src += v210_block_size;
+                    y += 6;
+                    u += 3;
+                    v += 3;
+                }
+                v210_to_planar_scalar(src, y, u, v, pairs - pair, shift);
+            }
+
+            YURI_TARGET_SSSE3
+            void planar_to_v210_ssse3(const uint16_t* y, const uint16_t* u, const uint16_t* v, uint8_t* dst, size_t pairs, int shift)
+            {
+                const __m128i mask10 = _mm_set1_epi16(0x3FF);
+                // Y in lanes 0 - 7, U in lanes 8 - 11, V in 12 - 15 (lanes of the second source shifted by 8)
+                const __m128i ab_y = lanes16(-1, 1, -1, 4, 0, -1, 3, -1);
+                const __m128i ab_uv = lanes16(0, -1, 5, -1, -1, 1, -1, 6);
+                const __m128i c_y = lanes16(-1, 2, -1, 5, -1, -1, -1, -1);
+                const __m128i c_uv = lanes16(4, -1, 2, -1, -1, -1, -1, -1);
+                const __m128i sh = _mm_cvtsi32_si128(shift);
+                const __m128i zero = _mm_setzero_si128();
+                size_t pair = 0;
+                // Reads 8 Y samples and 4 U and V samples
+                for (; pair * 2 + 8 <= pairs * 2; pair += v210_block_pairs) {
+                    const __m128i ys = _mm_srl_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y)), sh);
+                    const __m128i uvs = _mm_srl_epi16(_mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u)),
+                                                                         _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v))), sh);
+                    const __m128i ab = _mm_and_si128(_mm_or_si128(_mm_shuffle_epi8(ys, ab_y), _mm_shuffle_epi8(uvs, ab_uv)), mask10);
+                    const __m128i c16 = _mm_and_si128(_mm_or_si128(_mm_shuffle_epi8(ys, c_y), _mm_shuffle_epi8(uvs, c_uv)), mask10);
+                    const __m128i a = _mm_unpacklo_epi16(ab, zero);
+                    const __m128i b = _mm_unpackhi_epi16(ab, zero);
+                    const __m128i c = _mm_unpacklo_epi16(c16, zero);
+                    const __m128i w = _mm_or_si128(_mm_or_si128(a, _mm_slli_epi32(b, 10)), _mm_slli_epi32(c, 20));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), w);
+                    dst += v210_block_size;
+                    y += 6;
+                    u += 3;
+                    v += 3;
+                }
+                planar_to_v210_scalar(y, u, v, dst, pairs - pair, shift);
+            }
+
+            YURI_TARGET_SSSE3
+            void v210_to_uyvy_ssse3(const uint8_t* src, uint8_t* dst, size_t pairs)
+            {
+                const __m128i mask8 = _mm_set1_epi32(0xFF);
+                const __m128i compact = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+                size_t pair = 0;
+                // Writes 16 bytes (4 pixels more than a block)
+                for (; pair * 4 + 16 <= pairs * 4; pair += v210_block_pairs) {
+                    const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                    const __m128i a = _mm_and_si128(_mm_srli_epi32(w, 2), mask8);
+                    const __m128i b = _mm_and_si128(_mm_srli_epi32(w, 12), mask8);
+                    const __m128i c = _mm_and_si128(_mm_srli_epi32(w, 22), mask8);
+                    const __m128i bytes = _mm_or_si128(_mm_or_si128(a, _mm_slli_epi32(b, 8)), _mm_slli_epi32(c, 16));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(bytes, compact));
+                    src += v210_block_size;
+                    dst += 12;
+                }
+                v210_to_uyvy_scalar(src, dst, pairs - pair);
+            }
+
+            YURI_TARGET_SSSE3
+            void uyvy_to_v210_ssse3(const uint8_t* src, uint8_t* dst, size_t pairs)
+            {
+                const __m128i sel_a = _mm_setr_epi8(0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1);
+                const __m128i sel_b = _mm_setr_epi8(1, -1, -1, -1, 4, -1, -1, -1, 7, -1, -1, -1, 10, -1, -1, -1);
+                const __m128i sel_c = _mm_setr_epi8(2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1);
+                size_t pair = 0;
+                // Reads 16 bytes (4 pixels more than a block)
+                for (; pair * 4 + 16 <= pairs * 4; pair += v210_block_pairs) {
+                    const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                    const __m128i a = _mm_slli_epi32(_mm_shuffle_epi8(s, sel_a), 2);
+                    const __m128i b = _mm_slli_epi32(_mm_shuffle_epi8(s, sel_b), 12);
+                    const __m128i c = _mm_slli_epi32(_mm_shuffle_epi8(s, sel_c), 22);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(_mm_or_si128(a, b), c));
+                    src += 12;
+                    dst += v210_block_size;
+                }
+                uyvy_to_v210_scalar(src, dst, pairs - pair);
+            }
+#endif
+        }
+
+        v210_kernels_t select_v210_kernels()
+        {
+#ifdef YURI_HAVE_SSSE3_TARGET
+            if (core::utils::cpu_has_ssse3()) {
+                return {&v210_to_planar_ssse3, &planar_to_v210_ssse3, &v210_to_uyvy_ssse3, &uyvy_to_v210_ssse3};
+            }
+#endif
+            return get_scalar_v210_kernels();
+        }
+
+        v210_kernels_t get_scalar_v210_kernels()
+        {
+            return {&v210_to_planar_scalar, &planar_to_v210_scalar, &v210_to_uyvy_scalar, &uyvy_to_v210_scalar};
+        }
+
+        const v210_kernels_t& get_v210_kernels()
+        {
+            static const v210_kernels_t kernels = select_v210_kernels();
+            return kernels;
+        }
+
+        size_t v210_pairs(size_t width, size_t linesize)
+        {
+            return std::min(width / 2, linesize / v210_block_size * v210_block_pairs);
+        }
+
+        size_t v210_pairs(size_t width)
+        {
+            static const auto& info = core::raw_format::get_format_info(core::raw_format::yuv422_v210);
+            const auto params = core::RawVideoFrame::get_plane_params(info, 0, resolution_t{static_cast<dimension_t>(width), 1});
+            return v210_pairs(width, std::get<0>(params));
+        }
+    }
+}
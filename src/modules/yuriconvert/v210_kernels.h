@@ -0,0 +1,50 @@
+/*!
+ * @file 		v210_kernels.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * v210 stores 6 pixels in 4 little endian 32 bit words, each containing three
+ * 10 bit components. Components are stored in the same order as in UYVY:
+ * U0 Y0 V0 | Y1 U1 Y2 | V1 Y3 U2 | Y4 V2 Y5
+ */
+
+#ifndef V210_KERNELS_H_
+#define V210_KERNELS_H_
+
+#include "yuri/core/utils/new_types.h"
+
+namespace yuri {
+    namespace video {
+        //! Number of pixel pairs in a v210 block
+        constexpr size_t v210_block_pairs = 3;
+        constexpr size_t v210_block_size = 16;
+
+        /*!
+         * Line kernels. All functions process @em pairs pixel pairs,
+         * the last v210 block may be incomplete.
+         * @em shift is 0 for 10 bit planes and 6 for 16 bit planes.
+         * Scalar and SSSE3 versions produce identical results.
+         */
+        struct v210_kernels_t {
+            void (*to_planar)(const uint8_t* src, uint16_t* y, uint16_t* u, uint16_t* v, size_t pairs, int shift);
+            void (*from_planar)(const uint16_t* y, const uint16_t* u, const uint16_t* v, uint8_t* dst, size_t pairs, int shift);
+            void (*to_uyvy)(const uint8_t* src, uint8_t* dst, size_t pairs);
+            void (*from_uyvy)(const uint8_t* src, uint8_t* dst, size_t pairs);
+        };
+
+        //! Returns the fastest kernels supported by current CPU
+        const v210_kernels_t& get_v210_kernels();
+
+        v210_kernels_t get_scalar_v210_kernels();
+
+        //! Number of pixel pairs of a line @em width pixels wide, that fit into @em linesize bytes
+        size_t v210_pairs(size_t width, size_t linesize);
+
+        //! Same as above, with the line size core allocates for a v210 line @em width pixels wide
+        size_t v210_pairs(size_t width);
+    }
+}
+
+#endif /* V210_KERNELS_H_ */
@@ -0,0 +1,113 @@
+/*!
+ * @file 		v210_test.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "tests/catch.hpp"
+#include "v210_kernels.h"
+#include <random>
+#include <vector>
+
+namespace yuri {
+namespace video {
+
+namespace {
+
+// Outputs are allocated with some spare space, to catch writes past the line
+const size_t spare = 64;
+
+size_t v210_size(size_t pairs)
+{
+	return (pairs + v210_block_pairs - 1) / v210_block_pairs * v210_block_size;
+}
+
+template<typename T>
+std::vector<T> random_data(std::mt19937& gen, size_t count, unsigned max_value)
+{
+	std::uniform_int_distribution<unsigned> dist(0, max_value);
+	std::vector<T> data(count);
+	for (auto& d: data) d = static_cast<T>(dist(gen));
+	return data;
+}
+
+}
+
+TEST_CASE("v210 line size", "[v210]")
+{
+	REQUIRE(v210_pairs(12, 32) == 6);
+	REQUIRE(v210_pairs(12, 16) == 3);
+	REQUIRE(v210_pairs(7, 64) == 3);
+	for (size_t width = 2; width < 100; ++width) {
+		// Core may allocate less than a whole block for the last pixels, so they have to be skipped
+		REQUIRE(v210_size(v210_pairs(width)) <= v210_size(width / 2));
+		REQUIRE(v210_pairs(width) + v210_block_pairs > width / 2);
+	}
+}
+
+TEST_CASE("v210 kernels", "[v210]")
+{
+	const auto& fast = get_v210_kernels();
+	const auto scalar = get_scalar_v210_kernels();
+	std::mt19937 gen(210);
+
+	for (size_t pairs = 1; pairs < 50; ++pairs) {
+		const size_t v210_bytes = v210_size(pairs);
+		const auto v210 = random_data<uint8_t>(gen, v210_bytes, 255);
+		const auto uyvy = random_data<uint8_t>(gen, pairs * 4, 255);
+		INFO("pairs: " << pairs);
+
+		// To planar
+		{
+			for (int shift: {0, 6}) {
+				std::vector<uint16_t> y0(pairs * 2 + spare), u0(pairs + spare), v0(pairs + spare);
+				auto y1 = y0, u1 = u0, v1 = v0;
+				scalar.to_planar(v210.data(), y0.data(), u0.data(), v0.data(), pairs, shift);
+				fast.to_planar(v210.data(), y1.data(), u1.data(), v1.data(), pairs, shift);
+				REQUIRE(y0 == y1);
+				REQUIRE(u0 == u1);
+				REQUIRE(v0 == v1);
+			}
+		}
+		// From planar
+		{
+			for (int shift: {0, 6}) {
+				const unsigned max_value = shift ? 0xFFFF : 0x3FF;
+				const auto y = random_data<uint16_t>(gen, pairs * 2, max_value);
+				const auto u = random_data<uint16_t>(gen, pairs, max_value);
+				const auto v = random_data<uint16_t>(gen, pairs, max_value);
+				std::vector<uint8_t> out0(v210_bytes + spare), out1(v210_bytes + spare);
+				scalar.from_planar(y.data(), u.data(), v.data(), out0.data(), pairs, shift);
+				fast.from_planar(y.data(), u.data(), v.data(), out1.data(), pairs, shift);
+				REQUIRE(out0 == out1);
+			}
+		}
+		// To uyvy
+		{
+			std::vector<uint8_t> out0(pairs * 4 + spare), out1(pairs * 4 + spare);
+			scalar.to_uyvy(v210.data(), out0.data(), pairs);
+			fast.to_uyvy(v210.data(), out1.data(), pairs);
+			REQUIRE(out0 == out1);
+		}
+		// From uyvy
+		{
+			std::vector<uint8_t> out0(v210_bytes + spare), out1(v210_bytes + spare);
+			scalar.from_uyvy(uyvy.data(), out0.data(), pairs);
+			fast.from_uyvy(uyvy.data(), out1.data(), pairs);
+			REQUIRE(out0 == out1);
+		}
+		// Round trip
+		{
+			std::vector<uint8_t> packed(v210_bytes), unpacked(pairs * 4);
+			fast.from_uyvy(uyvy.data(), packed.data(), pairs);
+			fast.to_uyvy(packed.data(), unpacked.data(), pairs);
+			REQUIRE(unpacked == uyvy);
+		}
+	}
+}
+
+}
+}
@@ -0,0 +1,87 @@
+/*!
+ * @file 		avformat.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Minimal replacement of libavformat for testing code that only reads packets.
+ *
+ * Packets are produced by the callback stored in AVFormatContext, instead of reading a file.
+ */
+
+#ifndef TESTS_LIBAV_STUB_AVFORMAT_H_
+#define TESTS_LIBAV_STUB_AVFORMAT_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AV_NOPTS_VALUE ((int64_t)UINT64_C(0x8000000000000000))
+#define AV_PKT_FLAG_KEY 0x0001
+
+typedef struct AVRational {
+	int num;
+	int den;
+} AVRational;
+
+typedef struct AVPacket {
+	uint8_t* data;
+	int size;
+	int stream_index;
+	int flags;
+	int64_t pts;
+	int64_t dts;
+	int64_t pos;
+} AVPacket;
+
+typedef struct AVStream {
+	AVRational time_base;
+} AVStream;
+
+typedef struct AVFormatContext {
+	unsigned int nb_streams;
+	AVStream** streams;
+	//! Fills the packet and returns 0, or returns negative value at the end of stream
+	int (*read_packet)(struct AVFormatContext* ctx, AVPacket* packet);
+	void* opaque;
+} AVFormatContext;
+
+static inline int64_t av_rescale_q(int64_t a, AVRational bq, AVRational cq)
+{
+	return (int64_t)((long double)a * bq.num * cq.den / ((long double)bq.den * cq.num));
+}
+
+static inline AVPacket* av_packet_alloc(void)
+{
+	AVPacket* packet = (AVPacket*)calloc(1, sizeof(AVPacket));
+	if (packet) {
+		packet->pts = AV_NOPTS_VALUE;
+		packet->dts = AV_NOPTS_VALUE;
+		packet->pos = -1;
+	}
+	return packet;
+}
+
+static inline void av_packet_unref(AVPacket* packet)
+{
+	memset(packet, 0, sizeof(AVPacket));
+	packet->pts = AV_NOPTS_VALUE;
+	packet->dts = AV_NOPTS_VALUE;
+	packet->pos = -1;
+}
+
+static inline void av_packet_free(AVPacket** packet)
+{
+	if (packet) {
+		free(*packet);
+		*packet = NULL;
+	}
+}
+
+static inline int av_read_frame(AVFormatContext* ctx, AVPacket* packet)
+{
+	return ctx->read_packet(ctx, packet);
+}
+
+#endif /* TESTS_LIBAV_STUB_AVFORMAT_H_ */
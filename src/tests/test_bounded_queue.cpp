@@ -0,0 +1,104 @@
+/*!
+ * @file 		test_bounded_queue.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "catch.hpp"
+#include "modules/avoutput/bounded_queue.h"
+#include <memory>
+#include <thread>
+
+namespace yuri {
+namespace avoutput {
+
+TEST_CASE("bounded queue", "[bounded_queue]")
+{
+	using queue_t = bounded_queue<std::unique_ptr<int>>;
+	queue_t queue(2);
+	std::unique_ptr<int> value;
+
+	SECTION("capacity") {
+		for (int i = 0; i < 2; ++i) {
+			value.reset(new int(i));
+			REQUIRE(queue.push(value, 0_ms) == queue_t::status_t::ok);
+			REQUIRE(!value);
+		}
+		value.reset(new int(2));
+		REQUIRE(queue.push(value, 10_ms) == queue_t::status_t::timeout);
+		// Not moved from on failure
+		REQUIRE(*value == 2);
+		std::unique_ptr<int> out;
+		REQUIRE(queue.pop(out));
+		REQUIRE(*out == 0);
+		REQUIRE(queue.push(value, 0_ms) == queue_t::status_t::ok);
+		REQUIRE(queue.pop(out));
+		REQUIRE(*out == 1);
+		REQUIRE(queue.pop(out));
+		REQUIRE(*out == 2);
+	}
+	SECTION("close") {
+		value.reset(new int(0));
+		REQUIRE(queue.push(value, 0_ms) == queue_t::status_t::ok);
+		queue.close();
+		value.reset(new int(1));
+		REQUIRE(queue.push(value, 1_s) == queue_t::status_t::closed);
+		REQUIRE(*value == 1);
+		// Queued values are still available after closing
+		std::unique_ptr<int> out;
+		REQUIRE(queue.pop(out));
+		REQUIRE(*out == 0);
+		REQUIRE(!queue.pop(out));
+		queue.reset(1);
+		REQUIRE(queue.push(value, 0_ms) == queue_t::status_t::ok);
+		REQUIRE(queue.push(value, 0_ms) == queue_t::status_t::timeout);
+	}
+	SECTION("reset") {
+		value.reset(new int(0));
+		REQUIRE(queue.push(value, 0_ms) == queue_t::status_t::ok);
+		// Zero capacity would block forever, so it's raised to 1
+		queue.reset(0);
+		value.reset(new int(1));
+		REQUIRE(queue.push(value, 0_ms) == queue_t::status_t::ok);
+		std::unique_ptr<int> out;
+		REQUIRE(queue.pop(out));
+		REQUIRE(*out == 1);
+	}
+	SECTION("threads") {
+		const int count = 1000;
+		std::thread producer([&]{
+			for (int i = 0; i < count; ++i) {
+				std::unique_ptr<int> v(new int(i));
+				while (queue.push(v, 1_ms) == queue_t::status_t::timeout) {}
+			}
+			queue.close();
+		});
+		std::unique_ptr<int> out;
+		int expected = 0;
+		while (queue.pop(out)) {
+			REQUIRE(*out == expected);
+			++expected;
+		}
+		producer.join();
+		REQUIRE(expected == count);
+	}
+	SECTION("close wakes up waiting threads") {
+		std::thread consumer([&]{
+			std::unique_ptr<int> out;
+			while (queue.pop(out)) {}
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		queue.close();
+		consumer.join();
+		for (int i = 0; i < 2; ++i) {
+			value.reset(new int(i));
+			REQUIRE(queue.push(value, 0_ms) == queue_t::status_t::closed);
+		}
+	}
+}
+
+}
+}
@@ -0,0 +1,178 @@
+/*!
+ * @file 		test_demuxer.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file doc/LICENSE
+ *
+ * Built against the libavformat stub in libav_stub, so the packets are scripted.
+ */
+
+#include "catch.hpp"
+#include "modules/rawavfile/demuxer.h"
+#include <atomic>
+#include <thread>
+
+namespace yuri {
+namespace rawavfile {
+
+namespace {
+
+struct packet_spec_t {
+	int stream;
+	int64_t pts;
+	int size;
+};
+
+//! Format context returning packets from a list
+class source_t {
+public:
+	source_t(std::vector<packet_spec_t> packets, size_t streams = 2)
+	:packets_(std::move(packets)),stream_data_(streams),reads_(0)
+	{
+		for (auto& s: stream_data_) {
+			s.time_base = AVRational{1, 1000};
+			streams_.push_back(&s);
+		}
+		ctx_.nb_streams = static_cast<unsigned>(streams);
+		ctx_.streams = streams_.data();
+		ctx_.read_packet = &source_t::read_packet;
+		ctx_.opaque = this;
+	}
+	AVFormatContext* get() { return &ctx_; }
+	size_t reads() const { return reads_; }
+
+	//! Waits until the reading thread stops requesting packets
+	size_t settled_reads()
+	{
+		size_t last;
+		do {
+			last = reads_;
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		} while (last != reads_);
+		return last;
+	}
+
+private:
+	static int read_packet(AVFormatContext* ctx, AVPacket* packet)
+	{
+		auto& self = *static_cast<source_t*>(ctx->opaque);
+		const size_t index = self.reads_;
+		if (index >= self.packets_.size()) return -1;
+		const auto& spec = self.packets_[index];
+		packet->stream_index = spec.stream;
+		packet->pts = spec.pts;
+		packet->size = spec.size;
+		++self.reads_;
+		return 0;
+	}
+
+	std::vector<packet_spec_t> packets_;
+	std::vector<AVStream> stream_data_;
+	std::vector<AVStream*> streams_;
+	AVFormatContext ctx_;
+	std::atomic<size_t> reads_;
+};
+
+std::vector<packet_spec_t> interleaved(size_t count, int size = 10)
+{
+	std::vector<packet_spec_t> packets;
+	for (size_t i = 0; i < count; ++i) {
+		packets.push_back({static_cast<int>(i % 2), static_cast<int64_t>(i / 2 * 40), size});
+	}
+	return packets;
+}
+
+}
+
+TEST_CASE("demuxer packet time", "[demuxer]")
+{
+	AVPacket packet;
+	packet.pts = 90000;
+	packet.dts = 0;
+	duration_t time;
+	REQUIRE(get_packet_time(packet, AVRational{1, 90000}, time));
+	REQUIRE(time == 1_s);
+	packet.pts = AV_NOPTS_VALUE;
+	packet.dts = 25;
+	REQUIRE(get_packet_time(packet, AVRational{1, 25}, time));
+	REQUIRE(time == 1_s);
+	packet.dts = AV_NOPTS_VALUE;
+	REQUIRE(!get_packet_time(packet, AVRational{1, 25}, time));
+}
+
+TEST_CASE("demuxer", "[demuxer]")
+{
+	demuxer_t::packet_t packet;
+
+	SECTION("packets are split by stream") {
+		source_t source(interleaved(20), 3);
+		demuxer_t demuxer(1 << 20, 10_s);
+		// Stream 2 is read first, stream 1 is dropped
+		demuxer.start(source.get(), {2, 0}, {false, false});
+		REQUIRE(demuxer.pop(0, packet, 1_s) == demuxer_t::status_t::end);
+		for (int64_t i = 0; i < 10; ++i) {
+			REQUIRE(demuxer.pop(1, packet, 1_s) == demuxer_t::status_t::packet);
+			REQUIRE(packet->stream_index == 0);
+			REQUIRE(packet->pts == i * 40);
+		}
+		REQUIRE(demuxer.pop(1, packet, 1_s) == demuxer_t::status_t::end);
+		REQUIRE(demuxer.pop(5, packet, 1_s) == demuxer_t::status_t::end);
+	}
+	SECTION("size limit") {
+		source_t source(interleaved(100, 100));
+		demuxer_t demuxer(1000, 10_s);
+		demuxer.start(source.get(), {0, 1}, {false, false});
+		REQUIRE(source.settled_reads() == 10);
+		REQUIRE(demuxer.pop(0, packet, 1_s) == demuxer_t::status_t::packet);
+		REQUIRE(source.settled_reads() == 11);
+		// Raising the limit wakes up the reader
+		demuxer.set_limits(2000, 10_s);
+		REQUIRE(source.settled_reads() == 21);
+	}
+	SECTION("duration limit") {
+		source_t source(interleaved(100));
+		demuxer_t demuxer(1 << 20, 200_ms);
+		demuxer.start(source.get(), {0, 1}, {false, false});
+		// Packets 40 ms apart, so 6 packets of stream 0 span 200 ms
+		REQUIRE(source.settled_reads() == 11);
+		REQUIRE(demuxer.pop(0, packet, 1_s) == demuxer_t::status_t::packet);
+		REQUIRE(packet->pts == 0);
+		REQUIRE(source.settled_reads() == 12);
+	}
+	SECTION("no starve") {
+		// Stream 1 has a packet only after all packets of stream 0
+		std::vector<packet_spec_t> packets;
+		for (int64_t i = 0; i < 50; ++i) packets.push_back({0, i * 40, 100});
+		packets.push_back({1, 0, 100});
+		source_t source(packets);
+		{
+			demuxer_t demuxer(1000, 10_s);
+			demuxer.start(source.get(), {0, 1}, {false, false});
+			REQUIRE(source.settled_reads() == 10);
+			REQUIRE(demuxer.pop(1, packet, 10_ms) == demuxer_t::status_t::empty);
+		}
+		source_t starving(packets);
+		demuxer_t demuxer(1000, 10_s);
+		demuxer.start(starving.get(), {0, 1}, {false, true});
+		REQUIRE(demuxer.pop(1, packet, 1_s) == demuxer_t::status_t::packet);
+		REQUIRE(packet->stream_index == 1);
+		REQUIRE(starving.reads() == packets.size());
+	}
+	SECTION("stop") {
+		source_t source(interleaved(100, 100));
+		demuxer_t demuxer(1000, 10_s);
+		demuxer.start(source.get(), {0, 1}, {false, false});
+		REQUIRE(source.settled_reads() == 10);
+		demuxer.stop();
+		REQUIRE(!demuxer.running());
+		REQUIRE(demuxer.pop(0, packet, 1_s) == demuxer_t::status_t::end);
+		// Restart continues from current position of the context
+		demuxer.start(source.get(), {0, 1}, {false, false});
+		REQUIRE(demuxer.pop(0, packet, 1_s) == demuxer_t::status_t::packet);
+		REQUIRE(packet->pts == 200);
+	}
+}
+
+}
+}
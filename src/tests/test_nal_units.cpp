@@ -0,0 +1,126 @@
+/*!
+ * @file 		test_nal_units.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "catch.hpp"
+#include "modules/avoutput/nal_units.h"
+#include "yuri/core/frame/compressed_frame_types.h"
+
+namespace yuri {
+namespace avoutput {
+
+namespace {
+
+using bytes_t = std::vector<uint8_t>;
+
+std::vector<bytes_t> split(const bytes_t& data)
+{
+	std::vector<bytes_t> nals;
+	for_each_nal(data.data(), data.size(), [&](const uint8_t* nal, size_t size) {
+		nals.emplace_back(nal, nal + size);
+	});
+	return nals;
+}
+
+}
+
+TEST_CASE("for_each_nal", "[nal_units]")
+{
+	REQUIRE(split({}).empty());
+	REQUIRE(split({0x65, 0x88, 0x80}).empty());
+	REQUIRE(split({0, 0, 1}).empty());
+	// 3 and 4 byte start codes, garbage before the first one and trailing zeros
+	const bytes_t stream = {0x12, 0, 0, 0, 1, 0x67, 0x42, 0, 0, 1, 0x68, 0xce, 0, 0, 0, 1, 0x65, 0x88, 0, 0x80, 0, 0};
+	const auto nals = split(stream);
+	REQUIRE(nals.size() == 3);
+	REQUIRE(nals[0] == (bytes_t{0x67, 0x42}));
+	REQUIRE(nals[1] == (bytes_t{0x68, 0xce}));
+	REQUIRE(nals[2] == (bytes_t{0x65, 0x88, 0, 0x80}));
+	// Empty units are skipped
+	REQUIRE(split({0, 0, 1, 0, 0, 1, 0x09, 0xf0}) == (std::vector<bytes_t>{{0x09, 0xf0}}));
+}
+
+TEST_CASE("avc1_to_annexb", "[nal_units]")
+{
+	bytes_t out;
+	const bytes_t avc1 = {0, 0, 0, 2, 0x67, 0x42, 0, 0, 0, 3, 0x65, 0x88, 0x80};
+	REQUIRE(avc1_to_annexb(avc1.data(), avc1.size(), out));
+	REQUIRE(out == (bytes_t{0, 0, 0, 1, 0x67, 0x42, 0, 0, 0, 1, 0x65, 0x88, 0x80}));
+	REQUIRE(avc1_to_annexb(avc1.data(), 0, out));
+	REQUIRE(out.empty());
+	// Length past the end of data
+	REQUIRE(!avc1_to_annexb(avc1.data(), avc1.size() - 1, out));
+	// Incomplete length prefix
+	REQUIRE(!avc1_to_annexb(avc1.data(), 8, out));
+	const bytes_t huge = {0xff, 0xff, 0xff, 0xff, 0x65};
+	REQUIRE(!avc1_to_annexb(huge.data(), huge.size(), out));
+}
+
+TEST_CASE("summarize_nals", "[nal_units]")
+{
+	SECTION("h264") {
+		const bytes_t sps = {0, 0, 0, 1, 0x67, 0x42, 0xc0, 0x1e};
+		const bytes_t pps = {0, 0, 0, 1, 0x68, 0xce, 0x3c, 0x80};
+		const bytes_t idr = {0, 0, 0, 1, 0x65, 0x88, 0x84};
+		const bytes_t slice = {0, 0, 0, 1, 0x41, 0x9a, 0x02};
+		const bytes_t sei = {0, 0, 0, 1, 0x06, 0x05, 0x01};
+
+		bytes_t stream = sei;
+		stream.insert(stream.end(), sps.begin(), sps.end());
+		stream.insert(stream.end(), pps.begin(), pps.end());
+		auto s = summarize_nals(core::compressed_frame::h264, stream.data(), stream.size());
+		REQUIRE(!s.picture);
+		REQUIRE(!s.keyframe);
+		// SPS followed by PPS
+		const bytes_t parameter_sets = {0, 0, 0, 1, 0x67, 0x42, 0xc0, 0x1e, 0, 0, 0, 1, 0x68, 0xce, 0x3c, 0x80};
+		REQUIRE(s.parameter_sets == parameter_sets);
+
+		stream.insert(stream.end(), idr.begin(), idr.end());
+		s = summarize_nals(core::compressed_frame::h264, stream.data(), stream.size());
+		REQUIRE(s.picture);
+		REQUIRE(s.keyframe);
+		REQUIRE(s.parameter_sets == parameter_sets);
+
+		s = summarize_nals(core::compressed_frame::h264, slice.data(), slice.size());
+		REQUIRE(s.picture);
+		REQUIRE(!s.keyframe);
+		REQUIRE(s.parameter_sets.empty());
+	}
+	SECTION("h265") {
+		const bytes_t vps = {0, 0, 0, 1, 0x40, 0x01, 0x0c};
+		const bytes_t sps = {0, 0, 0, 1, 0x42, 0x01, 0x01};
+		const bytes_t pps = {0, 0, 0, 1, 0x44, 0x01, 0xc1};
+		const bytes_t idr = {0, 0, 0, 1, 0x26, 0x01, 0xaf};
+		const bytes_t cra = {0, 0, 0, 1, 0x2a, 0x01, 0xaf};
+		const bytes_t trail = {0, 0, 0, 1, 0x02, 0x01, 0xd0};
+
+		bytes_t stream = vps;
+		stream.insert(stream.end(), sps.begin(), sps.end());
+		stream.insert(stream.end(), pps.begin(), pps.end());
+		const bytes_t parameter_sets = stream;
+		stream.insert(stream.end(), idr.begin(), idr.end());
+		auto s = summarize_nals(core::compressed_frame::h265, stream.data(), stream.size());
+		REQUIRE(s.picture);
+		REQUIRE(s.keyframe);
+		REQUIRE(s.parameter_sets == parameter_sets);
+
+		s = summarize_nals(core::compressed_frame::h265, cra.data(), cra.size());
+		REQUIRE(s.picture);
+		REQUIRE(s.keyframe);
+		s = summarize_nals(core::compressed_frame::h265, trail.data(), trail.size());
+		REQUIRE(s.picture);
+		REQUIRE(!s.keyframe);
+		REQUIRE(s.parameter_sets.empty());
+		// As H.264, the same unit is a non-IDR slice
+		s = summarize_nals(core::compressed_frame::h264, trail.data(), trail.size());
+		REQUIRE(!s.keyframe);
+	}
+}
+
+}
+}
@@ -0,0 +1,115 @@
+/*!
+ * @file 		test_seek_index.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "catch.hpp"
+#include "modules/rawavfile/seek_index.h"
+#include <cstdio>
+#include <fstream>
+
+namespace yuri {
+namespace rawavfile {
+
+namespace {
+
+const std::string media_file = "test_seek_index.media";
+const std::string index_file = "test_seek_index.idx";
+
+void write_file(const std::string& path, const std::string& content)
+{
+	std::ofstream f(path, std::ios::binary);
+	f << content;
+}
+
+//! Removes the files at the end of a test
+struct files_guard_t {
+	~files_guard_t()
+	{
+		std::remove(media_file.c_str());
+		std::remove(index_file.c_str());
+	}
+};
+
+}
+
+TEST_CASE("seek index mode", "[seek_index]")
+{
+	REQUIRE(parse_seek_index_mode("none") == seek_index_mode_t::none);
+	REQUIRE(parse_seek_index_mode("scan") == seek_index_mode_t::scan);
+	REQUIRE(parse_seek_index_mode("container") == seek_index_mode_t::container);
+	REQUIRE(parse_seek_index_mode("whatever") == seek_index_mode_t::container);
+}
+
+TEST_CASE("seek index", "[seek_index]")
+{
+	files_guard_t guard;
+	write_file(media_file, std::string(1234, 'x'));
+	// Unsorted on purpose, the index has to be sorted after loading
+	write_file(index_file, "yuri-keyframes 1 2 1234 4\n"
+			"500 5000\n"
+			"0 100\n"
+			"1000 -1\n"
+			"250 2500\n");
+	seek_index_t index;
+	REQUIRE(index.empty());
+	REQUIRE(index.find(0) == nullptr);
+
+	SECTION("find") {
+		REQUIRE(index.load(index_file, media_file, 2));
+		REQUIRE(index.size() == 4);
+		REQUIRE(index.find(-1) == nullptr);
+		REQUIRE(index.find(0)->pos == 100);
+		REQUIRE(index.find(249)->pts == 0);
+		REQUIRE(index.find(250)->pos == 2500);
+		REQUIRE(index.find(999)->pts == 500);
+		REQUIRE(index.find(1000)->pos == -1);
+		REQUIRE(index.find(1000000)->pts == 1000);
+		index.clear();
+		REQUIRE(index.find(1000) == nullptr);
+	}
+	SECTION("save") {
+		REQUIRE(index.load(index_file, media_file, 2));
+		REQUIRE(index.save(index_file, media_file, 2));
+		seek_index_t loaded;
+		REQUIRE(loaded.load(index_file, media_file, 2));
+		REQUIRE(loaded.size() == 4);
+		for (int64_t pts: {0, 250, 500, 1000}) {
+			REQUIRE(loaded.find(pts)->pts == pts);
+			REQUIRE(loaded.find(pts)->pos == index.find(pts)->pos);
+		}
+		// Saving an empty index gives a file that is valid, but doesn't provide anything
+		seek_index_t empty;
+		REQUIRE(empty.save(index_file, media_file, 2));
+		REQUIRE(!loaded.load(index_file, media_file, 2));
+		REQUIRE(loaded.empty());
+	}
+	SECTION("rejected") {
+		// Different stream
+		REQUIRE(!index.load(index_file, media_file, 1));
+		REQUIRE(index.empty());
+		// Missing index
+		REQUIRE(!index.load(index_file + ".missing", media_file, 2));
+		// The file has changed
+		write_file(media_file, std::string(1235, 'x'));
+		REQUIRE(!index.load(index_file, media_file, 2));
+		write_file(media_file, std::string(1234, 'x'));
+		REQUIRE(index.load(index_file, media_file, 2));
+		// Truncated index
+		write_file(index_file, "yuri-keyframes 1 2 1234 4\n0 100\n250 2500\n");
+		REQUIRE(!index.load(index_file, media_file, 2));
+		REQUIRE(index.empty());
+		// Wrong magic or version
+		write_file(index_file, "yuri-keyframez 1 2 1234 1\n0 100\n");
+		REQUIRE(!index.load(index_file, media_file, 2));
+		write_file(index_file, "yuri-keyframes 2 2 1234 1\n0 100\n");
+		REQUIRE(!index.load(index_file, media_file, 2));
+	}
+}
+
+}
+}
@@ -0,0 +1,154 @@
+/*!
+ * @file 		test_swizzle.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "catch.hpp"
+#include "yuri/core/utils/swizzle.h"
+#include <random>
+#include <vector>
+
+namespace yuri {
+namespace core {
+namespace utils {
+
+namespace {
+
+// Outputs have some spare space, to catch writes past the requested count
+const size_t spare = 64;
+
+std::vector<uint8_t> random_bytes(size_t count)
+{
+	static std::mt19937 gen(1);
+	std::vector<uint8_t> data(count);
+	for (auto& d: data) d = static_cast<uint8_t>(gen());
+	return data;
+}
+
+std::vector<size_t> test_counts()
+{
+	std::vector<size_t> counts;
+	for (size_t i = 0; i < 80; ++i) counts.push_back(i);
+	for (size_t i: {127, 128, 129, 1000, 1001, 1919}) counts.push_back(i);
+	return counts;
+}
+
+using planes_t = std::vector<std::vector<uint8_t>>;
+
+std::vector<uint8_t*> pointers(planes_t& planes)
+{
+	std::vector<uint8_t*> p;
+	for (auto& plane: planes) p.push_back(plane.data());
+	return p;
+}
+
+}
+
+TEST_CASE("swizzle", "[swizzle]")
+{
+	const auto kernels = detail::get_supported_swizzle_kernels();
+	REQUIRE(kernels.size() > 0);
+	const auto& scalar = kernels.front();
+
+	for (const auto& k: kernels) {
+		INFO("kernels: " << k.name);
+		SECTION(std::string("shuffle_pixels ") + k.name) {
+			const std::vector<std::tuple<size_t, size_t, std::array<uint8_t, 4>>> orders = {
+					std::make_tuple(4, 4, std::array<uint8_t, 4>{{2, 1, 0, 3}}),
+					std::make_tuple(4, 4, std::array<uint8_t, 4>{{3, 2, 1, 0}}),
+					std::make_tuple(4, 4, std::array<uint8_t, 4>{{1, 2, 3, 4}}),
+					std::make_tuple(3, 4, std::array<uint8_t, 4>{{2, 1, 0, 3}}),
+					std::make_tuple(3, 4, std::array<uint8_t, 4>{{3, 0, 1, 2}}),
+					std::make_tuple(4, 3, std::array<uint8_t, 4>{{2, 1, 0, 3}}),
+					std::make_tuple(4, 3, std::array<uint8_t, 4>{{1, 2, 3, 0}}),
+					std::make_tuple(3, 3, std::array<uint8_t, 4>{{2, 1, 0, 3}}),
+			};
+			for (const auto& o: orders) {
+				const size_t src_bpp = std::get<0>(o);
+				const size_t dst_bpp = std::get<1>(o);
+				for (auto count: test_counts()) {
+					INFO(src_bpp << " -> " << dst_bpp << " bytes, " << count << " pixels");
+					const auto src = random_bytes(count * src_bpp);
+					std::vector<uint8_t> expected(count * dst_bpp + spare, 0x55);
+					auto out = expected;
+					scalar.shuffle(src.data(), src_bpp, expected.data(), dst_bpp, count, std::get<2>(o), 0xAA);
+					k.shuffle(src.data(), src_bpp, out.data(), dst_bpp, count, std::get<2>(o), 0xAA);
+					REQUIRE(out == expected);
+				}
+			}
+		}
+		SECTION(std::string("(de)interleave_planes ") + k.name) {
+			using deinterleave_t = decltype(k.deinterleave2);
+			using interleave_t = decltype(k.interleave2);
+			const std::vector<std::tuple<size_t, deinterleave_t, interleave_t, deinterleave_t, interleave_t>> functions = {
+					std::make_tuple(2, scalar.deinterleave2, scalar.interleave2, k.deinterleave2, k.interleave2),
+					std::make_tuple(3, scalar.deinterleave3, scalar.interleave3, k.deinterleave3, k.interleave3),
+					std::make_tuple(4, scalar.deinterleave4, scalar.interleave4, k.deinterleave4, k.interleave4),
+			};
+			for (const auto& f: functions) {
+				const size_t components = std::get<0>(f);
+				for (auto count: test_counts()) {
+					INFO(components << " components, " << count << " pixels");
+					const auto packed = random_bytes(count * components);
+					planes_t expected(components, std::vector<uint8_t>(count + spare, 0x55));
+					auto out = expected;
+					std::get<1>(f)(packed.data(), pointers(expected).data(), count);
+					std::get<3>(f)(packed.data(), pointers(out).data(), count);
+					REQUIRE(out == expected);
+					// Scalar deinterleave was checked above, so it's enough to compare interleaved data with the source
+					std::vector<uint8_t> interleaved(count * components + spare, 0x55);
+					std::vector<const uint8_t*> planes;
+					for (const auto& plane: expected) planes.push_back(plane.data());
+					std::get<4>(f)(planes.data(), interleaved.data(), count);
+					REQUIRE(std::equal(packed.begin(), packed.end(), interleaved.begin()));
+					REQUIRE(std::all_of(interleaved.begin() + packed.size(), interleaved.end(), [](uint8_t v){ return v == 0x55; }));
+				}
+			}
+		}
+		SECTION(std::string("split/merge_yuv422 ") + k.name) {
+			for (const auto& layout: {yuyv_layout, uyvy_layout, yvyu_layout, vyuy_layout}) {
+				for (auto pairs: test_counts()) {
+					INFO(pairs << " pairs");
+					const auto packed = random_bytes(pairs * 4);
+					planes_t expected = {std::vector<uint8_t>(pairs * 2 + spare, 0x55),
+							std::vector<uint8_t>(pairs + spare, 0x55), std::vector<uint8_t>(pairs + spare, 0x55)};
+					auto out = expected;
+					scalar.split422(packed.data(), expected[0].data(), expected[1].data(), expected[2].data(), pairs, layout);
+					k.split422(packed.data(), out[0].data(), out[1].data(), out[2].data(), pairs, layout);
+					REQUIRE(out == expected);
+
+					std::vector<uint8_t> merged(pairs * 4 + spare, 0x55);
+					k.merge422(expected[0].data(), expected[1].data(), expected[2].data(), merged.data(), pairs, layout);
+					REQUIRE(std::equal(packed.begin(), packed.end(), merged.begin()));
+					REQUIRE(std::all_of(merged.begin() + packed.size(), merged.end(), [](uint8_t v){ return v == 0x55; }));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("swizzle dispatch", "[swizzle]")
+{
+	// The public functions use the best kernels, check they're wired correctly
+	const auto packed = random_bytes(101 * 4);
+	planes_t planes(4, std::vector<uint8_t>(101));
+	deinterleave_planes(packed.data(), pointers(planes).data(), 4, 101);
+	for (size_t i = 0; i < 101; ++i) {
+		for (size_t k = 0; k < 4; ++k) {
+			REQUIRE(planes[k][i] == packed[i * 4 + k]);
+		}
+	}
+	std::vector<uint8_t> shuffled(101 * 4);
+	shuffle_pixels(packed.data(), 4, shuffled.data(), 4, 101, {{3, 2, 1, 0}});
+	for (size_t i = 0; i < 101 * 4; ++i) {
+		REQUIRE(shuffled[i] == packed[i / 4 * 4 + 3 - i % 4]);
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,172 @@
+/*!
+ * @file 		test_timer_service.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "catch.hpp"
+#include "yuri/core/thread/TimerService.h"
+#include "yuri/core/utils/Timer.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace yuri {
+namespace core {
+
+namespace {
+
+//! Records order of the callbacks
+class recorder_t {
+public:
+	BasicTimerService::callback_t record(int value)
+	{
+		return [this, value]{
+			std::unique_lock<std::mutex> _(mutex_);
+			values_.push_back(value);
+			times_.push_back(timestamp_t{});
+			cond_.notify_all();
+		};
+	}
+	bool wait(size_t count, duration_t timeout = 5_s)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		return cond_.wait_for(lock, std::chrono::microseconds(timeout.value), [&]{ return values_.size() >= count; });
+	}
+	std::vector<int> values()
+	{
+		std::unique_lock<std::mutex> _(mutex_);
+		return values_;
+	}
+	std::vector<timestamp_t> times()
+	{
+		std::unique_lock<std::mutex> _(mutex_);
+		return times_;
+	}
+private:
+	std::mutex mutex_;
+	std::condition_variable cond_;
+	std::vector<int> values_;
+	std::vector<timestamp_t> times_;
+};
+
+}
+
+TEST_CASE("timer service", "[timer_service]")
+{
+	// Declared first, so it outlives callbacks of the timers
+	recorder_t recorder;
+	BasicTimerService timers;
+	const timestamp_t now;
+
+	SECTION("order") {
+		const std::vector<int> offsets = {50, 10, 30, 20, 40, 20};
+		std::vector<BasicTimerService::timer_id_t> ids;
+		for (size_t i = 0; i < offsets.size(); ++i) {
+			ids.push_back(timers.schedule(now + 1_ms * offsets[i], recorder.record(static_cast<int>(i))));
+			REQUIRE(ids.back() != 0);
+		}
+		REQUIRE(std::set<BasicTimerService::timer_id_t>(ids.begin(), ids.end()).size() == ids.size());
+		REQUIRE(recorder.wait(offsets.size()));
+		// Timers with the same deadline are called in the order they were scheduled
+		REQUIRE(recorder.values() == (std::vector<int>{1, 3, 5, 2, 4, 0}));
+		const auto times = recorder.times();
+		for (size_t i = 0; i < times.size(); ++i) {
+			REQUIRE(times[i] >= now + 1_ms * offsets[recorder.values()[i]]);
+		}
+	}
+	SECTION("deadline in the past") {
+		timers.schedule(now - 1_s, recorder.record(0));
+		REQUIRE(recorder.wait(1, 1_s));
+	}
+	SECTION("earlier timer scheduled later") {
+		timers.schedule(now + 1_hours, recorder.record(0));
+		timers.schedule(now + 20_ms, recorder.record(1));
+		REQUIRE(recorder.wait(1, 1_s));
+		REQUIRE(recorder.values() == std::vector<int>{1});
+	}
+	SECTION("cancel") {
+		const auto first = timers.schedule(now + 20_ms, recorder.record(0));
+		timers.schedule(now + 40_ms, recorder.record(1));
+		const auto last = timers.schedule(now + 60_ms, recorder.record(2));
+		timers.cancel(first);
+		timers.cancel(last);
+		REQUIRE(recorder.wait(1));
+		REQUIRE(!recorder.wait(2, 100_ms));
+		REQUIRE(recorder.values() == std::vector<int>{1});
+		// Cancelling a timer that was already called does nothing
+		timers.cancel(first);
+		timers.cancel(12345);
+	}
+	SECTION("cancel waits for running callback") {
+		std::atomic<bool> started(false), finished(false);
+		const auto id = timers.schedule(now, [&]{
+			started = true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			finished = true;
+		});
+		while (!started) std::this_thread::yield();
+		timers.cancel(id);
+		REQUIRE(finished);
+	}
+	SECTION("cancel from the callback") {
+		BasicTimerService::timer_id_t id = 0;
+		std::atomic<bool> id_set(false);
+		id = timers.schedule(now + 10_ms, [&]{
+			while (!id_set) std::this_thread::yield();
+			timers.cancel(id);
+			recorder.record(0)();
+		});
+		id_set = true;
+		REQUIRE(recorder.wait(1));
+	}
+}
+
+TEST_CASE("fps timer", "[timer_service]")
+{
+	const timestamp_t start;
+	// 59.94 fps
+	const double fps = 60000.0 / 1001.0;
+	FPSTimer timer(fps);
+	timer.reset(start);
+	REQUIRE(timer.next_deadline() == start);
+	REQUIRE(timer.get_period() == 16683_us);
+
+	auto last = timer.next_deadline();
+	for (size_t i = 1; i <= 100000; ++i) {
+		timer.advance();
+		const auto deadline = timer.next_deadline();
+		// Periods are rounded, but don't drift
+		const auto period = deadline - last;
+		REQUIRE((period == 16683_us || period == 16684_us));
+		last = deadline;
+	}
+	REQUIRE(timer.get_frame_count() == 100000);
+	// 100000 frames take exactly 1668.3333... seconds
+	const auto elapsed = timer.next_deadline() - start;
+	REQUIRE(elapsed >= 1668333332_us);
+	REQUIRE(elapsed <= 1668333334_us);
+
+	// Changing fps continues from the next deadline
+	const auto next = timer.next_deadline();
+	timer.set_fps(25.0);
+	REQUIRE(timer.next_deadline() == next);
+	REQUIRE(timer.get_frame_count() == 0);
+	timer.advance();
+	REQUIRE(timer.next_deadline() - next == 40_ms);
+
+	FPSTimer stopped(0.0);
+	stopped.reset(start);
+	stopped.advance();
+	REQUIRE(stopped.next_deadline() == start);
+	REQUIRE(stopped.get_period() == 0_us);
+}
+
+}
+}
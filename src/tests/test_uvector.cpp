@@ -0,0 +1,70 @@
+/*!
+ * @file 		test_uvector.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "catch.hpp"
+#include "yuri/core/utils/uvector.h"
+#include <vector>
+
+namespace yuri {
+
+namespace {
+template<class T>
+std::vector<int> to_vector(const T& v)
+{
+	return {v.begin(), v.end()};
+}
+}
+
+TEST_CASE("uvector insert") {
+	const std::vector<int> values = {1, 2, 3, 4, 5};
+	const std::vector<int> inserted = {10, 11, 12};
+
+	SECTION("middle") {
+		uvector<int> v(values.begin(), values.end());
+		v.reserve(16);
+		v.insert(v.begin() + 2, inserted.begin(), inserted.end());
+		REQUIRE(to_vector(v) == (std::vector<int>{1, 2, 10, 11, 12, 3, 4, 5}));
+	}
+	SECTION("begin") {
+		uvector<int> v(values.begin(), values.end());
+		v.reserve(16);
+		v.insert(v.begin(), inserted.begin(), inserted.end());
+		REQUIRE(to_vector(v) == (std::vector<int>{10, 11, 12, 1, 2, 3, 4, 5}));
+	}
+	SECTION("end") {
+		uvector<int> v(values.begin(), values.end());
+		v.reserve(16);
+		v.insert(v.end(), inserted.begin(), inserted.end());
+		REQUIRE(to_vector(v) == (std::vector<int>{1, 2, 3, 4, 5, 10, 11, 12}));
+	}
+	SECTION("with reallocation") {
+		// No spare capacity, so the iterator passed to insert() is invalidated by the reallocation
+		uvector<int> v(values.begin(), values.end());
+		REQUIRE(v.capacity() == values.size());
+		v.insert(v.begin() + 1, inserted.begin(), inserted.end());
+		REQUIRE(to_vector(v) == (std::vector<int>{1, 10, 11, 12, 2, 3, 4, 5}));
+		v.insert(v.end(), inserted.begin(), inserted.end());
+		REQUIRE(to_vector(v) == (std::vector<int>{1, 10, 11, 12, 2, 3, 4, 5, 10, 11, 12}));
+	}
+	SECTION("more than the tail") {
+		uvector<int> v(values.begin(), values.end());
+		const std::vector<int> many = {20, 21, 22, 23, 24, 25, 26};
+		v.insert(v.begin() + 4, many.begin(), many.end());
+		REQUIRE(to_vector(v) == (std::vector<int>{1, 2, 3, 4, 20, 21, 22, 23, 24, 25, 26, 5}));
+	}
+	SECTION("empty") {
+		uvector<int> v;
+		v.insert(v.end(), inserted.begin(), inserted.end());
+		REQUIRE(to_vector(v) == inserted);
+		v.insert(v.begin() + 1, inserted.begin(), inserted.begin());
+		REQUIRE(to_vector(v) == inserted);
+	}
+}
+
+}
@@ -30,11 +30,50 @@ CompressedVideoFrame::CompressedVideoFrame(format_t format, resolution_t resolut
 	std::copy(data,data+size,data_.begin());
 }
 
+CompressedVideoFrame::CompressedVideoFrame(format_t format, resolution_t resolution, vector_type&& data)
+:VideoFrame(format, resolution),data_(std::move(data))
+{
+}
+
+CompressedVideoFrame::CompressedVideoFrame(format_t format, resolution_t resolution, segments_t segments)
+:VideoFrame(format, resolution),segments_(std::move(segments)),
+ segments_size_(core::get_segments_size(segments_)),segmented_(true)
+{
+}
+
 CompressedVideoFrame::~CompressedVideoFrame() noexcept
 {
 
 }
 
+CompressedVideoFrame::segment_t CompressedVideoFrame::make_segment(const pCompressedVideoFrame& frame, size_t offset, size_t size)
+{
+	if (frame->is_segmented()) {
+		// Referencing a range inside of a segmented frame would need the data joined anyway
+		frame->join_segments();
+	}
+	return {frame->data_.data() + offset, size, frame};
+}
+
+CompressedVideoFrame::segments_t CompressedVideoFrame::get_segments() const
+{
+	if (is_segmented()) {
+		lock_t _(segments_mutex_);
+		if (is_segmented()) return segments_;
+	}
+	return {{data_.data(), data_.size(), {}}};
+}
+
+void CompressedVideoFrame::join_segments() const
+{
+	lock_t _(segments_mutex_);
+	if (!is_segmented()) return;
+	data_.resize(segments_size_);
+	core::join_segments(segments_, data_.data());
+	segments_.clear();
+	segmented_.store(false, std::memory_order_release);
+}
+
 
 
 
@@ -13,6 +13,8 @@
 
 #include "yuri/core/frame/VideoFrame.h"
 #include "yuri/core/utils/uvector.h"
+#include "yuri/core/utils/data_segment.h"
+#include <atomic>
 
 namespace yuri {
 namespace core {
@@ -35,12 +37,27 @@ public:
 								reference;
 	typedef /* typename */ vector_type::const_reference
 								const_reference;
+	using segment_t = data_segment_t;
+	using segments_t = data_segments_t;
 
 	EXPORT CompressedVideoFrame(format_t format, resolution_t resolution);
 	EXPORT CompressedVideoFrame(format_t format, resolution_t resolution, size_t size);
 	EXPORT CompressedVideoFrame(format_t format, resolution_t resolution, const uint8_t* data, size_t size);
+	/*!
+	 * Creates a frame taking ownership of @em data, without copying it.
+	 * The buffer can use a custom deleter, so memory owned by an encoder
+	 * (e.g. returned to its pool) can be passed downstream as well.
+	 */
+	EXPORT CompressedVideoFrame(format_t format, resolution_t resolution, vector_type&& data);
 	template<class Deleter>
 	CompressedVideoFrame(format_t format, resolution_t resolution, const uint8_t* data, size_t size, Deleter deleter);
+	/*!
+	 * Creates a frame composed of several segments, without copying them.
+	 * The segments are joined into a single buffer only when contiguous data are requested
+	 * (get_data(), data(), begin(), operator[]...), consumers that can work with
+	 * the segments directly should use get_segments() instead.
+	 */
+	EXPORT CompressedVideoFrame(format_t format, resolution_t resolution, segments_t segments);
 	EXPORT ~CompressedVideoFrame() noexcept;
 
 	template<class... Args>
@@ -49,22 +66,37 @@ public:
 		return std::make_shared<CompressedVideoFrame>(std::forward<Args>(args)...);
 	}
 
-	EXPORT vector_type&	get_data() { return data_; }
-
-	EXPORT const vector_type& get_data() const { return data_; }
-
-
-	iterator					begin() {return data_.begin();}
-	iterator					end() {return data_.end();}
-	const_iterator				begin() const {return data_.begin();}
-	const_iterator				end() const {return data_.end();}
-	const_iterator				cbegin() const {return data_.cbegin();}
-	const_iterator				cend() const {return data_.cend();}
+	/*!
+	 * Returns a segment referencing @em size bytes of @em frame starting at @em offset.
+	 * The segment keeps the frame alive, so it can be used to build new frames
+	 * from parts of existing ones.
+	 */
+	EXPORT static segment_t make_segment(const pCompressedVideoFrame& frame, size_t offset, size_t size);
+
+	EXPORT vector_type&	get_data() { return contiguous_data(); }
+
+	EXPORT const vector_type& get_data() const { return contiguous_data(); }
+
+	//! Returns true if the frame still stores its data as separate segments
+	bool						is_segmented() const { return segmented_.load(std::memory_order_acquire); }
+	/*!
+	 * Returns data of the frame as a list of segments, without joining them.
+	 * For contiguous frames, this is a single segment without an owner,
+	 * valid only as long as the frame exists and is not modified.
+	 */
+	EXPORT segments_t			get_segments() const;
+
+	iterator					begin() {return contiguous_data().begin();}
+	iterator					end() {return contiguous_data().end();}
+	const_iterator				begin() const {return contiguous_data().begin();}
+	const_iterator				end() const {return contiguous_data().end();}
+	const_iterator				cbegin() const {return contiguous_data().cbegin();}
+	const_iterator				cend() const {return contiguous_data().cend();}
 	iterator					data() { return begin(); }
 	const_iterator				data() const { return begin(); }
-	reference					operator[](index_t index) { return data_[index]; }
-	const_reference				operator[](index_t index) const { return data_[index]; }
-	size_t						size() const { return data_.size(); }
+	reference					operator[](index_t index) { return contiguous_data()[index]; }
+	const_reference				operator[](index_t index) const { return contiguous_data()[index]; }
+	size_t						size() const { return is_segmented() ? segments_size_ : data_.size(); }
 
 //	void						push_back(const value_type& plane);
 //	void						push_back(value_type&& plane);
@@ -75,14 +107,26 @@ private:
 	EXPORT virtual pFrame	do_get_copy() const { return pFrame(); }
 	EXPORT virtual size_t	do_get_size() const noexcept { return size(); };
 
-	vector_type data_;
+	vector_type&				contiguous_data() const
+	{
+		if (is_segmented()) join_segments();
+		return data_;
+	}
+	//! Copies all segments into data_ and releases them
+	EXPORT void					join_segments() const;
+
+	mutable vector_type			data_;
+	mutable segments_t			segments_;
+	size_t						segments_size_ = 0;
+	mutable std::atomic<bool>	segmented_ {false};
+	mutable std::mutex			segments_mutex_;
 };
 
 template<class Deleter>
 CompressedVideoFrame::CompressedVideoFrame(format_t format, resolution_t resolution, const uint8_t* data, size_t size, Deleter deleter)
 :VideoFrame(format, resolution)
 {
-	data_.set(data, size, deleter);
+	data_.set(const_cast<uint8_t*>(data), size, deleter);
 }
 
 }
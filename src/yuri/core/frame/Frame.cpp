@@ -13,7 +13,7 @@
 namespace yuri {
 namespace core {
 
-Frame::Frame(format_t format):format_(format),index_(0)
+Frame::Frame(format_t format):format_(format),index_(0),damage_valid_(false)
 {
 
 }
@@ -52,10 +52,31 @@ void Frame::copy_basic_params(const Frame &other)
 	set_format_name(other.get_format_name());
 
 }
+void Frame::set_damage(std::vector<geometry_t> damage)
+{
+	damage_ = std::move(damage);
+	damage_valid_ = true;
+}
+void Frame::add_damage(const geometry_t& rect)
+{
+	damage_.push_back(rect);
+	damage_valid_ = true;
+}
+void Frame::clear_damage()
+{
+	damage_.clear();
+	damage_valid_ = false;
+}
+void Frame::copy_damage(const Frame &other)
+{
+	damage_ = other.damage_;
+	damage_valid_ = other.damage_valid_;
+}
 void Frame::copy_parameters(Frame& frame) const
 {
 	frame.set_format(format_);
 	frame.copy_basic_params(*this);
+	frame.copy_damage(*this);
 }
 
 }
@@ -12,6 +12,7 @@
 #define FRAME_H_
 #include "yuri/core/utils/new_types.h"
 #include "yuri/core/utils/Timer.h"
+#include <vector>
 namespace yuri {
 namespace core {
 
@@ -137,6 +138,41 @@ public:
 	 * @param other Source frame
 	 */
 	EXPORT void 	copy_basic_params(const Frame &other);
+
+	/*!
+	 * Returns true if the frame carries information about damaged regions.
+	 * When there's no such information, the whole frame has to be considered changed.
+	 * @return true if damaged regions are known
+	 */
+	EXPORT bool		has_damage() const noexcept { return damage_valid_; }
+	/*!
+	 * Returns list of rectangles that changed since previous frame
+	 * (frame with index one less then this frame).
+	 * Empty list with has_damage() returning true means nothing changed.
+	 * @return damaged rectangles
+	 */
+	EXPORT const std::vector<geometry_t>&
+					get_damage() const noexcept { return damage_; }
+	/*!
+	 * Sets list of damaged rectangles
+	 * @param damage damaged rectangles
+	 */
+	EXPORT void		set_damage(std::vector<geometry_t> damage);
+	/*!
+	 * Adds a damaged rectangle to the list
+	 * @param rect damaged rectangle
+	 */
+	EXPORT void		add_damage(const geometry_t& rect);
+	/*!
+	 * Removes any information about damaged regions
+	 */
+	EXPORT void		clear_damage();
+	/*!
+	 * Copies damaged regions from other frame.
+	 * Should be used only when the frame has the same geometry as @em other.
+	 * @param other Source frame
+	 */
+	EXPORT void		copy_damage(const Frame &other);
 private:
 	/*!
 	 * Implementation of copy, should be implemented in node classes only.
@@ -167,6 +203,11 @@ private:
 	duration_t		duration_;
 	//! An arbitrary string describing the format (candidate for removal, not really used anymore)
 	std::string		format_name_;
+	//! Regions that changed since previous frame
+	std::vector<geometry_t>
+					damage_;
+	//! True if damage_ is valid
+	bool			damage_valid_;
 };
 
 }
@@ -0,0 +1,90 @@
+/*!
+ * @file 		damage.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "damage.h"
+#include <algorithm>
+
+namespace yuri {
+namespace core {
+
+geometry_t damage_bounds(const std::vector<geometry_t>& damage)
+{
+	if (damage.empty()) return {0, 0, 0, 0};
+	position_t min_x = damage[0].x;
+	position_t min_y = damage[0].y;
+	position_t max_x = geometry_max_x(damage[0]);
+	position_t max_y = geometry_max_y(damage[0]);
+	for (const auto& rect: damage) {
+		min_x = std::min(min_x, rect.x);
+		min_y = std::min(min_y, rect.y);
+		max_x = std::max(max_x, geometry_max_x(rect));
+		max_y = std::max(max_y, geometry_max_y(rect));
+	}
+	return {static_cast<dimension_t>(max_x - min_x), static_cast<dimension_t>(max_y - min_y), min_x, min_y};
+}
+
+geometry_t align_damage(geometry_t rect, dimension_t align_x, dimension_t align_y, resolution_t resolution)
+{
+	rect = intersection(rect, resolution);
+	if (!rect) return {0, 0, 0, 0};
+	if (align_x > 1) {
+		const position_t max_x = geometry_max_x(rect);
+		rect.x -= rect.x % align_x;
+		rect.width = ((max_x - rect.x + align_x - 1) / align_x) * align_x;
+	}
+	if (align_y > 1) {
+		const position_t max_y = geometry_max_y(rect);
+		rect.y -= rect.y % align_y;
+		rect.height = ((max_y - rect.y + align_y - 1) / align_y) * align_y;
+	}
+	return intersection(rect, resolution);
+}
+
+std::vector<geometry_t> simplify_damage(const std::vector<geometry_t>& damage, resolution_t resolution, size_t max_rects)
+{
+	std::vector<geometry_t> rects;
+	rects.reserve(damage.size());
+	for (const auto& rect: damage) {
+		const auto clipped = intersection(rect, resolution);
+		if (clipped) rects.push_back(clipped);
+	}
+	if (rects.size() > max_rects) {
+		return {damage_bounds(rects)};
+	}
+	return rects;
+}
+
+DamageTracker::DamageTracker()
+:valid_(false),index_(0),format_(0),resolution_{0, 0}
+{
+}
+
+bool DamageTracker::follows(const VideoFrame& frame) const
+{
+	return valid_ && frame.has_damage() &&
+			frame.get_index() == index_ + 1 &&
+			frame.get_format() == format_ &&
+			frame.get_resolution() == resolution_;
+}
+
+void DamageTracker::update(const VideoFrame& frame)
+{
+	valid_ = true;
+	index_ = frame.get_index();
+	format_ = frame.get_format();
+	resolution_ = frame.get_resolution();
+}
+
+void DamageTracker::reset()
+{
+	valid_ = false;
+}
+
+}
+}
@@ -0,0 +1,72 @@
+/*!
+ * @file 		damage.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Helpers for processing only damaged (changed) regions of frames.
+ *
+ * Sources that know which parts of the image changed (e.g. screen grabbers)
+ * store the changed rectangles in the frame (Frame::set_damage()).
+ * Filters can then process only these regions and reuse their previous
+ * output for the rest of the image, as long as the frames follow each other
+ * directly (checked by DamageTracker).
+ */
+
+#ifndef DAMAGE_H_
+#define DAMAGE_H_
+#include "VideoFrame.h"
+
+namespace yuri {
+namespace core {
+
+/*!
+ * Returns bounding rectangle of all rectangles in @em damage
+ */
+EXPORT geometry_t damage_bounds(const std::vector<geometry_t>& damage);
+
+/*!
+ * Expands the rectangle so its edges are aligned to multiples of @em align_x and @em align_y
+ * and clips it to the image.
+ */
+EXPORT geometry_t align_damage(geometry_t rect, dimension_t align_x, dimension_t align_y, resolution_t resolution);
+
+/*!
+ * Clips all rectangles to the image and removes empty ones. When there's more than
+ * @em max_rects rectangles, they're replaced by their bounding rectangle.
+ */
+EXPORT std::vector<geometry_t> simplify_damage(const std::vector<geometry_t>& damage, resolution_t resolution, size_t max_rects = 16);
+
+/*!
+ * Keeps track of the last processed frame and decides whether a new frame
+ * can be processed only in its damaged regions.
+ */
+class DamageTracker {
+public:
+	EXPORT DamageTracker();
+	/*!
+	 * Returns true when @em frame carries damage info and directly follows
+	 * the frame passed to last call of update(), having the same format and resolution.
+	 * In that case the output for previous frame can be reused outside of the damaged regions.
+	 */
+	EXPORT bool follows(const VideoFrame& frame) const;
+	/*!
+	 * Stores @em frame as the last processed frame.
+	 */
+	EXPORT void update(const VideoFrame& frame);
+	/*!
+	 * Forgets last processed frame, so next frame will be processed whole.
+	 */
+	EXPORT void reset();
+private:
+	bool			valid_;
+	index_t			index_;
+	format_t		format_;
+	resolution_t	resolution_;
+};
+
+}
+}
+
+#endif /* DAMAGE_H_ */
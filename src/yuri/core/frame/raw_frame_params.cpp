@@ -93,6 +93,18 @@ namespace {
 			{bayer_bggr,{bayer_bggr,"Bayer pattern BGGR",{"bggr"}, "",	{{"", {8, 1}, {8}}} }},
 			{bayer_grbg,{bayer_grbg,"Bayer pattern GRBG",{"grbg"}, "",	{{"", {8, 1}, {8}}} }},
 			{bayer_gbrg,{bayer_gbrg,"Bayer pattern GBRG",{"gbrg"}, "",	{{"", {8, 1}, {8}}} }},
+			{bayer_rggb10,{bayer_rggb10,"Bayer pattern RGGB 10 bit",{"rggb10"}, "",	{{"", {16, 1}, {10}}} }},
+			{bayer_bggr10,{bayer_bggr10,"Bayer pattern BGGR 10 bit",{"bggr10"}, "",	{{"", {16, 1}, {10}}} }},
+			{bayer_grbg10,{bayer_grbg10,"Bayer pattern GRBG 10 bit",{"grbg10"}, "",	{{"", {16, 1}, {10}}} }},
+			{bayer_gbrg10,{bayer_gbrg10,"Bayer pattern GBRG 10 bit",{"gbrg10"}, "",	{{"", {16, 1}, {10}}} }},
+			{bayer_rggb12,{bayer_rggb12,"Bayer pattern RGGB 12 bit",{"rggb12"}, "",	{{"", {16, 1}, {12}}} }},
+			{bayer_bggr12,{bayer_bggr12,"Bayer pattern BGGR 12 bit",{"bggr12"}, "",	{{"", {16, 1}, {12}}} }},
+			{bayer_grbg12,{bayer_grbg12,"Bayer pattern GRBG 12 bit",{"grbg12"}, "",	{{"", {16, 1}, {12}}} }},
+			{bayer_gbrg12,{bayer_gbrg12,"Bayer pattern GBRG 12 bit",{"gbrg12"}, "",	{{"", {16, 1}, {12}}} }},
+			{bayer_rggb16,{bayer_rggb16,"Bayer pattern RGGB 16 bit",{"rggb16"}, "",	{{"", {16, 1}, {16}}} }},
+			{bayer_bggr16,{bayer_bggr16,"Bayer pattern BGGR 16 bit",{"bggr16"}, "",	{{"", {16, 1}, {16}}} }},
+			{bayer_grbg16,{bayer_grbg16,"Bayer pattern GRBG 16 bit",{"grbg16"}, "",	{{"", {16, 1}, {16}}} }},
+			{bayer_gbrg16,{bayer_gbrg16,"Bayer pattern GBRG 16 bit",{"gbrg16"}, "",	{{"", {16, 1}, {16}}} }},
 
 
 			{rgb24p,{rgb24p, "RGB 24 bit, planar",{"RGBP", "RGB24P"}, "",{{"R",{8, 1}, {8}},{"G",{8, 1}, {8}},{"B",{8, 1}, {8}}} }},
@@ -111,6 +123,9 @@ namespace {
 			{yuv422p,{yuv422p, "YUV 4:2:2 16 bit, planar",{"YUV422P"}, "",{{"Y",{8, 1}, {8}, 1, 1},{"U",{8, 1}, {8}, 2, 1},{"V",{8, 1}, {8}, 2, 1}} }},
 			{yuv420p,{yuv420p, "YUV 4:2:0 12 bit, planar",{"YUV420P"}, "",{{"Y",{8, 1}, {8}, 1, 1},{"U",{8, 1}, {8}, 2, 2},{"V",{8, 1}, {8}, 2, 2}} }},
 			{yuv411p,{yuv411p, "YUV 4:1:1 9 bit, planar",{"YUV411P"}, "",{{"Y",{8, 1}, {8}, 1, 1},{"U",{8, 1}, {8}, 4, 1},{"V",{8, 1}, {8}, 4, 1}} }},
+			{yuv422p10,{yuv422p10, "YUV 4:2:2 10 bit, planar",{"YUV422P10"}, "",{{"Y",{16, 1}, {10}, 1, 1},{"U",{16, 1}, {10}, 2, 1},{"V",{16, 1}, {10}, 2, 1}} }},
+			{yuv420p10,{yuv420p10, "YUV 4:2:0 10 bit, planar",{"YUV420P10"}, "",{{"Y",{16, 1}, {10}, 1, 1},{"U",{16, 1}, {10}, 2, 2},{"V",{16, 1}, {10}, 2, 2}} }},
+			{yuv422p16,{yuv422p16, "YUV 4:2:2 16 bit, planar",{"YUV422P16"}, "",{{"Y",{16, 1}, {16}, 1, 1},{"U",{16, 1}, {16}, 2, 1},{"V",{16, 1}, {16}, 2, 1}} }},
 
             {nv12,{nv12, "NV12",{"NV12"}, "",{{"Y",{8, 1}, {8}, 1, 1},{"UV",{16, 1}, {8, 8}, 2, 2}}}},
 
@@ -139,6 +139,18 @@ const format_t bayer_rggb	= 0x301;	// BAYER pattern RGGB
 const format_t bayer_bggr	= 0x302;	// BAYER pattern BGGR
 const format_t bayer_grbg	= 0x303;	// BAYER pattern GRBG
 const format_t bayer_gbrg	= 0x304;	// BAYER pattern GBRG
+const format_t bayer_rggb10	= 0x305;	// BAYER pattern RGGB, 10 bit in 16 bit LE words
+const format_t bayer_bggr10	= 0x306;	// BAYER pattern BGGR, 10 bit in 16 bit LE words
+const format_t bayer_grbg10	= 0x307;	// BAYER pattern GRBG, 10 bit in 16 bit LE words
+const format_t bayer_gbrg10	= 0x308;	// BAYER pattern GBRG, 10 bit in 16 bit LE words
+const format_t bayer_rggb12	= 0x309;	// BAYER pattern RGGB, 12 bit in 16 bit LE words
+const format_t bayer_bggr12	= 0x30a;	// BAYER pattern BGGR, 12 bit in 16 bit LE words
+const format_t bayer_grbg12	= 0x30b;	// BAYER pattern GRBG, 12 bit in 16 bit LE words
+const format_t bayer_gbrg12	= 0x30c;	// BAYER pattern GBRG, 12 bit in 16 bit LE words
+const format_t bayer_rggb16	= 0x30d;	// BAYER pattern RGGB, 16 bit LE
+const format_t bayer_bggr16	= 0x30e;	// BAYER pattern BGGR, 16 bit LE
+const format_t bayer_grbg16	= 0x30f;	// BAYER pattern GRBG, 16 bit LE
+const format_t bayer_gbrg16	= 0x310;	// BAYER pattern GBRG, 16 bit LE
 
 // Planar formats
 const format_t rgb24p		= 0x400;	// RGB 8:8:8 (planar)
@@ -157,6 +169,9 @@ const format_t yuv444p		= 0x500;	// YUV 4:4:4 (planar)
 const format_t yuv422p		= 0x501;	// YUV 4:2:2 (planar)
 const format_t yuv420p		= 0x502;	// YUV 4:2:0 (planar)
 const format_t yuv411p		= 0x503;	// YUV 4:1:1 (planar)
+const format_t yuv422p10	= 0x504;	// YUV 4:2:2 10 bit in 16 bit LE words (planar)
+const format_t yuv420p10	= 0x505;	// YUV 4:2:0 10 bit in 16 bit LE words (planar)
+const format_t yuv422p16	= 0x506;	// YUV 4:2:2 16 bit LE (planar)
 
 const format_t nv12         = 0x600;    // NV12 4:2:0 (planar, two planes)
 
@@ -9,6 +9,7 @@
  */
 
 #include "DatagramSocket.h"
+#include "yuri/core/thread/ThreadBase.h"
 
 
 namespace yuri {
@@ -28,9 +29,58 @@ DatagramSocket::~DatagramSocket() noexcept
 size_t DatagramSocket::send_datagram(const uint8_t* data, size_t size) {
 	return do_send_datagram(data, size);
 }
+size_t DatagramSocket::send_datagram(const core::data_segments_t& segments) {
+	return do_send_datagram_segments(segments);
+}
+size_t DatagramSocket::send_datagrams(const std::vector<core::data_segments_t>& datagrams) {
+	return do_send_datagrams(datagrams);
+}
 size_t DatagramSocket::receive_datagram(uint8_t* data, size_t size) {
 	return do_receive_datagram(data, size);
 }
+size_t DatagramSocket::receive_datagrams(std::vector<received_datagram_t>& datagrams) {
+	return do_receive_datagrams(datagrams);
+}
+bool DatagramSocket::set_receive_buffer_size(size_t size) {
+	return do_set_receive_buffer_size(size);
+}
+bool DatagramSocket::set_send_buffer_size(size_t size) {
+	return do_set_send_buffer_size(size);
+}
+size_t DatagramSocket::do_send_datagram_segments(const core::data_segments_t& segments) {
+	if (segments.size() == 1) {
+		return do_send_datagram(segments[0].data, segments[0].size);
+	}
+	std::vector<uint8_t> buffer(core::get_segments_size(segments));
+	core::join_segments(segments, buffer.data());
+	return do_send_datagram(buffer.data(), buffer.size());
+}
+size_t DatagramSocket::do_send_datagrams(const std::vector<core::data_segments_t>& datagrams) {
+	size_t sent = 0;
+	for (const auto& d: datagrams) {
+		if (do_send_datagram_segments(d) != core::get_segments_size(d)) break;
+		++sent;
+	}
+	return sent;
+}
+size_t DatagramSocket::do_receive_datagrams(std::vector<received_datagram_t>& datagrams) {
+	size_t received = 0;
+	for (auto& d: datagrams) {
+		// The first read behaves as receive_datagram(), the others shouldn't block
+		if (received && !do_data_available()) break;
+		d.size = do_receive_datagram(d.data, d.capacity);
+		if (!d.size) break;
+		d.timestamp = timestamp_t{};
+		++received;
+	}
+	return received;
+}
+bool DatagramSocket::do_set_receive_buffer_size(size_t) {
+	return false;
+}
+bool DatagramSocket::do_set_send_buffer_size(size_t) {
+	return false;
+}
 bool DatagramSocket::bind(const std::string& url, port_t port) {
 	return do_bind(url, port);
 }
@@ -47,6 +97,15 @@ bool DatagramSocket::ready_to_send() {
 bool DatagramSocket::wait_for_data(duration_t duration) {
 	return do_wait_for_data(duration);
 }
+bool DatagramSocket::wait_for_send(duration_t duration) {
+	return do_wait_for_send(duration);
+}
+bool DatagramSocket::do_wait_for_send(duration_t duration) {
+	// Sockets that can't wait are checked again after the timeout
+	if (do_ready_to_send()) return true;
+	ThreadBase::sleep(duration);
+	return do_ready_to_send();
+}
 
 
 }
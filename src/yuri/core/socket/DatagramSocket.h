@@ -13,6 +13,7 @@
 #include "socket_errors.h"
 #include "yuri/log/Log.h"
 #include "yuri/core/utils/time_types.h"
+#include "yuri/core/utils/data_segment.h"
 #include <string>
 #include <array>
 #include <vector>
@@ -21,6 +22,20 @@ namespace core {
 namespace socket {
 
 typedef uint16_t port_t;
+
+/*!
+ * Datagram received by DatagramSocket::receive_datagrams().
+ * @em data and @em capacity are set by the caller, the rest is filled by the socket.
+ */
+struct received_datagram_t {
+	uint8_t* data;
+	size_t capacity;
+	//! Size of the received datagram in bytes
+	size_t size;
+	//! Time the datagram arrived, or the time it was read, if the socket doesn't provide it
+	timestamp_t timestamp;
+};
+
 class DatagramSocket;
 typedef std::shared_ptr<DatagramSocket> pDatagramSocket;
 class DatagramSocket {
@@ -62,6 +77,13 @@ public:
 	 */
 	EXPORT bool ready_to_send();
 
+	/*!
+	 * Waits for the underlying socket to become ready to send a packet, for at most @em duration.
+	 * @param duration Maximum time to wait
+	 * @return true if the socket is ready to send, false if timeout occurred before it became ready.
+	 */
+	EXPORT bool wait_for_send(duration_t duration);
+
 	/*!
 	 * Sends datagram
 	 * @param data Pinter to data to send
@@ -70,6 +92,24 @@ public:
 	 */
 	EXPORT size_t send_datagram(const uint8_t* data, size_t size);
 
+	/*!
+	 * Sends a single datagram composed of several segments.
+	 * Sockets supporting scatter/gather I/O send the segments directly,
+	 * for other sockets the segments are joined into a temporary buffer.
+	 * @param segments Segments of the datagram, in order
+	 * @return number of bytes really sent
+	 */
+	EXPORT size_t send_datagram(const core::data_segments_t& segments);
+
+	/*!
+	 * Sends several datagrams, each composed of segments.
+	 * Sockets supporting it send the whole batch with a single system call,
+	 * other sockets send the datagrams one by one.
+	 * @param datagrams Datagrams to send, in order
+	 * @return number of datagrams really sent. Sending stops at the first datagram that failed.
+	 */
+	EXPORT size_t send_datagrams(const std::vector<core::data_segments_t>& datagrams);
+
 	/*!
 	 * Convenience wrapper for sending datagrams with different underlying type
 	 * @param data Pointer to beginning of data
@@ -108,6 +148,27 @@ public:
 	 */
 	EXPORT size_t receive_datagram(uint8_t* data, size_t size);
 
+	/*!
+	 * Receives datagrams that are already waiting in the socket, at most one into each
+	 * element of @em datagrams.
+	 * Sockets supporting it receive the whole batch with a single system call.
+	 * @param datagrams Buffers to receive to
+	 * @return number of datagrams received, these are stored in the first elements of @em datagrams
+	 */
+	EXPORT size_t receive_datagrams(std::vector<received_datagram_t>& datagrams);
+
+	/*!
+	 * Sets size of the kernel receive buffer, to hold bursts of datagrams
+	 * that arrive before they get read.
+	 * @return false if the buffer size couldn't be set to at least @em size bytes
+	 */
+	EXPORT bool set_receive_buffer_size(size_t size);
+	/*!
+	 * Sets size of the kernel send buffer
+	 * @return false if the buffer size couldn't be set to at least @em size bytes
+	 */
+	EXPORT bool set_send_buffer_size(size_t size);
+
 	/*!
 	 * Convenience wrapper, receives datagram into an array with different underlying type
 	 * @param data Beginning of data
@@ -138,12 +199,18 @@ protected:
 private:
 
 	virtual size_t do_send_datagram(const uint8_t* data, size_t size) = 0;
+	EXPORT virtual size_t do_send_datagram_segments(const core::data_segments_t& segments);
+	EXPORT virtual size_t do_send_datagrams(const std::vector<core::data_segments_t>& datagrams);
 	virtual size_t do_receive_datagram(uint8_t* data, size_t size) = 0;
+	EXPORT virtual size_t do_receive_datagrams(std::vector<received_datagram_t>& datagrams);
+	EXPORT virtual bool do_set_receive_buffer_size(size_t size);
+	EXPORT virtual bool do_set_send_buffer_size(size_t size);
 	virtual bool do_bind(const std::string& url, port_t port) = 0;
 	virtual bool do_connect(const std::string& url, port_t port) = 0;
 	virtual bool do_data_available() = 0;
 	virtual bool do_ready_to_send() = 0;
 	virtual bool do_wait_for_data(duration_t duration) = 0;
+	EXPORT virtual bool do_wait_for_send(duration_t duration);
 };
 
 
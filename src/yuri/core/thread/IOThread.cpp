@@ -12,6 +12,7 @@
 #include "yuri/exception/NotImplemented.h"
 #include "yuri/core/frame/Frame.h"
 #include "yuri/core/pipe/Pipe.h"
+#include "TimerService.h"
 #include "yuri/core/utils/assign_parameters.h"
 #include <algorithm>
 #include <stdexcept>
@@ -220,6 +221,23 @@ bool IOThread::pipes_data_available()
     return false;
 }
 
+bool IOThread::wait_until(timestamp_t deadline)
+{
+    const timestamp_t now;
+    if (deadline <= now)
+        return true;
+    if (deadline - now >= latency_) {
+        // The thread would wake up because of the latency anyway
+        wait_for(latency_);
+    } else {
+        auto&      timers = TimerService::get_instance();
+        const auto id     = timers.schedule(deadline, [this] { notify(); });
+        wait_for(latency_);
+        timers.cancel(id);
+    }
+    return timestamp_t{} >= deadline;
+}
+
 bool IOThread::set_param(const Parameter& parameter)
 {
     if (assign_parameters(parameter) //
@@ -205,6 +205,16 @@ protected:
      */
     EXPORT bool pipes_data_available();
 
+    /*!
+     * Waits until @em deadline, new data in an input pipe, or for at most latency,
+     * whatever comes first. Deadlines are handled by the shared TimerService,
+     * so the thread wakes up at the deadline precisely.
+     *
+     * @param deadline			Absolute time to wait for
+     * @return true if the deadline passed, false if the wait ended earlier
+     */
+    EXPORT bool wait_until(timestamp_t deadline);
+
     /*!
      * Implementation of @em connect_in method.
      * Child classes that needs to hook on pipes being connected (for example
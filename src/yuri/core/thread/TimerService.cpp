@@ -0,0 +1,138 @@
+/*!
+ * @file 		TimerService.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "TimerService.h"
+#include <stdexcept>
+#include <type_traits>
+#ifdef YURI_LINUX
+#include <cerrno>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+SINGLETON_DEFINE_HELPER(yuri::core::TimerService)
+
+namespace yuri {
+namespace core {
+
+#ifdef YURI_LINUX
+namespace {
+//! timestamp_t uses system clock with libstdc++, but it may be steady clock elsewhere
+const clockid_t timer_clock = std::is_same<yuri::detail::clock_t, std::chrono::steady_clock>::value ? CLOCK_MONOTONIC : CLOCK_REALTIME;
+}
+#endif
+
+BasicTimerService::BasicTimerService()
+:next_id_(1),running_id_(0),stop_(false)
+#ifdef YURI_LINUX
+,timer_fd_(::timerfd_create(timer_clock, TFD_CLOEXEC))
+#endif
+{
+#ifdef YURI_LINUX
+	if (timer_fd_ < 0) throw std::runtime_error("Failed to create timer");
+#endif
+	thread_ = std::thread([this]{ run(); });
+}
+
+BasicTimerService::~BasicTimerService() noexcept
+{
+	{
+		lock_t _(mutex_);
+		stop_ = true;
+		// Deadline in the past wakes up the thread immediately
+		arm(yuri::detail::time_point{});
+	}
+	thread_.join();
+#ifdef YURI_LINUX
+	::close(timer_fd_);
+#endif
+}
+
+BasicTimerService::timer_id_t BasicTimerService::schedule(timestamp_t deadline, callback_t callback)
+{
+	lock_t _(mutex_);
+	const auto id = next_id_++;
+	const auto earliest = timers_.empty() || deadline.value < timers_.begin()->first.first;
+	timers_.emplace(key_t{deadline.value, id}, std::move(callback));
+	deadlines_.emplace(id, deadline.value);
+	if (earliest) arm(deadline.value);
+	return id;
+}
+
+void BasicTimerService::cancel(timer_id_t id)
+{
+	lock_t lock(mutex_);
+	auto it = deadlines_.find(id);
+	if (it != deadlines_.end()) {
+		// The timer thread may wake up for nothing, when this was the earliest timer
+		timers_.erase(key_t{it->second, id});
+		deadlines_.erase(it);
+		return;
+	}
+	if (std::this_thread::get_id() == thread_.get_id()) return;
+	cond_.wait(lock, [&]{ return running_id_ != id; });
+}
+
+#ifdef YURI_LINUX
+
+void BasicTimerService::arm(yuri::detail::time_point deadline)
+{
+	const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+	itimerspec spec {};
+	// Zero value would disarm the timer
+	spec.it_value.tv_sec = ns > 0 ? ns / 1000000000 : 0;
+	spec.it_value.tv_nsec = ns > 0 ? ns % 1000000000 : 1;
+	::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+#else
+
+void BasicTimerService::arm(yuri::detail::time_point)
+{
+	cond_.notify_all();
+}
+
+#endif
+
+void BasicTimerService::run()
+{
+	lock_t lock(mutex_);
+	while (!stop_) {
+		while (!timers_.empty() && timers_.begin()->first.first <= yuri::detail::clock_t::now()) {
+			auto it = timers_.begin();
+			running_id_ = it->first.second;
+			auto callback = std::move(it->second);
+			deadlines_.erase(running_id_);
+			timers_.erase(it);
+			lock.unlock();
+			callback();
+			lock.lock();
+			running_id_ = 0;
+			cond_.notify_all();
+		}
+		if (stop_) break;
+#ifdef YURI_LINUX
+		if (!timers_.empty()) arm(timers_.begin()->first.first);
+		lock.unlock();
+		// Blocks until the timer expires, schedule() re-arms it for earlier deadlines
+		uint64_t expirations;
+		while (::read(timer_fd_, &expirations, sizeof(expirations)) < 0 && errno == EINTR) {}
+		lock.lock();
+#else
+		if (timers_.empty()) {
+			cond_.wait(lock);
+		} else {
+			cond_.wait_until(lock, timers_.begin()->first.first);
+		}
+#endif
+	}
+}
+
+}
+}
@@ -0,0 +1,80 @@
+/*!
+ * @file 		TimerService.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef TIMERSERVICE_H_
+#define TIMERSERVICE_H_
+
+#include "yuri/core/utils/new_types.h"
+#include "yuri/core/utils/time_types.h"
+#include "yuri/core/utils/Singleton.h"
+#include "yuri/core/utils/platform.h"
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+namespace yuri {
+namespace core {
+
+/*!
+ * Single thread calling callbacks at absolute deadlines.
+ *
+ * On Linux the thread waits on a timerfd armed for the earliest deadline,
+ * which expires without the timer slack applied to sleeping threads.
+ * Callbacks run in the timer thread and should only wake up other threads.
+ */
+class BasicTimerService {
+public:
+	using callback_t = std::function<void()>;
+	using timer_id_t = uint64_t;
+
+	EXPORT BasicTimerService();
+	EXPORT ~BasicTimerService() noexcept;
+
+	/*!
+	 * Calls @em callback once at @em deadline (or right away, if it already passed).
+	 * @return id of the timer, never 0
+	 */
+	EXPORT timer_id_t schedule(timestamp_t deadline, callback_t callback);
+	/*!
+	 * Cancels timer @em id. When called outside the timer thread, it also waits
+	 * for the callback to finish, if it's running, so it can't be called afterwards.
+	 */
+	EXPORT void cancel(timer_id_t id);
+
+private:
+	using key_t = std::pair<yuri::detail::time_point, timer_id_t>;
+
+	void run();
+	//! Makes the timer thread wake up at @em deadline
+	void arm(yuri::detail::time_point deadline);
+
+	std::map<key_t, callback_t> timers_;
+	std::unordered_map<timer_id_t, yuri::detail::time_point> deadlines_;
+	timer_id_t next_id_;
+	//! Timer with callback currently running, 0 if none
+	timer_id_t running_id_;
+	bool stop_;
+	mutex mutex_;
+	std::condition_variable cond_;
+#ifdef YURI_LINUX
+	int timer_fd_;
+#endif
+	std::thread thread_;
+};
+
+using TimerService = utils::Singleton<BasicTimerService>;
+
+}
+}
+
+SINGLETON_DECLARE_HELPER(yuri::core::TimerService)
+
+#endif /* TIMERSERVICE_H_ */
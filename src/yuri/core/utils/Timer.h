@@ -30,18 +30,41 @@ private:
 };
 
 
-// TODO ???
-//class FPSTimer {
-//public:
-//	FPSTimer(double fps):fps_(fps),frame_count_(0){}
-//
-//
-//
-//private:
-//	Timer 						timer_;
-//	double						fps_;
-//	size_t 						frame_count_;
-//};
+/*!
+ * Absolute deadlines of frames with constant framerate.
+ *
+ * Deadlines are computed from the start and number of frames,
+ * so rounding errors don't accumulate (e.g. for 59.94 fps).
+ */
+class FPSTimer {
+public:
+	explicit FPSTimer(double fps = 25.0):fps_(fps) {reset();}
+	//! Starts counting frames from @em start
+	void							reset(timestamp_t start = timestamp_t{}) noexcept {
+		start_ = start;
+		frame_count_ = 0;
+	}
+	//! Changes framerate, keeping the deadline of the next frame
+	void							set_fps(double fps) noexcept {
+		reset(next_deadline());
+		fps_ = fps;
+	}
+	double							get_fps() const noexcept { return fps_; }
+	duration_t						get_period() const noexcept {
+		return fps_ > 0.0 ? duration_t{static_cast<detail::duration_rep>(1e6 / fps_)} : duration_t{};
+	}
+	timestamp_t						next_deadline() const noexcept {
+		if (fps_ <= 0.0) return start_;
+		return start_ + duration_t{static_cast<detail::duration_rep>(frame_count_ * 1e6 / fps_)};
+	}
+	//! Moves to the next frame
+	void							advance() noexcept { ++frame_count_; }
+	size_t							get_frame_count() const noexcept { return frame_count_; }
+private:
+	double							fps_;
+	timestamp_t						start_;
+	size_t							frame_count_;
+};
 
 }
 
@@ -0,0 +1,90 @@
+/*!
+ * @file 		cpu_features.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "cpu_features.h"
+#include "environment.h"
+#if defined(YURI_ARCH_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace yuri {
+namespace core {
+namespace utils {
+
+namespace {
+
+struct cpu_features_t {
+	bool sse2 	= false;
+	bool ssse3 	= false;
+	bool sse41 	= false;
+	bool avx2 	= false;
+};
+
+cpu_features_t detect_features()
+{
+	cpu_features_t f;
+	// Setting YURI_DISABLE_SIMD forces all modules to use their scalar paths.
+	if (!get_environment_variable("YURI_DISABLE_SIMD").empty()) return f;
+#if defined(YURI_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+	__builtin_cpu_init();
+	f.sse2 	= __builtin_cpu_supports("sse2");
+	f.ssse3	= __builtin_cpu_supports("ssse3");
+	f.sse41	= __builtin_cpu_supports("sse4.1");
+	f.avx2 	= __builtin_cpu_supports("avx2");
+#elif defined(YURI_ARCH_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int max_id = info[0];
+	if (max_id >= 1) {
+		__cpuid(info, 1);
+		f.sse2 	= (info[3] & (1 << 26)) != 0;
+		f.ssse3	= (info[2] & (1 << 9)) != 0;
+		f.sse41	= (info[2] & (1 << 19)) != 0;
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool ymm_enabled = osxsave && ((_xgetbv(0) & 0x6) == 0x6);
+		if (max_id >= 7 && ymm_enabled) {
+			__cpuidex(info, 7, 0);
+			f.avx2 = (info[1] & (1 << 5)) != 0;
+		}
+	}
+#endif
+	return f;
+}
+
+const cpu_features_t& get_features()
+{
+	static const cpu_features_t features = detect_features();
+	return features;
+}
+
+}
+
+bool cpu_has_sse2()
+{
+	return get_features().sse2;
+}
+
+bool cpu_has_ssse3()
+{
+	return get_features().ssse3;
+}
+
+bool cpu_has_sse41()
+{
+	return get_features().sse41;
+}
+
+bool cpu_has_avx2()
+{
+	return get_features().avx2;
+}
+
+}
+}
+}
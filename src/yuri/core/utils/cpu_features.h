@@ -0,0 +1,69 @@
+/*!
+ * @file 		cpu_features.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Runtime detection of SIMD extensions supported by current CPU
+ */
+
+#ifndef SRC_YURI_CORE_UTILS_CPU_FEATURES_H_
+#define SRC_YURI_CORE_UTILS_CPU_FEATURES_H_
+
+#include "yuri/core/utils/platform.h"
+
+/*
+ * YURI_HAVE_SSE2 is defined when SSE2 intrinsics can be used unconditionally
+ * (always true for x86_64).
+ *
+ * YURI_HAVE_AVX2_TARGET is defined when the compiler is able to build AVX2
+ * code for a single function (marked with YURI_TARGET_AVX2) without enabling
+ * AVX2 for the whole translation unit. Such functions must only be called
+ * after checking cpu_has_avx2().
+ */
+#if defined(YURI_ARCH_X86_64) || (defined(YURI_ARCH_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+	#define YURI_HAVE_SSE2 1
+#endif
+
+#if defined(YURI_HAVE_SSE2) && (defined(__GNUC__) || defined(__clang__))
+	#define YURI_HAVE_AVX2_TARGET 1
+	#define YURI_HAVE_SSSE3_TARGET 1
+	#define YURI_TARGET_AVX2	__attribute__((target("avx2")))
+	#define YURI_TARGET_SSSE3	__attribute__((target("ssse3")))
+#elif defined(YURI_HAVE_SSE2) && defined(_MSC_VER)
+	#define YURI_HAVE_AVX2_TARGET 1
+	#define YURI_HAVE_SSSE3_TARGET 1
+	#define YURI_TARGET_AVX2
+	#define YURI_TARGET_SSSE3
+#else
+	#define YURI_TARGET_AVX2
+	#define YURI_TARGET_SSSE3
+#endif
+
+namespace yuri {
+namespace core {
+namespace utils {
+
+/*!
+ * @return true if the CPU supports SSE2 instructions
+ */
+EXPORT bool cpu_has_sse2();
+/*!
+ * @return true if the CPU supports SSSE3 instructions
+ */
+EXPORT bool cpu_has_ssse3();
+/*!
+ * @return true if the CPU supports SSE 4.1 instructions
+ */
+EXPORT bool cpu_has_sse41();
+/*!
+ * @return true if the CPU (and the OS) supports AVX2 instructions
+ */
+EXPORT bool cpu_has_avx2();
+
+}
+}
+}
+
+#endif /* SRC_YURI_CORE_UTILS_CPU_FEATURES_H_ */
@@ -0,0 +1,59 @@
+/*!
+ * @file 		data_segment.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#ifndef SRC_YURI_CORE_UTILS_DATA_SEGMENT_H_
+#define SRC_YURI_CORE_UTILS_DATA_SEGMENT_H_
+#include "yuri/core/utils/new_types.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace yuri {
+namespace core {
+
+/*!
+ * Read only view of a contiguous block of memory.
+ * If @em owner is set, it keeps the memory alive for the whole lifetime of the segment,
+ * otherwise the memory is owned by someone else and has to outlive the segment.
+ */
+struct data_segment_t {
+	const uint8_t* data;
+	size_t size;
+	std::shared_ptr<const void> owner;
+};
+
+using data_segments_t = std::vector<data_segment_t>;
+
+//! Total size of all segments in bytes
+inline size_t get_segments_size(const data_segments_t& segments)
+{
+	size_t size = 0;
+	for (const auto& s: segments) {
+		size += s.size;
+	}
+	return size;
+}
+
+/*!
+ * Copies all segments into a contiguous buffer.
+ * @param dest Pointer to a buffer with at least get_segments_size() bytes
+ * @return pointer past the last byte written
+ */
+inline uint8_t* join_segments(const data_segments_t& segments, uint8_t* dest)
+{
+	for (const auto& s: segments) {
+		dest = std::copy(s.data, s.data + s.size, dest);
+	}
+	return dest;
+}
+
+}
+}
+
+#endif /* SRC_YURI_CORE_UTILS_DATA_SEGMENT_H_ */
@@ -0,0 +1,527 @@
+/*!
+ * @file 		swizzle.cpp
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ */
+
+#include "swizzle.h"
+#include "cpu_features.h"
+#include <algorithm>
+#ifdef YURI_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef YURI_HAVE_SSSE3_TARGET
+#include <tmmintrin.h>
+#endif
+#ifdef YURI_HAVE_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+namespace yuri {
+namespace core {
+namespace utils {
+
+namespace {
+
+/* ***************************************************************************
+ * 					Scalar versions
+ *************************************************************************** */
+
+void shuffle_pixels_scalar(const uint8_t* src, size_t src_bpp, uint8_t* dst, size_t dst_bpp, size_t count,
+		const std::array<uint8_t, 4>& order, uint8_t fill)
+{
+	for (size_t pixel = 0; pixel < count; ++pixel) {
+		for (size_t k = 0; k < dst_bpp; ++k) {
+			dst[k] = order[k] < src_bpp ? src[order[k]] : fill;
+		}
+		src += src_bpp;
+		dst += dst_bpp;
+	}
+}
+
+void deinterleave_scalar(const uint8_t* src, uint8_t* const* planes, size_t components, size_t first, size_t count)
+{
+	src += first * components;
+	for (size_t pixel = first; pixel < count; ++pixel) {
+		for (size_t k = 0; k < components; ++k) {
+			planes[k][pixel] = *src++;
+		}
+	}
+}
+
+void interleave_scalar(const uint8_t* const* planes, uint8_t* dst, size_t components, size_t first, size_t count)
+{
+	dst += first * components;
+	for (size_t pixel = first; pixel < count; ++pixel) {
+		for (size_t k = 0; k < components; ++k) {
+			*dst++ = planes[k][pixel];
+		}
+	}
+}
+
+void split_yuv422_scalar(const uint8_t* src, uint8_t* y, uint8_t* u, uint8_t* v, size_t first, size_t pairs,
+		const yuv422_layout_t& layout)
+{
+	for (size_t pair = first; pair < pairs; ++pair) {
+		const uint8_t* s = src + pair * 4;
+		y[pair * 2    ] = s[layout[0]];
+		u[pair        ] = s[layout[1]];
+		y[pair * 2 + 1] = s[layout[2]];
+		v[pair        ] = s[layout[3]];
+	}
+}
+
+void merge_yuv422_scalar(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t first, size_t pairs,
+		const yuv422_layout_t& layout)
+{
+	for (size_t pair = first; pair < pairs; ++pair) {
+		uint8_t* d = dst + pair * 4;
+		d[layout[0]] = y[pair * 2    ];
+		d[layout[1]] = u[pair        ];
+		d[layout[2]] = y[pair * 2 + 1];
+		d[layout[3]] = v[pair        ];
+	}
+}
+
+/* ***************************************************************************
+ * 					SSE2 versions (2 components)
+ *************************************************************************** */
+
+void deinterleave2(const uint8_t* src, uint8_t* const* planes, size_t count)
+{
+	size_t pixel = 0;
+#ifdef YURI_HAVE_SSE2
+	const __m128i mask = _mm_set1_epi16(0x00FF);
+	for (; pixel + 16 <= count; pixel += 16) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pixel * 2));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pixel * 2 + 16));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(planes[0] + pixel),
+				_mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(planes[1] + pixel),
+				_mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+	}
+#endif
+	deinterleave_scalar(src, planes, 2, pixel, count);
+}
+
+void interleave2(const uint8_t* const* planes, uint8_t* dst, size_t count)
+{
+	size_t pixel = 0;
+#ifdef YURI_HAVE_SSE2
+	for (; pixel + 16 <= count; pixel += 16) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0] + pixel));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1] + pixel));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pixel * 2), _mm_unpacklo_epi8(a, b));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pixel * 2 + 16), _mm_unpackhi_epi8(a, b));
+	}
+#endif
+	interleave_scalar(planes, dst, 2, pixel, count);
+}
+
+#ifdef YURI_HAVE_SSSE3_TARGET
+
+/* ***************************************************************************
+ * 					SSSE3 versions
+ *************************************************************************** */
+
+/*
+ * Shuffles are done in 16 byte chunks, each containing whole pixels
+ * (5 pixels for 3 -> 3 and 4 pixels otherwise).
+ * Every chunk loads and stores full 16 bytes, so the loops stop early enough
+ * for the last load and store to stay inside the line.
+ */
+struct shuffle_mask_t {
+	uint8_t shuffle[16];
+	uint8_t fill[16];
+	size_t pixels;
+	size_t guard;
+};
+
+shuffle_mask_t make_shuffle_mask(size_t src_bpp, size_t dst_bpp, const std::array<uint8_t, 4>& order, uint8_t fill)
+{
+	shuffle_mask_t m;
+	m.pixels = (src_bpp == 3 && dst_bpp == 3) ? 5 : 4;
+	m.guard = std::max((16 + src_bpp - 1) / src_bpp, (16 + dst_bpp - 1) / dst_bpp);
+	std::fill(std::begin(m.shuffle), std::end(m.shuffle), 0x80);
+	std::fill(std::begin(m.fill), std::end(m.fill), 0);
+	for (size_t p = 0; p < m.pixels; ++p) {
+		for (size_t k = 0; k < dst_bpp; ++k) {
+			const size_t idx = p * dst_bpp + k;
+			if (order[k] < src_bpp) {
+				m.shuffle[idx] = static_cast<uint8_t>(p * src_bpp + order[k]);
+			} else {
+				m.fill[idx] = fill;
+			}
+		}
+	}
+	return m;
+}
+
+YURI_TARGET_SSSE3
+void shuffle_pixels_ssse3(const uint8_t* src, size_t src_bpp, uint8_t* dst, size_t dst_bpp, size_t count,
+		const std::array<uint8_t, 4>& order, uint8_t fill)
+{
+	const shuffle_mask_t m = make_shuffle_mask(src_bpp, dst_bpp, order, fill);
+	const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m.shuffle));
+	const __m128i fillv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m.fill));
+	size_t pixel = 0;
+	for (; pixel + m.guard <= count; pixel += m.pixels) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pixel * src_bpp));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pixel * dst_bpp),
+				_mm_or_si128(_mm_shuffle_epi8(v, shuffle), fillv));
+	}
+	shuffle_pixels_scalar(src + pixel * src_bpp, src_bpp, dst + pixel * dst_bpp, dst_bpp, count - pixel, order, fill);
+}
+
+/*
+ * Masks for 3 components. For deinterleaving, mask [k][r] moves bytes of component k
+ * from r-th 16 byte block of input to their positions in the plane.
+ * For interleaving, mask [r][k] moves bytes from plane k to r-th block of output.
+ */
+struct masks3_t {
+	uint8_t split[3][3][16];
+	uint8_t merge[3][3][16];
+};
+
+const masks3_t& get_masks3()
+{
+	static const masks3_t masks = [](){
+		masks3_t m;
+		for (size_t k = 0; k < 3; ++k) {
+			for (size_t r = 0; r < 3; ++r) {
+				for (size_t i = 0; i < 16; ++i) {
+					const size_t src_byte = i * 3 + k;
+					m.split[k][r][i] = (src_byte >= r * 16 && src_byte < r * 16 + 16) ?
+							static_cast<uint8_t>(src_byte - r * 16) : 0x80;
+					const size_t dst_byte = r * 16 + i;
+					m.merge[r][k][i] = (dst_byte % 3 == k) ? static_cast<uint8_t>(dst_byte / 3) : 0x80;
+				}
+			}
+		}
+		return m;
+	}();
+	return masks;
+}
+
+YURI_TARGET_SSSE3
+inline __m128i load_mask(const uint8_t* mask)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+YURI_TARGET_SSSE3
+void deinterleave3_ssse3(const uint8_t* src, uint8_t* const* planes, size_t count)
+{
+	const auto& m = get_masks3();
+	__m128i masks[3][3];
+	for (size_t k = 0; k < 3; ++k) {
+		for (size_t r = 0; r < 3; ++r) {
+			masks[k][r] = load_mask(m.split[k][r]);
+		}
+	}
+	size_t pixel = 0;
+	for (; pixel + 16 <= count; pixel += 16) {
+		const uint8_t* s = src + pixel * 3;
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+		for (size_t k = 0; k < 3; ++k) {
+			const __m128i v = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, masks[k][0]),
+					_mm_shuffle_epi8(b, masks[k][1])), _mm_shuffle_epi8(c, masks[k][2]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(planes[k] + pixel), v);
+		}
+	}
+	deinterleave_scalar(src, planes, 3, pixel, count);
+}
+
+YURI_TARGET_SSSE3
+void interleave3_ssse3(const uint8_t* const* planes, uint8_t* dst, size_t count)
+{
+	const auto& m = get_masks3();
+	__m128i masks[3][3];
+	for (size_t r = 0; r < 3; ++r) {
+		for (size_t k = 0; k < 3; ++k) {
+			masks[r][k] = load_mask(m.merge[r][k]);
+		}
+	}
+	size_t pixel = 0;
+	for (; pixel + 16 <= count; pixel += 16) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0] + pixel));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1] + pixel));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[2] + pixel));
+		for (size_t r = 0; r < 3; ++r) {
+			const __m128i v = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, masks[r][0]),
+					_mm_shuffle_epi8(b, masks[r][1])), _mm_shuffle_epi8(c, masks[r][2]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pixel * 3 + r * 16), v);
+		}
+	}
+	interleave_scalar(planes, dst, 3, pixel, count);
+}
+
+// Transposes 4x4 bytes in each dword group (and back, as it's its own inverse)
+YURI_TARGET_SSSE3
+inline __m128i transpose4_mask()
+{
+	return _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+}
+
+YURI_TARGET_SSSE3
+void deinterleave4_ssse3(const uint8_t* src, uint8_t* const* planes, size_t count)
+{
+	const __m128i mask = transpose4_mask();
+	size_t pixel = 0;
+	for (; pixel + 16 <= count; pixel += 16) {
+		const uint8_t* s = src + pixel * 4;
+		const __m128i x0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)), mask);
+		const __m128i x1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16)), mask);
+		const __m128i x2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32)), mask);
+		const __m128i x3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48)), mask);
+		const __m128i t0 = _mm_unpacklo_epi32(x0, x1);
+		const __m128i t1 = _mm_unpacklo_epi32(x2, x3);
+		const __m128i t2 = _mm_unpackhi_epi32(x0, x1);
+		const __m128i t3 = _mm_unpackhi_epi32(x2, x3);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(planes[0] + pixel), _mm_unpacklo_epi64(t0, t1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(planes[1] + pixel), _mm_unpackhi_epi64(t0, t1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(planes[2] + pixel), _mm_unpacklo_epi64(t2, t3));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(planes[3] + pixel), _mm_unpackhi_epi64(t2, t3));
+	}
+	deinterleave_scalar(src, planes, 4, pixel, count);
+}
+
+YURI_TARGET_SSSE3
+void interleave4_ssse3(const uint8_t* const* planes, uint8_t* dst, size_t count)
+{
+	const __m128i mask = transpose4_mask();
+	size_t pixel = 0;
+	for (; pixel + 16 <= count; pixel += 16) {
+		const __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0] + pixel));
+		const __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1] + pixel));
+		const __m128i c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[2] + pixel));
+		const __m128i c3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[3] + pixel));
+		const __m128i u0 = _mm_unpacklo_epi32(c0, c1);
+		const __m128i u1 = _mm_unpacklo_epi32(c2, c3);
+		const __m128i u2 = _mm_unpackhi_epi32(c0, c1);
+		const __m128i u3 = _mm_unpackhi_epi32(c2, c3);
+		uint8_t* d = dst + pixel * 4;
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm_shuffle_epi8(_mm_unpacklo_epi64(u0, u1), mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16), _mm_shuffle_epi8(_mm_unpackhi_epi64(u0, u1), mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 32), _mm_shuffle_epi8(_mm_unpacklo_epi64(u2, u3), mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 48), _mm_shuffle_epi8(_mm_unpackhi_epi64(u2, u3), mask));
+	}
+	interleave_scalar(planes, dst, 4, pixel, count);
+}
+
+/*
+ * YUV 4:2:2 is processed by 8 macropixels. Each 16 byte block is shuffled to
+ * 8 Y bytes, 4 U bytes and 4 V bytes (and back).
+ */
+struct yuv422_masks_t {
+	uint8_t split[16];
+	uint8_t merge[16];
+};
+
+yuv422_masks_t make_yuv422_masks(const yuv422_layout_t& layout)
+{
+	yuv422_masks_t m;
+	for (uint8_t g = 0; g < 4; ++g) {
+		const uint8_t from[4] = {static_cast<uint8_t>(2 * g), static_cast<uint8_t>(8 + g),
+				static_cast<uint8_t>(2 * g + 1), static_cast<uint8_t>(12 + g)};
+		for (size_t k = 0; k < 4; ++k) {
+			m.split[from[k]] = static_cast<uint8_t>(4 * g + layout[k]);
+			m.merge[4 * g + layout[k]] = from[k];
+		}
+	}
+	return m;
+}
+
+YURI_TARGET_SSSE3
+void split_yuv422_ssse3(const uint8_t* src, uint8_t* y, uint8_t* u, uint8_t* v, size_t pairs,
+		const yuv422_layout_t& layout)
+{
+	const yuv422_masks_t m = make_yuv422_masks(layout);
+	const __m128i mask = load_mask(m.split);
+	size_t pair = 0;
+	for (; pair + 8 <= pairs; pair += 8) {
+		const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pair * 4)), mask);
+		const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pair * 4 + 16)), mask);
+		// uv contains U0-3 V0-3 U4-7 V4-7, reorder to U0-7 V0-7
+		const __m128i uv = _mm_shuffle_epi32(_mm_unpackhi_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(y + pair * 2), _mm_unpacklo_epi64(a, b));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(u + pair), uv);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(v + pair), _mm_unpackhi_epi64(uv, uv));
+	}
+	split_yuv422_scalar(src, y, u, v, pair, pairs, layout);
+}
+
+YURI_TARGET_SSSE3
+void merge_yuv422_ssse3(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t pairs,
+		const yuv422_layout_t& layout)
+{
+	const yuv422_masks_t m = make_yuv422_masks(layout);
+	const __m128i mask = load_mask(m.merge);
+	size_t pair = 0;
+	for (; pair + 8 <= pairs; pair += 8) {
+		const __m128i yv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + pair * 2));
+		const __m128i uv = _mm_unpacklo_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + pair)),
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + pair)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pair * 4),
+				_mm_shuffle_epi8(_mm_unpacklo_epi64(yv, uv), mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pair * 4 + 16),
+				_mm_shuffle_epi8(_mm_unpackhi_epi64(yv, uv), mask));
+	}
+	merge_yuv422_scalar(y, u, v, dst, pair, pairs, layout);
+}
+
+#endif
+
+#ifdef YURI_HAVE_AVX2_TARGET
+
+/* ***************************************************************************
+ * 					AVX2 versions
+ *************************************************************************** */
+
+// Processes two 16 byte chunks per iteration, one in each lane.
+YURI_TARGET_AVX2
+void shuffle_pixels_avx2(const uint8_t* src, size_t src_bpp, uint8_t* dst, size_t dst_bpp, size_t count,
+		const std::array<uint8_t, 4>& order, uint8_t fill)
+{
+	const shuffle_mask_t m = make_shuffle_mask(src_bpp, dst_bpp, order, fill);
+	const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m.shuffle)));
+	const __m256i fillv = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m.fill)));
+	const size_t src_step = m.pixels * src_bpp;
+	const size_t dst_step = m.pixels * dst_bpp;
+	size_t pixel = 0;
+	for (; pixel + m.pixels + m.guard <= count; pixel += 2 * m.pixels) {
+		const uint8_t* s = src + pixel * src_bpp;
+		uint8_t* d = dst + pixel * dst_bpp;
+		const __m256i in = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s))),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + src_step)), 1);
+		const __m256i out = _mm256_or_si256(_mm256_shuffle_epi8(in, shuffle), fillv);
+		if (dst_step == 16) {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(d), out);
+		} else {
+			// The second store overwrites the unused last byte of the first one
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm256_castsi256_si128(out));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d + dst_step), _mm256_extracti128_si256(out, 1));
+		}
+	}
+	shuffle_pixels_ssse3(src + pixel * src_bpp, src_bpp, dst + pixel * dst_bpp, dst_bpp, count - pixel, order, fill);
+}
+
+#endif
+
+using detail::swizzle_kernels_t;
+
+template<size_t components>
+void deinterleave_n_scalar(const uint8_t* src, uint8_t* const* planes, size_t count)
+{
+	deinterleave_scalar(src, planes, components, 0, count);
+}
+
+template<size_t components>
+void interleave_n_scalar(const uint8_t* const* planes, uint8_t* dst, size_t count)
+{
+	interleave_scalar(planes, dst, components, 0, count);
+}
+
+void split_yuv422_all_scalar(const uint8_t* src, uint8_t* y, uint8_t* u, uint8_t* v, size_t pairs,
+		const yuv422_layout_t& layout)
+{
+	split_yuv422_scalar(src, y, u, v, 0, pairs, layout);
+}
+
+void merge_yuv422_all_scalar(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t pairs,
+		const yuv422_layout_t& layout)
+{
+	merge_yuv422_scalar(y, u, v, dst, 0, pairs, layout);
+}
+
+std::vector<swizzle_kernels_t> make_kernels()
+{
+	std::vector<swizzle_kernels_t> kernels = {{
+			&shuffle_pixels_scalar,
+			&deinterleave_n_scalar<2>, &interleave_n_scalar<2>,
+			&deinterleave_n_scalar<3>, &interleave_n_scalar<3>,
+			&deinterleave_n_scalar<4>, &interleave_n_scalar<4>,
+			&split_yuv422_all_scalar, &merge_yuv422_all_scalar, "scalar"}};
+#ifdef YURI_HAVE_SSSE3_TARGET
+	if (cpu_has_ssse3()) {
+		kernels.push_back({&shuffle_pixels_ssse3,
+			&deinterleave2, &interleave2,
+			&deinterleave3_ssse3, &interleave3_ssse3,
+			&deinterleave4_ssse3, &interleave4_ssse3,
+			&split_yuv422_ssse3, &merge_yuv422_ssse3, "SSSE3"});
+#ifdef YURI_HAVE_AVX2_TARGET
+		if (cpu_has_avx2()) {
+			kernels.push_back(kernels.back());
+			kernels.back().shuffle = &shuffle_pixels_avx2;
+			kernels.back().name = "AVX2";
+		}
+#endif
+	}
+#endif
+	return kernels;
+}
+
+const swizzle_kernels_t& get_swizzle_kernels()
+{
+	static const swizzle_kernels_t kernels = make_kernels().back();
+	return kernels;
+}
+
+}
+
+void shuffle_pixels(const uint8_t* src, size_t src_bpp, uint8_t* dst, size_t dst_bpp, size_t count,
+		const std::array<uint8_t, 4>& order, uint8_t fill)
+{
+	get_swizzle_kernels().shuffle(src, src_bpp, dst, dst_bpp, count, order, fill);
+}
+
+void deinterleave_planes(const uint8_t* src, uint8_t* const* planes, size_t components, size_t count)
+{
+	switch (components) {
+		case 2: get_swizzle_kernels().deinterleave2(src, planes, count); break;
+		case 3: get_swizzle_kernels().deinterleave3(src, planes, count); break;
+		case 4: get_swizzle_kernels().deinterleave4(src, planes, count); break;
+		default: deinterleave_scalar(src, planes, components, 0, count); break;
+	}
+}
+
+void interleave_planes(const uint8_t* const* planes, uint8_t* dst, size_t components, size_t count)
+{
+	switch (components) {
+		case 2: get_swizzle_kernels().interleave2(planes, dst, count); break;
+		case 3: get_swizzle_kernels().interleave3(planes, dst, count); break;
+		case 4: get_swizzle_kernels().interleave4(planes, dst, count); break;
+		default: interleave_scalar(planes, dst, components, 0, count); break;
+	}
+}
+
+void split_yuv422(const uint8_t* src, uint8_t* y, uint8_t* u, uint8_t* v, size_t pairs,
+		const yuv422_layout_t& layout)
+{
+	get_swizzle_kernels().split422(src, y, u, v, pairs, layout);
+}
+
+void merge_yuv422(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t pairs,
+		const yuv422_layout_t& layout)
+{
+	get_swizzle_kernels().merge422(y, u, v, dst, pairs, layout);
+}
+
+namespace detail {
+
+std::vector<swizzle_kernels_t> get_supported_swizzle_kernels()
+{
+	return make_kernels();
+}
+
+}
+
+}
+}
+}
@@ -0,0 +1,106 @@
+/*!
+ * @file 		swizzle.h
+ * @author 		agent <agent@local>
+ * @date 		19.10.2026
+ * @copyright	Institute of Intermedia, CTU in Prague, 2026
+ * 				Distributed under modified BSD Licence, details in file doc/LICENSE
+ *
+ * @brief		Byte permutations of packed and planar pixel data
+ *
+ * All functions select SSSE3/AVX2 implementation at runtime when available
+ * and produce identical results to their scalar versions.
+ */
+
+#ifndef SRC_YURI_CORE_UTILS_SWIZZLE_H_
+#define SRC_YURI_CORE_UTILS_SWIZZLE_H_
+
+#include "yuri/core/utils/platform.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace yuri {
+namespace core {
+namespace utils {
+
+/*!
+ * Reorders bytes of @em count packed pixels.
+ *
+ * Byte @em k of each output pixel is set to byte @em order[k] of the corresponding input pixel,
+ * or to @em fill when @em order[k] is not lower than @em src_bpp.
+ *
+ * @param src_bpp	Bytes per input pixel (3 or 4)
+ * @param dst_bpp	Bytes per output pixel (3 or 4)
+ */
+EXPORT void shuffle_pixels(const uint8_t* src, size_t src_bpp, uint8_t* dst, size_t dst_bpp, size_t count,
+		const std::array<uint8_t, 4>& order, uint8_t fill = 0xFF);
+
+/*!
+ * Splits @em count pixels with @em components interleaved bytes into separate planes.
+ * Component @em k is stored to @em planes[k].
+ *
+ * @param components Number of components (2, 3 or 4)
+ */
+EXPORT void deinterleave_planes(const uint8_t* src, uint8_t* const* planes, size_t components, size_t count);
+
+/*!
+ * Interleaves @em count pixels from @em components planes into a single packed line.
+ *
+ * @param components Number of components (2, 3 or 4)
+ */
+EXPORT void interleave_planes(const uint8_t* const* planes, uint8_t* dst, size_t components, size_t count);
+
+/*!
+ * Position of Y0, U, Y1 and V bytes in a macropixel of packed YUV 4:2:2 formats.
+ */
+using yuv422_layout_t = std::array<uint8_t, 4>;
+
+const yuv422_layout_t yuyv_layout = {{0, 1, 2, 3}};
+const yuv422_layout_t uyvy_layout = {{1, 0, 3, 2}};
+const yuv422_layout_t yvyu_layout = {{0, 3, 2, 1}};
+const yuv422_layout_t vyuy_layout = {{1, 2, 3, 0}};
+
+/*!
+ * Splits @em pairs macropixels of packed YUV 4:2:2 into Y, U and V planes.
+ */
+EXPORT void split_yuv422(const uint8_t* src, uint8_t* y, uint8_t* u, uint8_t* v, size_t pairs,
+		const yuv422_layout_t& layout);
+
+/*!
+ * Merges @em pairs macropixels from Y, U and V planes into packed YUV 4:2:2.
+ */
+EXPORT void merge_yuv422(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, size_t pairs,
+		const yuv422_layout_t& layout);
+
+namespace detail {
+
+/*!
+ * Implementations of the functions above for a single instruction set.
+ */
+struct swizzle_kernels_t {
+	void (*shuffle)(const uint8_t*, size_t, uint8_t*, size_t, size_t, const std::array<uint8_t, 4>&, uint8_t);
+	void (*deinterleave2)(const uint8_t*, uint8_t* const*, size_t);
+	void (*interleave2)(const uint8_t* const*, uint8_t*, size_t);
+	void (*deinterleave3)(const uint8_t*, uint8_t* const*, size_t);
+	void (*interleave3)(const uint8_t* const*, uint8_t*, size_t);
+	void (*deinterleave4)(const uint8_t*, uint8_t* const*, size_t);
+	void (*interleave4)(const uint8_t* const*, uint8_t*, size_t);
+	void (*split422)(const uint8_t*, uint8_t*, uint8_t*, uint8_t*, size_t, const yuv422_layout_t&);
+	void (*merge422)(const uint8_t*, const uint8_t*, const uint8_t*, uint8_t*, size_t, const yuv422_layout_t&);
+	const char* name;
+};
+
+/*!
+ * Returns scalar kernels, followed by kernels for each SIMD extension supported by current CPU.
+ * The functions above use the last ones.
+ */
+EXPORT std::vector<swizzle_kernels_t> get_supported_swizzle_kernels();
+
+}
+
+}
+}
+}
+
+#endif /* SRC_YURI_CORE_UTILS_SWIZZLE_H_ */
@@ -87,7 +87,11 @@ public:
 	}
 
 	uvector(uvector<T, Realloc>&& rhs) noexcept:data_(std::move(rhs.data_)),size_(rhs.size_),allocated_(rhs.allocated_),deleter_(std::move(rhs.deleter_))
-	{}
+	{
+		// Leaves rhs empty, so it can be reused safely
+		rhs.size_ = 0;
+		rhs.allocated_ = 0;
+	}
 
 	uvector<T, Realloc>& operator=(uvector<T, Realloc>&& rhs) noexcept {
 		// By using swap, there's no need to deallocate data immediately
@@ -158,8 +162,11 @@ public:
 	template< class InputIt >
 	void 					insert( iterator pos, InputIt first, InputIt last) {
 		size_type count = std::distance(first,last);
+		// reserve() may reallocate, so pos has to be recomputed after it
+		const size_type offset = std::distance(begin(), pos);
 		reserve(size_+count);
-		if (pos<end()) std::copy_backward(pos,end(),end());
+		pos = begin() + offset;
+		if (pos<end()) std::copy_backward(pos,end(),end()+count);
 		std::copy(first,last,pos);
 		size_ += count;
 	}
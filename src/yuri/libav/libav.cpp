@@ -24,6 +24,7 @@ extern "C" {
 #include <map>
 #include <cassert>
 #include <atomic>
+#include <tuple>
 namespace yuri {
 namespace libav {
 
@@ -87,8 +88,9 @@ std::unordered_map<format_t, AVPixelFormat> yuri_pixel_map = {
 		{uyvy422,					AV_PIX_FMT_UYVY422},
 
 		{yuv411p,					AV_PIX_FMT_YUV411P},
-
-		{yuv422_v210,				AV_PIX_FMT_YUV422P10LE},
+		{yuv422p10,					AV_PIX_FMT_YUV422P10LE},
+		{yuv420p10,					AV_PIX_FMT_YUV420P10LE},
+		{yuv422p16,					AV_PIX_FMT_YUV422P16LE},
 
         {nv12,				        AV_PIX_FMT_NV12},
 };
@@ -181,12 +183,71 @@ yuri::format_t yuri_format_from_avcodec(AVCodecID codec)
 	return 0;
 }
 
-core::pRawVideoFrame yuri_frame_from_av(const AVFrame& av_frame)
+namespace {
+
+//! Deleter for planes referencing an AVFrame, the frame is released with the last plane
+struct av_frame_deleter {
+	std::shared_ptr<AVFrame> frame;
+	void operator()(void*) noexcept { frame.reset(); }
+};
+
+std::shared_ptr<AVFrame> reference_av_frame(const AVFrame& av_frame)
+{
+	AVFrame* ref = av_frame_alloc();
+	if (!ref) return {};
+	if (av_frame_ref(ref, &av_frame) < 0) {
+		av_frame_free(&ref);
+		return {};
+	}
+	return {ref, [](AVFrame* f) { av_frame_free(&f); }};
+}
+
+/*!
+ * Wraps buffers of an AVFrame as planes of a new frame.
+ * @return empty pointer if the frame has to be copied
+ */
+core::pRawVideoFrame wrap_av_frame(const AVFrame& av_frame, format_t fmt, resolution_t res, bool allow_padding)
+{
+	// Buffers referenced elsewhere (e.g. reference pictures kept by the decoder) can't be shared,
+	// as get_frame_unique() doesn't know about the other references and nodes could draw into them.
+	if (!av_frame_is_writable(const_cast<AVFrame*>(&av_frame))) return {};
+	const auto& fi = core::raw_format::get_format_info(fmt);
+	const size_t planes = fi.planes.size();
+	if (!planes || planes > AV_NUM_DATA_POINTERS) return {};
+	for (size_t i = 0; i < planes; ++i) {
+		// Flipped images (negative line size) are copied
+		if (!av_frame.data[i] || av_frame.linesize[i] <= 0) return {};
+		const size_t line_size = std::get<0>(core::RawVideoFrame::get_plane_params(fi, i, res));
+		const size_t stride = av_frame.linesize[i];
+		if (stride < line_size || (!allow_padding && stride != line_size)) return {};
+	}
+	auto ref = reference_av_frame(av_frame);
+	if (!ref) return {};
+
+	auto frame = std::make_shared<core::RawVideoFrame>(fmt, res, 0);
+	for (size_t i = 0; i < planes; ++i) {
+		resolution_t plane_res;
+		std::tie(std::ignore, std::ignore, plane_res) = core::RawVideoFrame::get_plane_params(fi, i, res);
+		const size_t stride = ref->linesize[i];
+		core::Plane::vector_type data{ref->data[i], stride * plane_res.height, av_frame_deleter{ref}};
+		frame->emplace_back(std::move(data), plane_res, static_cast<dimension_t>(stride));
+	}
+	return frame;
+}
+
+}
+
+core::pRawVideoFrame yuri_frame_from_av(const AVFrame& av_frame, bool allow_padding)
 {
 	format_t fmt = libav::yuri_pixelformat_from_av(static_cast<AVPixelFormat>(av_frame.format));
 	if (fmt == 0) return {};
+	const resolution_t res {static_cast<dimension_t>(av_frame.width), static_cast<dimension_t>(av_frame.height)};
+
+	if (auto frame = wrap_av_frame(av_frame, fmt, res, allow_padding)) {
+		return frame;
+	}
 
-	core::pRawVideoFrame frame = core::RawVideoFrame::create_empty(fmt, {static_cast<dimension_t>(av_frame.width), static_cast<dimension_t>(av_frame.height)}, true);
+	core::pRawVideoFrame frame = core::RawVideoFrame::create_empty(fmt, res, true);
 	const auto& fi = core::raw_format::get_format_info(fmt);
 	for (size_t i=0;i<4;++i) {
 		if ((av_frame.linesize[i] == 0) || (!av_frame.data[i])) break;
@@ -37,7 +37,19 @@ yuri::format_t yuri_pixelformat_from_av(AVPixelFormat format);
 yuri::format_t yuri_format_from_avcodec(AVCodecID codec);
 yuri::format_t yuri_audio_from_av(AVSampleFormat format);
 
-core::pRawVideoFrame yuri_frame_from_av(const AVFrame& frame);
+/*!
+ * Creates yuri frame from decoded AVFrame.
+ *
+ * When possible, the frame is not copied, but planes reference buffers of @em frame
+ * (which are kept alive as long as the planes exist). This is done only when nothing else
+ * references the buffers (av_frame_is_writable()), so frames still used by the decoder,
+ * e.g. as reference pictures, are always copied.
+ * @param frame			Decoded frame
+ * @param allow_padding	Allows planes with lines padded by the decoder (line size larger than
+ * 						the width of the plane). If false, frames with padded lines are copied
+ * 						into planes with tightly packed lines.
+ */
+core::pRawVideoFrame yuri_frame_from_av(const AVFrame& frame, bool allow_padding = false);
 
 lock_t get_libav_lock();
 